@@ -0,0 +1,354 @@
+/**
+* times the two heaviest users of _array at startup, loading a mesh
+* and splitting a string, with _array as it was and as it is.
+*
+* the old _array is kept here as _old_array, as it stood before it
+* grew geometrically and learnt to move: it grows by two unless told
+* to double, and zero fills and copies every object when it does.
+* the loader and the split are run on each as they were written for
+* it, the old ones copying each submesh, keyframe and word into place,
+* the new ones reserving and filling in place.
+*
+* the loader and the split live in application.cpp and
+* application_header.h, which need direct3d, so they are repeated here
+* with stand ins for _vertex, _submesh and _mesh of the same layout.
+* the mesh is a made up _mesh_ file of the same format, built in
+* memory. both ways must load and split to the same counts. exits
+* non zero if they don't.
+*/
+
+#include "core.h"
+
+#include <cstdio>
+#include <ctime>
+
+#define bench_submeshes     8
+#define bench_vertices      4096
+#define bench_keyframes     64
+#define bench_bones         32
+#define bench_words         4096
+#define bench_mesh_loads    200
+#define bench_string_splits 200
+
+/* _array before it doubled and moved, kept to time against */
+template <typename T,typename T2 = uint32_t >
+struct _old_array {
+
+	T * m_data;
+	T2  m_size;
+	T2  m_count;
+
+	~_old_array(){ clear(); }
+	_old_array() : m_data(NULL),m_size(0),m_count(0) {}
+	_old_array(const _old_array& x) : m_data(NULL),m_size(0),m_count(0){ copy(x); }
+	void operator = (const _old_array& x) { copy(x); }
+	void copy (const _old_array& x){
+		clear();
+		if(x.m_count){
+			alloc(x.m_count+1);
+			m_count = x.m_count;
+			for(T2 i =0;i<m_count; i++){ m_data[i] = x.m_data[i]; }
+		}
+	}
+	void clear() { if(m_data){ delete [] m_data;m_data = NULL;m_size=m_count=0;} }
+	void alloc(const T2& count){
+		if(m_size >= count){ return; }
+
+		T* buffer = new T[count];
+		application_zero(buffer,sizeof(T)*count);
+		if( m_data ){
+			for(T2 i =0;i<m_size; i++){ buffer[i] = m_data[i]; }
+			delete [] m_data;
+		}
+		m_data = buffer;
+		m_size = count;
+	}
+	void allocate(const T2& count){
+		clear();
+		alloc(count+1);
+		m_count=count;
+	}
+	void pushback(const T& val,bool p2 = false){
+		T2 count = m_count+2;
+		if(p2) { count = (m_size<=count)? count*2 : count; }
+		alloc(count);
+		m_data[m_count++] = val;
+	}
+	T& operator [](const T2& index){ return m_data[index]; }
+	const T& operator [](const T2& index) const { return m_data[index]; }
+};
+
+typedef _old_array<char>          _old_string;
+typedef _old_array<int32_t>       _old_int_array;
+typedef _old_array<_old_string>   _old_string_array;
+typedef _old_array<_mat4>         _old_matrix_array;
+typedef _old_array<_old_matrix_array> _old_transform_array;
+
+/* laid out as _vertex, copied member by member as it is */
+struct bench_vertex {
+	bench_vertex(){}
+	bench_vertex(const bench_vertex& v){ copy(v); }
+	void operator = (const bench_vertex& v){ copy(v); }
+	void copy(const bench_vertex& v){
+		m_vertex = v.m_vertex;
+		m_normal = v.m_normal;
+		m_uv = v.m_uv;
+		m_bone_indexes = v.m_bone_indexes;
+		m_bone_weights = v.m_bone_weights;
+	}
+	_vec3 m_vertex;
+	_vec3 m_normal;
+	_vec2 m_uv;
+	_vec4 m_bone_indexes;
+	_vec4 m_bone_weights;
+};
+
+struct bench_submesh {
+	bench_submesh(){}
+	bench_submesh(const bench_submesh& sm) { copy(sm); }
+	bench_submesh(bench_submesh&& sm) { move(sm); }
+	void operator = (const bench_submesh& sm) { copy(sm); }
+	void operator = (bench_submesh&& sm) { move(sm); }
+	void copy(const bench_submesh& sm){
+		m_indices  = sm.m_indices;
+		m_vertices = sm.m_vertices;
+	}
+	void move(bench_submesh& sm){
+		m_indices  = _move(sm.m_indices);
+		m_vertices = _move(sm.m_vertices);
+	}
+	_int_array m_indices;
+	_array<bench_vertex> m_vertices;
+};
+
+struct bench_mesh {
+	_array<bench_submesh> m_submeshes;
+	_transform_array m_keyframes;
+};
+
+/* _submesh and _mesh as they were, copied whole */
+struct bench_old_submesh {
+	bench_old_submesh(){}
+	bench_old_submesh(const bench_old_submesh& sm) { copy(sm); }
+	void operator = (const bench_old_submesh& sm) { copy(sm); }
+	void copy(const bench_old_submesh& sm){
+		m_indices  = sm.m_indices;
+		m_vertices = sm.m_vertices;
+	}
+	_old_int_array m_indices;
+	_old_array<bench_vertex> m_vertices;
+};
+
+struct bench_old_mesh {
+	_old_array<bench_old_submesh> m_submeshes;
+	_old_transform_array m_keyframes;
+};
+
+/* the file: submesh count, then indices and vertices per submesh, then bones and keyframes */
+static _array<uint8_t> benchfile() {
+	_array<uint8_t> file;
+	uint32_t size = 6 + sizeof(uint16_t) +
+		bench_submeshes*(2*sizeof(uint32_t) + bench_vertices*(sizeof(uint32_t) + sizeof(bench_vertex))) +
+		2*sizeof(uint16_t) + sizeof(_mat4)*bench_bones*(bench_keyframes+1);
+	file.allocate(size);
+
+	uint8_t *data = file.m_data;
+	memcpy(data, "_mesh_", 6); data += 6;
+	*(uint16_t*)data = bench_submeshes; data += sizeof(uint16_t);
+	for (uint32_t s = 0; s < bench_submeshes; s++) {
+		*(uint32_t*)data = bench_vertices; data += sizeof(uint32_t);
+		for (uint32_t i = 0; i < bench_vertices; i++) { *(uint32_t*)data = i; data += sizeof(uint32_t); }
+		*(uint32_t*)data = bench_vertices; data += sizeof(uint32_t);
+		for (uint32_t i = 0; i < bench_vertices; i++) {
+			bench_vertex v;
+			v.m_vertex = _vec3(float(i), float(s), 1.0f);
+			memcpy(data, &v, sizeof(bench_vertex)); data += sizeof(bench_vertex);
+		}
+	}
+	*(uint16_t*)data = bench_bones; data += sizeof(uint16_t);
+	data += sizeof(_mat4)*bench_bones;
+	*(uint16_t*)data = bench_keyframes;
+	return file;
+}
+
+/* as application::loadmeshfile, the bones themselves left out */
+static void benchloadmesh(const uint8_t *all_data, bench_mesh *mesh) {
+	uint32_t pos = 6;
+	uint16_t submesh_count_ = *( (uint16_t*)(&all_data[pos]) );
+	pos += sizeof(uint16_t);
+
+	mesh->m_submeshes.reserve(mesh->m_submeshes.m_count+submesh_count_);
+	for (uint32_t i = 0; i < submesh_count_; i++) {
+
+		bench_submesh &submesh_ = mesh->m_submeshes.emplaceback();
+		uint32_t index_count_ = *( (uint32_t*)(&all_data[pos]) );
+		pos += sizeof(uint32_t);
+
+		submesh_.m_indices.reserve(index_count_);
+		for (uint32_t i = 0; i < index_count_; i++) {
+			submesh_.m_indices.pushback( *( (uint32_t*)(&all_data[pos]) ) ,true);
+			pos += sizeof(uint32_t);
+		}
+
+		uint32_t vertex_count_ = *( (uint32_t*)(&all_data[pos]) );
+		pos += sizeof(uint32_t);
+
+		bench_vertex * v = (bench_vertex*)(&all_data[pos]);
+		submesh_.m_vertices.reserve(vertex_count_);
+		for (uint32_t ii = 0; ii < vertex_count_; ii++) { submesh_.m_vertices.pushback( v[ii] ,true); }
+
+		pos += sizeof(bench_vertex)*vertex_count_;
+	}
+
+	uint16_t bone_count = *( (uint16_t*)(&all_data[pos]) );
+	pos += sizeof(uint16_t);
+	_mat4* bones = ( _mat4* )(&all_data[pos]);
+	pos += sizeof(_mat4)*bone_count;
+	uint16_t keyframe_count = *( (uint16_t*)(&all_data[pos]) );
+
+	mesh->m_keyframes.reserve(mesh->m_keyframes.m_count+keyframe_count);
+	for (uint32_t ii = 0; ii < keyframe_count; ii++) {
+		_matrix_array &keyframe = mesh->m_keyframes.emplaceback();
+		keyframe.allocate(bone_count);
+		for (uint16_t j = 0; j < bone_count; j++) { keyframe[j] = bones[j]; }
+	}
+}
+
+/* as _utility::stringsplit */
+static _string_array benchsplit(const _string& string, char split = ' ') {
+	_string buffer;
+	_string_array result;
+
+	for (uint32_t i = 0; i < string.m_count; i++) {
+		if (string[i] == split) {
+			if (buffer.m_count > 0) { result.pushback(_move(buffer),true); }
+		} else { buffer.pushback(string[i],true); }
+	}
+	if (buffer.m_count > 0) { result.pushback(_move(buffer),true); }
+
+	return result;
+}
+
+/* as application::loadmeshfile was, each submesh and keyframe built then copied in */
+static void benchloadmeshold(const uint8_t *all_data, bench_old_mesh *mesh) {
+	uint32_t pos = 6;
+	uint16_t submesh_count_ = *( (uint16_t*)(&all_data[pos]) );
+	pos += sizeof(uint16_t);
+
+	for (uint32_t i = 0; i < submesh_count_; i++) {
+
+		bench_old_submesh submesh_;
+		uint32_t index_count_ = *( (uint32_t*)(&all_data[pos]) );
+		pos += sizeof(uint32_t);
+
+		for (uint32_t i = 0; i < index_count_; i++) {
+			submesh_.m_indices.pushback( *( (uint32_t*)(&all_data[pos]) ) ,true);
+			pos += sizeof(uint32_t);
+		}
+
+		uint32_t vertex_count_ = *( (uint32_t*)(&all_data[pos]) );
+		pos += sizeof(uint32_t);
+
+		bench_vertex * v = (bench_vertex*)(&all_data[pos]);
+		for (uint32_t ii = 0; ii < vertex_count_; ii++) { submesh_.m_vertices.pushback( v[ii] ,true); }
+
+		mesh->m_submeshes.pushback(submesh_,true);
+
+		pos += sizeof(bench_vertex)*vertex_count_;
+	}
+
+	uint16_t bone_count = *( (uint16_t*)(&all_data[pos]) );
+	pos += sizeof(uint16_t);
+	_mat4* bones = ( _mat4* )(&all_data[pos]);
+	pos += sizeof(_mat4)*bone_count;
+	uint16_t keyframe_count = *( (uint16_t*)(&all_data[pos]) );
+
+	for (uint32_t ii = 0; ii < keyframe_count; ii++) {
+		_old_matrix_array keyframe;
+		keyframe.allocate(bone_count);
+		for (uint16_t j = 0; j < bone_count; j++) { keyframe[j] = bones[j]; }
+		mesh->m_keyframes.pushback(keyframe);
+	}
+}
+
+/* as _utility::stringsplit was, each word copied out then cleared */
+static _old_string_array benchsplitold(const _old_string& string, char split = ' ') {
+	_old_string buffer;
+	_old_string_array result;
+
+	for (uint32_t i = 0; i < string.m_count; i++) {
+		if (string[i] == split) {
+			if (buffer.m_count > 0) {
+				result.pushback(buffer,true);
+				buffer.clear();
+			}
+		} else { buffer.pushback(string[i],true); }
+	}
+	if (buffer.m_count > 0) { result.pushback(buffer,true); }
+
+	return result;
+}
+
+/* prints the time of one run each way, in microseconds */
+static void benchreport(const char *name, double seconds[2], uint32_t runs) {
+	printf("  %-16s %12.1f %12.1f\n", name, seconds[0] * 1e6 / double(runs), seconds[1] * 1e6 / double(runs));
+}
+
+static double benchseconds(clock_t start) {
+	return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main() {
+
+	_array<uint8_t> file = benchfile();
+
+	_old_string old_text;
+	_string text;
+	const char *word = "-0.125 ";
+	for (uint32_t i = 0; i < bench_words; i++) {
+		for (const char *c = word; *c; c++) {
+			old_text.pushback(*c,true);
+			text.pushback(*c,true);
+		}
+	}
+
+	printf("  %-16s %12s %12s\n", "us a run", "old _array", "_array");
+	uint32_t counts[2][2] = { { 0, 0 }, { 0, 0 } };
+	double seconds[2];
+
+	clock_t start = clock();
+	for (uint32_t n = 0; n < bench_mesh_loads; n++) {
+		bench_old_mesh mesh;
+		benchloadmeshold(file.m_data, &mesh);
+		counts[0][0] += mesh.m_submeshes[n % bench_submeshes].m_vertices.m_count + mesh.m_keyframes.m_count;
+	}
+	seconds[0] = benchseconds(start);
+
+	start = clock();
+	for (uint32_t n = 0; n < bench_mesh_loads; n++) {
+		bench_mesh mesh;
+		benchloadmesh(file.m_data, &mesh);
+		counts[1][0] += mesh.m_submeshes[n % bench_submeshes].m_vertices.m_count + mesh.m_keyframes.m_count;
+	}
+	seconds[1] = benchseconds(start);
+	benchreport("mesh load", seconds, bench_mesh_loads);
+
+	start = clock();
+	for (uint32_t n = 0; n < bench_string_splits; n++) {
+		_old_string_array words = benchsplitold(old_text);
+		counts[0][1] += words.m_count;
+	}
+	seconds[0] = benchseconds(start);
+
+	start = clock();
+	for (uint32_t n = 0; n < bench_string_splits; n++) {
+		_string_array words = benchsplit(text);
+		counts[1][1] += words.m_count;
+	}
+	seconds[1] = benchseconds(start);
+	benchreport("string split", seconds, bench_string_splits);
+
+	bool same = counts[0][0] == counts[1][0] && counts[0][1] == counts[1][1];
+	printf("counts %u %u, %s\n", counts[1][0], counts[1][1], same ? "the same both ways" : "DIFFERENT between the ways");
+	return same ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+/**
+* times box contact generation at 10, 100 and 1000 boxes three ways:
+* the old brute force pass that hands every pair of boxes to
+* collision_detector::boxandbox, sweep_and_prune, and the
+* dynamic_aabb_tree physics_world uses.
+*
+* the boxes drift through a space that grows with their number, so
+* each box has about as many neighbours at every size. they bounce off
+* its walls, and are moved by hand rather than simulated, so each
+* broadphase sees the same boxes in the same places every step. the
+* pairs found touching must be the same all three ways. the contacts
+* of a pair depend on which box of it comes first, which each way
+* orders as it likes, so their number can differ a little.
+*
+* for each it prints the narrowphase pair tests a step, the pairs
+* touching, the contacts found and the time a step, the broadphase
+* update included.
+*/
+
+#include "physics.h"
+
+#include <cstdio>
+#include <ctime>
+
+#define bench_steps   30
+#define bench_step    (1.0f/60.0f)
+
+/* the room each box gets, as the edge of a cube */
+#define bench_spacing 4.0f
+
+enum bench_method { bench_brute_force, bench_sweep_and_prune, bench_tree, bench_methods };
+
+static const char *s_method_names[bench_methods] = { "brute force", "sweep and prune", "aabb tree" };
+
+struct bench_result {
+	uint32_t m_pair_tests;
+	uint32_t m_touching;
+	uint32_t m_contacts;
+	double   m_seconds;
+};
+
+/* a field of boxes, and where they are heading */
+struct bench_field {
+	physics_world m_world;
+	_array<_vec3> m_velocities;
+	float m_size;
+};
+
+static bool benchfield(bench_field *field, uint32_t count) {
+	if (!field->m_world.create(count, 1024, 1 << 20, 1)) { return false; }
+	field->m_velocities.alloc(count);
+
+	// the cube of space, with about bench_spacing^3 for each box
+	float side = 1.0f;
+	while (side*side*side < float(count)) { side += 1.0f; }
+	field->m_size = side * bench_spacing;
+
+	class random random_(count);
+	for (uint32_t i = 0; i < count; i++) {
+		collision_box *box = field->m_world.createbox();
+		if (!box) { return false; }
+		box->m_half_size = random_.randomvector( _vec3(0.5f, 0.5f, 0.5f), _vec3(1.5f, 1.5f, 1.5f) );
+
+		rigid_body *body = box->m_body;
+		body->setposition( random_.randomvector( _vec3(0.0f, 0.0f, 0.0f), _vec3(field->m_size, field->m_size, field->m_size) ) );
+		body->setorientation( random_.randomquaternion() );
+		body->setawake();
+		body->calculatederiveddata();
+		box->calculateinternals();
+
+		field->m_velocities.pushback( random_.randomvector(5.0f), true );
+	}
+	return true;
+}
+
+/* moves every box on, turning it back at the walls */
+static void benchmove(bench_field *field) {
+	for (uint32_t i = 0; i < field->m_world.m_boxes.m_count; i++) {
+		collision_box *box = &field->m_world.m_boxes[i];
+		_vec3 position = box->m_body->getposition();
+		_vec3 &velocity = field->m_velocities[i];
+		position += velocity * bench_step;
+		for (uint32_t a = 0; a < 3; a++) {
+			if ((position[a] < 0.0f && velocity[a] < 0.0f) || (position[a] > field->m_size && velocity[a] > 0.0f)) {
+				velocity[a] = -velocity[a];
+			}
+		}
+		box->m_body->setposition(position);
+		box->m_body->calculatederiveddata();
+		box->calculateinternals();
+	}
+}
+
+static void benchrun(uint32_t count, bench_method method, bench_result *result) {
+	bench_field field;
+	collision_data data;
+	if (!benchfield(&field, count) || !data.create(1024, 1 << 20)) { return; }
+
+	sweep_and_prune sap;
+	dynamic_aabb_tree tree;
+	_array<collision_box> &boxes = field.m_world.m_boxes;
+	for (uint32_t i = 0; i < boxes.m_count; i++) {
+		if (method == bench_sweep_and_prune) { sap.insert(&boxes[i], primitive_box); }
+		if (method == bench_tree) { tree.insert(&boxes[i], primitive_box); }
+	}
+
+	result->m_pair_tests = 0;
+	result->m_touching   = 0;
+	result->m_contacts   = 0;
+	clock_t start = clock();
+	for (uint32_t s = 0; s < bench_steps; s++) {
+		benchmove(&field);
+		data.reset();
+
+		if (method == bench_brute_force) {
+			for (uint32_t i = 0; i < boxes.m_count; i++) {
+				for (uint32_t j = i+1; j < boxes.m_count; j++) {
+					if (collision_detector::boxandbox(boxes[i], boxes[j], &data)) { result->m_touching++; }
+				}
+			}
+			result->m_pair_tests += boxes.m_count*(boxes.m_count-1)/2;
+		} else {
+			_array<potential_contact> *pairs;
+			uint32_t pair_count;
+			if (method == bench_sweep_and_prune) {
+				sap.update();
+				pairs = &sap.m_pairs;
+				pair_count = sap.m_pair_count;
+			} else {
+				tree.refit();
+				pair_count = tree.findpairs();
+				pairs = &tree.m_pairs;
+			}
+			for (uint32_t i = 0; i < pair_count; i++) {
+				if (collision_detector::boxandbox(*(collision_box*)(*pairs)[i].m_primitive[0],
+					*(collision_box*)(*pairs)[i].m_primitive[1], &data)) { result->m_touching++; }
+			}
+			result->m_pair_tests += pair_count;
+		}
+		result->m_contacts += data.m_contact_count;
+	}
+	result->m_seconds = double(clock() - start) / CLOCKS_PER_SEC;
+	data.destroy();
+}
+
+int main() {
+
+	static const uint32_t counts[] = { 10, 100, 1000 };
+
+	printf("box contacts, %u steps\n", bench_steps);
+	printf("  %5s  %-16s %12s %10s %10s %10s\n", "boxes", "", "pairs/step", "touching", "contacts", "ms/step");
+
+	bool same = true;
+	for (uint32_t c = 0; c < sizeof(counts)/sizeof(counts[0]); c++) {
+		bench_result results[bench_methods];
+		for (uint32_t m = 0; m < bench_methods; m++) {
+			benchrun(counts[c], bench_method(m), &results[m]);
+			printf("  %5u  %-16s %12u %10u %10u %10.3f\n", counts[c], s_method_names[m],
+				results[m].m_pair_tests / bench_steps, results[m].m_touching / bench_steps,
+				results[m].m_contacts / bench_steps, results[m].m_seconds * 1000.0 / bench_steps);
+			if (results[m].m_touching != results[0].m_touching) { same = false; }
+		}
+	}
+
+	printf(same ? "the same pairs touching every way\n" : "DIFFERENT pairs touching between the ways\n");
+	return same ? 0 : 1;
+}
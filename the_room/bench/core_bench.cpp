@@ -0,0 +1,249 @@
+/**
+* times the float vector, quaternion and matrix operations of core.h.
+*
+* the build makes this twice, core_bench on sse and core_bench_scalar
+* with core_no_simd defined, so the two can be run side by side.
+*
+* the sse code adds some of its products in another order, so its
+* results are rounded differently. before timing, each operation that
+* has an sse path is checked against plain scalar code written out
+* here, and has to agree within bench_tolerance. the sums printed at
+* the end add up millions of results, the quaternion one a product of
+* them, so between the two builds they only agree to about three
+* figures.
+*/
+
+#include "core.h"
+
+#include <ctime>
+
+#define bench_count      1024
+#define bench_iterations 20000
+
+/* the largest difference allowed between an sse result and the scalar one, for inputs in [-1,1] */
+#define bench_tolerance  1e-5f
+
+static _vec4       s_vectors[bench_count];
+static _vec3       s_points[bench_count];
+static _quaternion s_quaternions[bench_count];
+static _mat4       s_matrices[bench_count];
+
+static _vec3 s_points_out[bench_count];
+static float s_x[bench_count], s_y[bench_count], s_z[bench_count];
+static _mat4 s_matrices_out[bench_count];
+
+/* a repeatable value in [-1,1] */
+static float benchvalue(uint32_t &seed) {
+	seed = seed * 1664525u + 1013904223u;
+	return float(seed >> 8) / float(1 << 23) - 1.0f;
+}
+
+/* the scalar product of two quaternions, as the scalar path of _quaternion::operator *= */
+static _quaternion benchquaternion(const _quaternion &a, const _quaternion &b) {
+	return _quaternion(
+		a.r*b.r - a.i*b.i - a.j*b.j - a.k*b.k,
+		a.r*b.i + a.i*b.r + a.j*b.k - a.k*b.j,
+		a.r*b.j + a.j*b.r + a.k*b.i - a.i*b.k,
+		a.r*b.k + a.k*b.r + a.i*b.j - a.j*b.i);
+}
+
+/* the scalar product of a matrix and a vector, with w for the weight of the translation */
+static _vec4 benchtransform(const _mat4 &m, const _vec4 &v) {
+	_vec4 result;
+	for (uint32_t c = 0; c < 4; c++) {
+		result[c] = v.x*m[0][c] + v.y*m[1][c] + v.z*m[2][c] + v.w*m[3][c];
+	}
+	return result;
+}
+
+/* the largest difference of the components of a and b so far */
+static float benchdifference(float error, const float *a, const float *b, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		float difference = fabs(a[i] - b[i]);
+		if (!(difference <= error)) { error = difference; }
+	}
+	return error;
+}
+
+/* prints the largest difference of an operation, and returns false if it is over the tolerance */
+static bool benchcheck(const char *name, float error) {
+	bool passed = error <= bench_tolerance;
+	printf("  %-28s %8.1e%s\n", name, error, passed ? "" : "  over tolerance");
+	return passed;
+}
+
+/* prints the time of one operation, in nanoseconds */
+static void benchreport(const char *name, clock_t start) {
+	double seconds = double(clock() - start) / CLOCKS_PER_SEC;
+	printf("  %-28s %8.2f ns\n", name, seconds * 1e9 / (double(bench_count) * bench_iterations));
+}
+
+int main() {
+
+	uint32_t seed = 1;
+	for (uint32_t i = 0; i < bench_count; i++) {
+		s_vectors[i] = _vec4(benchvalue(seed), benchvalue(seed), benchvalue(seed), benchvalue(seed));
+		s_points[i]  = _vec3(benchvalue(seed), benchvalue(seed), benchvalue(seed));
+		s_x[i] = s_points[i].x; s_y[i] = s_points[i].y; s_z[i] = s_points[i].z;
+		s_quaternions[i] = _quaternion(1.0f, benchvalue(seed)*0.01f, benchvalue(seed)*0.01f, benchvalue(seed)*0.01f);
+		s_quaternions[i].normalise();
+		for (uint32_t c = 0; c < 4; c++) {
+			s_matrices[i][c] = _vec4(benchvalue(seed), benchvalue(seed), benchvalue(seed), benchvalue(seed));
+		}
+	}
+
+#ifdef core_simd
+	printf("core.h on sse\n");
+#else
+	printf("core.h scalar\n");
+#endif
+
+	// every sse path against the scalar code, on the same inputs
+	printf("largest difference from scalar\n");
+	float errors[5] = { 0, 0, 0, 0, 0 };
+	for (uint32_t i = 0; i < bench_count; i++) {
+		const _mat4 &m = s_matrices[i];
+		const _mat4 &n = s_matrices[(i+1) % bench_count];
+
+		_quaternion q = s_quaternions[i];
+		q *= s_quaternions[(i+1) % bench_count];
+		_quaternion qr = benchquaternion(s_quaternions[i], s_quaternions[(i+1) % bench_count]);
+		errors[0] = benchdifference(errors[0], q.data, qr.data, 4);
+
+		_vec3 p  = m * s_points[i];
+		_vec4 pr = benchtransform(m, _vec4(s_points[i].x, s_points[i].y, s_points[i].z, 1.0f));
+		errors[1] = benchdifference(errors[1], &p.x, &pr.x, 3);
+
+		_vec3 d  = m.transformdirection(s_points[i]);
+		_vec4 dr = benchtransform(m, _vec4(s_points[i].x, s_points[i].y, s_points[i].z, 0.0f));
+		errors[2] = benchdifference(errors[2], &d.x, &dr.x, 3);
+
+		// _multiply is always scalar
+		_mat4 mm  = m * n;
+		_mat4 mmr = _multiply(m, n);
+		errors[3] = benchdifference(errors[3], &mm[0].x, &mmr[0].x, 16);
+	}
+	float *outx = &s_points_out[0].x;
+	_transformpoints(s_matrices[1], s_x, s_y, s_z, outx, outx + bench_count, outx + bench_count*2, bench_count);
+	for (uint32_t i = 0; i < bench_count; i++) {
+		_vec4 pr = benchtransform(s_matrices[1], _vec4(s_x[i], s_y[i], s_z[i], 1.0f));
+		float p[3] = { outx[i], outx[bench_count + i], outx[bench_count*2 + i] };
+		errors[4] = benchdifference(errors[4], p, &pr.x, 3);
+	}
+	_transformmatrices(s_matrices[2], s_matrices, s_matrices_out, bench_count);
+	for (uint32_t i = 0; i < bench_count; i++) {
+		_mat4 mmr = _multiply(s_matrices[2], s_matrices[i]);
+		errors[3] = benchdifference(errors[3], &s_matrices_out[i][0].x, &mmr[0].x, 16);
+	}
+
+	bool passed = benchcheck("quaternion *=", errors[0]);
+	passed = benchcheck("mat4 * vec3", errors[1]) && passed;
+	passed = benchcheck("mat4 transformdirection", errors[2]) && passed;
+	passed = benchcheck("mat4 * mat4", errors[3]) && passed;
+	passed = benchcheck("_transformpoints, soa", errors[4]) && passed;
+
+	printf("time per operation\n");
+
+	// each loop feeds its result back in, so nothing can be hoisted
+	clock_t start = clock();
+	_vec4 vsum;
+	for (uint32_t n = 0; n < bench_iterations; n++) {
+		for (uint32_t i = 0; i < bench_count; i++) { vsum = (vsum + s_vectors[i]) * 0.5f; }
+	}
+	benchreport("vec4 + and * scalar", start);
+
+	start = clock();
+	_vec4 vproduct(1.0f);
+	for (uint32_t n = 0; n < bench_iterations; n++) {
+		for (uint32_t i = 0; i < bench_count; i++) { vproduct *= s_vectors[i]; vproduct += s_vectors[i]; }
+	}
+	benchreport("vec4 *= and +=", start);
+
+	start = clock();
+	_quaternion q;
+	for (uint32_t n = 0; n < bench_iterations; n++) {
+		for (uint32_t i = 0; i < bench_count; i++) { q *= s_quaternions[i]; }
+		q.normalise();
+	}
+	benchreport("quaternion *=", start);
+
+	// the transforms are independent, as they are when a set of
+	// bodies or vertices is transformed, and only summed.
+	start = clock();
+	_vec4 transformed;
+	for (uint32_t n = 0; n < bench_iterations; n++) {
+		for (uint32_t i = 0; i < bench_count; i++) { transformed += s_matrices[i] * s_vectors[i]; }
+	}
+	benchreport("mat4 * vec4", start);
+
+	start = clock();
+	_vec3 point;
+	for (uint32_t n = 0; n < bench_iterations; n++) {
+		for (uint32_t i = 0; i < bench_count; i++) { point += s_matrices[i] * s_points[i]; }
+	}
+	benchreport("mat4 * vec3", start);
+
+	start = clock();
+	_vec3 direction;
+	for (uint32_t n = 0; n < bench_iterations; n++) {
+		for (uint32_t i = 0; i < bench_count; i++) { direction += s_matrices[i].transformdirection(s_points[i]); }
+	}
+	benchreport("mat4 transformdirection", start);
+
+	start = clock();
+	_vec4 product;
+	for (uint32_t n = 0; n < bench_iterations; n++) {
+		for (uint32_t i = 0; i < bench_count; i++) {
+			_mat4 m = s_matrices[i] * s_matrices[(i+1) % bench_count];
+			product += m[0] + m[1] + m[2] + m[3];
+		}
+	}
+	benchreport("mat4 * mat4", start);
+
+	// the bulk kernels, one matrix over the whole array
+	start = clock();
+	_vec3 batched;
+	for (uint32_t n = 0; n < bench_iterations; n++) {
+		_transformpoints(s_matrices[n % bench_count], s_points, s_points_out, bench_count);
+		batched += s_points_out[n % bench_count];
+	}
+	benchreport("_transformpoints", start);
+
+	start = clock();
+	for (uint32_t n = 0; n < bench_iterations; n++) {
+		_transformdirections(s_matrices[n % bench_count], s_points, s_points_out, bench_count);
+		batched += s_points_out[n % bench_count];
+	}
+	benchreport("_transformdirections", start);
+
+	start = clock();
+	for (uint32_t n = 0; n < bench_iterations; n++) {
+		_transformpoints(s_matrices[n % bench_count], s_x, s_y, s_z, outx, outx + bench_count, outx + bench_count*2, bench_count);
+		batched.x += outx[n % bench_count];
+	}
+	benchreport("_transformpoints, soa", start);
+
+	start = clock();
+	for (uint32_t n = 0; n < bench_iterations; n++) {
+		_transformmatrices(s_matrices[n % bench_count], s_matrices, s_matrices_out, bench_count);
+		batched += s_matrices_out[n % bench_count].getaxisvector(0);
+	}
+	benchreport("_transformmatrices", start);
+
+	start = clock();
+	for (uint32_t n = 0; n < bench_iterations; n++) {
+		_multiplymatrices(s_matrices, s_matrices + 1, s_matrices_out, bench_count - 1);
+		batched += s_matrices_out[n % (bench_count - 1)].getaxisvector(1);
+	}
+	benchreport("_multiplymatrices", start);
+
+	printf("sums %f %f %f %f %f %f %f\n",
+		vsum.x + vsum.y + vsum.z + vsum.w,
+		vproduct.x + vproduct.y + vproduct.z + vproduct.w,
+		q.r + q.i + q.j + q.k,
+		transformed.x + transformed.y + transformed.z + transformed.w,
+		point.x + point.y + point.z + direction.x + direction.y + direction.z,
+		product.x + product.y + product.z + product.w,
+		batched.x + batched.y + batched.z + s_matrices_out[0][0].x);
+	return passed ? 0 : 1;
+}
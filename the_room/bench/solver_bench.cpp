@@ -0,0 +1,213 @@
+/**
+* compares the contact resolver's two velocity solvers on stacks of
+* boxes: the iterative cyclone resolver and the sequential impulse
+* solver with warm starting.
+*
+* each stack is dropped from a little above the floor, its boxes set
+* off a little from one another, and run until every box sleeps or
+* 30 seconds pass. for each height and solver it prints:
+*   rest    the seconds until every box was asleep, or "never"
+*   drift   how far the top box ended from above the bottom one
+*   fallen  the boxes that ended off the stack, lower than they began
+*   iters   the velocity iterations used a step, while awake
+*   solve   the time resolving contacts took a step, while awake
+*
+* then a pile of tilted boxes is dropped and run for 10 seconds twice,
+* with manifold reduction off and on. it prints the contacts found and
+* kept a step, the iterations and time of the solve, and the deepest
+* penetration seen.
+*/
+
+#include "physics.h"
+
+#include <cstdio>
+#include <ctime>
+
+#define bench_max_steps   1800
+#define bench_step        (1.0f/60.0f)
+
+/* the pile for manifold reduction, layers of side by side boxes */
+#define bench_pile_side   6
+#define bench_pile_boxes  (bench_pile_side*bench_pile_side*3)
+#define bench_pile_steps  600
+
+/* how far off centre each box is set, alternating */
+#define bench_offset      0.01f
+
+struct bench_result {
+	uint32_t m_rest_step;
+	float    m_drift;
+	uint32_t m_fallen;
+	double   m_iterations;
+	double   m_seconds;
+	uint32_t m_steps;
+};
+
+static bool benchstack(physics_world *world, uint32_t height) {
+	if (!world->create(height, 256, 65536, 1)) { return false; }
+
+	for (uint32_t i = 0; i < height; i++) {
+		collision_box *box = world->createbox();
+		if (!box) { return false; }
+		box->m_half_size = _vec3(1.0f, 1.0f, 1.0f);
+
+		rigid_body *body = box->m_body;
+		float offset = (i & 1) ? bench_offset : -bench_offset;
+		body->setposition( _vec3(offset, 1.05f + float(i)*2.02f, offset*0.5f) );
+		body->setorientation(_quaternion());
+		body->setvelocity( _vec3(0.0f, 0.0f, 0.0f) );
+		body->setrotation( _vec3(0.0f, 0.0f, 0.0f) );
+		body->setmass(8.0f);
+
+		_mat3 tensor;
+		tensor.setblockinertiatensor(box->m_half_size, 8.0f);
+		body->setinertiatensor(tensor);
+
+		body->setlineardamping(0.95f);
+		body->setangulardamping(0.8f);
+		body->setacceleration(0.0f, -10.0f, 0.0f);
+		body->setawake();
+		body->calculatederiveddata();
+		body->storeprevious();
+
+		world->addbox(box);
+	}
+	world->addplane( _vec3(0.0f, 1.0f, 0.0f), 0.0f );
+	return true;
+}
+
+static bool benchawake(physics_world *world) {
+	for (uint32_t i = 0; i < world->m_boxes.m_count; i++) {
+		if (world->m_boxes[i].m_body->getawake()) { return true; }
+	}
+	return false;
+}
+
+static void benchrun(uint32_t height, solver_mode mode, bench_result *result) {
+	physics_world world;
+	result->m_rest_step  = 0;
+	result->m_iterations = 0.0;
+	result->m_seconds    = 0.0;
+	result->m_steps      = 0;
+	if (!benchstack(&world, height)) { return; }
+	world.m_resolver.m_mode = mode;
+
+	for (uint32_t s = 0; s < bench_max_steps && benchawake(&world); s++) {
+		world.integrate(bench_step);
+		world.generatecontacts();
+
+		clock_t start = clock();
+		world.resolvecontacts(bench_step);
+		result->m_seconds += double(clock() - start) / CLOCKS_PER_SEC;
+		result->m_iterations += world.m_resolver.m_velocity_iterations_used;
+		result->m_steps++;
+
+		if (!benchawake(&world)) { result->m_rest_step = s+1; }
+	}
+
+	_vec3 bottom = world.m_boxes[0].m_body->getposition();
+	_vec3 top    = world.m_boxes[height-1].m_body->getposition();
+	_vec3 apart  = top - bottom;
+	result->m_drift = sqrt(apart.x*apart.x + apart.z*apart.z);
+
+	result->m_fallen = 0;
+	for (uint32_t i = 1; i < height; i++) {
+		if (world.m_boxes[i].m_body->getposition().y < 1.0f + float(i)*2.0f - 1.0f) { result->m_fallen++; }
+	}
+}
+
+/* a pile of tilted boxes, dropped onto the floor in layers */
+static bool benchpile(physics_world *world) {
+	if (!world->create(bench_pile_boxes, 1024, 65536, 1)) { return false; }
+
+	class random random_(16);
+	for (uint32_t i = 0; i < bench_pile_boxes; i++) {
+		collision_box *box = world->createbox();
+		if (!box) { return false; }
+		box->m_half_size = _vec3(1.0f, 1.0f, 1.0f);
+
+		uint32_t layer = i / (bench_pile_side*bench_pile_side);
+		uint32_t place = i % (bench_pile_side*bench_pile_side);
+		rigid_body *body = box->m_body;
+		body->setposition( _vec3(float(place % bench_pile_side)*2.2f, 1.5f + float(layer)*2.5f, float(place / bench_pile_side)*2.2f) );
+		body->setorientation(1.0f, random_.randombinomial(0.3f), random_.randombinomial(0.3f), random_.randombinomial(0.3f));
+		body->setvelocity( _vec3(0.0f, 0.0f, 0.0f) );
+		body->setrotation( _vec3(0.0f, 0.0f, 0.0f) );
+		body->setmass(8.0f);
+
+		_mat3 tensor;
+		tensor.setblockinertiatensor(box->m_half_size, 8.0f);
+		body->setinertiatensor(tensor);
+
+		body->setlineardamping(0.95f);
+		body->setangulardamping(0.8f);
+		body->setacceleration(0.0f, -10.0f, 0.0f);
+		body->setcansleep(false);
+		body->setawake();
+		body->calculatederiveddata();
+		body->storeprevious();
+
+		world->addbox(box);
+	}
+	world->addplane( _vec3(0.0f, 1.0f, 0.0f), 0.0f );
+	return true;
+}
+
+static void benchreduce(bool reduce) {
+	physics_world world;
+	if (!benchpile(&world)) { return; }
+
+	bool reduced = collision_detector::s_reduce;
+	collision_detector::s_reduce = reduce;
+
+	double found = 0.0, kept = 0.0, iterations = 0.0, seconds = 0.0, depth = 0.0;
+	for (uint32_t s = 0; s < bench_pile_steps; s++) {
+		world.integrate(bench_step);
+		world.generatecontacts();
+
+		collision_data &data = world.m_cdata;
+		found += data.m_contact_count + data.m_reduced_count;
+		kept  += data.m_contact_count;
+		for (uint32_t i = 0; i < data.m_contact_count; i++) {
+			if (data.m_contact_array[i].m_penetration > depth) { depth = data.m_contact_array[i].m_penetration; }
+		}
+
+		clock_t start = clock();
+		world.resolvecontacts(bench_step);
+		seconds += double(clock() - start) / CLOCKS_PER_SEC;
+		iterations += world.m_resolver.m_velocity_iterations_used;
+	}
+	collision_detector::s_reduce = reduced;
+
+	printf("  %-9s %8.1f %8.1f %7.1f %9.4f %9.3f\n", reduce ? "reduced" : "all", found / bench_pile_steps,
+		kept / bench_pile_steps, iterations / bench_pile_steps, seconds * 1000.0 / bench_pile_steps, depth);
+}
+
+int main() {
+
+	static const uint32_t heights[] = { 2, 4, 8, 12 };
+	static const solver_mode modes[] = { solver_iterative, solver_sequential_impulse };
+	static const char *names[] = { "iterative", "sequential impulse" };
+
+	printf("  %6s  %-19s %7s %6s %6s %7s %9s\n", "height", "solver", "rest s", "drift", "fallen", "iters", "solve ms");
+	for (uint32_t h = 0; h < sizeof(heights)/sizeof(heights[0]); h++) {
+		for (uint32_t m = 0; m < sizeof(modes)/sizeof(modes[0]); m++) {
+			bench_result result;
+			benchrun(heights[h], modes[m], &result);
+
+			char rest[16];
+			if (result.m_rest_step) { sprintf(rest, "%.2f", float(result.m_rest_step) * bench_step); }
+			else { sprintf(rest, "never"); }
+
+			double steps = result.m_steps ? double(result.m_steps) : 1.0;
+			printf("  %6u  %-19s %7s %6.3f %6u %7.1f %9.4f\n", heights[h], names[m], rest,
+				result.m_drift, result.m_fallen, result.m_iterations / steps, result.m_seconds * 1000.0 / steps);
+		}
+	}
+
+	printf("\n%u tilted boxes dropped in a pile, %u steps\n", bench_pile_boxes, bench_pile_steps);
+	printf("  %-9s %8s %8s %7s %9s %9s\n", "contacts", "found", "kept", "iters", "solve ms", "deepest");
+	benchreduce(false);
+	benchreduce(true);
+	return 0;
+}
@@ -0,0 +1,138 @@
+/**
+* times physics_world stepping a field of box stacks on 1, 2, 4 and 8
+* threads.
+*
+* the stacks stand apart, so each is an island of its own that the
+* resolver can hand to any thread. the boxes never sleep, so every
+* step does the same work. each run starts from the same field and
+* steps it the same number of times, so the positions it ends with
+* must be the same to the bit whatever the thread count: the checksum
+* of them printed for each run has to match the first.
+*
+* the time is wall clock time, as clock() would add up every thread.
+*/
+
+#include "physics.h"
+
+#include <cstdio>
+#include <memory.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define bench_stacks_side 12
+#define bench_stack_height 4
+#define bench_boxes       (bench_stacks_side*bench_stacks_side*bench_stack_height)
+#define bench_warmup      60
+#define bench_steps       300
+#define bench_step        (1.0f/60.0f)
+
+/* the wall clock, in seconds */
+static double benchseconds() {
+#ifdef _WIN32
+	LARGE_INTEGER count, frequency;
+	QueryPerformanceCounter(&count);
+	QueryPerformanceFrequency(&frequency);
+	return double(count.QuadPart) / double(frequency.QuadPart);
+#else
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return double(now.tv_sec) + double(now.tv_nsec) * 1e-9;
+#endif
+}
+
+/* the stacks, in rows, each box turned a little so they rock */
+static bool benchfield(physics_world *world, uint32_t threads) {
+	if (!world->create(bench_boxes, 1024, 65536, threads)) { return false; }
+
+	for (uint32_t i = 0; i < bench_boxes; i++) {
+		uint32_t stack = i / bench_stack_height;
+		uint32_t level = i % bench_stack_height;
+
+		collision_box *box = world->createbox();
+		if (!box) { return false; }
+		box->m_half_size = _vec3(1.0f, 1.0f, 1.0f);
+
+		rigid_body *body = box->m_body;
+		body->setposition( _vec3(float(stack % bench_stacks_side)*4.0f, 1.0f + float(level)*2.05f, float(stack / bench_stacks_side)*4.0f) );
+		body->setorientation(1.0f, 0.0f, 0.02f*float(level), 0.0f);
+		body->setvelocity( _vec3(0.0f, 0.0f, 0.0f) );
+		body->setrotation( _vec3(0.0f, 0.0f, 0.0f) );
+		body->setmass(8.0f);
+
+		_mat3 tensor;
+		tensor.setblockinertiatensor(box->m_half_size, 8.0f);
+		body->setinertiatensor(tensor);
+
+		body->setlineardamping(0.95f);
+		body->setangulardamping(0.8f);
+		body->setacceleration(0.0f, -10.0f, 0.0f);
+		body->setcansleep(false);
+		body->setawake();
+		body->calculatederiveddata();
+		body->storeprevious();
+
+		world->addbox(box);
+	}
+	world->addplane( _vec3(0.0f, 1.0f, 0.0f), 0.0f );
+	return true;
+}
+
+/* folds the bits of every box position into one number */
+static uint32_t benchchecksum(physics_world *world) {
+	uint32_t sum = 2166136261u;
+	for (uint32_t i = 0; i < world->m_boxes.m_count; i++) {
+		_vec3 position = world->m_boxes[i].m_body->getposition();
+		float values[3] = { position.x, position.y, position.z };
+		for (uint32_t j = 0; j < 3; j++) {
+			uint32_t bits;
+			memcpy(&bits, &values[j], sizeof(bits));
+			sum = (sum ^ bits) * 16777619u;
+		}
+	}
+	return sum;
+}
+
+int main() {
+
+	static const uint32_t threads[] = { 1, 2, 4, 8 };
+
+	printf("%u boxes in %u stacks, %u steps\n", bench_boxes, bench_stacks_side*bench_stacks_side, bench_steps);
+	printf("  threads  step ms  solve ms  speedup  islands  checksum\n");
+
+	double single = 0.0;
+	uint32_t reference = 0;
+	bool same = true;
+	for (uint32_t t = 0; t < sizeof(threads)/sizeof(threads[0]); t++) {
+
+		physics_world world;
+		if (!benchfield(&world, threads[t])) { printf("no world\n"); return 1; }
+		for (uint32_t s = 0; s < bench_warmup; s++) { world.step(bench_step); }
+
+		double solve = 0.0;
+		double start = benchseconds();
+		for (uint32_t s = 0; s < bench_steps; s++) {
+			world.integrate(bench_step);
+			world.generatecontacts();
+			double solve_start = benchseconds();
+			world.resolvecontacts(bench_step);
+			solve += benchseconds() - solve_start;
+		}
+		double seconds = benchseconds() - start;
+
+		if (t == 0) { single = solve; }
+		uint32_t checksum = benchchecksum(&world);
+		if (t == 0) { reference = checksum; }
+		else if (checksum != reference) { same = false; }
+
+		printf("  %7u %8.3f %9.3f %8.2f %8u  %08x\n", world.m_pool.m_thread_count,
+			seconds*1000.0/bench_steps, solve*1000.0/bench_steps, single/solve,
+			world.m_resolver.m_parallel_islands, checksum);
+	}
+
+	printf(same ? "the same on every thread count\n" : "DIFFERENT between thread counts\n");
+	return same ? 0 : 1;
+}
@@ -1,981 +1,1612 @@
-#pragma once
-
-#include <cmath>
-
-template < typename T>
-struct _vector2{
-
-	/* constructors ************************************************************/
-	_vector2():x(0),y(0) {}
-	_vector2(const T& v):x(v),y(v) {}
-	_vector2(const _vector2 &v ):x(v.x),y(v.y) {}
-	_vector2(const T& x_,const T& y_ ):x(x_),y(y_) {}
-	/***************************************************************************/
-
-	T& operator [](const int &index ) { return (&x)[ index ]; }
-	const T& operator [](const int &index )const { return (&x)[ index ]; }
-
-	/* copies this vector */
-	void operator =(const _vector2 &v) { x=v.x; y=v.y; }
-	/** 
-	* flips all the components of the vector 
-	*/
-	void negate() { x=-x; y=-y; }
-
-	T x,y;
-};
-
-template < typename T>
-struct _vector3{
-
-	/* constructors ************************************************************/
-
-	_vector3():x( T(0.0f) ),y( T(0.0f) ),z( T(0.0f) ) {}
-
-	/* initialize with scalar */
-	_vector3(const T& s):x(s),y(s),z(s) {}
-
-	/* copy */
-	_vector3(const _vector3& v ):x(v.x),y(v.y),z(v.z) {}
-
-	/* initialize components  */
-	_vector3(const T& x_,const T& y_,const T& z_ ):x(x_),y(y_),z(z_) {}
-
-	/***************************************************************************/
-
-	/* copies this vector */
-	void operator =(const _vector3<T> &v) { x=v.x; y=v.y; z=v.z; }
-
-	T& operator [](const int &index ) { return (&x)[ index ]; }
-	const T& operator [](const int &index )const { return (&x)[ index ]; }
-
-
-	/** 
-	* flips all the components of the vector 
-	*/
-	void invert() { x=-x; y=-y; z=-z; }
-
-	/** 
-	* multiply this vector with the given scalar 
-	*/
-	void operator *=(const T& s) { x*=s; y*=s; z*=s; }
-
-	/** 
-	* return this vector multiplied by the given scalar 
-	*/
-	_vector3 operator *(const T& s) const { return _vector3(x*s,y*s,z*s); }
-
-	/** 
-	* multiply this vector with the given vector 
-	*/
-	void operator *=(const _vector3& v) { x*=v.x; y*=v.y; z*=v.z; }
-
-	/** 
-	* return this vector multiplied by the given vector
-	*/
-	_vector3 operator *(const _vector3& v) const { return _vector3(x*v.x,y*v.y,z*v.z); }
-
-	/** 
-	* add the given vector to this vector 
-	*/
-	void operator +=( const _vector3& v ) { x+=v.x; y+=v.y; z+=v.z; }
-
-	/** 
-	* return this vector added to the given vector 
-	*/
-	_vector3 operator +(const  _vector3& v) const { return _vector3(x+v.x,y+v.y,z+v.z); }
-
-	/** subtract the given vector from this vector */
-	void operator -=(const _vector3& v) { x-=v.x; y-=v.y; z-=v.z; }
-
-	/** 
-	* return the given vector subtracted from this vector 
-	*/
-	_vector3 operator -(const  _vector3& v) const { return _vector3(x-v.x,y-v.y,z-v.z); }
-
-	/** 
-	* return the magnitude of this vector 
-	*/
-	T magnitude() const { return sqrt( (x*x)+(y*y)+(z*z) ); }
-
-	/** 
-	* return the squared magnitude of this vector 
-	*/
-	T squaremagnitude() const { return x*x+y*y+z*z; }
-
-	/** 
-	* limits the size of the vector to the given maximum 
-	*/
-	void trim(T size) {
-		if (squaremagnitude() > size*size) {
-			normalise();
-			x *= size;
-			y *= size;
-			z *= size;
-		}
-	}
-
-	/**
-	* performs a component-wise product with the given vector and
-	* sets this vector to its result
-	*/
-	void componentproductupdate(const _vector3<T> &v ) {
-		x *= v.x;
-		y *= v.y;
-		z *= v.z;
-	}
-
-	/** 
-	* turns a non-zero vector into a vector of unit length 
-	*/
-	void normalise() {
-		const T len = magnitude();
-		if (len > 0) {
-			x = x/len;
-			y = y/len;
-			z = z/len;
-		}
-	}
-
-	/** 
-	* returns the normalised version of a vector 
-	*/
-	_vector3 normal() const {
-		const T len = magnitude();
-		if (len > 0) {
-			return _vector3(x/len,y/len,z/len);
-		}
-		return *this;
-	}
-
-	/** 
-	* zero all the components of the vector 
-	*/
-	void clear() { x = y = z = 0; } 
-
-	/**
-	* adds the given vector to this vector, scaled by the given amount
-	*/
-	void addscaledvector(const _vector3& vector, T scale) { 
-		x += vector.x * scale;
-		y += vector.y * scale;
-		z += vector.z * scale;
-	}
-
-	T x,y,z;
-};
-
-/**
-* returns the scalar product of v1 and v2
-*/
-template <typename T>
-T _dot(const _vector3<T>&v1,const _vector3<T>&v2) { return (v1.x*v2.x+v1.y*v2.y+v1.z*v2.z); }
-
-/**
-* returns the vector product of v1 and v2
-*/
-template <typename T>
-_vector3<T> _cross(const _vector3<T>&v1,const _vector3<T>&v2) {
-	return _vector3<T>(  v1.y*v2.z-v1.z*v2.y,  v1.z*v2.x-v1.x*v2.z,  v1.x*v2.y-v1.y*v2.x );
-}
-
-/** 
-* returns the normalised version of v 
-*/
-template <typename T>
-_vector3<T> _normalize(const _vector3<T>&v) {
-	const T len = v.magnitude();
-	if(len>0){
-		return _vector3<T>(v.x/len,v.y/len,v.z/len);
-	}
-	return v;
-}
-
-/** 
-* returns the distance between two vectors as a scalar 
-*/
-template <typename T>
-T _distance(const _vector3<T>&v1,const _vector3<T>&v2) {
-	_vector3<T> dif = v1-v2;
-	return dif.magnitude();
-}
-
-template < typename T>
-struct _vector4{
-
-	/* constructors ************************************************************/
-
-	_vector4():x( T(0.0f) ),y( T(0.0f) ),z( T(0.0f) ),w( T(0.0f) ) {}
-
-	/* initialize with scalar */
-	_vector4(const T& v):x(v),y(v),z(v),w(v) {}
-
-	/* copy */
-	_vector4(const _vector4& v ):x(v.x),y(v.y),z(v.z),w(v.w) {}
-
-	/* initialize components  */
-	_vector4(const T& x_,const T& y_,const T& z_,const T& w_ ):x(x_),y(y_),z(z_),w(w_) {}
-
-	/***************************************************************************/
-
-	T& operator [](const int &index ) { return (&x)[ index ]; }
-	const T& operator [](const int &index )const { return (&x)[ index ]; }
-
-	/** 
-	* copies this vector 
-	*/
-	void operator =(const _vector4 &v) { x=v.x; y=v.y; z=v.z; w=v.w; }
-
-	/** 
-	* flips all the components of the vector 
-	*/
-	void invert() { x=-x; y=-y; z=-z; w=-w; }
-
-	/** 
-	* multiply this vector with the given scalar 
-	*/
-	void operator *=(const T& s) { x*=s; y*=s; z*=s; w*=s; }
-
-	/** 
-	* return this vector multiplied by the given scalar 
-	*/
-	_vector4 operator *(const T& s) const { return _vector4(x*s,y*s,z*s,w*s); }
-
-	/** 
-	* multiply this vector with the given vector 
-	*/
-	void operator *=(const _vector4& v) { x*=v.x; y*=v.y; z*=v.z; w*=v.w; }
-
-	/** 
-	* return this vector multiplied by the given vector
-	*/
-	_vector4 operator *(const _vector4& v) const { return _vector4(x*v.x,y*v.y,z*v.z,w*v.w); }
-
-	/** 
-	* add the given vector to this vector 
-	*/
-	void operator +=(const _vector4& v) { x+=v.x; y+=v.y; z+=v.z; w+=v.w; }
-
-	/** 
-	* return this vector added to the given vector 
-	*/
-	_vector4 operator +(const  _vector4& v) const { return _vector4(x+v.x,y+v.y,z+v.z,w+v.w); }
-
-	T x,y,z,w;
-};
-
-/**
-* holds a three degree of freedom orientation.
-*
-* quaternions have
-* several mathematical properties that make them useful for
-* representing orientations, but require four items of data to
-* hold the three degrees of freedom. these four items of data can
-* be viewed as the coefficients of a complex number with three
-* imaginary parts. the mathematics of the quaternion is then
-* defined and is roughly correspondent to the math of 3d
-* rotations. a quaternion is only a valid rotation if it is
-* normalised: i.e. it has a length of 1.
-*
-* angular velocity and acceleration can be correctly
-* represented as vectors. quaternions are only needed for
-* orientation.
-*/
-
-class _quaternion { 
-
-public:
-	union {
-		struct {
-			/**
-			* holds the real component of the quaternion.
-			*/
-			float r;
-			/**
-			* holds the first complex component of the
-			* quaternion.
-			*/
-			float i;
-			/**
-			* holds the second complex component of the
-			* quaternion.
-			*/
-			float j;
-			/**
-			* holds the third complex component of the
-			* quaternion.
-			*/
-			float k;
-		};
-		/**
-		* holds the quaternion data in array form.
-		*/
-		float data[4];
-	};
-
-	/**
-	* the default constructor creates a quaternion representing
-	* a zero rotation.
-	*/
-	_quaternion() : r(1), i(0), j(0), k(0) {}
-
-	/**
-	* the explicit constructor creates a quaternion with the given
-	* components.
-	*
-	* the given orientation does not need to be normalised,
-	* and can be zero. this function will not alter the given
-	* values, or normalise the quaternion. to normalise the
-	* quaternion (and make a zero quaternion a legal rotation),
-	* use the normalise function.
-	*
-	*/
-	_quaternion(const float r, const float i, const float j, const float k): r(r), i(i), j(j), k(k) { }
-
-	/**
-	* normalises the quaternion to unit length, making it a valid
-	* orientation quaternion.
-	*/
-	void normalise() {
-		float d = r*r+i*i+j*j+k*k;
-
-		// check for zero length quaternion, and use the no-rotation
-		// quaternion in that case.
-		if (d < FLT_EPSILON ) { r = 1.0f; return; }
-
-		d = ((float)1.0)/sqrt(d);
-		r *= d;
-		i *= d;
-		j *= d;
-		k *= d;
-	}
-
-	/**
-	* multiplies the quaternion by the given quaternion
-	*/
-	void operator *=(const _quaternion &multiplier) {
-		_quaternion q = *this;
-		r = q.r*multiplier.r - q.i*multiplier.i -
-			q.j*multiplier.j - q.k*multiplier.k;
-		i = q.r*multiplier.i + q.i*multiplier.r +
-			q.j*multiplier.k - q.k*multiplier.j;
-		j = q.r*multiplier.j + q.j*multiplier.r +
-			q.k*multiplier.i - q.i*multiplier.k;
-		k = q.r*multiplier.k + q.k*multiplier.r +
-			q.i*multiplier.j - q.j*multiplier.i;
-	}
-
-	/**
-	* adds the given vector to this, scaled by the given amount.
-	* this is used to update the orientation quaternion by a rotation
-	* and time.
-	*/
-	void addscaledvector(const _vector3<float>& vector, float scale) {
-		_quaternion q(0,
-			vector.x * scale,
-			vector.y * scale,
-			vector.z * scale);
-		q *= *this;
-		r += q.r * ((float)0.5);
-		i += q.i * ((float)0.5);
-		j += q.j * ((float)0.5);
-		k += q.k * ((float)0.5);
-	}
-
-	void rotatebyvector(const _vector3<float>& vector) {
-		_quaternion q(0, vector.x, vector.y, vector.z);
-		(*this) *= q;
-	}
-};
-
-
-template < typename T>
-struct _matrix3{
-
-	/* constructors ************************************************************/
-
-	/* creates an identity matrix*/
-	_matrix3() { m_data[0][0]=m_data[1][1]=m_data[2][2]=1; }
-
-	/**
-	* sets the matrix to be a diagonal matrix with the given
-	* values along the leading diagonal.
-	*/
-	_matrix3(const T& s) { m_data[0][0]=m_data[1][1]=m_data[2][2]=s; }
-
-	/* copy */
-	_matrix3(const _matrix3& m) {  operator=(m); }
-
-	/**
-	* creates a new matrix with explicit coefficients.
-	*/
-	_matrix3(float c0,float c1,float c2,float c3,
-		float c4,float c5,float c6,float c7,float c8) {
-			(*this)[0][0]=c0; (*this)[1][0]=c1; (*this)[2][0]=c2;
-			(*this)[0][1]=c3; (*this)[1][1]=c4; (*this)[2][1]=c5;
-			(*this)[0][2]=c6; (*this)[1][2]=c7; (*this)[2][2]=c8;
-	}
-
-	/***************************************************************************/
-
-	/* copies this matrix */
-	void operator=(const _matrix3 &m) {
-		m_data[0]=m.m_data[0];
-		m_data[1]=m.m_data[1];
-		m_data[2]=m.m_data[2];
-	}
-
-	/**
-	* multiplies this matrix in place by the given other matrix
-	*/
-	void operator*=(const _matrix3<T> &o) {
-		T t1;
-		T t2;
-		T t3;
-
-		t1 = m_data[0][0]*o[0][0] + m_data[1][0]*o[0][1] + m_data[2][0]*o[0][2];
-		t2 = m_data[0][0]*o[1][0] + m_data[1][0]*o[1][1] + m_data[2][0]*o[1][2];
-		t3 = m_data[0][0]*o[2][0] + m_data[1][0]*o[2][1] + m_data[2][0]*o[2][2];
-		m_data[0][0] = t1;
-		m_data[1][0] = t2;
-		m_data[2][0] = t3;
-
-		t1 = m_data[0][1]*o[0][0] + m_data[1][1]*o[0][1] + m_data[2][1]*o[0][2];
-		t2 = m_data[0][1]*o[1][0] + m_data[1][1]*o[1][1] + m_data[2][1]*o[1][2];
-		t3 = m_data[0][1]*o[2][0] + m_data[1][1]*o[2][1] + m_data[2][1]*o[2][2];
-		m_data[0][1] = t1;
-		m_data[1][1] = t2;
-		m_data[2][1] = t3;
-
-		t1 = m_data[0][2]*o[0][0] + m_data[1][2]*o[0][1] + m_data[2][2]*o[0][2];
-		t2 = m_data[0][2]*o[1][0] + m_data[1][2]*o[1][1] + m_data[2][2]*o[1][2];
-		t3 = m_data[0][2]*o[2][0] + m_data[1][2]*o[2][1] + m_data[2][2]*o[2][2];
-		m_data[0][2] = t1;
-		m_data[1][2] = t2;
-		m_data[2][2] = t3;
-	}
-
-	/**
-	* multiplies this matrix in place by the given scalar
-	*/
-	void operator*=(const float s) {
-		m_data[0][0] *= s; m_data[1][0] *= s; m_data[2][0] *= s;
-		m_data[0][1] *= s; m_data[1][1] *= s; m_data[2][1] *= s;
-		m_data[0][2] *= s; m_data[1][2] *= s; m_data[2][2] *= s;
-	}
-
-	/**
-	* does a component-wise addition of this matrix and the given matrix
-	*/
-	void operator+=(const _matrix3<T> &o) {
-		m_data[0][0] += o[0][0]; m_data[1][0] += o[1][0]; m_data[2][0] += o[2][0];
-		m_data[0][1] += o[0][1]; m_data[1][1] += o[1][1]; m_data[2][1] += o[2][1];
-		m_data[0][2] += o[0][2]; m_data[1][2] += o[1][2]; m_data[2][2] += o[2][2];
-	}
-
-	/**
-	* transform the given vector by this matrix
-	*/
-	_vector3<T> operator * (const _vector3<T>& v) const {
-		return _vector3<T> (
-			v.x*m_data[0][0] + v.y*m_data[1][0] + v.z*m_data[2][0],
-			v.x*m_data[0][1] + v.y*m_data[1][1] + v.z*m_data[2][1],
-			v.x*m_data[0][2] + v.y*m_data[1][2] + v.z*m_data[2][2]);
-	}
-
-	_vector3<T>& operator [](const int &index ) { return m_data[ index ]; }
-	const _vector3<T>& operator [](const int &index )const { return m_data[ index ]; }
-
-
-	/**
-	* transform the given vector by this matrix
-	*/
-	_vector3<T> transform(const _vector3<T> &v) const { return (*this) * v; }
-
-	/**
-	* transform the given vector by the transpose of this matrix
-	*/
-	_vector3<T> transformtranspose( const _vector3<T> &v ) const {
-		return _vector3<T>(
-			v.x * m_data[0][0] + v.y * m_data[0][1] + v.z * m_data[0][2],
-			v.x * m_data[1][0] + v.y * m_data[1][1] + v.z * m_data[1][2],
-			v.x * m_data[2][0] + v.y * m_data[2][1] + v.z * m_data[2][2]
-		);
-	}
-
-	/**
-	* sets the matrix to be a diagonal matrix with the given
-	* values along the leading diagonal.
-	*/
-	void setdiagonal(T a, T b, T c) { setinertiatensorcoeffs(a, b, c); }
-
-	/**
-	* sets the value of the matrix from inertia tensor values.
-	*/
-	void setinertiatensorcoeffs(T ix,T iy,T iz,T ixy=0,T ixz=0,T iyz=0) {
-		(*this)[0][0] = ix;
-		(*this)[1][0] = (*this)[0][1] = -ixy;
-		(*this)[2][0] = (*this)[0][2] = -ixz;
-		(*this)[1][1] = iy;
-		(*this)[2][1] = (*this)[1][2] = -iyz;
-		(*this)[2][2] = iz;
-	}
-
-	/**
-	* sets the matrix values from the given three vector components
-	* these are arranged as the three columns of the vector
-	*/
-	void setcomponents(const _vector3<T> &compone, const _vector3<T> &comptwo,const _vector3<T> &compthree) {
-		m_data[0][0] = compone.x;
-		m_data[1][0] = comptwo.x;
-		m_data[2][0] = compthree.x;
-		m_data[0][1] = compone.y;
-		m_data[1][1] = comptwo.y;
-		m_data[2][1] = compthree.y;
-		m_data[0][2] = compone.z;
-		m_data[1][2] = comptwo.z;
-		m_data[2][2] = compthree.z;
-	}
-
-	/**
-	* sets the matrix to be the inverse of the given matrix
-	*/
-	void setinverse(const _matrix3<T>& m) {
-		float t4  = m[0][0]*m[1][1];
-		float t6  = m[0][0]*m[2][1];
-		float t8  = m[1][0]*m[0][1];
-		float t10 = m[2][0]*m[0][1];
-		float t12 = m[1][0]*m[0][2];
-		float t14 = m[2][0]*m[0][2];
-
-		// Calculate the determinant
-		float t16 = ( t4*m[2][2]-t6*m[1][2]-t8*m[2][2]+t10*m[1][2]+t12*m[2][1]-t14*m[1][1] );
-
-		// Make sure the determinant is non-zero.
-		if (t16 == 0.0f) { return; }
-		float t17 = 1/t16;
-
-		(*this)[0][0] =  ( m[1][1]*m[2][2] - m[2][1]*m[1][2] )*t17;
-		(*this)[1][0] = -( m[1][0]*m[2][2] - m[2][0]*m[1][2] )*t17;
-		(*this)[2][0] =  ( m[1][0]*m[2][1] - m[2][0]*m[1][1] )*t17;
-		(*this)[0][1] = -( m[0][1]*m[2][2] - m[2][1]*m[0][2] )*t17;
-		(*this)[1][1] =  ( m[0][0]*m[2][2] - t14)*t17;
-		(*this)[2][1] = -( t6-t10 )*t17;
-		(*this)[0][2] =  ( m[0][1]*m[1][2] - m[1][1]*m[0][2] )*t17;
-		(*this)[1][2] = -( m[0][0]*m[1][2] - t12)*t17;
-		(*this)[2][2] =  (t4-t8)*t17;
-	}
-
-	/**
-	* returns a new matrix containing the inverse of this matrix
-	*/
-	_matrix3<T> inverse() const {
-		_matrix3<T> result;
-		result.setinverse(*this);
-		return result;
-	}
-
-
-	/**
-	* sets the value of the matrix as an inertia tensor of
-	* a rectangular block aligned with the body's coordinate
-	* system with the given axis half-sizes and mass.
-	*/
-	void setblockinertiatensor(const _vector3<T> &halfsizes, float mass) {
-		_vector3<T> squares = halfsizes * halfsizes;
-		setinertiatensorcoeffs(0.3f*mass*(squares.y + squares.z),
-			0.3f*mass*(squares.x + squares.z),
-			0.3f*mass*(squares.x + squares.y));
-	}
-
-	/**
-	* sets the matrix to be a skew symmetric matrix based on
-	* the given vector. the skew symmetric matrix is the equivalent
-	* of the vector product. so if a,b are vectors. a x b = a_s b
-	* where a_s is the skew symmetric form of a
-	*/
-	void setskewsymmetric(const _vector3<T> v) {
-		m_data[0][0] = m_data[1][1] = m_data[2][2] = 0;
-		m_data[1][0] = -v.z;
-		m_data[2][0] = v.y;
-		m_data[0][1] = v.z;
-		m_data[2][1] = -v.x;
-		m_data[0][2] = -v.y;
-		m_data[1][2] = v.x;
-	}
-
-
-	_vector3<T> m_data[3];
-
-	/**
-	* interpolates a couple of matrices.
-	*/
-	static _matrix3<T> linearinterpolate(const _matrix3<T>& a, const _matrix3<T>& b, T prop) {
-		_matrix3<T> result;
-		T * a_data      = (T*)a.m_data;
-		T * b_data      = (T*)b.m_data;
-		T * result_data = (T*)result.m_data;
-		for (uint32_t i = 0; i < 9; i++) {
-			result_data[i] = a_data[i] * (1-prop) + b_data[i] * prop;
-		}
-		return result;
-	}
-
-};
-
-/** 
-* returns matrix containing the transpose of matrix m
-*/
-template <typename T>
-_matrix3<T> _transpose(const _matrix3<T>& m) {
-	_matrix3<T> result;
-	result[0][0]=m[0][0];  result[0][1]=m[1][0];  result[0][2]=m[2][0];
-	result[1][0]=m[0][1];  result[1][1]=m[1][1];  result[1][2]=m[2][1];
-	result[2][0]=m[0][2];  result[2][1]=m[1][2];  result[2][2]=m[2][2];
-	return result;
-}
-
-/**
-* returns matrix m1 and m2 multiplied 
-*/
-template <typename T>
-_matrix3<T> operator*(const _matrix3<T>& m1,const _matrix3<T>& m2) {
-	_matrix3<T> result;
-
-	result[0][0] = m1[0][0]*m2[0][0] + m1[0][1]*m2[1][0] + m1[0][2]*m2[2][0];
-	result[1][0] = m1[1][0]*m2[0][0] + m1[1][1]*m2[1][0] + m1[1][2]*m2[2][0];
-	result[2][0] = m1[2][0]*m2[0][0] + m1[2][1]*m2[1][0] + m1[2][2]*m2[2][0];
-
-	result[0][1] = m1[0][0]*m2[0][1] + m1[0][1]*m2[1][1] + m1[0][2]*m2[2][1];
-	result[1][1] = m1[1][0]*m2[0][1] + m1[1][1]*m2[1][1] + m1[1][2]*m2[2][1];
-	result[2][1] = m1[2][0]*m2[0][1] + m1[2][1]*m2[1][1] + m1[2][2]*m2[2][1];
-
-	result[0][2] = m1[0][0]*m2[0][2] + m1[0][1]*m2[1][2] + m1[0][2]*m2[2][2];
-	result[1][2] = m1[1][0]*m2[0][2] + m1[1][1]*m2[1][2] + m1[1][2]*m2[2][2];
-	result[2][2] = m1[2][0]*m2[0][2] + m1[2][1]*m2[1][2] + m1[2][2]*m2[2][2];
-
-	return result;
-}
-
-template < typename T>
-struct _matrix4{
-
-	/**constructors ************************************************************/
-	/* creates an identity matrix*/
-	_matrix4() { m_data[0][0]=m_data[1][1]=m_data[2][2]=m_data[3][3]=1; }
-	/**
-	* Sets the matrix to be a diagonal matrix with the given
-	* values along the leading diagonal.
-	*/
-	_matrix4(const T& s) { m_data[0][0]=m_data[1][1]=m_data[2][2]=m_data[3][3]=s; }
-	/* copy */
-	_matrix4(const _matrix4& m) { operator=(m); }
-	/***************************************************************************/
-
-	/* copies this matrix */
-	void operator=(const _matrix4 &m) {
-		m_data[0]=m.m_data[0];
-		m_data[1]=m.m_data[1];
-		m_data[2]=m.m_data[2];
-		m_data[3]=m.m_data[3];
-	}
-
-	/**
-	* Returns a matrix which is this matrix multiplied by the given scalar
-	*/
-	_matrix4 operator*(const T& s) {
-		_matrix4 result(*this);
-		result[0]*=s;
-		result[1]*=s;
-		result[2]*=s;
-		result[3]*=s;
-		return result;
-	}
-
-	/**
-	* Transform the given vector by this matrix
-	*/
-	_vector4<T> operator * (const _vector4<T>& v) {
-		return _vector4<T> (
-			v.x*m_data[0][0] + v.y*m_data[1][0] + v.z*m_data[2][0] + v.w*m_data[3][0],
-			v.x*m_data[0][1] + v.y*m_data[1][1] + v.z*m_data[2][1] + v.w*m_data[3][1],
-			v.x*m_data[0][2] + v.y*m_data[1][2] + v.z*m_data[2][2] + v.w*m_data[3][2],
-			v.x*m_data[0][3] + v.y*m_data[1][3] + v.z*m_data[2][3] + v.w*m_data[3][3]);
-	}
-
-	/**
-	* Transform the given vector by this matrix
-	*/
-	_vector3<T> operator*(const _vector3<T> & v) const {
-		return _vector3<T>(
-			v.x*m_data[0][0] + v.y*m_data[1][0] + v.z*m_data[2][0] + m_data[3][0],
-			v.x*m_data[0][1] + v.y*m_data[1][1] + v.z*m_data[2][1] + m_data[3][1],
-			v.x*m_data[0][2] + v.y*m_data[1][2] + v.z*m_data[2][2] + m_data[3][2]);
-	}
-
-	/**
-	* Transform the given vector by this matrix
-	*/
-	_vector3<T> transform(const _vector3<T> &v) const { return (*this) * v; }
-
-	_vector4<T>& operator [](const int &index ) { return m_data[ index ]; }
-	const _vector4<T>& operator [](const int &index )const { return m_data[ index ]; }
-
-
-	/**
-	* transform the given vector by the transformational inverse
-	* of this matrix.
-	*
-	* this function relies on the fact that the inverse of
-	* a pure rotation matrix is its transpose. it separates the
-	* translational and rotation components, transposes the
-	* rotation, and multiplies out. if the matrix is not a
-	* scale and shear free transform matrix, then this function
-	* will not give correct results.
-	*
-	*/
-	_vector3<T> transforminverse(const _vector3<T> &vector) const {
-		_vector3<T> tmp = vector;
-		tmp.x -= (*this)[3][0];
-		tmp.y -= (*this)[3][1];
-		tmp.z -= (*this)[3][2];
-		return _vector3<T>(
-			tmp.x * (*this)[0][0] +
-			tmp.y * (*this)[0][1] +
-			tmp.z * (*this)[0][2],
-
-			tmp.x * (*this)[1][0] +
-			tmp.y * (*this)[1][1] +
-			tmp.z * (*this)[1][2],
-
-			tmp.x * (*this)[2][0] +
-			tmp.y * (*this)[2][1] +
-			tmp.z * (*this)[2][2]
-		);
-	}
-
-	/**
-	* gets a vector representing one axis (i.e. one column) in the matrix
-	*/
-	_vector3<T> getaxisvector(uint32_t i) const { return _vector3<T>(m_data[i].x,m_data[i].y,m_data[i].z); }
-
-	/**
-	* transform the given direction vector by the
-	* transformational inverse of this matrix.
-	*
-	* this function relies on the fact that the inverse of
-	* a pure rotation matrix is its transpose. it separates the
-	* translational and rotation components, transposes the
-	* rotation, and multiplies out. if the matrix is not a
-	* scale and shear free transform matrix, then this function
-	* will not give correct results.
-	*/
-	_vector3<T> transforminversedirection(const _vector3<T> &v) const {
-		return _vector3<T>(
-			v.x * (*this)[0][0] + v.y * (*this)[0][1] + v.z * (*this)[0][2],
-			v.x * (*this)[1][0] + v.y * (*this)[1][1] + v.z * (*this)[1][2],
-			v.x * (*this)[2][0] + v.y * (*this)[2][1] + v.z * (*this)[2][2]
-		);
-	}
-
-	/**
-	* transform the given direction vector by this matrix
-	*/
-	_vector3<T> transformdirection(const _vector3<T> &v) const {
-		return _vector3<T> (
-			v.x * (*this)[0][0] + v.y * (*this)[1][0] + v.z * (*this)[2][0],
-			v.x * (*this)[0][1] + v.y * (*this)[1][1] + v.z * (*this)[2][1],
-			v.x * (*this)[0][2] + v.y * (*this)[1][2] + v.z * (*this)[2][2]
-		);
-	}
-
-
-	_vector4<T> m_data[4];
-};
-
-/* returns matrix containing the transpose of matrix m*/
-template <typename T>
-_matrix4<T> _transpose(const _matrix4<T>& m) {
-	_matrix4<T> result;
-	result[0][0]=m[0][0];  result[0][1]=m[1][0];  result[0][2]=m[2][0]; result[0][3]=m[3][0];
-	result[1][0]=m[0][1];  result[1][1]=m[1][1];  result[1][2]=m[2][1]; result[1][3]=m[3][1];
-	result[2][0]=m[0][2];  result[2][1]=m[1][2];  result[2][2]=m[2][2]; result[2][3]=m[3][2];
-	result[3][0]=m[0][3];  result[3][1]=m[1][3];  result[3][2]=m[2][3]; result[3][3]=m[3][3];
-	return result;
-}
-
-/**
-* returns matrix m1 and m2 multiplied 
-*/
-template <typename T>
-_matrix4<T> operator*(const _matrix4<T>& m1,const _matrix4<T>& m2) {
-	_matrix4<T> result;
-
-	result[0][0] = m1[0][0]*m2[0][0] + m1[0][1]*m2[1][0] + m1[0][2]*m2[2][0]  + m1[0][3]*m2[3][0];
-	result[1][0] = m1[1][0]*m2[0][0] + m1[1][1]*m2[1][0] + m1[1][2]*m2[2][0]  + m1[1][3]*m2[3][0];
-	result[2][0] = m1[2][0]*m2[0][0] + m1[2][1]*m2[1][0] + m1[2][2]*m2[2][0]  + m1[2][3]*m2[3][0];
-	result[3][0] = m1[3][0]*m2[0][0] + m1[3][1]*m2[1][0] + m1[3][2]*m2[2][0]  + m1[3][3]*m2[3][0];
-
-	result[0][1] = m1[0][0]*m2[0][1] + m1[0][1]*m2[1][1] + m1[0][2]*m2[2][1]  + m1[0][3]*m2[3][1];
-	result[1][1] = m1[1][0]*m2[0][1] + m1[1][1]*m2[1][1] + m1[1][2]*m2[2][1]  + m1[1][3]*m2[3][1];
-	result[2][1] = m1[2][0]*m2[0][1] + m1[2][1]*m2[1][1] + m1[2][2]*m2[2][1]  + m1[2][3]*m2[3][1];
-	result[3][1] = m1[3][0]*m2[0][1] + m1[3][1]*m2[1][1] + m1[3][2]*m2[2][1]  + m1[3][3]*m2[3][1];
-
-	result[0][2] = m1[0][0]*m2[0][2] + m1[0][1]*m2[1][2] + m1[0][2]*m2[2][2]  + m1[0][3]*m2[3][2];
-	result[1][2] = m1[1][0]*m2[0][2] + m1[1][1]*m2[1][2] + m1[1][2]*m2[2][2]  + m1[1][3]*m2[3][2];
-	result[2][2] = m1[2][0]*m2[0][2] + m1[2][1]*m2[1][2] + m1[2][2]*m2[2][2]  + m1[2][3]*m2[3][2];
-	result[3][2] = m1[3][0]*m2[0][2] + m1[3][1]*m2[1][2] + m1[3][2]*m2[2][2]  + m1[3][3]*m2[3][2];
-
-	result[0][3] = m1[0][0]*m2[0][3] + m1[0][1]*m2[1][3] + m1[0][2]*m2[2][3]  + m1[0][3]*m2[3][3];
-	result[1][3] = m1[1][0]*m2[0][3] + m1[1][1]*m2[1][3] + m1[1][2]*m2[2][3]  + m1[1][3]*m2[3][3];
-	result[2][3] = m1[2][0]*m2[0][3] + m1[2][1]*m2[1][3] + m1[2][2]*m2[2][3]  + m1[2][3]*m2[3][3];
-	result[3][3] = m1[3][0]*m2[0][3] + m1[3][1]*m2[1][3] + m1[3][2]*m2[2][3]  + m1[3][3]*m2[3][3];
-	return result;
-}
-
-template <typename T> /*glm*/
-_matrix4<T> _lookatrh (const _vector3<T>& eye,const _vector3<T>& center,const _vector3<T>& up) {
-	const _vector3<T> f(_normalize(center - eye));
-	const _vector3<T> s(_normalize(_cross(f, up)));
-	const _vector3<T> u(_cross(s, f));
-
-	_matrix4<T> result;
-	result[0][0] = s.x;
-	result[1][0] = s.y;
-	result[2][0] = s.z;
-	result[0][1] = u.x;
-	result[1][1] = u.y;
-	result[2][1] = u.z;
-	result[0][2] =-f.x;
-	result[1][2] =-f.y;
-	result[2][2] =-f.z;
-	result[3][0] =-_dot(s, eye);
-	result[3][1] =-_dot(u, eye);
-	result[3][2] = _dot(f, eye);
-	return result;
-}
-template <typename T> /*glm*/
-_matrix4<T> _perspectivefovrh(T fov,T width,T height,T zNear,T zFar ) {
-
-	T const rad = fov;
-	T const h = cos(T(0.5) * rad) / sin(T(0.5) * rad);
-	T const w = h * height / width; ///todo max(width , Height) / min(width , Height)?
-
-	_matrix4<T> result(T(0));
-	result[0][0] = w;
-	result[1][1] = h;
-	result[2][2] = - (zFar + zNear) / (zFar - zNear);
-	result[2][3] = - T(1);
-	result[3][2] = - (T(2) * zFar * zNear) / (zFar - zNear);
-	return result;
-}
-template <typename T>/*glm*/
-_matrix4<T> _ortho ( T left, T right, T bottom, T top, T zNear, T zFar ) {
-    _matrix4<T> Result(1);
-    Result[0][0] = static_cast<T>(2) / (right - left);
-    Result[1][1] = static_cast<T>(2) / (top - bottom);
-    Result[2][2] = - static_cast<T>(2) / (zFar - zNear);
-    Result[3][0] = - (right + left) / (right - left);
-    Result[3][1] = - (top + bottom) / (top - bottom);
-    Result[3][2] = - (zFar + zNear) / (zFar - zNear);
-    return Result;
-}
-
-template <typename T> /*glm*/
-_matrix4<T> _translate(const _vector3<T> & v ) {
-	_matrix4<T> result;
-	result[3] = result[0]*v[0] + result[1]*v[1] + result[2]*v[2] + result[3];
-	return result;
-}
-template <typename T> /*glm*/
-_matrix4<T> _scale ( const _vector3<T>& v ) {
-	_matrix4<T> result,m;
-	result[0] = m[0] * v[0];
-	result[1] = m[1] * v[1];
-	result[2] = m[2] * v[2];
-	result[3] = m[3];
-	return result;
-}
-template <typename T> /*glm*/
-_matrix4<T> _rotate ( T angle, const _vector3<T>& v ) {
-
-	const T a = angle;
-	const T c = cos(a);
-	const T s = sin(a);
-
-	_vector3<T> axis(_normalize(v));
-	_vector3<T> temp( axis*(T(1) - c));
-
-	_matrix4<T> result;
-	result[0][0] = c + temp[0] * axis[0];
-	result[0][1] = 0 + temp[0] * axis[1] + s * axis[2];
-	result[0][2] = 0 + temp[0] * axis[2] - s * axis[1];
-
-	result[1][0] = 0 + temp[1] * axis[0] - s * axis[2];
-	result[1][1] = c + temp[1] * axis[1];
-	result[1][2] = 0 + temp[1] * axis[2] + s * axis[0];
-
-	result[2][0] = 0 + temp[2] * axis[0] + s * axis[1];
-	result[2][1] = 0 + temp[2] * axis[1] - s * axis[0];
-	result[2][2] = c + temp[2] * axis[2];
-
-	return result;
-}
-template <typename T> /*glm*/
-_matrix4<T> _rotate ( const _matrix4<T>& m, T angle, const _vector3<T> & v ) {
-	T const a = angle;
-	T const c = cos(a);
-	T const s = sin(a);
-
-	_vector3<T> axis(_normalize(v));
-	_vector3<T> temp(axis* (T(1) - c) );
-
-	_matrix4<T> rotate(0);
-	rotate[0][0] = c + temp[0] * axis[0];
-	rotate[0][1] = 0 + temp[0] * axis[1] + s * axis[2];
-	rotate[0][2] = 0 + temp[0] * axis[2] - s * axis[1];
-
-	rotate[1][0] = 0 + temp[1] * axis[0] - s * axis[2];
-	rotate[1][1] = c + temp[1] * axis[1];
-	rotate[1][2] = 0 + temp[1] * axis[2] + s * axis[0];
-
-	rotate[2][0] = 0 + temp[2] * axis[0] + s * axis[1];
-	rotate[2][1] = 0 + temp[2] * axis[1] - s * axis[0];
-	rotate[2][2] = c + temp[2] * axis[2];
-
-	_matrix4<T> result(0);
-	result[0] = m[0] * rotate[0][0] + m[1] * rotate[0][1] + m[2] * rotate[0][2];
-	result[1] = m[0] * rotate[1][0] + m[1] * rotate[1][1] + m[2] * rotate[1][2];
-	result[2] = m[0] * rotate[2][0] + m[1] * rotate[2][1] + m[2] * rotate[2][2];
-	result[3] = m[3];
-	return result;
-}
-template <typename T> /*glm*/
-_matrix4<T> _yawpitchroll (const T&yaw, const T&pitch,const T&roll) {
-	T tmp_ch = cos(yaw);
-	T tmp_sh = sin(yaw);
-	T tmp_cp = cos(pitch);
-	T tmp_sp = sin(pitch);
-	T tmp_cb = cos(roll);
-	T tmp_sb = sin(roll);
-
-	_matrix4<T> result;
-	result[0][0] = tmp_ch * tmp_cb + tmp_sh * tmp_sp * tmp_sb;
-	result[0][1] = tmp_sb * tmp_cp;
-	result[0][2] = -tmp_sh * tmp_cb + tmp_ch * tmp_sp * tmp_sb;
-	result[0][3] = static_cast<T>(0);
-	result[1][0] = -tmp_ch * tmp_sb + tmp_sh * tmp_sp * tmp_cb;
-	result[1][1] = tmp_cb * tmp_cp;
-	result[1][2] = tmp_sb * tmp_sh + tmp_ch * tmp_sp * tmp_cb;
-	result[1][3] = static_cast<T>(0);
-	result[2][0] = tmp_sh * tmp_cp;
-	result[2][1] = -tmp_sp;
-	result[2][2] = tmp_ch * tmp_cp;
-	result[2][3] = static_cast<T>(0);
-	result[3][0] = static_cast<T>(0);
-	result[3][1] = static_cast<T>(0);
-	result[3][2] = static_cast<T>(0);
-	result[3][3] = static_cast<T>(1);
-	return result;
-}
-
+#pragma once
+
+/**
+* the maths and containers shared by the application and the physics.
+* nothing here depends on windows or direct3d, so the physics can be
+* built on its own with only this header.
+*/
+
+#include <cmath>
+#include <cfloat>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+
+/**
+* some libraries only declare the float abs in std, which leaves the
+* int one for abs(float) and turns every fraction into 0. the sse
+* headers happen to bring it in, the scalar build needs it said.
+*/
+using std::abs;
+
+/**
+* the float quaternions and matrices work on sse registers when the
+* compiler targets it. define core_no_simd to build only the scalar
+* code. the types keep their layout, the vertex buffers are made of
+* them, so the registers are loaded and stored unaligned.
+*
+* _vector3 and _vector4 stay scalar. a _vector3 is twelve bytes, too
+* small for a register load, and the element wise _vector4 operators
+* and the _matrix4 times _vector4 product timed no faster on sse than
+* what the compiler makes of the scalar code.
+*/
+#if !defined(core_no_simd) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__))
+#define core_simd
+#include <xmmintrin.h>
+#endif
+
+/**
+* the constructors, the operators that return a new value and the
+* transforms such as _translate are marked core_constexpr, so a
+* transform made of literal values is built by the compiler. older
+* compilers, such as the one of the project file, build them inline
+* instead, and a core_constant is then made once at startup.
+*
+* the sse versions of the float operators can't be worked out while
+* compiling, so constant float matrices are combined with _multiply.
+*/
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#define core_has_constexpr
+#define core_constexpr constexpr
+#define core_constant  constexpr
+#else
+#define core_constexpr inline
+#define core_constant  const
+#endif
+
+/* error macros, shared with the application ****************/
+#define application_zero(x,y)                { for(uint32_t i=0;i<y;( (uint8_t*)(x) )[i]=0 ,i++); }
+#define application_error(x)                 { fprintf(stderr,"error %s l: %i f: %s \n",x,__LINE__,__FILE__); }
+#define application_throw(x)                 { fprintf(stderr,"error %s l: %i f: %s \n",x,__LINE__,__FILE__); return false; }
+/*********************************************************/
+
+template < typename T>
+struct _vector2{
+
+	/* constructors ************************************************************/
+	core_constexpr _vector2():x(0),y(0) {}
+	core_constexpr _vector2(const T& v):x(v),y(v) {}
+	core_constexpr _vector2(const _vector2 &v ):x(v.x),y(v.y) {}
+	core_constexpr _vector2(const T& x_,const T& y_ ):x(x_),y(y_) {}
+	/***************************************************************************/
+
+	T& operator [](const int &index ) { return (&x)[ index ]; }
+	const T& operator [](const int &index )const { return (&x)[ index ]; }
+
+	/* copies this vector */
+	void operator =(const _vector2 &v) { x=v.x; y=v.y; }
+	/** 
+	* flips all the components of the vector 
+	*/
+	void negate() { x=-x; y=-y; }
+
+	T x,y;
+};
+
+template < typename T>
+struct _vector3{
+
+	/* constructors ************************************************************/
+
+	core_constexpr _vector3():x( T(0.0f) ),y( T(0.0f) ),z( T(0.0f) ) {}
+
+	/* initialize with scalar */
+	core_constexpr _vector3(const T& s):x(s),y(s),z(s) {}
+
+	/* copy */
+	core_constexpr _vector3(const _vector3& v ):x(v.x),y(v.y),z(v.z) {}
+
+	/* initialize components  */
+	core_constexpr _vector3(const T& x_,const T& y_,const T& z_ ):x(x_),y(y_),z(z_) {}
+
+	/***************************************************************************/
+
+	/* copies this vector */
+	void operator =(const _vector3<T> &v) { x=v.x; y=v.y; z=v.z; }
+
+	T& operator [](const int &index ) { return (&x)[ index ]; }
+	const T& operator [](const int &index )const { return (&x)[ index ]; }
+
+
+	/** 
+	* flips all the components of the vector 
+	*/
+	void invert() { x=-x; y=-y; z=-z; }
+
+	/** 
+	* multiply this vector with the given scalar 
+	*/
+	void operator *=(const T& s) { x*=s; y*=s; z*=s; }
+
+	/** 
+	* return this vector multiplied by the given scalar 
+	*/
+	core_constexpr _vector3 operator *(const T& s) const { return _vector3(x*s,y*s,z*s); }
+
+	/** 
+	* multiply this vector with the given vector 
+	*/
+	void operator *=(const _vector3& v) { x*=v.x; y*=v.y; z*=v.z; }
+
+	/** 
+	* return this vector multiplied by the given vector
+	*/
+	core_constexpr _vector3 operator *(const _vector3& v) const { return _vector3(x*v.x,y*v.y,z*v.z); }
+
+	/** 
+	* add the given vector to this vector 
+	*/
+	void operator +=( const _vector3& v ) { x+=v.x; y+=v.y; z+=v.z; }
+
+	/** 
+	* return this vector added to the given vector 
+	*/
+	core_constexpr _vector3 operator +(const  _vector3& v) const { return _vector3(x+v.x,y+v.y,z+v.z); }
+
+	/** subtract the given vector from this vector */
+	void operator -=(const _vector3& v) { x-=v.x; y-=v.y; z-=v.z; }
+
+	/** 
+	* return the given vector subtracted from this vector 
+	*/
+	core_constexpr _vector3 operator -(const  _vector3& v) const { return _vector3(x-v.x,y-v.y,z-v.z); }
+
+	/** 
+	* return the magnitude of this vector 
+	*/
+	T magnitude() const { return sqrt( (x*x)+(y*y)+(z*z) ); }
+
+	/** 
+	* return the squared magnitude of this vector 
+	*/
+	T squaremagnitude() const { return x*x+y*y+z*z; }
+
+	/** 
+	* limits the size of the vector to the given maximum 
+	*/
+	void trim(T size) {
+		if (squaremagnitude() > size*size) {
+			normalise();
+			x *= size;
+			y *= size;
+			z *= size;
+		}
+	}
+
+	/**
+	* performs a component-wise product with the given vector and
+	* sets this vector to its result
+	*/
+	void componentproductupdate(const _vector3<T> &v ) {
+		x *= v.x;
+		y *= v.y;
+		z *= v.z;
+	}
+
+	/** 
+	* turns a non-zero vector into a vector of unit length 
+	*/
+	void normalise() {
+		const T len = magnitude();
+		if (len > 0) {
+			x = x/len;
+			y = y/len;
+			z = z/len;
+		}
+	}
+
+	/** 
+	* returns the normalised version of a vector 
+	*/
+	_vector3 normal() const {
+		const T len = magnitude();
+		if (len > 0) {
+			return _vector3(x/len,y/len,z/len);
+		}
+		return *this;
+	}
+
+	/** 
+	* zero all the components of the vector 
+	*/
+	void clear() { x = y = z = 0; } 
+
+	/**
+	* adds the given vector to this vector, scaled by the given amount
+	*/
+	void addscaledvector(const _vector3& vector, T scale) { 
+		x += vector.x * scale;
+		y += vector.y * scale;
+		z += vector.z * scale;
+	}
+
+	T x,y,z;
+};
+
+/**
+* returns the scalar product of v1 and v2
+*/
+template <typename T>
+core_constexpr T _dot(const _vector3<T>&v1,const _vector3<T>&v2) { return (v1.x*v2.x+v1.y*v2.y+v1.z*v2.z); }
+
+/**
+* returns the vector product of v1 and v2
+*/
+template <typename T>
+core_constexpr _vector3<T> _cross(const _vector3<T>&v1,const _vector3<T>&v2) {
+	return _vector3<T>(  v1.y*v2.z-v1.z*v2.y,  v1.z*v2.x-v1.x*v2.z,  v1.x*v2.y-v1.y*v2.x );
+}
+
+/** 
+* returns the normalised version of v 
+*/
+template <typename T>
+_vector3<T> _normalize(const _vector3<T>&v) {
+	const T len = v.magnitude();
+	if(len>0){
+		return _vector3<T>(v.x/len,v.y/len,v.z/len);
+	}
+	return v;
+}
+
+/** 
+* returns the distance between two vectors as a scalar 
+*/
+template <typename T>
+T _distance(const _vector3<T>&v1,const _vector3<T>&v2) {
+	_vector3<T> dif = v1-v2;
+	return dif.magnitude();
+}
+
+template < typename T>
+struct _vector4{
+
+	/* constructors ************************************************************/
+
+	core_constexpr _vector4():x( T(0.0f) ),y( T(0.0f) ),z( T(0.0f) ),w( T(0.0f) ) {}
+
+	/* initialize with scalar */
+	core_constexpr _vector4(const T& v):x(v),y(v),z(v),w(v) {}
+
+	/* copy */
+	core_constexpr _vector4(const _vector4& v ):x(v.x),y(v.y),z(v.z),w(v.w) {}
+
+	/* initialize components  */
+	core_constexpr _vector4(const T& x_,const T& y_,const T& z_,const T& w_ ):x(x_),y(y_),z(z_),w(w_) {}
+
+	/***************************************************************************/
+
+	T& operator [](const int &index ) { return (&x)[ index ]; }
+	const T& operator [](const int &index )const { return (&x)[ index ]; }
+
+	/** 
+	* copies this vector 
+	*/
+	void operator =(const _vector4 &v) { x=v.x; y=v.y; z=v.z; w=v.w; }
+
+	/** 
+	* flips all the components of the vector 
+	*/
+	void invert() { x=-x; y=-y; z=-z; w=-w; }
+
+	/** 
+	* multiply this vector with the given scalar 
+	*/
+	void operator *=(const T& s) { x*=s; y*=s; z*=s; w*=s; }
+
+	/** 
+	* return this vector multiplied by the given scalar 
+	*/
+	core_constexpr _vector4 operator *(const T& s) const { return _vector4(x*s,y*s,z*s,w*s); }
+
+	/** 
+	* multiply this vector with the given vector 
+	*/
+	void operator *=(const _vector4& v) { x*=v.x; y*=v.y; z*=v.z; w*=v.w; }
+
+	/** 
+	* return this vector multiplied by the given vector
+	*/
+	core_constexpr _vector4 operator *(const _vector4& v) const { return _vector4(x*v.x,y*v.y,z*v.z,w*v.w); }
+
+	/** 
+	* add the given vector to this vector 
+	*/
+	void operator +=(const _vector4& v) { x+=v.x; y+=v.y; z+=v.z; w+=v.w; }
+
+	/** 
+	* return this vector added to the given vector 
+	*/
+	core_constexpr _vector4 operator +(const  _vector4& v) const { return _vector4(x+v.x,y+v.y,z+v.z,w+v.w); }
+
+	T x,y,z,w;
+};
+
+/**
+* holds a three degree of freedom orientation.
+*
+* quaternions have
+* several mathematical properties that make them useful for
+* representing orientations, but require four items of data to
+* hold the three degrees of freedom. these four items of data can
+* be viewed as the coefficients of a complex number with three
+* imaginary parts. the mathematics of the quaternion is then
+* defined and is roughly correspondent to the math of 3d
+* rotations. a quaternion is only a valid rotation if it is
+* normalised: i.e. it has a length of 1.
+*
+* angular velocity and acceleration can be correctly
+* represented as vectors. quaternions are only needed for
+* orientation.
+*/
+
+class _quaternion { 
+
+public:
+	union {
+		struct {
+			/**
+			* holds the real component of the quaternion.
+			*/
+			float r;
+			/**
+			* holds the first complex component of the
+			* quaternion.
+			*/
+			float i;
+			/**
+			* holds the second complex component of the
+			* quaternion.
+			*/
+			float j;
+			/**
+			* holds the third complex component of the
+			* quaternion.
+			*/
+			float k;
+		};
+		/**
+		* holds the quaternion data in array form.
+		*/
+		float data[4];
+	};
+
+	/**
+	* the default constructor creates a quaternion representing
+	* a zero rotation.
+	*/
+	core_constexpr _quaternion() : r(1), i(0), j(0), k(0) {}
+
+	/**
+	* the explicit constructor creates a quaternion with the given
+	* components.
+	*
+	* the given orientation does not need to be normalised,
+	* and can be zero. this function will not alter the given
+	* values, or normalise the quaternion. to normalise the
+	* quaternion (and make a zero quaternion a legal rotation),
+	* use the normalise function.
+	*
+	*/
+	core_constexpr _quaternion(const float r, const float i, const float j, const float k): r(r), i(i), j(j), k(k) { }
+
+	/**
+	* normalises the quaternion to unit length, making it a valid
+	* orientation quaternion.
+	*/
+	void normalise() {
+		float d = r*r+i*i+j*j+k*k;
+
+		// check for zero length quaternion, and use the no-rotation
+		// quaternion in that case.
+		if (d < FLT_EPSILON ) { r = 1.0f; return; }
+
+		d = ((float)1.0)/sqrt(d);
+		r *= d;
+		i *= d;
+		j *= d;
+		k *= d;
+	}
+
+	/**
+	* multiplies the quaternion by the given quaternion
+	*/
+	void operator *=(const _quaternion &multiplier) {
+#ifdef core_simd
+		// each component of this scales the other quaternion, turned
+		// and signed so the four products line up with r, i, j and k.
+		const __m128 a = _mm_loadu_ps(data);
+		const __m128 b = _mm_loadu_ps(multiplier.data);
+		__m128 result = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0,0,0,0)), b);
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1,1,1,1)),
+			_mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2,3,0,1)), _mm_set_ps( 0.0f,-0.0f, 0.0f,-0.0f))));
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2,2,2,2)),
+			_mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1,0,3,2)), _mm_set_ps(-0.0f, 0.0f, 0.0f,-0.0f))));
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3,3,3,3)),
+			_mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0,1,2,3)), _mm_set_ps( 0.0f, 0.0f,-0.0f,-0.0f))));
+		_mm_storeu_ps(data, result);
+#else
+		_quaternion q = *this;
+		r = q.r*multiplier.r - q.i*multiplier.i -
+			q.j*multiplier.j - q.k*multiplier.k;
+		i = q.r*multiplier.i + q.i*multiplier.r +
+			q.j*multiplier.k - q.k*multiplier.j;
+		j = q.r*multiplier.j + q.j*multiplier.r +
+			q.k*multiplier.i - q.i*multiplier.k;
+		k = q.r*multiplier.k + q.k*multiplier.r +
+			q.i*multiplier.j - q.j*multiplier.i;
+#endif
+	}
+
+	/**
+	* adds the given vector to this, scaled by the given amount.
+	* this is used to update the orientation quaternion by a rotation
+	* and time.
+	*/
+	void addscaledvector(const _vector3<float>& vector, float scale) {
+		_quaternion q(0,
+			vector.x * scale,
+			vector.y * scale,
+			vector.z * scale);
+		q *= *this;
+		r += q.r * ((float)0.5);
+		i += q.i * ((float)0.5);
+		j += q.j * ((float)0.5);
+		k += q.k * ((float)0.5);
+	}
+
+	void rotatebyvector(const _vector3<float>& vector) {
+		_quaternion q(0, vector.x, vector.y, vector.z);
+		(*this) *= q;
+	}
+};
+
+
+template < typename T>
+struct _matrix3{
+
+	/* constructors ************************************************************/
+
+	/* creates an identity matrix*/
+	_matrix3() { m_data[0][0]=m_data[1][1]=m_data[2][2]=1; }
+
+	/**
+	* sets the matrix to be a diagonal matrix with the given
+	* values along the leading diagonal.
+	*/
+	_matrix3(const T& s) { m_data[0][0]=m_data[1][1]=m_data[2][2]=s; }
+
+	/* copy, and a matrix with the given rows */
+#ifdef core_has_constexpr
+	constexpr _matrix3(const _matrix3& m) : m_data{ m.m_data[0], m.m_data[1], m.m_data[2] } {}
+	constexpr _matrix3(const _vector3<T>& r0, const _vector3<T>& r1, const _vector3<T>& r2) : m_data{ r0, r1, r2 } {}
+#else
+	_matrix3(const _matrix3& m) {  operator=(m); }
+	_matrix3(const _vector3<T>& r0, const _vector3<T>& r1, const _vector3<T>& r2) { m_data[0]=r0; m_data[1]=r1; m_data[2]=r2; }
+#endif
+
+	/**
+	* creates a new matrix with explicit coefficients.
+	*/
+	_matrix3(float c0,float c1,float c2,float c3,
+		float c4,float c5,float c6,float c7,float c8) {
+			(*this)[0][0]=c0; (*this)[1][0]=c1; (*this)[2][0]=c2;
+			(*this)[0][1]=c3; (*this)[1][1]=c4; (*this)[2][1]=c5;
+			(*this)[0][2]=c6; (*this)[1][2]=c7; (*this)[2][2]=c8;
+	}
+
+	/***************************************************************************/
+
+	/* copies this matrix */
+	void operator=(const _matrix3 &m) {
+		m_data[0]=m.m_data[0];
+		m_data[1]=m.m_data[1];
+		m_data[2]=m.m_data[2];
+	}
+
+	/**
+	* multiplies this matrix in place by the given other matrix
+	*/
+	void operator*=(const _matrix3<T> &o) {
+		T t1;
+		T t2;
+		T t3;
+
+		t1 = m_data[0][0]*o[0][0] + m_data[1][0]*o[0][1] + m_data[2][0]*o[0][2];
+		t2 = m_data[0][0]*o[1][0] + m_data[1][0]*o[1][1] + m_data[2][0]*o[1][2];
+		t3 = m_data[0][0]*o[2][0] + m_data[1][0]*o[2][1] + m_data[2][0]*o[2][2];
+		m_data[0][0] = t1;
+		m_data[1][0] = t2;
+		m_data[2][0] = t3;
+
+		t1 = m_data[0][1]*o[0][0] + m_data[1][1]*o[0][1] + m_data[2][1]*o[0][2];
+		t2 = m_data[0][1]*o[1][0] + m_data[1][1]*o[1][1] + m_data[2][1]*o[1][2];
+		t3 = m_data[0][1]*o[2][0] + m_data[1][1]*o[2][1] + m_data[2][1]*o[2][2];
+		m_data[0][1] = t1;
+		m_data[1][1] = t2;
+		m_data[2][1] = t3;
+
+		t1 = m_data[0][2]*o[0][0] + m_data[1][2]*o[0][1] + m_data[2][2]*o[0][2];
+		t2 = m_data[0][2]*o[1][0] + m_data[1][2]*o[1][1] + m_data[2][2]*o[1][2];
+		t3 = m_data[0][2]*o[2][0] + m_data[1][2]*o[2][1] + m_data[2][2]*o[2][2];
+		m_data[0][2] = t1;
+		m_data[1][2] = t2;
+		m_data[2][2] = t3;
+	}
+
+	/**
+	* multiplies this matrix in place by the given scalar
+	*/
+	void operator*=(const float s) {
+		m_data[0][0] *= s; m_data[1][0] *= s; m_data[2][0] *= s;
+		m_data[0][1] *= s; m_data[1][1] *= s; m_data[2][1] *= s;
+		m_data[0][2] *= s; m_data[1][2] *= s; m_data[2][2] *= s;
+	}
+
+	/**
+	* does a component-wise addition of this matrix and the given matrix
+	*/
+	void operator+=(const _matrix3<T> &o) {
+		m_data[0][0] += o[0][0]; m_data[1][0] += o[1][0]; m_data[2][0] += o[2][0];
+		m_data[0][1] += o[0][1]; m_data[1][1] += o[1][1]; m_data[2][1] += o[2][1];
+		m_data[0][2] += o[0][2]; m_data[1][2] += o[1][2]; m_data[2][2] += o[2][2];
+	}
+
+	/**
+	* transform the given vector by this matrix
+	*/
+	_vector3<T> operator * (const _vector3<T>& v) const {
+		return _vector3<T> (
+			v.x*m_data[0][0] + v.y*m_data[1][0] + v.z*m_data[2][0],
+			v.x*m_data[0][1] + v.y*m_data[1][1] + v.z*m_data[2][1],
+			v.x*m_data[0][2] + v.y*m_data[1][2] + v.z*m_data[2][2]);
+	}
+
+	_vector3<T>& operator [](const int &index ) { return m_data[ index ]; }
+	core_constexpr const _vector3<T>& operator [](const int &index )const { return m_data[ index ]; }
+
+
+	/**
+	* transform the given vector by this matrix
+	*/
+	_vector3<T> transform(const _vector3<T> &v) const { return (*this) * v; }
+
+	/**
+	* transform the given vector by the transpose of this matrix
+	*/
+	_vector3<T> transformtranspose( const _vector3<T> &v ) const {
+		return _vector3<T>(
+			v.x * m_data[0][0] + v.y * m_data[0][1] + v.z * m_data[0][2],
+			v.x * m_data[1][0] + v.y * m_data[1][1] + v.z * m_data[1][2],
+			v.x * m_data[2][0] + v.y * m_data[2][1] + v.z * m_data[2][2]
+		);
+	}
+
+	/**
+	* sets the matrix to be a diagonal matrix with the given
+	* values along the leading diagonal.
+	*/
+	void setdiagonal(T a, T b, T c) { setinertiatensorcoeffs(a, b, c); }
+
+	/**
+	* sets the value of the matrix from inertia tensor values.
+	*/
+	void setinertiatensorcoeffs(T ix,T iy,T iz,T ixy=0,T ixz=0,T iyz=0) {
+		(*this)[0][0] = ix;
+		(*this)[1][0] = (*this)[0][1] = -ixy;
+		(*this)[2][0] = (*this)[0][2] = -ixz;
+		(*this)[1][1] = iy;
+		(*this)[2][1] = (*this)[1][2] = -iyz;
+		(*this)[2][2] = iz;
+	}
+
+	/**
+	* sets the matrix values from the given three vector components
+	* these are arranged as the three columns of the vector
+	*/
+	void setcomponents(const _vector3<T> &compone, const _vector3<T> &comptwo,const _vector3<T> &compthree) {
+		m_data[0][0] = compone.x;
+		m_data[1][0] = comptwo.x;
+		m_data[2][0] = compthree.x;
+		m_data[0][1] = compone.y;
+		m_data[1][1] = comptwo.y;
+		m_data[2][1] = compthree.y;
+		m_data[0][2] = compone.z;
+		m_data[1][2] = comptwo.z;
+		m_data[2][2] = compthree.z;
+	}
+
+	/**
+	* sets the matrix to be the inverse of the given matrix
+	*/
+	void setinverse(const _matrix3<T>& m) {
+		float t4  = m[0][0]*m[1][1];
+		float t6  = m[0][0]*m[2][1];
+		float t8  = m[1][0]*m[0][1];
+		float t10 = m[2][0]*m[0][1];
+		float t12 = m[1][0]*m[0][2];
+		float t14 = m[2][0]*m[0][2];
+
+		// Calculate the determinant
+		float t16 = ( t4*m[2][2]-t6*m[1][2]-t8*m[2][2]+t10*m[1][2]+t12*m[2][1]-t14*m[1][1] );
+
+		// Make sure the determinant is non-zero.
+		if (t16 == 0.0f) { return; }
+		float t17 = 1/t16;
+
+		(*this)[0][0] =  ( m[1][1]*m[2][2] - m[2][1]*m[1][2] )*t17;
+		(*this)[1][0] = -( m[1][0]*m[2][2] - m[2][0]*m[1][2] )*t17;
+		(*this)[2][0] =  ( m[1][0]*m[2][1] - m[2][0]*m[1][1] )*t17;
+		(*this)[0][1] = -( m[0][1]*m[2][2] - m[2][1]*m[0][2] )*t17;
+		(*this)[1][1] =  ( m[0][0]*m[2][2] - t14)*t17;
+		(*this)[2][1] = -( t6-t10 )*t17;
+		(*this)[0][2] =  ( m[0][1]*m[1][2] - m[1][1]*m[0][2] )*t17;
+		(*this)[1][2] = -( m[0][0]*m[1][2] - t12)*t17;
+		(*this)[2][2] =  (t4-t8)*t17;
+	}
+
+	/**
+	* returns a new matrix containing the inverse of this matrix
+	*/
+	_matrix3<T> inverse() const {
+		_matrix3<T> result;
+		result.setinverse(*this);
+		return result;
+	}
+
+
+	/**
+	* sets the value of the matrix as an inertia tensor of
+	* a rectangular block aligned with the body's coordinate
+	* system with the given axis half-sizes and mass.
+	*/
+	void setblockinertiatensor(const _vector3<T> &halfsizes, float mass) {
+		_vector3<T> squares = halfsizes * halfsizes;
+		setinertiatensorcoeffs(0.3f*mass*(squares.y + squares.z),
+			0.3f*mass*(squares.x + squares.z),
+			0.3f*mass*(squares.x + squares.y));
+	}
+
+	/**
+	* sets the matrix to be a skew symmetric matrix based on
+	* the given vector. the skew symmetric matrix is the equivalent
+	* of the vector product. so if a,b are vectors. a x b = a_s b
+	* where a_s is the skew symmetric form of a
+	*/
+	void setskewsymmetric(const _vector3<T> v) {
+		m_data[0][0] = m_data[1][1] = m_data[2][2] = 0;
+		m_data[1][0] = -v.z;
+		m_data[2][0] = v.y;
+		m_data[0][1] = v.z;
+		m_data[2][1] = -v.x;
+		m_data[0][2] = -v.y;
+		m_data[1][2] = v.x;
+	}
+
+
+	_vector3<T> m_data[3];
+
+	/**
+	* interpolates a couple of matrices.
+	*/
+	static _matrix3<T> linearinterpolate(const _matrix3<T>& a, const _matrix3<T>& b, T prop) {
+		_matrix3<T> result;
+		T * a_data      = (T*)a.m_data;
+		T * b_data      = (T*)b.m_data;
+		T * result_data = (T*)result.m_data;
+		for (uint32_t i = 0; i < 9; i++) {
+			result_data[i] = a_data[i] * (1-prop) + b_data[i] * prop;
+		}
+		return result;
+	}
+
+};
+
+/** 
+* returns matrix containing the transpose of matrix m
+*/
+template <typename T>
+_matrix3<T> _transpose(const _matrix3<T>& m) {
+	_matrix3<T> result;
+	result[0][0]=m[0][0];  result[0][1]=m[1][0];  result[0][2]=m[2][0];
+	result[1][0]=m[0][1];  result[1][1]=m[1][1];  result[1][2]=m[2][1];
+	result[2][0]=m[0][2];  result[2][1]=m[1][2];  result[2][2]=m[2][2];
+	return result;
+}
+
+/**
+* returns matrix m1 and m2 multiplied 
+*/
+template <typename T>
+_matrix3<T> operator*(const _matrix3<T>& m1,const _matrix3<T>& m2) {
+	_matrix3<T> result;
+
+	result[0][0] = m1[0][0]*m2[0][0] + m1[0][1]*m2[1][0] + m1[0][2]*m2[2][0];
+	result[1][0] = m1[1][0]*m2[0][0] + m1[1][1]*m2[1][0] + m1[1][2]*m2[2][0];
+	result[2][0] = m1[2][0]*m2[0][0] + m1[2][1]*m2[1][0] + m1[2][2]*m2[2][0];
+
+	result[0][1] = m1[0][0]*m2[0][1] + m1[0][1]*m2[1][1] + m1[0][2]*m2[2][1];
+	result[1][1] = m1[1][0]*m2[0][1] + m1[1][1]*m2[1][1] + m1[1][2]*m2[2][1];
+	result[2][1] = m1[2][0]*m2[0][1] + m1[2][1]*m2[1][1] + m1[2][2]*m2[2][1];
+
+	result[0][2] = m1[0][0]*m2[0][2] + m1[0][1]*m2[1][2] + m1[0][2]*m2[2][2];
+	result[1][2] = m1[1][0]*m2[0][2] + m1[1][1]*m2[1][2] + m1[1][2]*m2[2][2];
+	result[2][2] = m1[2][0]*m2[0][2] + m1[2][1]*m2[1][2] + m1[2][2]*m2[2][2];
+
+	return result;
+}
+
+template < typename T>
+struct _matrix4{
+
+	/**constructors ************************************************************/
+	/* creates an identity matrix*/
+	_matrix4() { m_data[0][0]=m_data[1][1]=m_data[2][2]=m_data[3][3]=1; }
+	/**
+	* Sets the matrix to be a diagonal matrix with the given
+	* values along the leading diagonal.
+	*/
+	_matrix4(const T& s) { m_data[0][0]=m_data[1][1]=m_data[2][2]=m_data[3][3]=s; }
+	/* copy, and a matrix with the given rows */
+#ifdef core_has_constexpr
+	constexpr _matrix4(const _matrix4& m) : m_data{ m.m_data[0], m.m_data[1], m.m_data[2], m.m_data[3] } {}
+	constexpr _matrix4(const _vector4<T>& r0, const _vector4<T>& r1, const _vector4<T>& r2, const _vector4<T>& r3) : m_data{ r0, r1, r2, r3 } {}
+#else
+	_matrix4(const _matrix4& m) { operator=(m); }
+	_matrix4(const _vector4<T>& r0, const _vector4<T>& r1, const _vector4<T>& r2, const _vector4<T>& r3) { m_data[0]=r0; m_data[1]=r1; m_data[2]=r2; m_data[3]=r3; }
+#endif
+	/***************************************************************************/
+
+	/* copies this matrix */
+	void operator=(const _matrix4 &m) {
+		m_data[0]=m.m_data[0];
+		m_data[1]=m.m_data[1];
+		m_data[2]=m.m_data[2];
+		m_data[3]=m.m_data[3];
+	}
+
+	/**
+	* Returns a matrix which is this matrix multiplied by the given scalar
+	*/
+	_matrix4 operator*(const T& s) {
+		_matrix4 result(*this);
+		result[0]*=s;
+		result[1]*=s;
+		result[2]*=s;
+		result[3]*=s;
+		return result;
+	}
+
+	/**
+	* Transform the given vector by this matrix
+	*/
+	_vector4<T> operator * (const _vector4<T>& v) {
+		return _vector4<T> (
+			v.x*m_data[0][0] + v.y*m_data[1][0] + v.z*m_data[2][0] + v.w*m_data[3][0],
+			v.x*m_data[0][1] + v.y*m_data[1][1] + v.z*m_data[2][1] + v.w*m_data[3][1],
+			v.x*m_data[0][2] + v.y*m_data[1][2] + v.z*m_data[2][2] + v.w*m_data[3][2],
+			v.x*m_data[0][3] + v.y*m_data[1][3] + v.z*m_data[2][3] + v.w*m_data[3][3]);
+	}
+
+	/**
+	* Transform the given vector by this matrix
+	*/
+	_vector3<T> operator*(const _vector3<T> & v) const {
+		return _vector3<T>(
+			v.x*m_data[0][0] + v.y*m_data[1][0] + v.z*m_data[2][0] + m_data[3][0],
+			v.x*m_data[0][1] + v.y*m_data[1][1] + v.z*m_data[2][1] + m_data[3][1],
+			v.x*m_data[0][2] + v.y*m_data[1][2] + v.z*m_data[2][2] + m_data[3][2]);
+	}
+
+	/**
+	* Transform the given vector by this matrix
+	*/
+	_vector3<T> transform(const _vector3<T> &v) const { return (*this) * v; }
+
+	_vector4<T>& operator [](const int &index ) { return m_data[ index ]; }
+	core_constexpr const _vector4<T>& operator [](const int &index )const { return m_data[ index ]; }
+
+
+	/**
+	* transform the given vector by the transformational inverse
+	* of this matrix.
+	*
+	* this function relies on the fact that the inverse of
+	* a pure rotation matrix is its transpose. it separates the
+	* translational and rotation components, transposes the
+	* rotation, and multiplies out. if the matrix is not a
+	* scale and shear free transform matrix, then this function
+	* will not give correct results.
+	*
+	*/
+	_vector3<T> transforminverse(const _vector3<T> &vector) const {
+		_vector3<T> tmp = vector;
+		tmp.x -= (*this)[3][0];
+		tmp.y -= (*this)[3][1];
+		tmp.z -= (*this)[3][2];
+		return _vector3<T>(
+			tmp.x * (*this)[0][0] +
+			tmp.y * (*this)[0][1] +
+			tmp.z * (*this)[0][2],
+
+			tmp.x * (*this)[1][0] +
+			tmp.y * (*this)[1][1] +
+			tmp.z * (*this)[1][2],
+
+			tmp.x * (*this)[2][0] +
+			tmp.y * (*this)[2][1] +
+			tmp.z * (*this)[2][2]
+		);
+	}
+
+	/**
+	* gets a vector representing one axis (i.e. one column) in the matrix
+	*/
+	_vector3<T> getaxisvector(uint32_t i) const { return _vector3<T>(m_data[i].x,m_data[i].y,m_data[i].z); }
+
+	/**
+	* transform the given direction vector by the
+	* transformational inverse of this matrix.
+	*
+	* this function relies on the fact that the inverse of
+	* a pure rotation matrix is its transpose. it separates the
+	* translational and rotation components, transposes the
+	* rotation, and multiplies out. if the matrix is not a
+	* scale and shear free transform matrix, then this function
+	* will not give correct results.
+	*/
+	_vector3<T> transforminversedirection(const _vector3<T> &v) const {
+		return _vector3<T>(
+			v.x * (*this)[0][0] + v.y * (*this)[0][1] + v.z * (*this)[0][2],
+			v.x * (*this)[1][0] + v.y * (*this)[1][1] + v.z * (*this)[1][2],
+			v.x * (*this)[2][0] + v.y * (*this)[2][1] + v.z * (*this)[2][2]
+		);
+	}
+
+	/**
+	* transform the given direction vector by this matrix
+	*/
+	_vector3<T> transformdirection(const _vector3<T> &v) const {
+		return _vector3<T> (
+			v.x * (*this)[0][0] + v.y * (*this)[1][0] + v.z * (*this)[2][0],
+			v.x * (*this)[0][1] + v.y * (*this)[1][1] + v.z * (*this)[2][1],
+			v.x * (*this)[0][2] + v.y * (*this)[1][2] + v.z * (*this)[2][2]
+		);
+	}
+
+
+	_vector4<T> m_data[4];
+};
+
+/* returns matrix containing the transpose of matrix m*/
+template <typename T>
+_matrix4<T> _transpose(const _matrix4<T>& m) {
+	_matrix4<T> result;
+	result[0][0]=m[0][0];  result[0][1]=m[1][0];  result[0][2]=m[2][0]; result[0][3]=m[3][0];
+	result[1][0]=m[0][1];  result[1][1]=m[1][1];  result[1][2]=m[2][1]; result[1][3]=m[3][1];
+	result[2][0]=m[0][2];  result[2][1]=m[1][2];  result[2][2]=m[2][2]; result[2][3]=m[3][2];
+	result[3][0]=m[0][3];  result[3][1]=m[1][3];  result[3][2]=m[2][3]; result[3][3]=m[3][3];
+	return result;
+}
+
+/**
+* returns row r of a matrix multiplied by matrix m
+*/
+template <typename T>
+core_constexpr _vector4<T> _multiplyrow(const _vector4<T>& r,const _matrix4<T>& m) {
+	return _vector4<T>(
+		r.x*m[0].x + r.y*m[1].x + r.z*m[2].x + r.w*m[3].x,
+		r.x*m[0].y + r.y*m[1].y + r.z*m[2].y + r.w*m[3].y,
+		r.x*m[0].z + r.y*m[1].z + r.z*m[2].z + r.w*m[3].z,
+		r.x*m[0].w + r.y*m[1].w + r.z*m[2].w + r.w*m[3].w);
+}
+
+/**
+* returns matrix m1 and m2 multiplied, always in scalar code, so it
+* can combine constant matrices while compiling.
+*/
+template <typename T>
+core_constexpr _matrix4<T> _multiply(const _matrix4<T>& m1,const _matrix4<T>& m2) {
+	return _matrix4<T>(_multiplyrow(m1[0], m2), _multiplyrow(m1[1], m2), _multiplyrow(m1[2], m2), _multiplyrow(m1[3], m2));
+}
+
+/**
+* returns matrix m1 and m2 multiplied 
+*/
+template <typename T>
+core_constexpr _matrix4<T> operator*(const _matrix4<T>& m1,const _matrix4<T>& m2) { return _multiply(m1, m2); }
+
+#ifdef core_simd
+/* float matrices on sse ****************************************************/
+
+/* the sum of the four rows of m, each scaled by a component of v */
+inline __m128 _combine(const __m128 &v, const _matrix4<float>& m) {
+	__m128 result = _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0,0,0,0)), _mm_loadu_ps(&m.m_data[0].x));
+	result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1,1,1,1)), _mm_loadu_ps(&m.m_data[1].x)));
+	result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2,2,2,2)), _mm_loadu_ps(&m.m_data[2].x)));
+	result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3,3,3,3)), _mm_loadu_ps(&m.m_data[3].x)));
+	return result;
+}
+
+template <> inline void _matrix4<float>::operator=(const _matrix4<float> &m) {
+	_mm_storeu_ps(&m_data[0].x, _mm_loadu_ps(&m.m_data[0].x));
+	_mm_storeu_ps(&m_data[1].x, _mm_loadu_ps(&m.m_data[1].x));
+	_mm_storeu_ps(&m_data[2].x, _mm_loadu_ps(&m.m_data[2].x));
+	_mm_storeu_ps(&m_data[3].x, _mm_loadu_ps(&m.m_data[3].x));
+}
+
+/* the sum of the first three rows of m, each scaled by a component of v */
+inline __m128 _combine(const _vector3<float> &v, const _matrix4<float>& m) {
+	__m128 result = _mm_mul_ps(_mm_set1_ps(v.x), _mm_loadu_ps(&m.m_data[0].x));
+	result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(v.y), _mm_loadu_ps(&m.m_data[1].x)));
+	result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(v.z), _mm_loadu_ps(&m.m_data[2].x)));
+	return result;
+}
+
+template <> inline _vector3<float> _matrix4<float>::operator*(const _vector3<float> & v) const {
+	float result[4];
+	_mm_storeu_ps(result, _mm_add_ps(_combine(v, *this), _mm_loadu_ps(&m_data[3].x)));
+	return _vector3<float>(result[0], result[1], result[2]);
+}
+
+template <> inline _vector3<float> _matrix4<float>::transformdirection(const _vector3<float> &v) const {
+	float result[4];
+	_mm_storeu_ps(result, _combine(v, *this));
+	return _vector3<float>(result[0], result[1], result[2]);
+}
+
+template <>
+inline _matrix4<float> operator*(const _matrix4<float>& m1,const _matrix4<float>& m2) {
+	_matrix4<float> result;
+	_mm_storeu_ps(&result.m_data[0].x, _combine(_mm_loadu_ps(&m1.m_data[0].x), m2));
+	_mm_storeu_ps(&result.m_data[1].x, _combine(_mm_loadu_ps(&m1.m_data[1].x), m2));
+	_mm_storeu_ps(&result.m_data[2].x, _combine(_mm_loadu_ps(&m1.m_data[2].x), m2));
+	_mm_storeu_ps(&result.m_data[3].x, _combine(_mm_loadu_ps(&m1.m_data[3].x), m2));
+	return result;
+}
+/***************************************************************************/
+#endif
+
+/**
+* holds a transform that only turns and moves, laid out as the first
+* three columns of a _matrix4: rows 0 to 2 are the axes and row 3 the
+* translation. the fourth column of such a matrix is always
+* (0,0,0,1), so it is left out, which saves a quarter of the memory
+* and the multiplies by 0 and 1.
+*/
+template < typename T>
+struct _affine{
+
+	/**constructors ************************************************************/
+	/* creates an identity transform */
+	_affine() { m_data[0].x=m_data[1].y=m_data[2].z=1; }
+	/* takes the first three columns of the given matrix */
+	explicit _affine(const _matrix4<T>& m) {
+		m_data[0]=m.getaxisvector(0);
+		m_data[1]=m.getaxisvector(1);
+		m_data[2]=m.getaxisvector(2);
+		m_data[3]=m.getaxisvector(3);
+	}
+	/* copy, and a transform with the given axes and translation */
+#ifdef core_has_constexpr
+	constexpr _affine(const _affine& m) : m_data{ m.m_data[0], m.m_data[1], m.m_data[2], m.m_data[3] } {}
+	constexpr _affine(const _vector3<T>& r0, const _vector3<T>& r1, const _vector3<T>& r2, const _vector3<T>& r3) : m_data{ r0, r1, r2, r3 } {}
+#else
+	_affine(const _affine& m) { operator=(m); }
+	_affine(const _vector3<T>& r0, const _vector3<T>& r1, const _vector3<T>& r2, const _vector3<T>& r3) { m_data[0]=r0; m_data[1]=r1; m_data[2]=r2; m_data[3]=r3; }
+#endif
+	/***************************************************************************/
+
+	/* copies this transform */
+	void operator=(const _affine &m) {
+		m_data[0]=m.m_data[0];
+		m_data[1]=m.m_data[1];
+		m_data[2]=m.m_data[2];
+		m_data[3]=m.m_data[3];
+	}
+
+	_vector3<T>& operator [](const int &index ) { return m_data[ index ]; }
+	core_constexpr const _vector3<T>& operator [](const int &index )const { return m_data[ index ]; }
+
+	/**
+	* returns the full matrix of this transform, for the renderer.
+	*/
+	core_constexpr _matrix4<T> tomatrix4() const {
+		return _matrix4<T>(
+			_vector4<T>(m_data[0].x, m_data[0].y, m_data[0].z, T(0)),
+			_vector4<T>(m_data[1].x, m_data[1].y, m_data[1].z, T(0)),
+			_vector4<T>(m_data[2].x, m_data[2].y, m_data[2].z, T(0)),
+			_vector4<T>(m_data[3].x, m_data[3].y, m_data[3].z, T(1)));
+	}
+
+	/**
+	* Transform the given vector by this transform
+	*/
+	core_constexpr _vector3<T> operator*(const _vector3<T> & v) const {
+		return _vector3<T>(
+			v.x*m_data[0].x + v.y*m_data[1].x + v.z*m_data[2].x + m_data[3].x,
+			v.x*m_data[0].y + v.y*m_data[1].y + v.z*m_data[2].y + m_data[3].y,
+			v.x*m_data[0].z + v.y*m_data[1].z + v.z*m_data[2].z + m_data[3].z);
+	}
+
+	/**
+	* Transform the given vector by this transform
+	*/
+	core_constexpr _vector3<T> transform(const _vector3<T> &v) const { return (*this) * v; }
+
+	/**
+	* transform the given direction vector by this transform
+	*/
+	core_constexpr _vector3<T> transformdirection(const _vector3<T> &v) const {
+		return _vector3<T> (
+			v.x*m_data[0].x + v.y*m_data[1].x + v.z*m_data[2].x,
+			v.x*m_data[0].y + v.y*m_data[1].y + v.z*m_data[2].y,
+			v.x*m_data[0].z + v.y*m_data[1].z + v.z*m_data[2].z);
+	}
+
+	/**
+	* transform the given vector by the inverse of this transform.
+	* the axes are taken to be of unit length and at right angles,
+	* so the inverse of the rotation is its transpose.
+	*/
+	core_constexpr _vector3<T> transforminverse(const _vector3<T> &v) const {
+		return transforminversedirection(v - m_data[3]);
+	}
+
+	/**
+	* transform the given direction vector by the inverse of this
+	* transform, with the same assumption as transforminverse.
+	*/
+	core_constexpr _vector3<T> transforminversedirection(const _vector3<T> &v) const {
+		return _vector3<T>(
+			v.x*m_data[0].x + v.y*m_data[0].y + v.z*m_data[0].z,
+			v.x*m_data[1].x + v.y*m_data[1].y + v.z*m_data[1].z,
+			v.x*m_data[2].x + v.y*m_data[2].y + v.z*m_data[2].z);
+	}
+
+	/**
+	* gets a vector representing one axis, or the translation for 3
+	*/
+	core_constexpr _vector3<T> getaxisvector(uint32_t i) const { return m_data[i]; }
+
+	/**
+	* sets the transform to be the inverse of the given one, which
+	* must only turn and move.
+	*/
+	void setinverse(const _affine<T>& m) {
+		_vector3<T> translation = m[3];
+		_vector3<T> axis[3] = { m[0], m[1], m[2] };
+		m_data[0] = _vector3<T>(axis[0].x, axis[1].x, axis[2].x);
+		m_data[1] = _vector3<T>(axis[0].y, axis[1].y, axis[2].y);
+		m_data[2] = _vector3<T>(axis[0].z, axis[1].z, axis[2].z);
+		m_data[3] = transformdirection(translation) * T(-1);
+	}
+
+	/**
+	* returns a new transform containing the inverse of this transform
+	*/
+	_affine<T> inverse() const {
+		_affine<T> result;
+		result.setinverse(*this);
+		return result;
+	}
+
+	_vector3<T> m_data[4];
+};
+
+/**
+* returns transforms m1 and m2 combined, in the order of the matrix
+* product: (m1 * m2) * v is m2 * (m1 * v).
+*/
+template <typename T>
+core_constexpr _affine<T> operator*(const _affine<T>& m1,const _affine<T>& m2) {
+	return _affine<T>(m2.transformdirection(m1[0]), m2.transformdirection(m1[1]), m2.transformdirection(m1[2]), m2 * m1[3]);
+}
+
+/* bulk transforms *********************************************************/
+
+/**
+* the kernels below transform a whole array at once, so the matrix is
+* loaded a single time, and on sse several components are worked on
+* together. the output may be the input array.
+*
+* points and directions held as vectors are left scalar: a vector is
+* twelve bytes, and with the matrix kept in locals the compiler does
+* better than loading each into a register.
+*/
+
+/** transforms count points by m. */
+template <typename T>
+void _transformpoints(const _matrix4<T>& m, const _vector3<T> *in, _vector3<T> *out, uint32_t count) {
+	const T m00 = m[0][0], m01 = m[0][1], m02 = m[0][2];
+	const T m10 = m[1][0], m11 = m[1][1], m12 = m[1][2];
+	const T m20 = m[2][0], m21 = m[2][1], m22 = m[2][2];
+	const T m30 = m[3][0], m31 = m[3][1], m32 = m[3][2];
+	for (uint32_t i = 0; i < count; i++) {
+		const T x = in[i].x, y = in[i].y, z = in[i].z;
+		out[i].x = x*m00 + y*m10 + z*m20 + m30;
+		out[i].y = x*m01 + y*m11 + z*m21 + m31;
+		out[i].z = x*m02 + y*m12 + z*m22 + m32;
+	}
+}
+
+/** transforms count directions by m, leaving out its translation. */
+template <typename T>
+void _transformdirections(const _matrix4<T>& m, const _vector3<T> *in, _vector3<T> *out, uint32_t count) {
+	const T m00 = m[0][0], m01 = m[0][1], m02 = m[0][2];
+	const T m10 = m[1][0], m11 = m[1][1], m12 = m[1][2];
+	const T m20 = m[2][0], m21 = m[2][1], m22 = m[2][2];
+	for (uint32_t i = 0; i < count; i++) {
+		const T x = in[i].x, y = in[i].y, z = in[i].z;
+		out[i].x = x*m00 + y*m10 + z*m20;
+		out[i].y = x*m01 + y*m11 + z*m21;
+		out[i].z = x*m02 + y*m12 + z*m22;
+	}
+}
+
+/**
+* transforms count points by m, a _matrix4 or an _affine, held as an
+* array per component. on sse four points are transformed at once.
+*/
+template <typename M, typename T>
+void _transformpoints(const M& m, const T *x, const T *y, const T *z, T *outx, T *outy, T *outz, uint32_t count) {
+	const T m00 = m[0][0], m01 = m[0][1], m02 = m[0][2];
+	const T m10 = m[1][0], m11 = m[1][1], m12 = m[1][2];
+	const T m20 = m[2][0], m21 = m[2][1], m22 = m[2][2];
+	const T m30 = m[3][0], m31 = m[3][1], m32 = m[3][2];
+	for (uint32_t i = 0; i < count; i++) {
+		const T px = x[i], py = y[i], pz = z[i];
+		outx[i] = px*m00 + py*m10 + pz*m20 + m30;
+		outy[i] = px*m01 + py*m11 + pz*m21 + m31;
+		outz[i] = px*m02 + py*m12 + pz*m22 + m32;
+	}
+}
+
+/** sets each out[i] to m * in[i]. */
+template <typename T>
+void _transformmatrices(const _matrix4<T>& m, const _matrix4<T> *in, _matrix4<T> *out, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) { out[i] = m * in[i]; }
+}
+
+/** sets each out[i] to a[i] * b[i], on sse through the matrix product. */
+template <typename T>
+void _multiplymatrices(const _matrix4<T> *a, const _matrix4<T> *b, _matrix4<T> *out, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) { out[i] = a[i] * b[i]; }
+}
+
+#ifdef core_simd
+template <typename M>
+inline void _transformpoints(const M& m, const float *x, const float *y, const float *z, float *outx, float *outy, float *outz, uint32_t count) {
+	// each element of the matrix is spread over a register, so one
+	// multiply takes four points' components.
+	const __m128 m00 = _mm_set1_ps(m[0][0]), m01 = _mm_set1_ps(m[0][1]), m02 = _mm_set1_ps(m[0][2]);
+	const __m128 m10 = _mm_set1_ps(m[1][0]), m11 = _mm_set1_ps(m[1][1]), m12 = _mm_set1_ps(m[1][2]);
+	const __m128 m20 = _mm_set1_ps(m[2][0]), m21 = _mm_set1_ps(m[2][1]), m22 = _mm_set1_ps(m[2][2]);
+	const __m128 m30 = _mm_set1_ps(m[3][0]), m31 = _mm_set1_ps(m[3][1]), m32 = _mm_set1_ps(m[3][2]);
+
+	uint32_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128 px = _mm_loadu_ps(x + i), py = _mm_loadu_ps(y + i), pz = _mm_loadu_ps(z + i);
+		_mm_storeu_ps(outx + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, m00), _mm_mul_ps(py, m10)), _mm_mul_ps(pz, m20)), m30));
+		_mm_storeu_ps(outy + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, m01), _mm_mul_ps(py, m11)), _mm_mul_ps(pz, m21)), m31));
+		_mm_storeu_ps(outz + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, m02), _mm_mul_ps(py, m12)), _mm_mul_ps(pz, m22)), m32));
+	}
+	for (; i < count; i++) {
+		const float px = x[i], py = y[i], pz = z[i];
+		outx[i] = px*m[0][0] + py*m[1][0] + pz*m[2][0] + m[3][0];
+		outy[i] = px*m[0][1] + py*m[1][1] + pz*m[2][1] + m[3][1];
+		outz[i] = px*m[0][2] + py*m[1][2] + pz*m[2][2] + m[3][2];
+	}
+}
+
+template <>
+inline void _transformmatrices(const _matrix4<float>& m, const _matrix4<float> *in, _matrix4<float> *out, uint32_t count) {
+	const __m128 a0 = _mm_loadu_ps(&m.m_data[0].x), a1 = _mm_loadu_ps(&m.m_data[1].x);
+	const __m128 a2 = _mm_loadu_ps(&m.m_data[2].x), a3 = _mm_loadu_ps(&m.m_data[3].x);
+	for (uint32_t i = 0; i < count; i++) {
+		// all of in[i] is read before out[i] is written, they may be the same
+		_matrix4<float> b = in[i];
+		_mm_storeu_ps(&out[i].m_data[0].x, _combine(a0, b));
+		_mm_storeu_ps(&out[i].m_data[1].x, _combine(a1, b));
+		_mm_storeu_ps(&out[i].m_data[2].x, _combine(a2, b));
+		_mm_storeu_ps(&out[i].m_data[3].x, _combine(a3, b));
+	}
+}
+#endif
+/***************************************************************************/
+
+template <typename T> /*glm*/
+_matrix4<T> _lookatrh (const _vector3<T>& eye,const _vector3<T>& center,const _vector3<T>& up) {
+	const _vector3<T> f(_normalize(center - eye));
+	const _vector3<T> s(_normalize(_cross(f, up)));
+	const _vector3<T> u(_cross(s, f));
+
+	_matrix4<T> result;
+	result[0][0] = s.x;
+	result[1][0] = s.y;
+	result[2][0] = s.z;
+	result[0][1] = u.x;
+	result[1][1] = u.y;
+	result[2][1] = u.z;
+	result[0][2] =-f.x;
+	result[1][2] =-f.y;
+	result[2][2] =-f.z;
+	result[3][0] =-_dot(s, eye);
+	result[3][1] =-_dot(u, eye);
+	result[3][2] = _dot(f, eye);
+	return result;
+}
+template <typename T> /*glm*/
+_matrix4<T> _perspectivefovrh(T fov,T width,T height,T zNear,T zFar ) {
+
+	T const rad = fov;
+	T const h = cos(T(0.5) * rad) / sin(T(0.5) * rad);
+	T const w = h * height / width; ///todo max(width , Height) / min(width , Height)?
+
+	_matrix4<T> result(T(0));
+	result[0][0] = w;
+	result[1][1] = h;
+	result[2][2] = - (zFar + zNear) / (zFar - zNear);
+	result[2][3] = - T(1);
+	result[3][2] = - (T(2) * zFar * zNear) / (zFar - zNear);
+	return result;
+}
+template <typename T>/*glm*/
+_matrix4<T> _ortho ( T left, T right, T bottom, T top, T zNear, T zFar ) {
+    _matrix4<T> Result(1);
+    Result[0][0] = static_cast<T>(2) / (right - left);
+    Result[1][1] = static_cast<T>(2) / (top - bottom);
+    Result[2][2] = - static_cast<T>(2) / (zFar - zNear);
+    Result[3][0] = - (right + left) / (right - left);
+    Result[3][1] = - (top + bottom) / (top - bottom);
+    Result[3][2] = - (zFar + zNear) / (zFar - zNear);
+    return Result;
+}
+
+template <typename T> /*glm*/
+core_constexpr _matrix4<T> _translate(const _vector3<T> & v ) {
+	return _matrix4<T>(
+		_vector4<T>(T(1), T(0), T(0), T(0)),
+		_vector4<T>(T(0), T(1), T(0), T(0)),
+		_vector4<T>(T(0), T(0), T(1), T(0)),
+		_vector4<T>(v.x,  v.y,  v.z,  T(1)));
+}
+template <typename T> /*glm*/
+core_constexpr _matrix4<T> _scale ( const _vector3<T>& v ) {
+	return _matrix4<T>(
+		_vector4<T>(v.x,  T(0), T(0), T(0)),
+		_vector4<T>(T(0), v.y,  T(0), T(0)),
+		_vector4<T>(T(0), T(0), v.z,  T(0)),
+		_vector4<T>(T(0), T(0), T(0), T(1)));
+}
+/**
+* returns a rotation about the given axis, of unit length, by the
+* angle with the given sine and cosine. with the sine and cosine
+* known, such as for a quarter turn, it is worked out while compiling.
+*/
+template <typename T> /*glm*/
+core_constexpr _matrix4<T> _rotate ( const T& s, const T& c, const _vector3<T>& axis ) {
+	return _matrix4<T>(
+		_vector4<T>(c + axis.x*(T(1) - c)*axis.x,     axis.x*(T(1) - c)*axis.y + s*axis.z, axis.x*(T(1) - c)*axis.z - s*axis.y, T(0)),
+		_vector4<T>(axis.y*(T(1) - c)*axis.x - s*axis.z, c + axis.y*(T(1) - c)*axis.y,     axis.y*(T(1) - c)*axis.z + s*axis.x, T(0)),
+		_vector4<T>(axis.z*(T(1) - c)*axis.x + s*axis.y, axis.z*(T(1) - c)*axis.y - s*axis.x, c + axis.z*(T(1) - c)*axis.z,     T(0)),
+		_vector4<T>(T(0), T(0), T(0), T(1)));
+}
+template <typename T> /*glm*/
+_matrix4<T> _rotate ( T angle, const _vector3<T>& v ) {
+	return _rotate(T(sin(angle)), T(cos(angle)), _normalize(v));
+}
+template <typename T> /*glm*/
+_matrix4<T> _rotate ( const _matrix4<T>& m, T angle, const _vector3<T> & v ) {
+	T const a = angle;
+	T const c = cos(a);
+	T const s = sin(a);
+
+	_vector3<T> axis(_normalize(v));
+	_vector3<T> temp(axis* (T(1) - c) );
+
+	_matrix4<T> rotate(0);
+	rotate[0][0] = c + temp[0] * axis[0];
+	rotate[0][1] = 0 + temp[0] * axis[1] + s * axis[2];
+	rotate[0][2] = 0 + temp[0] * axis[2] - s * axis[1];
+
+	rotate[1][0] = 0 + temp[1] * axis[0] - s * axis[2];
+	rotate[1][1] = c + temp[1] * axis[1];
+	rotate[1][2] = 0 + temp[1] * axis[2] + s * axis[0];
+
+	rotate[2][0] = 0 + temp[2] * axis[0] + s * axis[1];
+	rotate[2][1] = 0 + temp[2] * axis[1] - s * axis[0];
+	rotate[2][2] = c + temp[2] * axis[2];
+
+	_matrix4<T> result(0);
+	result[0] = m[0] * rotate[0][0] + m[1] * rotate[0][1] + m[2] * rotate[0][2];
+	result[1] = m[0] * rotate[1][0] + m[1] * rotate[1][1] + m[2] * rotate[1][2];
+	result[2] = m[0] * rotate[2][0] + m[1] * rotate[2][1] + m[2] * rotate[2][2];
+	result[3] = m[3];
+	return result;
+}
+template <typename T> /*glm*/
+_matrix4<T> _yawpitchroll (const T&yaw, const T&pitch,const T&roll) {
+	T tmp_ch = cos(yaw);
+	T tmp_sh = sin(yaw);
+	T tmp_cp = cos(pitch);
+	T tmp_sp = sin(pitch);
+	T tmp_cb = cos(roll);
+	T tmp_sb = sin(roll);
+
+	_matrix4<T> result;
+	result[0][0] = tmp_ch * tmp_cb + tmp_sh * tmp_sp * tmp_sb;
+	result[0][1] = tmp_sb * tmp_cp;
+	result[0][2] = -tmp_sh * tmp_cb + tmp_ch * tmp_sp * tmp_sb;
+	result[0][3] = static_cast<T>(0);
+	result[1][0] = -tmp_ch * tmp_sb + tmp_sh * tmp_sp * tmp_cb;
+	result[1][1] = tmp_cb * tmp_cp;
+	result[1][2] = tmp_sb * tmp_sh + tmp_ch * tmp_sp * tmp_cb;
+	result[1][3] = static_cast<T>(0);
+	result[2][0] = tmp_sh * tmp_cp;
+	result[2][1] = -tmp_sp;
+	result[2][2] = tmp_ch * tmp_cp;
+	result[2][3] = static_cast<T>(0);
+	result[3][0] = static_cast<T>(0);
+	result[3][1] = static_cast<T>(0);
+	result[3][2] = static_cast<T>(0);
+	result[3][3] = static_cast<T>(1);
+	return result;
+}
+
+/* casts x to an rvalue, so it is moved from rather than copied, as std::move */
+template <typename T> struct _unreference     { typedef T type; };
+template <typename T> struct _unreference<T&> { typedef T type; };
+template <typename T>
+inline typename _unreference<T>::type&& _move(T&& x) { return static_cast<typename _unreference<T>::type&&>(x); }
+
+/* tells whether an _array of T is a string, which is kept 0 terminated */
+template <typename T> struct _string_char          { enum { value = 0 }; };
+template <>           struct _string_char<char>    { enum { value = 1 }; };
+template <>           struct _string_char<wchar_t> { enum { value = 1 }; };
+
+/* simplistic array - for preferred  convention.
+   it doubles when it grows and moves its objects over, new room is not
+   zeroed, and pop takes from the end in place. in an array of char the
+   object after the last one is kept at 0, so a _string always ends in
+   a 0. allocate gives value initialised objects, zero for plain data. */
+template <typename T,typename T2 = uint32_t >
+struct _array {
+
+	T * m_data;
+	T2  m_size;
+	T2  m_count;
+
+	~_array(){ clear(); }
+	_array() : m_data(NULL),m_size(0),m_count(0) {}
+	_array(const _array& x) : m_data(NULL),m_size(0),m_count(0){ copy(x); }
+	/* takes the objects of x, leaving it empty */
+	_array(_array&& x) : m_data(x.m_data),m_size(x.m_size),m_count(x.m_count){
+		x.m_data = NULL;
+		x.m_size = x.m_count = 0;
+	}
+	void operator = (const _array& x) { if(this != &x){ copy(x); } }
+	void operator = (_array&& x) {
+		if(this == &x){ return; }
+		clear();
+		m_data  = x.m_data;
+		m_size  = x.m_size;
+		m_count = x.m_count;
+		x.m_data = NULL;
+		x.m_size = x.m_count = 0;
+	}
+	_array(const char *str) : m_data(NULL),m_size(0),m_count(0) { operator=(str); }
+	void operator = (const char* str) {
+		if(!str){ return; }
+		uint32_t len = strlen(str);
+		if(len){
+			m_count = 0;
+			reserve(len);
+			for(T2 i =0;i<len; i++){ m_data[i] = str[i]; }
+			m_count = len;
+			terminate();
+		}
+	}
+	void copy (const _array& x){
+		if(!x.m_count){ clear(); return; }
+		m_count = 0;
+		reserve(x.m_count);
+		for(T2 i =0;i<x.m_count; i++){ m_data[i] = x.m_data[i]; }
+		m_count = x.m_count;
+		terminate();
+	}
+	void clear() { if(m_data){ delete [] m_data;m_data = NULL;m_size=m_count=0;} }
+	/* grows the room to count objects, keeping all those held so far, in or past m_count */
+	void alloc(const T2& count){
+		if(m_size >= count){ return; }
+		delete [] grow(count);
+	}
+	/* makes room for count objects, and the one after */
+	void reserve(const T2& count){ alloc(count+1); }
+	void allocate(const T2& count){
+		clear();
+		m_data  = new T[count+1]();
+		m_size  = count+1;
+		m_count = count;
+	}
+	/* the flag is left from when doubling was optional, the array always doubles now */
+	void pushback(const T& val,bool = false){
+		if(m_count+2 <= m_size){ m_data[m_count++] = val; terminate(); return; }
+
+		/* val may be in the old objects, so it is copied before they go */
+		T* old = grow(growth());
+		m_data[m_count++] = val;
+		delete [] old;
+		terminate();
+	}
+	void pushback(T&& val,bool = false){
+		if(m_count+2 <= m_size){ m_data[m_count++] = _move(val); terminate(); return; }
+
+		/* val may be one of the objects, which grow moves out of, so it is taken first */
+		T taken(_move(val));
+		T* old = grow(growth());
+		m_data[m_count++] = _move(taken);
+		delete [] old;
+		terminate();
+	}
+	/* adds an object at the end, at its default value, and returns it to be filled in place.
+	   the room past m_count can hold objects left over from before m_count was lowered,
+	   so the new one is always reset */
+	T& emplaceback(){
+		if(m_count+2 > m_size){ alloc(growth()); }
+		m_data[m_count] = T();
+		m_count++;
+		terminate();
+		return m_data[m_count-1];
+	}
+	_array operator + (const _array& str){
+
+		_array result;
+		result.allocate(m_count+str.m_count);
+		for(T2 i=0;i<m_count;i++){ result[i]=m_data[i]; }
+		for(T2 i=0,ii=m_count;i<str.m_count;i++,ii++){ result[ii]=str[i]; }
+		return result;
+	}
+	T& operator [](const T2& index){ return m_data[index]; }
+	const T& operator [](const T2& index) const { return m_data[index]; }
+	T pop(){
+		if(m_count==0){ return T(); }
+
+		T result = _move(m_data[--m_count]);
+		terminate();
+		return result;
+	}
+
+	/* the room to grow to when full: double, and enough for one more and the one after */
+	T2 growth() const { return (m_size*2 > m_count+2) ? m_size*2 : m_count+2; }
+	/* moves the objects to a new buffer of count objects, and returns the old one to be deleted */
+	T* grow(const T2& count){
+		T* buffer = new T[count];
+		for(T2 i =0;i<m_size; i++){ buffer[i] = _move(m_data[i]); }
+		T* old = m_data;
+		m_data = buffer;
+		m_size = count;
+		return old;
+	}
+	/* ends a string with a 0 after its last char, other arrays are left as they are */
+	void terminate(){ if(_string_char<T>::value && m_count < m_size){ m_data[m_count] = T(); } }
+};
+
+typedef _array<char>    _string;
+
+/* pooled objects - a fixed set of objects handed out and given back in constant time.
+   the slots in use are also kept in a dense list, so they can be walked without the free ones. */
+template <typename T,typename T2 = uint32_t >
+struct _pool {
+
+	T *  m_data;     /* the objects, one per slot */
+	T2   m_size;     /* the number of slots */
+	T2 * m_free;     /* the free slots, a stack taken from the top */
+	T2   m_free_count;
+	T2 * m_active;   /* the slots in use, in no particular order */
+	T2   m_count;    /* the number of slots in use */
+	T2 * m_place;    /* where each slot in use is in m_active */
+
+	~_pool(){ clear(); }
+	_pool() : m_data(NULL),m_size(0),m_free(NULL),m_free_count(0),m_active(NULL),m_count(0),m_place(NULL) {}
+
+	void clear() {
+		if(m_data){
+			delete [] m_data;   m_data = NULL;
+			delete [] m_free;   m_free = NULL;
+			delete [] m_active; m_active = NULL;
+			delete [] m_place;  m_place = NULL;
+			m_size=m_free_count=m_count=0;
+		}
+	}
+	/* makes the given number of slots, all free. the objects are default constructed, not zeroed */
+	void alloc(const T2& size){
+		clear();
+		m_data   = new T[size];
+		m_free   = new T2[size];
+		m_active = new T2[size];
+		m_place  = new T2[size];
+		m_size   = size;
+		/* lower slots are handed out first */
+		for(T2 i=0;i<size;i++){ m_free[i] = size-1-i; m_place[i] = size; }
+		m_free_count = size;
+	}
+	/* takes a free slot and returns it, or m_size when there are none left */
+	T2 acquire(){
+		if(m_free_count==0){ return m_size; }
+
+		T2 slot = m_free[--m_free_count];
+		m_place[slot] = m_count;
+		m_active[m_count++] = slot;
+		return slot;
+	}
+	/* tells whether the slot is in use */
+	bool inuse(const T2& slot) const { return slot < m_size && m_place[slot] < m_count && m_active[ m_place[slot] ] == slot; }
+	/* gives a slot back. the last slot in use takes its place in m_active, so walk m_active
+	   backwards when releasing slots along the way. a slot that is not in use is left alone,
+	   returning false, as giving it back twice would put it on the free stack twice */
+	bool release(const T2& slot){
+		assert(inuse(slot));
+		if(!inuse(slot)){ return false; }
+
+		T2 place = m_place[slot];
+		T2 last  = m_active[--m_count];
+		m_active[place] = last;
+		m_place[last]   = place;
+		m_place[slot]   = m_size;
+		m_free[m_free_count++] = slot;
+		return true;
+	}
+	T2 slot(const T* object) const { return T2(object-m_data); }
+	/* the object of the given slot */
+	T& operator [](const T2& slot){ return m_data[slot]; }
+	const T& operator [](const T2& slot) const { return m_data[slot]; }
+	/* the object of the given place in the list of slots in use */
+	T& active(const T2& index){ return m_data[ m_active[index] ]; }
+	const T& active(const T2& index) const { return m_data[ m_active[index] ]; }
+};
+
+/** struct typedefs ****************************/
+typedef _vector2<float> _vec2;
+typedef _vector3<float> _vec3;
+typedef _vector4<float> _vec4;
+
+typedef _matrix3<float> _mat3;
+typedef _matrix4<float> _mat4;
+typedef _affine<float>  _aff;
+
+typedef _array<float>   _float_array;
+typedef _array<int32_t> _int_array;
+typedef _array<_string> _string_array;
+
+typedef _array<_mat4>          _matrix_array;
+typedef _array<_matrix_array>  _transform_array;
+/***********************************************/
+
+#ifdef core_has_constexpr
+/* compile time checks of the constexpr maths **************************/
+static_assert(_dot(_vec3(1.0f,2.0f,3.0f), _vec3(4.0f,5.0f,6.0f)) == 32.0f, "_dot");
+static_assert(_cross(_vec3(1.0f,0.0f,0.0f), _vec3(0.0f,1.0f,0.0f)).z == 1.0f, "_cross");
+static_assert((_vec3(1.0f,2.0f,3.0f) - _vec3(1.0f,1.0f,1.0f) * 2.0f).x == -1.0f, "vector operators");
+static_assert(_quaternion().r == 1.0f && _quaternion(0.0f,1.0f,0.0f,0.0f).i == 1.0f, "quaternion constructors");
+
+static_assert(_translate(_vec3(1.0f,2.0f,3.0f)).m_data[3].y == 2.0f && _translate(_vec3(1.0f,2.0f,3.0f)).m_data[3].w == 1.0f, "_translate");
+static_assert(_scale(_vec3(2.0f,3.0f,4.0f)).m_data[2].z == 4.0f && _scale(_vec3(2.0f,3.0f,4.0f)).m_data[3].w == 1.0f, "_scale");
+
+/* scaled, then moved: the scale stays on the axes and the move is untouched */
+static_assert(_multiply(_scale(_vec3(2.0f,2.0f,2.0f)), _translate(_vec3(5.0f,0.0f,0.0f))).m_data[0].x == 2.0f &&
+              _multiply(_scale(_vec3(2.0f,2.0f,2.0f)), _translate(_vec3(5.0f,0.0f,0.0f))).m_data[3].x == 5.0f, "_multiply");
+
+/* a quarter turn about z takes x to y */
+static_assert(_rotate(1.0f, 0.0f, _vec3(0.0f,0.0f,1.0f)).m_data[0].y == 1.0f &&
+              _rotate(1.0f, 0.0f, _vec3(0.0f,0.0f,1.0f)).m_data[1].x == -1.0f, "_rotate");
+
+/* a quarter turn about z, then a move along x */
+static_assert((_aff(_vec3(0.0f,1.0f,0.0f), _vec3(-1.0f,0.0f,0.0f), _vec3(0.0f,0.0f,1.0f), _vec3(3.0f,0.0f,0.0f)) * _vec3(1.0f,0.0f,0.0f)).x == 3.0f &&
+              (_aff(_vec3(0.0f,1.0f,0.0f), _vec3(-1.0f,0.0f,0.0f), _vec3(0.0f,0.0f,1.0f), _vec3(3.0f,0.0f,0.0f)) * _vec3(1.0f,0.0f,0.0f)).y == 1.0f, "_affine");
+static_assert(_aff(_vec3(0.0f,1.0f,0.0f), _vec3(-1.0f,0.0f,0.0f), _vec3(0.0f,0.0f,1.0f), _vec3(3.0f,0.0f,0.0f)).transforminverse(_vec3(3.0f,1.0f,0.0f)).x == 1.0f, "_affine inverse");
+static_assert(_aff(_vec3(0.0f,1.0f,0.0f), _vec3(-1.0f,0.0f,0.0f), _vec3(0.0f,0.0f,1.0f), _vec3(3.0f,0.0f,0.0f)).tomatrix4().m_data[3].w == 1.0f, "tomatrix4");
+/***********************************************************************/
+#endif
@@ -1,160 +1,211 @@
-#pragma once
-
-#include "application_header.h"
-#include "physics.h"
-
-/** forward declaration  */
-struct ui;
-struct ui_text;
-struct ui_static;
-struct ui_button;
-
-struct ui_control;
-
-struct camera;
-
-struct the_room;
-struct object_485;
-/*************************/
-
-
-enum shotstate { UNUSED = 0, FIREING };
-struct ammo_round : public collision_sphere {
-
-	float m_update_time;
-	shotstate m_type;
-
-	ammo_round()  { m_body = new rigid_body; }
-
-	~ammo_round() { delete m_body; }
-
-	// sets the properties of the round
-	void setstate();
-};
-
-
-#define box_count 10
-
-struct box : public collision_box {
-
-	bool m_is_over_lapping;
-
-	box()  { m_body = new rigid_body(); }
-
-	~box() { delete m_body; }
-
-	/** sets the box to a specific location. */
-	void setstate(const _vec3 &position,
-		const _quaternion &orientation,
-		const _vec3 &extents,
-		const _vec3 &velocity)
-	{
-		m_body->setposition(position);
-		m_body->setorientation(orientation);
-		m_body->setvelocity(velocity);
-		m_body->setrotation( _vec3(0,0,0) );
-		m_half_size = extents;
-
-		float mass = m_half_size.x * m_half_size.y * m_half_size.z * 8.0f;
-		m_body->setmass(mass);
-
-
-		_mat3 tensor;
-		tensor.setblockinertiatensor( m_half_size , mass);
-		m_body->setinertiatensor(tensor);
-
-		m_body->setlineardamping(0.95f);
-		m_body->setangulardamping(0.8f);
-		m_body->clearaccumulators();
-		m_body->setacceleration(0,-10.0f,0);
-
-		m_body->setawake();
-
-		m_body->calculatederiveddata();
-	}
-
-	static _vec4 * s_box_colors;
-};
-
-#define _scene_aim  0x01
-#define _scene_menu 0x02
-
-struct scene_manager : public application_object {
-
-	scene_manager();
-
-	virtual bool init();
-	virtual void clear();
-	virtual bool update();
-	virtual void onlostdevice();
-	virtual void onresetdevice();
-
-	virtual void msgproc(UINT msg, WPARAM wParam, LPARAM lParam);
-
-	bool loadmesh( _mesh * mesh, int id);
-
-	/* global object array */
-	_array<application_object*> m_object_array;
-	/**********************************************************/
-
-	object_485 * m_485;
-	the_room   * m_the_room;
-
-
-	/* global ui class */
-	ui * m_ui;
-
-	/***** ui control pointers*/
-	ui_static * m_cross_hair_1;
-	ui_static * m_cross_hair_2;
-
-	ui_static * m_fps_control;
-	ui_text   * m_directions;
-	ui_button * m_continue;
-	ui_button * m_vsync;
-	ui_button * m_fullscreen;
-	ui_button * m_exit;
-	/**************************/
-
-	/* main camera; */
-	camera * m_camera;
-
-
-	/* physics... */
-
-	/** holds the maximum number of contacts. */
-	const static unsigned max_contacts = 256;
-
-	/** holds the array of contacts. */
-	contact m_contacts[max_contacts];
-
-	/** holds the collision data structure for collision detection. */
-	collision_data m_cdata;
-
-	/** holds the contact resolver. */
-	contact_resolver m_resolver;
-
-	/**
-	* holds the maximum number of  rounds that can be
-	* fired.
-	*/
-	const static unsigned m_ammo_rounds = 1024;
-
-	/** 
-	* holds the particle data 
-	*/
-	ammo_round m_ammo[m_ammo_rounds];
-
-
-	box m_box_data[box_count];
-
-	/** processes the contact generation code. */
-	void generatecontacts();
-
-	/** processes the objects in the simulation forward in time. */
-	void updateobjects( float duration);
-
-	void reset();
-
-};
-
+#pragma once
+
+#include "application_header.h"
+#include "physics.h"
+
+/** forward declaration  */
+struct ui;
+struct ui_text;
+struct ui_static;
+struct ui_button;
+
+struct ui_control;
+
+struct camera;
+
+struct the_room;
+struct object_485;
+/*************************/
+
+
+#define round_radius 0.2f
+
+#define box_count 10
+
+/** the scene's boxes are made and owned by its physics world. */
+struct box {
+
+	/** sets the box to a specific location. */
+	static void setstate(collision_box *box_,
+		const _vec3 &position,
+		const _quaternion &orientation,
+		const _vec3 &extents,
+		const _vec3 &velocity)
+	{
+		rigid_body *body = box_->m_body;
+		body->setposition(position);
+		body->setorientation(orientation);
+		body->setvelocity(velocity);
+		body->setrotation( _vec3(0,0,0) );
+		box_->m_half_size = extents;
+
+		float mass = extents.x * extents.y * extents.z * 8.0f;
+		body->setmass(mass);
+
+
+		_mat3 tensor;
+		tensor.setblockinertiatensor( extents , mass);
+		body->setinertiatensor(tensor);
+
+		body->setlineardamping(0.95f);
+		body->setangulardamping(0.8f);
+		body->clearaccumulators();
+		body->setacceleration(0,-10.0f,0);
+
+		body->setawake();
+
+		body->calculatederiveddata();
+		body->storeprevious();
+	}
+
+	static _vec4 * s_box_colors;
+};
+
+#define _scene_aim  0x01
+#define _scene_menu 0x02
+#define _scene_round_collisions 0x04
+#define _scene_continuous 0x08
+#define _scene_hitscan 0x10
+
+/**
+* the collision categories of the scene's primitives. a round's mask
+* holds _category_round only while rounds collide with each other.
+*/
+#define _category_box       0x01
+#define _category_character 0x02
+#define _category_round     0x04
+
+/** how far a hitscan shot reaches. */
+#define hitscan_range 256.0f
+
+/** the impulse a hitscan shot gives, the momentum of a round. */
+#define hitscan_impulse 4000.0f
+
+/** the default length of a physics step, in seconds. */
+#define physics_step (1.0f/60.0f)
+
+/** the most physics steps run for one frame. */
+#define physics_max_substeps 8
+
+struct scene_manager : public application_object {
+
+	scene_manager();
+
+	virtual bool init();
+	virtual void clear();
+	virtual bool update();
+	virtual void onlostdevice();
+	virtual void onresetdevice();
+
+	virtual void msgproc(UINT msg, WPARAM wParam, LPARAM lParam);
+
+	bool loadmesh( _mesh * mesh, int id);
+
+	/* global object array */
+	_array<application_object*> m_object_array;
+	/**********************************************************/
+
+	object_485 * m_485;
+	the_room   * m_the_room;
+
+
+	/* global ui class */
+	ui * m_ui;
+
+	/***** ui control pointers*/
+	ui_static * m_cross_hair_1;
+	ui_static * m_cross_hair_2;
+
+	ui_static * m_fps_control;
+	ui_text   * m_directions;
+	ui_button * m_continue;
+	ui_button * m_vsync;
+	ui_button * m_fullscreen;
+	ui_button * m_exit;
+	/**************************/
+
+	/* main camera; */
+	camera * m_camera;
+
+
+	/* physics... */
+
+	/** holds the number of contacts room is made for up front. */
+	const static unsigned max_contacts = 256;
+
+	/**
+	* holds the most contacts the collision data may grow to, those
+	* found past it are dropped and counted.
+	*/
+	const static unsigned contact_limit = 16384;
+
+	/**
+	* holds the boxes, the rounds, the floor and walls of the room,
+	* and their contacts and resolver. the scene steps it a call at a
+	* time, so the solve can be timed on its own.
+	*/
+	physics_world m_world;
+
+	/** casts rays into the boxes and the room, for hitscan shots. */
+	collision_query m_query;
+
+	/**
+	* holds the length of each physics step, in seconds. the physics
+	* always advances by this amount, whatever the frame rate.
+	*/
+	float m_physics_step;
+
+	/** holds the frame time not yet simulated. */
+	float m_accumulator;
+
+	/**
+	* holds how far the frame is between the last two physics steps,
+	* from 0 to 1, used to blend the drawn transforms.
+	*/
+	float m_interpolation;
+
+	/** holds the number of physics steps run in the last frame. */
+	uint32_t m_substeps;
+
+	/** holds the frame time thrown away because a frame needed too many steps. */
+	float m_dropped_seconds;
+
+	/**
+	* holds the contacts found in the last step, and how many were
+	* kept by manifold reduction and the room left for them.
+	*/
+	uint32_t m_contacts_found;
+	uint32_t m_contacts_kept;
+
+	/** counts the contacts dropped because the collision data was full. */
+	uint32_t m_contact_overflow;
+
+	/** holds the time spent resolving contacts, and the steps it was spent over, since the stats were last shown. */
+	float m_solve_seconds;
+	uint32_t m_solve_steps;
+
+	/**
+	* holds the maximum number of  rounds that can be
+	* fired. the world keeps them in m_world.m_rounds.
+	*/
+	const static unsigned m_ammo_rounds = 1024;
+
+	/** holds the scene's boxes, made by the world, the character's first. */
+	collision_box * m_box_data[box_count];
+
+	/**
+	* fires a shot that hits at once along the aim, pushing the first
+	* box in its way instead of launching a round.
+	*/
+	void firehitscan();
+
+	/** the categories a round collides with, given the scene's flags. */
+	uint32_t roundmask();
+
+	/** processes the objects in the simulation forward in time. */
+	void updateobjects( float duration);
+
+	void reset();
+
+};
+
@@ -1,361 +1,781 @@
-#include "body.h"
-
-#include <memory.h>
-
-
-/**
-* Internal function to do an intertia tensor transform
-*/
-static inline void _transforminertiatensor(
-	_mat3 &iitworld,
-	const _mat3 &iitbody,
-	const _mat4 &rotmat) {
-
-		float t4  = rotmat[0][0]*iitbody[0][0] + rotmat[1][0]*iitbody[0][1] + rotmat[2][0]*iitbody[0][2];
-		float t9  = rotmat[0][0]*iitbody[1][0] + rotmat[1][0]*iitbody[1][1] + rotmat[2][0]*iitbody[1][2];
-		float t14 = rotmat[0][0]*iitbody[2][0] + rotmat[1][0]*iitbody[2][1] + rotmat[2][0]*iitbody[2][2];
-		float t28 = rotmat[0][1]*iitbody[0][0] + rotmat[1][1]*iitbody[0][1] + rotmat[2][1]*iitbody[0][2]; 
-		float t33 = rotmat[0][1]*iitbody[1][0] + rotmat[1][1]*iitbody[1][1] + rotmat[2][1]*iitbody[1][2];
-		float t38 = rotmat[0][1]*iitbody[2][0] + rotmat[1][1]*iitbody[2][1] + rotmat[2][1]*iitbody[2][2];
-		float t52 = rotmat[0][2]*iitbody[0][0] + rotmat[1][2]*iitbody[0][1] + rotmat[2][2]*iitbody[0][2];
-		float t57 = rotmat[2][2]*iitbody[1][0] + rotmat[1][2]*iitbody[1][1] + rotmat[2][2]*iitbody[1][2];
-		float t62 = rotmat[0][2]*iitbody[2][0] + rotmat[1][2]*iitbody[2][1] + rotmat[2][2]*iitbody[2][2];
-
-		iitworld[0][0] = t4*rotmat[0][0]  + t9*rotmat[1][0]  + t14*rotmat[2][0];
-		iitworld[1][0] = t4*rotmat[0][1]  + t9*rotmat[1][1]  + t14*rotmat[2][1];
-		iitworld[2][0] = t4*rotmat[0][2]  + t9*rotmat[1][2]  + t14*rotmat[2][2];
-		iitworld[0][1] = t28*rotmat[0][0] + t33*rotmat[1][0] + t38*rotmat[2][0];
-		iitworld[1][1] = t28*rotmat[0][1] + t33*rotmat[1][1] + t38*rotmat[2][1];
-		iitworld[2][1] = t28*rotmat[0][2] + t33*rotmat[1][2] + t38*rotmat[2][2];
-		iitworld[0][2] = t52*rotmat[0][0] + t57*rotmat[1][0] + t62*rotmat[2][0];
-		iitworld[1][2] = t52*rotmat[0][1] + t57*rotmat[1][1] + t62*rotmat[2][1];
-		iitworld[2][2] = t52*rotmat[0][2] + t57*rotmat[1][2] + t62*rotmat[2][2];
-}
-
-/**
-* Inline function that creates a transform matrix from a position
-*/
-static inline void _calculatetransformmatrix(_mat4 &transformmatrix,
-	const _vec3 &position,
-	const _quaternion &orientation) {
-		transformmatrix[0][0] = 1-2*orientation.j*orientation.j  - 2*orientation.k*orientation.k;
-		transformmatrix[1][0] = 2*orientation.i*orientation.j    - 2*orientation.r*orientation.k;
-		transformmatrix[2][0] = 2*orientation.i*orientation.k    + 2*orientation.r*orientation.j;
-		transformmatrix[3][0] = position.x;
-
-		transformmatrix[0][1] = 2*orientation.i*orientation.j    + 2*orientation.r*orientation.k;
-		transformmatrix[1][1] = 1-2*orientation.i*orientation.i  - 2*orientation.k*orientation.k;
-		transformmatrix[2][1] = 2*orientation.j*orientation.k    - 2*orientation.r*orientation.i;
-		transformmatrix[3][1] = position.y;
-
-		transformmatrix[0][2] = 2*orientation.i*orientation.k    - 2*orientation.r*orientation.j;
-		transformmatrix[1][2] = 2*orientation.j*orientation.k    + 2*orientation.r*orientation.i;
-		transformmatrix[2][2] = 1-2*orientation.i*orientation.i - 2*orientation.j*orientation.j;
-		transformmatrix[3][2] = position.z;
-}
-
-void rigid_body::calculatederiveddata() {
-
-	m_orientation.normalise();
-
-	// Calculate the transform matrix for the body.
-	_calculatetransformmatrix(m_transform_matrix, m_position, m_orientation);
-
-	// Calculate the inertiaTensor in world space.
-	_transforminertiatensor(
-		m_inverse_inertia_tensor_world,
-		m_inverse_inertia_tensor,
-		m_transform_matrix);
-
-}
-
-void rigid_body::integrate(float duration) {
-
-	if (!m_isawake) { return; }
-
-	// calculate linear acceleration from force inputs.
-	m_last_frame_acceleration = m_acceleration;
-	m_last_frame_acceleration.addscaledvector( m_force_accumulated, m_inverse_mass );
-
-	// calculate angular acceleration from torque inputs.
-	_vec3 angularacceleration = m_inverse_inertia_tensor_world * m_torque_accumulated ;
-
-	// adjust velocities
-	// update linear velocity from both acceleration and impulse.
-	m_velocity.addscaledvector(m_last_frame_acceleration, duration);
-
-	// update angular velocity from both acceleration and impulse.
-	m_rotation.addscaledvector(angularacceleration, duration);
-
-	// impose drag.
-	m_velocity *= pow( m_linear_damping , duration);
-	m_rotation *= pow( m_angular_damping, duration);
-
-	// adjust positions
-	// update linear position.
-	m_position.addscaledvector(m_velocity, duration);
-
-	// update angular position.
-	m_orientation.addscaledvector(m_rotation, duration);
-
-	// normalise the orientation, and update the matrices with the new
-	// position and orientation
-	calculatederiveddata();
-
-	// clear accumulators.
-	clearaccumulators();
-
-	// update the kinetic energy store, and possibly put the body to
-	// sleep.
-	if (m_cansleep) {
-		float currentmotion = _dot(m_velocity,m_velocity) + _dot(m_rotation,m_rotation);
-
-		float bias = pow(0.5f, duration);
-		m_motion = bias*m_motion + (1-bias)*currentmotion;
-
-		if ( m_motion<_sleepepsilon ) { setawake(false); }
-		else if (m_motion > 10 * _sleepepsilon) { m_motion = 10 * _sleepepsilon; }
-	}
-}
-
-void rigid_body::setmass(const float mass) {
-	if(mass != 0) { m_inverse_mass = 1.0f/mass; }
-}
-
-float rigid_body::getmass() const {
-	if (m_inverse_mass == 0) {
-		return FLT_MAX;
-	} else {
-		return 1.0f/m_inverse_mass;
-	}
-}
-
-void rigid_body::setinversemass(const float inversemass) { m_inverse_mass = inversemass; }
-
-float rigid_body::getinversemass() const { return m_inverse_mass; }
-
-bool rigid_body::hasfinitemass() const { return m_inverse_mass >= 0.0f; }
-
-void rigid_body::setinertiatensor(const _mat3 &inertiatensor) {
-	m_inverse_inertia_tensor.setinverse(inertiatensor);
-}
-
-void rigid_body::getinertiatensor(_mat3 *inertiatensor) const {
-	inertiatensor->setinverse(m_inverse_inertia_tensor);
-}
-
-_mat3 rigid_body::getinertiatensor() const {
-	_mat3 it;
-	getinertiatensor(&it);
-	return it;
-}
-
-void rigid_body::getinertiatensorworld(_mat3 *inertiatensor) const {
-	inertiatensor->setinverse( m_inverse_inertia_tensor_world );
-}
-
-_mat3 rigid_body::getinertiatensorworld() const {
-	_mat3 it;
-	getinertiatensorworld(&it);
-	return it;
-}
-
-void rigid_body::setinverseinertiatensor(const _mat3 &inverseinertiatensor) {
-	m_inverse_inertia_tensor = inverseinertiatensor;
-}
-
-void rigid_body::getinverseinertiatensor(_mat3 *inverseinertiatensor) const {
-	*inverseinertiatensor = m_inverse_inertia_tensor;
-}
-
-_mat3 rigid_body::getinverseinertiatensor() const { return m_inverse_inertia_tensor; }
-
-void rigid_body::getinverseinertiatensorworld(_mat3 *inverseinertiatensor) const {
-	*inverseinertiatensor = m_inverse_inertia_tensor_world;
-}
-
-_mat3 rigid_body::getinverseinertiatensorworld() const { return m_inverse_inertia_tensor_world; }
-
-void rigid_body::setdamping(const float lineardamping, const float angulardamping) {
-	m_linear_damping = lineardamping;
-	m_angular_damping = angulardamping;
-}
-
-void rigid_body::setlineardamping(const float lineardamping) { m_linear_damping = lineardamping; }
-
-float rigid_body::getlineardamping() const { return m_linear_damping; }
-
-void rigid_body::setangulardamping(const float angulardamping) { m_angular_damping = angulardamping; }
-
-float rigid_body::getangulardamping() const { return m_angular_damping; }
-
-void rigid_body::setposition(const _vec3 &position) { m_position = position; }
-
-void rigid_body::setposition(const float x, const float y, const float z) {
-	m_position.x = x;
-	m_position.y = y;
-	m_position.z = z;
-}
-
-void rigid_body::getposition(_vec3 *position) const { *position = m_position; }
-
-_vec3 rigid_body::getposition() const { return m_position; }
-
-void rigid_body::setorientation(const _quaternion &orientation) {
-	m_orientation = orientation;
-	m_orientation.normalise();
-}
-
-void rigid_body::setorientation(const float r, const float i, const float j, const float k) {
-	m_orientation.r = r;
-	m_orientation.i = i;
-	m_orientation.j = j;
-	m_orientation.k = k;
-	m_orientation.normalise();
-}
-
-void rigid_body::getorientation(_quaternion *orientation) const { *orientation = m_orientation; }
-
-_quaternion rigid_body::getorientation() const { return m_orientation; }
-
-void rigid_body::getorientation(_mat3 *matrix) const {
-	getorientation( (float*)matrix->m_data );
-}
-
-void rigid_body::getorientation(float matrix[9]) const {
-
-	matrix[0] = m_transform_matrix[0][0];
-	matrix[1] = m_transform_matrix[1][0];
-	matrix[2] = m_transform_matrix[2][0];
-
-	matrix[3] = m_transform_matrix[0][1];
-	matrix[4] = m_transform_matrix[1][1];
-	matrix[5] = m_transform_matrix[2][1];
-
-	matrix[6] = m_transform_matrix[0][2];
-	matrix[7] = m_transform_matrix[1][2];
-	matrix[8] = m_transform_matrix[2][2];
-}
-
-void rigid_body::gettransform(_mat4 *transform) const {
-	memcpy(transform, &m_transform_matrix.m_data, sizeof(_mat4)); }
-
-void rigid_body::gettransform(float matrix[16]) const
-{
-	memcpy(matrix, m_transform_matrix.m_data, sizeof(float)*12);
-	matrix[12] = matrix[13] = matrix[14] = 0;
-	matrix[15] = 1;
-}
-
-_mat4 rigid_body::gettransform() const { return m_transform_matrix; }
-
-_vec3 rigid_body::getpointinlocalspace(const _vec3 &point) const {
-	return m_transform_matrix.transforminverse(point);
-}
-
-_vec3 rigid_body::getpointinworldspace(const _vec3 &point) const {
-	return m_transform_matrix* point;
-}
-
-_vec3 rigid_body::getdirectioninlocalspace(const _vec3 &direction) const {
-	return m_transform_matrix.transforminversedirection(direction);
-}
-
-_vec3 rigid_body::getdirectioninworldspace(const _vec3 &direction) const {
-	return m_transform_matrix.transformdirection(direction);
-}
-
-void rigid_body::setvelocity(const _vec3 &velocity) { m_velocity = velocity; }
-
-void rigid_body::setvelocity(const float x, const float y, const float z) {
-	m_velocity.x = x;
-	m_velocity.y = y;
-	m_velocity.z = z;
-}
-
-void rigid_body::getvelocity(_vec3 *velocity) const { *velocity = m_velocity; }
-
-_vec3 rigid_body::getvelocity() const { return m_velocity; }
-
-void rigid_body::addvelocity(const _vec3 &deltavelocity) { m_velocity += deltavelocity; }
-
-void rigid_body::setrotation(const _vec3 &rotation) { m_rotation = rotation; }
-
-void rigid_body::setrotation(const float x, const float y, const float z) {
-	m_rotation.x = x;
-	m_rotation.y = y;
-	m_rotation.z = z;
-}
-
-void rigid_body::getrotation(_vec3 *rotation) const { *rotation = m_rotation; }
-
-_vec3 rigid_body::getrotation() const { return m_rotation; }
-
-void rigid_body::addrotation(const _vec3 &deltarotation) { m_rotation += deltarotation; }
-
-void rigid_body::setawake(const bool awake) {
-	if (awake) {
-		m_isawake= true;
-
-		// add a bit of motion to avoid it falling asleep immediately.
-		m_motion = _sleepepsilon*2.0f;
-	} else {
-		m_isawake = false;
-		m_velocity.clear();
-		m_rotation.clear();
-	}
-}
-
-void rigid_body::setcansleep(const bool cansleep) {
-	m_cansleep = cansleep;
-	if (!cansleep && !m_isawake) { setawake(); }
-}
-
-void rigid_body::getlastframeacceleration(_vec3 *acceleration) const { *acceleration = m_last_frame_acceleration; }
-
-_vec3 rigid_body::getlastframeacceleration() const { return m_last_frame_acceleration; }
-
-void rigid_body::clearaccumulators() {
-	m_force_accumulated.clear();
-	m_torque_accumulated.clear();
-}
-
-void rigid_body::addforce(const _vec3 &force) {
-	m_force_accumulated += force;
-	m_isawake = true;
-}
-
-void rigid_body::addforceatbodypoint(const _vec3 &force, const _vec3 &point) {
-	// convert to coordinates relative to center of mass.
-	_vec3 pt = getpointinworldspace(point);
-	addforceatpoint(force, pt);
-
-}
-
-void rigid_body::addforceatpoint(const _vec3 &force, const _vec3 &point) {
-	// convert to coordinates relative to center of mass.
-	_vec3 pt = point;
-	pt -= m_position;
-
-	m_force_accumulated += force;
-	m_torque_accumulated += _cross(pt,force);
-
-	m_isawake = true;
-}
-
-void rigid_body::addtorque(const _vec3 &torque) {
-	m_torque_accumulated += torque;
-	m_isawake = true;
-}
-
-void rigid_body::setacceleration(const _vec3 &acceleration) { m_acceleration = acceleration; }
-
-void rigid_body::setacceleration(const float x, const float y, const float z) {
-	m_acceleration.x = x;
-	m_acceleration.y = y;
-	m_acceleration.z = z;
-}
-
-void rigid_body::getacceleration(_vec3 *acceleration) const { *acceleration = m_acceleration; }
-
-_vec3 rigid_body::getacceleration() const { return m_acceleration; }
+#include "body.h"
+
+#include <memory.h>
+
+#ifdef physics_simd
+#include <emmintrin.h>
+#endif
+
+float physics_sleepepsilon = 0.33f;
+
+
+/**
+* Internal function to do an intertia tensor transform
+*/
+static inline void _transforminertiatensor(
+	_mat3 &iitworld,
+	const _mat3 &iitbody,
+	const _aff &rotmat) {
+
+		float t4  = rotmat[0][0]*iitbody[0][0] + rotmat[1][0]*iitbody[0][1] + rotmat[2][0]*iitbody[0][2];
+		float t9  = rotmat[0][0]*iitbody[1][0] + rotmat[1][0]*iitbody[1][1] + rotmat[2][0]*iitbody[1][2];
+		float t14 = rotmat[0][0]*iitbody[2][0] + rotmat[1][0]*iitbody[2][1] + rotmat[2][0]*iitbody[2][2];
+		float t28 = rotmat[0][1]*iitbody[0][0] + rotmat[1][1]*iitbody[0][1] + rotmat[2][1]*iitbody[0][2]; 
+		float t33 = rotmat[0][1]*iitbody[1][0] + rotmat[1][1]*iitbody[1][1] + rotmat[2][1]*iitbody[1][2];
+		float t38 = rotmat[0][1]*iitbody[2][0] + rotmat[1][1]*iitbody[2][1] + rotmat[2][1]*iitbody[2][2];
+		float t52 = rotmat[0][2]*iitbody[0][0] + rotmat[1][2]*iitbody[0][1] + rotmat[2][2]*iitbody[0][2];
+		float t57 = rotmat[2][2]*iitbody[1][0] + rotmat[1][2]*iitbody[1][1] + rotmat[2][2]*iitbody[1][2];
+		float t62 = rotmat[0][2]*iitbody[2][0] + rotmat[1][2]*iitbody[2][1] + rotmat[2][2]*iitbody[2][2];
+
+		iitworld[0][0] = t4*rotmat[0][0]  + t9*rotmat[1][0]  + t14*rotmat[2][0];
+		iitworld[1][0] = t4*rotmat[0][1]  + t9*rotmat[1][1]  + t14*rotmat[2][1];
+		iitworld[2][0] = t4*rotmat[0][2]  + t9*rotmat[1][2]  + t14*rotmat[2][2];
+		iitworld[0][1] = t28*rotmat[0][0] + t33*rotmat[1][0] + t38*rotmat[2][0];
+		iitworld[1][1] = t28*rotmat[0][1] + t33*rotmat[1][1] + t38*rotmat[2][1];
+		iitworld[2][1] = t28*rotmat[0][2] + t33*rotmat[1][2] + t38*rotmat[2][2];
+		iitworld[0][2] = t52*rotmat[0][0] + t57*rotmat[1][0] + t62*rotmat[2][0];
+		iitworld[1][2] = t52*rotmat[0][1] + t57*rotmat[1][1] + t62*rotmat[2][1];
+		iitworld[2][2] = t52*rotmat[0][2] + t57*rotmat[1][2] + t62*rotmat[2][2];
+}
+
+/**
+* Inline function that creates a transform matrix from a position
+*/
+static inline void _calculatetransformmatrix(_aff &transformmatrix,
+	const _vec3 &position,
+	const _quaternion &orientation) {
+		transformmatrix[0][0] = 1-2*orientation.j*orientation.j  - 2*orientation.k*orientation.k;
+		transformmatrix[1][0] = 2*orientation.i*orientation.j    - 2*orientation.r*orientation.k;
+		transformmatrix[2][0] = 2*orientation.i*orientation.k    + 2*orientation.r*orientation.j;
+		transformmatrix[3][0] = position.x;
+
+		transformmatrix[0][1] = 2*orientation.i*orientation.j    + 2*orientation.r*orientation.k;
+		transformmatrix[1][1] = 1-2*orientation.i*orientation.i  - 2*orientation.k*orientation.k;
+		transformmatrix[2][1] = 2*orientation.j*orientation.k    - 2*orientation.r*orientation.i;
+		transformmatrix[3][1] = position.y;
+
+		transformmatrix[0][2] = 2*orientation.i*orientation.k    - 2*orientation.r*orientation.j;
+		transformmatrix[1][2] = 2*orientation.j*orientation.k    + 2*orientation.r*orientation.i;
+		transformmatrix[2][2] = 1-2*orientation.i*orientation.i - 2*orientation.j*orientation.j;
+		transformmatrix[3][2] = position.z;
+}
+
+/**
+* these move one body's values between the pool's arrays and the
+* vector types the rest of the library works with.
+*/
+static inline _vec3 _loadvector(const soa_vec3 &v, uint32_t i) { return _vec3(v.m_x[i], v.m_y[i], v.m_z[i]); }
+
+static inline void _storevector(const soa_vec3 &v, uint32_t i, const _vec3 &value) {
+	v.m_x[i] = value.x;
+	v.m_y[i] = value.y;
+	v.m_z[i] = value.z;
+}
+
+static inline _quaternion _loadquaternion(const soa_quaternion &q, uint32_t i) {
+	return _quaternion(q.m_r[i], q.m_i[i], q.m_j[i], q.m_k[i]);
+}
+
+static inline void _storequaternion(const soa_quaternion &q, uint32_t i, const _quaternion &value) {
+	q.m_r[i] = value.r;
+	q.m_i[i] = value.i;
+	q.m_j[i] = value.j;
+	q.m_k[i] = value.k;
+}
+
+static inline _mat3 _loadmatrix(float * const m[9], uint32_t i) {
+	_mat3 matrix;
+	for (uint32_t r = 0; r < 3; r++) {
+		for (uint32_t c = 0; c < 3; c++) { matrix[r][c] = m[r*3+c][i]; }
+	}
+	return matrix;
+}
+
+static inline void _storematrix(float * const m[9], uint32_t i, const _mat3 &matrix) {
+	for (uint32_t r = 0; r < 3; r++) {
+		for (uint32_t c = 0; c < 3; c++) { m[r*3+c][i] = matrix[r][c]; }
+	}
+}
+
+/**
+* works out the transform and the world space inverse inertia tensor
+* of a body from its position and orientation.
+*/
+static inline void _derive(rigid_body_pool *pool, uint32_t i) {
+
+	// Calculate the transform matrix for the body.
+	_calculatetransformmatrix(pool->m_transform_matrix[i],
+		_loadvector(pool->m_position, i),
+		_loadquaternion(pool->m_orientation, i));
+
+	// Calculate the inertiaTensor in world space.
+	_mat3 world;
+	_transforminertiatensor(world, pool->m_inverse_inertia_tensor[i], pool->m_transform_matrix[i]);
+	_storematrix(pool->m_inverse_inertia_tensor_world, i, world);
+}
+
+rigid_body_pool::rigid_body_pool() {
+	m_capacity = 0;
+	m_count    = 0;
+	m_bodies   = NULL;
+}
+
+rigid_body_pool::~rigid_body_pool() { destroy(); }
+
+/**
+* the arrays of floats held by the pool. they are allocated, cleared
+* and freed together.
+*/
+#define pool_float_arrays 40
+
+static void _floatarrays(rigid_body_pool *pool, float **arrays[pool_float_arrays]) {
+	soa_vec3 *vectors[] = {
+		&pool->m_position, &pool->m_velocity, &pool->m_rotation, &pool->m_force_accumulated,
+		&pool->m_torque_accumulated, &pool->m_acceleration, &pool->m_last_frame_acceleration };
+
+	uint32_t n = 0;
+	arrays[n++] = &pool->m_inverse_mass;
+	arrays[n++] = &pool->m_linear_damping;
+	arrays[n++] = &pool->m_angular_damping;
+	arrays[n++] = &pool->m_linear_factor;
+	arrays[n++] = &pool->m_angular_factor;
+	arrays[n++] = &pool->m_motion;
+	arrays[n++] = &pool->m_orientation.m_r;
+	arrays[n++] = &pool->m_orientation.m_i;
+	arrays[n++] = &pool->m_orientation.m_j;
+	arrays[n++] = &pool->m_orientation.m_k;
+	for (uint32_t i = 0; i < 9; i++) { arrays[n++] = &pool->m_inverse_inertia_tensor_world[i]; }
+	for (uint32_t i = 0; i < sizeof(vectors)/sizeof(vectors[0]); i++) {
+		arrays[n++] = &vectors[i]->m_x;
+		arrays[n++] = &vectors[i]->m_y;
+		arrays[n++] = &vectors[i]->m_z;
+	}
+}
+
+bool rigid_body_pool::create(uint32_t capacity) {
+	destroy();
+
+	m_capacity = (capacity + 3) & ~3u;
+	m_count    = 0;
+	m_factor_duration = 0;
+
+	float **arrays[pool_float_arrays];
+	_floatarrays(this, arrays);
+	for (uint32_t i = 0; i < pool_float_arrays; i++) {
+		*arrays[i] = new float[m_capacity];
+		memset(*arrays[i], 0, sizeof(float)*m_capacity);
+	}
+
+	m_isawake    = new bool[m_capacity];
+	m_cansleep   = new bool[m_capacity];
+	m_continuous = new bool[m_capacity];
+	memset(m_isawake,    0, m_capacity);
+	memset(m_cansleep,   0, m_capacity);
+	memset(m_continuous, 0, m_capacity);
+
+	m_island_next = new uint32_t[m_capacity];
+	m_in_island   = new bool[m_capacity];
+	for (uint32_t i = 0; i < m_capacity; i++) { m_island_next[i] = i; }
+	memset(m_in_island, 0, m_capacity);
+
+	m_inverse_inertia_tensor = new _mat3[m_capacity];
+	m_transform_matrix       = new _aff[m_capacity];
+	m_previous_position      = new _vec3[m_capacity];
+	m_previous_orientation   = new _quaternion[m_capacity];
+
+	m_bodies = new rigid_body[m_capacity];
+	for (uint32_t i = 0; i < m_capacity; i++) {
+		m_bodies[i].m_pool   = this;
+		m_bodies[i].m_index  = i;
+		m_bodies[i].m_island = 0;
+	}
+	m_free.m_count = 0;
+	return true;
+}
+
+void rigid_body_pool::destroy() {
+	if (!m_bodies) { return; }
+
+	float **arrays[pool_float_arrays];
+	_floatarrays(this, arrays);
+	for (uint32_t i = 0; i < pool_float_arrays; i++) { delete [] *arrays[i]; }
+
+	delete [] m_isawake;
+	delete [] m_cansleep;
+	delete [] m_continuous;
+	delete [] m_island_next;
+	delete [] m_in_island;
+	delete [] m_inverse_inertia_tensor;
+	delete [] m_transform_matrix;
+	delete [] m_previous_position;
+	delete [] m_previous_orientation;
+	delete [] m_bodies;
+
+	m_bodies   = NULL;
+	m_capacity = 0;
+	m_count    = 0;
+	m_free.clear();
+}
+
+rigid_body *rigid_body_pool::allocate() {
+
+	uint32_t i;
+	if (m_free.m_count) { i = m_free[--m_free.m_count]; }
+	else if (m_count < m_capacity) { i = m_count++; }
+	else { application_error("rigid_body_pool full"); return NULL; }
+
+	rigid_body *body = &m_bodies[i];
+	body->setinversemass(0);
+	body->setinverseinertiatensor(_mat3());
+	body->setdamping(1.0f, 1.0f);
+	body->setposition(0, 0, 0);
+	body->setorientation(_quaternion());
+	body->setacceleration(0, 0, 0);
+	body->clearaccumulators();
+	body->setawake(false);
+	body->setcontinuous(false);
+	m_cansleep[i] = true;
+	m_motion[i] = 0;
+	m_last_frame_acceleration.m_x[i] = m_last_frame_acceleration.m_y[i] = m_last_frame_acceleration.m_z[i] = 0;
+	body->calculatederiveddata();
+	body->storeprevious();
+	return body;
+}
+
+void rigid_body_pool::release(rigid_body *body) {
+	// the rest of its island can't be left asleep on a body that's gone
+	wake(body->m_index);
+	body->setawake(false);
+	m_free.pushback(body->m_index, true);
+}
+
+void rigid_body_pool::integrate(float duration) {
+
+	// the damping factors only change with the step or the damping.
+	if (duration != m_factor_duration) {
+		for (uint32_t i = 0; i < m_count; i++) {
+			m_linear_factor[i]  = pow(m_linear_damping[i],  duration);
+			m_angular_factor[i] = pow(m_angular_damping[i], duration);
+		}
+		m_factor_duration = duration;
+	}
+
+#ifdef physics_simd
+	float bias = pow(0.5f, duration);
+
+	const __m128 dt     = _mm_set1_ps(duration);
+	const __m128 half   = _mm_set1_ps(0.5f);
+	const __m128 one    = _mm_set1_ps(1.0f);
+	const __m128 zero   = _mm_setzero_ps();
+	const __m128 keep   = _mm_set1_ps(bias);
+	const __m128 gain   = _mm_set1_ps(1-bias);
+	const __m128 limit  = _mm_set1_ps(10 * _sleepepsilon);
+	const __m128 tiny   = _mm_set1_ps(FLT_EPSILON);
+
+	for (uint32_t i = 0; i < m_count; i += 4) {
+
+		if (!(m_isawake[i] | m_isawake[i+1] | m_isawake[i+2] | m_isawake[i+3])) { continue; }
+
+		// the lanes of sleeping bodies are worked out too, but not stored.
+		const __m128 awake = _mm_castsi128_ps(_mm_set_epi32(
+			-int(m_isawake[i+3]), -int(m_isawake[i+2]), -int(m_isawake[i+1]), -int(m_isawake[i])));
+		const __m128 sleepy = _mm_and_ps(awake, _mm_castsi128_ps(_mm_set_epi32(
+			-int(m_cansleep[i+3]), -int(m_cansleep[i+2]), -int(m_cansleep[i+1]), -int(m_cansleep[i]))));
+
+#define pool_load(array)          _mm_loadu_ps((array) + i)
+#define pool_store(array, value)  _mm_storeu_ps((array) + i, _mm_or_ps(_mm_and_ps(awake, value), _mm_andnot_ps(awake, pool_load(array))))
+
+		// calculate linear acceleration from force inputs.
+		__m128 im = pool_load(m_inverse_mass);
+		__m128 ax = _mm_add_ps(pool_load(m_acceleration.m_x), _mm_mul_ps(pool_load(m_force_accumulated.m_x), im));
+		__m128 ay = _mm_add_ps(pool_load(m_acceleration.m_y), _mm_mul_ps(pool_load(m_force_accumulated.m_y), im));
+		__m128 az = _mm_add_ps(pool_load(m_acceleration.m_z), _mm_mul_ps(pool_load(m_force_accumulated.m_z), im));
+
+		// calculate angular acceleration from torque inputs.
+		__m128 tx = pool_load(m_torque_accumulated.m_x);
+		__m128 ty = pool_load(m_torque_accumulated.m_y);
+		__m128 tz = pool_load(m_torque_accumulated.m_z);
+		float * const *iw = m_inverse_inertia_tensor_world;
+		__m128 bx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, pool_load(iw[0])), _mm_mul_ps(ty, pool_load(iw[3]))), _mm_mul_ps(tz, pool_load(iw[6])));
+		__m128 by = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, pool_load(iw[1])), _mm_mul_ps(ty, pool_load(iw[4]))), _mm_mul_ps(tz, pool_load(iw[7])));
+		__m128 bz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, pool_load(iw[2])), _mm_mul_ps(ty, pool_load(iw[5]))), _mm_mul_ps(tz, pool_load(iw[8])));
+
+		// update the velocities, and impose drag.
+		__m128 lf = pool_load(m_linear_factor);
+		__m128 af = pool_load(m_angular_factor);
+		__m128 vx = _mm_mul_ps(_mm_add_ps(pool_load(m_velocity.m_x), _mm_mul_ps(ax, dt)), lf);
+		__m128 vy = _mm_mul_ps(_mm_add_ps(pool_load(m_velocity.m_y), _mm_mul_ps(ay, dt)), lf);
+		__m128 vz = _mm_mul_ps(_mm_add_ps(pool_load(m_velocity.m_z), _mm_mul_ps(az, dt)), lf);
+		__m128 wx = _mm_mul_ps(_mm_add_ps(pool_load(m_rotation.m_x), _mm_mul_ps(bx, dt)), af);
+		__m128 wy = _mm_mul_ps(_mm_add_ps(pool_load(m_rotation.m_y), _mm_mul_ps(by, dt)), af);
+		__m128 wz = _mm_mul_ps(_mm_add_ps(pool_load(m_rotation.m_z), _mm_mul_ps(bz, dt)), af);
+
+		// update linear position.
+		__m128 px = _mm_add_ps(pool_load(m_position.m_x), _mm_mul_ps(vx, dt));
+		__m128 py = _mm_add_ps(pool_load(m_position.m_y), _mm_mul_ps(vy, dt));
+		__m128 pz = _mm_add_ps(pool_load(m_position.m_z), _mm_mul_ps(vz, dt));
+
+		// update angular position, as _quaternion::addscaledvector does.
+		__m128 qr = pool_load(m_orientation.m_r);
+		__m128 qi = pool_load(m_orientation.m_i);
+		__m128 qj = pool_load(m_orientation.m_j);
+		__m128 qk = pool_load(m_orientation.m_k);
+		__m128 sx = _mm_mul_ps(wx, dt);
+		__m128 sy = _mm_mul_ps(wy, dt);
+		__m128 sz = _mm_mul_ps(wz, dt);
+
+		__m128 dr = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(zero, _mm_mul_ps(sx, qi)), _mm_mul_ps(sy, qj)), _mm_mul_ps(sz, qk));
+		__m128 di = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(sx, qr), _mm_mul_ps(sy, qk)), _mm_mul_ps(sz, qj));
+		__m128 dj = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(sy, qr), _mm_mul_ps(sz, qi)), _mm_mul_ps(sx, qk));
+		__m128 dk = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(sz, qr), _mm_mul_ps(sx, qj)), _mm_mul_ps(sy, qi));
+		qr = _mm_add_ps(qr, _mm_mul_ps(dr, half));
+		qi = _mm_add_ps(qi, _mm_mul_ps(di, half));
+		qj = _mm_add_ps(qj, _mm_mul_ps(dj, half));
+		qk = _mm_add_ps(qk, _mm_mul_ps(dk, half));
+
+		// normalise the orientation, a zero one becomes no rotation.
+		__m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(qr, qr), _mm_mul_ps(qi, qi)), _mm_mul_ps(qj, qj)), _mm_mul_ps(qk, qk));
+		__m128 small = _mm_cmplt_ps(d, tiny);
+		__m128 scale = _mm_or_ps(_mm_and_ps(small, one), _mm_andnot_ps(small, _mm_div_ps(one, _mm_sqrt_ps(d))));
+		qr = _mm_or_ps(_mm_and_ps(small, one), _mm_andnot_ps(small, _mm_mul_ps(qr, scale)));
+		qi = _mm_mul_ps(qi, scale);
+		qj = _mm_mul_ps(qj, scale);
+		qk = _mm_mul_ps(qk, scale);
+
+		// update the kinetic energy store of the bodies that can sleep.
+		__m128 current = _mm_add_ps(
+			_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz)),
+			_mm_add_ps(_mm_add_ps(_mm_mul_ps(wx, wx), _mm_mul_ps(wy, wy)), _mm_mul_ps(wz, wz)));
+		__m128 motion = pool_load(m_motion);
+		__m128 mixed  = _mm_min_ps(_mm_add_ps(_mm_mul_ps(keep, motion), _mm_mul_ps(gain, current)), limit);
+		_mm_storeu_ps(m_motion + i, _mm_or_ps(_mm_and_ps(sleepy, mixed), _mm_andnot_ps(sleepy, motion)));
+
+		pool_store(m_last_frame_acceleration.m_x, ax);
+		pool_store(m_last_frame_acceleration.m_y, ay);
+		pool_store(m_last_frame_acceleration.m_z, az);
+		pool_store(m_velocity.m_x, vx);
+		pool_store(m_velocity.m_y, vy);
+		pool_store(m_velocity.m_z, vz);
+		pool_store(m_rotation.m_x, wx);
+		pool_store(m_rotation.m_y, wy);
+		pool_store(m_rotation.m_z, wz);
+		pool_store(m_position.m_x, px);
+		pool_store(m_position.m_y, py);
+		pool_store(m_position.m_z, pz);
+		pool_store(m_orientation.m_r, qr);
+		pool_store(m_orientation.m_i, qi);
+		pool_store(m_orientation.m_j, qj);
+		pool_store(m_orientation.m_k, qk);
+
+		// clear accumulators.
+		pool_store(m_force_accumulated.m_x, zero);
+		pool_store(m_force_accumulated.m_y, zero);
+		pool_store(m_force_accumulated.m_z, zero);
+		pool_store(m_torque_accumulated.m_x, zero);
+		pool_store(m_torque_accumulated.m_y, zero);
+		pool_store(m_torque_accumulated.m_z, zero);
+
+#undef pool_load
+#undef pool_store
+
+		// the matrices and the decision to sleep are made a body at a
+		// time. bodies in an island are put to sleep by the resolver.
+		for (uint32_t j = i; j < i+4; j++) {
+			if (!m_isawake[j]) { continue; }
+			_derive(this, j);
+			if (m_cansleep[j] && m_motion[j] < _sleepepsilon && !m_in_island[j]) { m_bodies[j].setawake(false); }
+		}
+	}
+#else
+	for (uint32_t i = 0; i < m_count; i++) { m_bodies[i].integrate(duration); }
+#endif
+	memset(m_in_island, 0, m_count);
+}
+
+void rigid_body_pool::wake(uint32_t index) {
+	uint32_t i = index;
+	do {
+		uint32_t next = m_island_next[i];
+		m_island_next[i] = i;
+		if (!m_isawake[i]) {
+			m_isawake[i] = true;
+
+			// add a bit of motion to avoid it falling asleep immediately.
+			m_motion[i] = _sleepepsilon*2.0f;
+		}
+		i = next;
+	} while (i != index);
+}
+
+bool rigid_body_pool::addtoisland(uint32_t island, uint32_t index) {
+	if (index == island || m_island_next[index] != index) { return false; }
+
+	m_island_next[index]  = m_island_next[island];
+	m_island_next[island] = index;
+	return true;
+}
+
+void rigid_body::calculatederiveddata() {
+
+	_quaternion orientation = getorientation();
+	orientation.normalise();
+	_storequaternion(m_pool->m_orientation, m_index, orientation);
+
+	_derive(m_pool, m_index);
+}
+
+void rigid_body::integrate(float duration) {
+
+	if (!getawake()) { return; }
+
+	rigid_body_pool *pool = m_pool;
+	uint32_t index = m_index;
+
+	_vec3 velocity = getvelocity();
+	_vec3 rotation = getrotation();
+	_vec3 position = getposition();
+	_quaternion orientation = getorientation();
+
+	// calculate linear acceleration from force inputs.
+	_vec3 lastframeacceleration = getacceleration();
+	lastframeacceleration.addscaledvector( _loadvector(pool->m_force_accumulated, index), pool->m_inverse_mass[index] );
+
+	// calculate angular acceleration from torque inputs.
+	_vec3 angularacceleration = getinverseinertiatensorworld() * _loadvector(pool->m_torque_accumulated, index);
+
+	// adjust velocities
+	// update linear velocity from both acceleration and impulse.
+	velocity.addscaledvector(lastframeacceleration, duration);
+
+	// update angular velocity from both acceleration and impulse.
+	rotation.addscaledvector(angularacceleration, duration);
+
+	// impose drag.
+	velocity *= pow( pool->m_linear_damping[index] , duration);
+	rotation *= pow( pool->m_angular_damping[index], duration);
+
+	// adjust positions
+	// update linear position.
+	position.addscaledvector(velocity, duration);
+
+	// update angular position.
+	orientation.addscaledvector(rotation, duration);
+
+	_storevector(pool->m_last_frame_acceleration, index, lastframeacceleration);
+	_storevector(pool->m_velocity, index, velocity);
+	_storevector(pool->m_rotation, index, rotation);
+	_storevector(pool->m_position, index, position);
+	_storequaternion(pool->m_orientation, index, orientation);
+
+	// normalise the orientation, and update the matrices with the new
+	// position and orientation
+	calculatederiveddata();
+
+	// clear accumulators.
+	clearaccumulators();
+
+	// update the kinetic energy store, and possibly put the body to
+	// sleep.
+	if (getcansleep()) {
+		float currentmotion = _dot(velocity,velocity) + _dot(rotation,rotation);
+
+		float bias = pow(0.5f, duration);
+		float &motion = pool->m_motion[index];
+		motion = bias*motion + (1-bias)*currentmotion;
+
+		if ( motion<_sleepepsilon && !pool->m_in_island[index] ) { setawake(false); }
+		else if (motion > 10 * _sleepepsilon) { motion = 10 * _sleepepsilon; }
+	}
+}
+
+void rigid_body::setmass(const float mass) {
+	if(mass != 0) { m_pool->m_inverse_mass[m_index] = 1.0f/mass; }
+}
+
+float rigid_body::getmass() const {
+	float inversemass = m_pool->m_inverse_mass[m_index];
+	if (inversemass == 0) {
+		return FLT_MAX;
+	} else {
+		return 1.0f/inversemass;
+	}
+}
+
+void rigid_body::setinversemass(const float inversemass) { m_pool->m_inverse_mass[m_index] = inversemass; }
+
+float rigid_body::getinversemass() const { return m_pool->m_inverse_mass[m_index]; }
+
+bool rigid_body::hasfinitemass() const { return m_pool->m_inverse_mass[m_index] >= 0.0f; }
+
+void rigid_body::setinertiatensor(const _mat3 &inertiatensor) {
+	m_pool->m_inverse_inertia_tensor[m_index].setinverse(inertiatensor);
+}
+
+void rigid_body::getinertiatensor(_mat3 *inertiatensor) const {
+	inertiatensor->setinverse(m_pool->m_inverse_inertia_tensor[m_index]);
+}
+
+_mat3 rigid_body::getinertiatensor() const {
+	_mat3 it;
+	getinertiatensor(&it);
+	return it;
+}
+
+void rigid_body::getinertiatensorworld(_mat3 *inertiatensor) const {
+	inertiatensor->setinverse( getinverseinertiatensorworld() );
+}
+
+_mat3 rigid_body::getinertiatensorworld() const {
+	_mat3 it;
+	getinertiatensorworld(&it);
+	return it;
+}
+
+void rigid_body::setinverseinertiatensor(const _mat3 &inverseinertiatensor) {
+	m_pool->m_inverse_inertia_tensor[m_index] = inverseinertiatensor;
+}
+
+void rigid_body::getinverseinertiatensor(_mat3 *inverseinertiatensor) const {
+	*inverseinertiatensor = m_pool->m_inverse_inertia_tensor[m_index];
+}
+
+_mat3 rigid_body::getinverseinertiatensor() const { return m_pool->m_inverse_inertia_tensor[m_index]; }
+
+void rigid_body::getinverseinertiatensorworld(_mat3 *inverseinertiatensor) const {
+	*inverseinertiatensor = getinverseinertiatensorworld();
+}
+
+_mat3 rigid_body::getinverseinertiatensorworld() const {
+	return _loadmatrix(m_pool->m_inverse_inertia_tensor_world, m_index);
+}
+
+void rigid_body::setdamping(const float lineardamping, const float angulardamping) {
+	setlineardamping(lineardamping);
+	setangulardamping(angulardamping);
+}
+
+void rigid_body::setlineardamping(const float lineardamping) {
+	m_pool->m_linear_damping[m_index] = lineardamping;
+	m_pool->m_factor_duration = 0;
+}
+
+float rigid_body::getlineardamping() const { return m_pool->m_linear_damping[m_index]; }
+
+void rigid_body::setangulardamping(const float angulardamping) {
+	m_pool->m_angular_damping[m_index] = angulardamping;
+	m_pool->m_factor_duration = 0;
+}
+
+float rigid_body::getangulardamping() const { return m_pool->m_angular_damping[m_index]; }
+
+void rigid_body::setposition(const _vec3 &position) { _storevector(m_pool->m_position, m_index, position); }
+
+void rigid_body::setposition(const float x, const float y, const float z) {
+	m_pool->m_position.m_x[m_index] = x;
+	m_pool->m_position.m_y[m_index] = y;
+	m_pool->m_position.m_z[m_index] = z;
+}
+
+void rigid_body::getposition(_vec3 *position) const { *position = getposition(); }
+
+_vec3 rigid_body::getposition() const { return _loadvector(m_pool->m_position, m_index); }
+
+void rigid_body::setorientation(const _quaternion &orientation) {
+	_quaternion normalised = orientation;
+	normalised.normalise();
+	_storequaternion(m_pool->m_orientation, m_index, normalised);
+}
+
+void rigid_body::setorientation(const float r, const float i, const float j, const float k) {
+	setorientation( _quaternion(r, i, j, k) );
+}
+
+void rigid_body::getorientation(_quaternion *orientation) const { *orientation = getorientation(); }
+
+_quaternion rigid_body::getorientation() const { return _loadquaternion(m_pool->m_orientation, m_index); }
+
+void rigid_body::getorientation(_mat3 *matrix) const {
+	getorientation( (float*)matrix->m_data );
+}
+
+void rigid_body::getorientation(float matrix[9]) const {
+
+	const _aff &transform = m_pool->m_transform_matrix[m_index];
+
+	matrix[0] = transform[0][0];
+	matrix[1] = transform[1][0];
+	matrix[2] = transform[2][0];
+
+	matrix[3] = transform[0][1];
+	matrix[4] = transform[1][1];
+	matrix[5] = transform[2][1];
+
+	matrix[6] = transform[0][2];
+	matrix[7] = transform[1][2];
+	matrix[8] = transform[2][2];
+}
+
+void rigid_body::gettransform(_mat4 *transform) const {
+	*transform = m_pool->m_transform_matrix[m_index].tomatrix4(); }
+
+void rigid_body::gettransform(float matrix[16]) const
+{
+	_mat4 transform = m_pool->m_transform_matrix[m_index].tomatrix4();
+	memcpy(matrix, transform.m_data, sizeof(float)*16);
+}
+
+const _aff & rigid_body::gettransform() const { return m_pool->m_transform_matrix[m_index]; }
+
+void rigid_body::storeprevious() {
+	m_pool->m_previous_position[m_index]    = getposition();
+	m_pool->m_previous_orientation[m_index] = getorientation();
+}
+
+_vec3 rigid_body::getpreviousposition() const { return m_pool->m_previous_position[m_index]; }
+
+_vec3 rigid_body::getinterpolatedposition(const float alpha) const {
+	const _vec3 &previous = m_pool->m_previous_position[m_index];
+	return previous + (getposition() - previous) * alpha;
+}
+
+void rigid_body::getinterpolatedtransform(const float alpha, _mat4 *transform) const {
+
+	const _quaternion &previous = m_pool->m_previous_orientation[m_index];
+	_quaternion current = getorientation();
+
+	// blend the orientations along the shorter arc, then renormalise;
+	// over a single step this is close enough to a slerp.
+	float sign = (previous.r*current.r + previous.i*current.i +
+	              previous.j*current.j + previous.k*current.k) < 0 ? -1.0f : 1.0f;
+	float beta = 1.0f - alpha;
+
+	_quaternion orientation(
+		previous.r*beta + current.r*alpha*sign,
+		previous.i*beta + current.i*alpha*sign,
+		previous.j*beta + current.j*alpha*sign,
+		previous.k*beta + current.k*alpha*sign);
+	orientation.normalise();
+
+	_aff interpolated;
+	_calculatetransformmatrix(interpolated, getinterpolatedposition(alpha), orientation);
+	*transform = interpolated.tomatrix4();
+}
+
+_vec3 rigid_body::getpointinlocalspace(const _vec3 &point) const {
+	return m_pool->m_transform_matrix[m_index].transforminverse(point);
+}
+
+_vec3 rigid_body::getpointinworldspace(const _vec3 &point) const {
+	return m_pool->m_transform_matrix[m_index] * point;
+}
+
+_vec3 rigid_body::getdirectioninlocalspace(const _vec3 &direction) const {
+	return m_pool->m_transform_matrix[m_index].transforminversedirection(direction);
+}
+
+_vec3 rigid_body::getdirectioninworldspace(const _vec3 &direction) const {
+	return m_pool->m_transform_matrix[m_index].transformdirection(direction);
+}
+
+void rigid_body::setvelocity(const _vec3 &velocity) { _storevector(m_pool->m_velocity, m_index, velocity); }
+
+void rigid_body::setvelocity(const float x, const float y, const float z) {
+	m_pool->m_velocity.m_x[m_index] = x;
+	m_pool->m_velocity.m_y[m_index] = y;
+	m_pool->m_velocity.m_z[m_index] = z;
+}
+
+void rigid_body::getvelocity(_vec3 *velocity) const { *velocity = getvelocity(); }
+
+_vec3 rigid_body::getvelocity() const { return _loadvector(m_pool->m_velocity, m_index); }
+
+void rigid_body::addvelocity(const _vec3 &deltavelocity) { setvelocity(getvelocity() + deltavelocity); }
+
+void rigid_body::setrotation(const _vec3 &rotation) { _storevector(m_pool->m_rotation, m_index, rotation); }
+
+void rigid_body::setrotation(const float x, const float y, const float z) {
+	m_pool->m_rotation.m_x[m_index] = x;
+	m_pool->m_rotation.m_y[m_index] = y;
+	m_pool->m_rotation.m_z[m_index] = z;
+}
+
+void rigid_body::getrotation(_vec3 *rotation) const { *rotation = getrotation(); }
+
+_vec3 rigid_body::getrotation() const { return _loadvector(m_pool->m_rotation, m_index); }
+
+void rigid_body::addrotation(const _vec3 &deltarotation) { setrotation(getrotation() + deltarotation); }
+
+void rigid_body::setawake(const bool awake) {
+	if (awake) {
+		m_pool->wake(m_index);
+
+		// add a bit of motion to avoid it falling asleep immediately.
+		m_pool->m_motion[m_index] = _sleepepsilon*2.0f;
+	} else {
+		m_pool->m_isawake[m_index] = false;
+		setvelocity(0, 0, 0);
+		setrotation(0, 0, 0);
+	}
+}
+
+bool rigid_body::getcansleep() const { return m_pool->m_cansleep[m_index]; }
+
+void rigid_body::setcansleep(const bool cansleep) {
+	m_pool->m_cansleep[m_index] = cansleep;
+	if (!cansleep && !getawake()) { setawake(); }
+}
+
+bool rigid_body::getsleepy() const { return m_pool->m_cansleep[m_index] && m_pool->m_motion[m_index] < _sleepepsilon; }
+
+bool rigid_body::getcontinuous() const { return m_pool->m_continuous[m_index]; }
+
+void rigid_body::setcontinuous(const bool continuous) { m_pool->m_continuous[m_index] = continuous; }
+
+void rigid_body::getlastframeacceleration(_vec3 *acceleration) const { *acceleration = getlastframeacceleration(); }
+
+_vec3 rigid_body::getlastframeacceleration() const { return _loadvector(m_pool->m_last_frame_acceleration, m_index); }
+
+void rigid_body::clearaccumulators() {
+	_storevector(m_pool->m_force_accumulated, m_index, _vec3(0, 0, 0));
+	_storevector(m_pool->m_torque_accumulated, m_index, _vec3(0, 0, 0));
+}
+
+void rigid_body::addforce(const _vec3 &force) {
+	_storevector(m_pool->m_force_accumulated, m_index, _loadvector(m_pool->m_force_accumulated, m_index) + force);
+	m_pool->wake(m_index);
+}
+
+void rigid_body::addforceatbodypoint(const _vec3 &force, const _vec3 &point) {
+	// convert to coordinates relative to center of mass.
+	_vec3 pt = getpointinworldspace(point);
+	addforceatpoint(force, pt);
+
+}
+
+void rigid_body::addforceatpoint(const _vec3 &force, const _vec3 &point) {
+	// convert to coordinates relative to center of mass.
+	_vec3 pt = point;
+	pt -= getposition();
+
+	_storevector(m_pool->m_force_accumulated, m_index, _loadvector(m_pool->m_force_accumulated, m_index) + force);
+	_storevector(m_pool->m_torque_accumulated, m_index, _loadvector(m_pool->m_torque_accumulated, m_index) + _cross(pt,force));
+
+	m_pool->wake(m_index);
+}
+
+void rigid_body::addtorque(const _vec3 &torque) {
+	_storevector(m_pool->m_torque_accumulated, m_index, _loadvector(m_pool->m_torque_accumulated, m_index) + torque);
+	m_pool->wake(m_index);
+}
+
+void rigid_body::setacceleration(const _vec3 &acceleration) { _storevector(m_pool->m_acceleration, m_index, acceleration); }
+
+void rigid_body::setacceleration(const float x, const float y, const float z) {
+	m_pool->m_acceleration.m_x[m_index] = x;
+	m_pool->m_acceleration.m_y[m_index] = y;
+	m_pool->m_acceleration.m_z[m_index] = z;
+}
+
+void rigid_body::getacceleration(_vec3 *acceleration) const { *acceleration = getacceleration(); }
+
+_vec3 rigid_body::getacceleration() const { return _loadvector(m_pool->m_acceleration, m_index); }
@@ -0,0 +1,682 @@
+#include "collide_coarse.h"
+
+bounding_box bounding_box::frombox(const collision_box &box) {
+
+	_vec3 centre = box.getaxis(3);
+	_vec3 axis[3] = { box.getaxis(0), box.getaxis(1), box.getaxis(2) };
+
+	// the extent on each world axis is the sum of the projections
+	// of the three half-size vectors.
+	_vec3 extent;
+	for (uint32_t i = 0; i < 3; i++) {
+		extent[i] =
+			abs(axis[0][i]) * box.m_half_size.x +
+			abs(axis[1][i]) * box.m_half_size.y +
+			abs(axis[2][i]) * box.m_half_size.z;
+	}
+	return bounding_box(centre - extent, centre + extent);
+}
+
+bounding_box bounding_box::fromsphere(const collision_sphere &sphere) {
+	_vec3 centre = sphere.getaxis(3);
+	_vec3 extent(sphere.m_radius);
+	return bounding_box(centre - extent, centre + extent);
+}
+
+bounding_box bounding_box::fromprimitive(const collision_primitive *primitive, primitive_type type) {
+	if (type == primitive_box) { return frombox(*(const collision_box*)primitive); }
+	return fromsphere(*(const collision_sphere*)primitive);
+}
+
+bool bounding_box::intersectsray(const _vec3 &origin, const _vec3 &inverse_direction, float max_distance) const {
+
+	// clip the ray against the three pairs of slabs in turn.
+	float tmin = 0.0f;
+	float tmax = max_distance;
+	for (uint32_t i = 0; i < 3; i++) {
+
+		// a ray parallel to the slabs is tested by its origin alone, as
+		// an origin on a slab would give 0 times infinity, a nan.
+		if (abs(inverse_direction[i]) > FLT_MAX) {
+			if (origin[i] < m_min[i] || origin[i] > m_max[i]) { return false; }
+			continue;
+		}
+		float t1 = (m_min[i] - origin[i]) * inverse_direction[i];
+		float t2 = (m_max[i] - origin[i]) * inverse_direction[i];
+		if (t1 > t2) { float t = t1; t1 = t2; t2 = t; }
+		if (t1 > tmin) { tmin = t1; }
+		if (t2 < tmax) { tmax = t2; }
+		if (tmin > tmax) { return false; }
+	}
+	return true;
+}
+
+sweep_and_prune::sweep_and_prune() {
+	m_axis           = 0;
+	m_pair_count     = 0;
+	m_filtered_count = 0;
+	m_swap_count     = 0;
+}
+
+uint32_t sweep_and_prune::insert(collision_primitive *primitive, primitive_type type) {
+
+	uint32_t index;
+	if (m_free_proxies.m_count) {
+		index = m_free_proxies[--m_free_proxies.m_count];
+	} else {
+		index = m_proxies.m_count;
+		m_proxies.pushback(sap_proxy(),true);
+	}
+
+	sap_proxy &proxy = m_proxies[index];
+	proxy.m_primitive = primitive;
+	proxy.m_type      = type;
+	proxy.m_bounds    = bounding_box::fromprimitive(primitive, type);
+	proxy.m_used      = true;
+
+	// the endpoints are added at the end of the list, the next
+	// update will sort them into place.
+	sap_endpoint endpoint;
+	endpoint.m_value = proxy.m_bounds.m_min[m_axis];
+	endpoint.m_proxy = index;
+	m_endpoints.pushback(endpoint,true);
+
+	endpoint.m_value = proxy.m_bounds.m_max[m_axis];
+	endpoint.m_proxy = index | sap_max_endpoint;
+	m_endpoints.pushback(endpoint,true);
+
+	return index;
+}
+
+void sweep_and_prune::remove(uint32_t proxy) {
+	if (proxy >= m_proxies.m_count || !m_proxies[proxy].m_used) { return; }
+
+	// the index can't be reused until its endpoints have been
+	// dropped from the list by the next update.
+	m_proxies[proxy].m_used = false;
+	m_removed_proxies.pushback(proxy,true);
+}
+
+void sweep_and_prune::clear() {
+	m_proxies.clear();
+	m_free_proxies.clear();
+	m_removed_proxies.clear();
+	m_endpoints.clear();
+	m_open.clear();
+	m_pairs.clear();
+	m_pair_count     = 0;
+	m_filtered_count = 0;
+	m_swap_count     = 0;
+}
+
+void sweep_and_prune::update() {
+
+	// refit the bounds of every live proxy.
+	for (uint32_t i = 0; i < m_proxies.m_count; i++) {
+		sap_proxy &proxy = m_proxies[i];
+		if (proxy.m_used) { proxy.m_bounds = bounding_box::fromprimitive(proxy.m_primitive, proxy.m_type); }
+	}
+
+	// refresh the endpoint values, dropping those of removed proxies.
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < m_endpoints.m_count; i++) {
+		sap_endpoint endpoint = m_endpoints[i];
+		const sap_proxy &proxy = m_proxies[endpoint.m_proxy & ~sap_max_endpoint];
+		if (!proxy.m_used) { continue; }
+
+		endpoint.m_value = (endpoint.m_proxy & sap_max_endpoint) ?
+			proxy.m_bounds.m_max[m_axis] : proxy.m_bounds.m_min[m_axis];
+		m_endpoints[count++] = endpoint;
+	}
+	m_endpoints.m_count = count;
+
+	for (uint32_t i = 0; i < m_removed_proxies.m_count; i++) {
+		m_free_proxies.pushback(m_removed_proxies[i],true);
+	}
+	m_removed_proxies.m_count = 0;
+
+	// restore the order with an insertion sort. the list was sorted
+	// last frame, so only the endpoints that crossed each other move.
+	// minimum endpoints sort before maximum endpoints of equal value, so
+	// touching extents are reported as overlapping.
+	m_swap_count = 0;
+	for (uint32_t i = 1; i < m_endpoints.m_count; i++) {
+		sap_endpoint endpoint = m_endpoints[i];
+		bool ismax = (endpoint.m_proxy & sap_max_endpoint) != 0;
+
+		uint32_t j = i;
+		while (j > 0) {
+			const sap_endpoint &previous = m_endpoints[j-1];
+			bool previousismax = (previous.m_proxy & sap_max_endpoint) != 0;
+			if (previous.m_value < endpoint.m_value ||
+				(previous.m_value == endpoint.m_value && (ismax || !previousismax))) { break; }
+			m_endpoints[j] = previous;
+			j--;
+		}
+		if (j != i) {
+			m_endpoints[j] = endpoint;
+			m_swap_count += i-j;
+		}
+	}
+
+	// sweep the sorted list. every proxy that opens while another is
+	// still open overlaps it on the sweep axis; the other two axes
+	// are checked before the pair is reported.
+	m_pair_count     = 0;
+	m_filtered_count = 0;
+	m_open.m_count   = 0;
+	for (uint32_t i = 0; i < m_endpoints.m_count; i++) {
+		uint32_t index = m_endpoints[i].m_proxy & ~sap_max_endpoint;
+
+		if (m_endpoints[i].m_proxy & sap_max_endpoint) {
+			for (uint32_t j = 0; j < m_open.m_count; j++) {
+				if (m_open[j] == index) {
+					m_open[j] = m_open[--m_open.m_count];
+					break;
+				}
+			}
+			continue;
+		}
+
+		const sap_proxy &proxy = m_proxies[index];
+		for (uint32_t j = 0; j < m_open.m_count; j++) {
+			const sap_proxy &other = m_proxies[m_open[j]];
+			if (!proxy.m_bounds.overlaps(other.m_bounds)) { continue; }
+			if (!proxy.m_primitive->collideswith(*other.m_primitive)) { m_filtered_count++; continue; }
+
+			if (m_pair_count >= m_pairs.m_count) { m_pairs.pushback(potential_contact(),true); }
+			potential_contact &pair = m_pairs[m_pair_count++];
+			pair.m_primitive[0] = other.m_primitive;
+			pair.m_primitive[1] = proxy.m_primitive;
+			pair.m_type[0]      = other.m_type;
+			pair.m_type[1]      = proxy.m_type;
+		}
+		m_open.pushback(index,true);
+	}
+}
+
+spatial_hash::spatial_hash() {
+	m_cell_size      = 1.0f;
+	m_max_extent     = 0.0f;
+	m_bucket_count   = 0;
+	m_filtered_count = 0;
+}
+
+void spatial_hash::setcellsize(float size) {
+	if (size > 0.0f) { m_cell_size = size; }
+}
+
+void spatial_hash::clear() {
+	m_items.m_count = 0;
+	m_max_extent    = 0.0f;
+}
+
+uint32_t spatial_hash::insert(collision_primitive *primitive, primitive_type type) {
+
+	if (m_items.m_count >= m_items.m_size) { m_items.alloc(m_items.m_size*2+16); }
+
+	uint32_t index = m_items.m_count++;
+	spatial_hash_item &item = m_items[index];
+	item.m_primitive = primitive;
+	item.m_type      = type;
+	item.m_bounds    = bounding_box::fromprimitive(primitive, type);
+
+	_vec3 extent = (item.m_bounds.m_max - item.m_bounds.m_min) * 0.5f;
+	_vec3 centre = item.m_bounds.m_min + extent;
+	for (uint32_t i = 0; i < 3; i++) {
+		item.m_cell[i] = cell(centre[i]);
+		if (extent[i] > m_max_extent) { m_max_extent = extent[i]; }
+	}
+	return index;
+}
+
+void spatial_hash::build() {
+
+	// keep the table at least twice the size of the item count, so
+	// most buckets hold a single cell.
+	uint32_t buckets = 64;
+	while (buckets < m_items.m_count*2) { buckets *= 2; }
+	if (buckets > m_bucket_count) {
+		m_bucket_count = buckets;
+		m_bucket_start.clear();
+		m_bucket_start.allocate(m_bucket_count+1);
+	}
+	if (m_sorted.m_size < m_items.m_count) { m_sorted.alloc(m_items.m_size); }
+	m_sorted.m_count = m_items.m_count;
+
+	// counting sort of the items by bucket.
+	for (uint32_t b = 0; b <= m_bucket_count; b++) { m_bucket_start[b] = 0; }
+	for (uint32_t i = 0; i < m_items.m_count; i++) {
+		const spatial_hash_item &item = m_items[i];
+		m_bucket_start[ bucket(item.m_cell[0], item.m_cell[1], item.m_cell[2]) + 1 ]++;
+	}
+	for (uint32_t b = 0; b < m_bucket_count; b++) { m_bucket_start[b+1] += m_bucket_start[b]; }
+
+	// place each item, using its bucket's start as a cursor. that
+	// leaves every start at the start of the next bucket, so they are
+	// shifted back down afterwards.
+	for (uint32_t i = 0; i < m_items.m_count; i++) {
+		const spatial_hash_item &item = m_items[i];
+		uint32_t b = bucket(item.m_cell[0], item.m_cell[1], item.m_cell[2]);
+		m_sorted[ m_bucket_start[b]++ ] = i;
+	}
+	for (uint32_t b = m_bucket_count; b > 0; b--) { m_bucket_start[b] = m_bucket_start[b-1]; }
+	m_bucket_start[0] = 0;
+}
+
+uint32_t spatial_hash::query(const bounding_box &bounds, _array<uint32_t> *results) {
+
+	results->m_count = 0;
+	if (!m_items.m_count) { return 0; }
+
+	// an item is filed under the cell of its centre, so the search
+	// area is grown by the largest item extent.
+	// the cells are counted in float, so bounds too large for an
+	// int32_t cell index or a uint32_t count cannot overflow either.
+	float low[3], high[3];
+	float cells = 1.0f;
+	for (uint32_t i = 0; i < 3; i++) {
+		low[i]  = floor( (bounds.m_min[i] - m_max_extent) / m_cell_size );
+		high[i] = floor( (bounds.m_max[i] + m_max_extent) / m_cell_size );
+		cells  *= high[i] - low[i] + 1.0f;
+	}
+
+	// a large query covers more cells than there are items, in that
+	// case it is cheaper to check every item. written so that nan
+	// bounds take this path too.
+	if ( !(cells <= float(m_items.m_count)) ) {
+		for (uint32_t i = 0; i < m_items.m_count; i++) {
+			if (m_items[i].m_bounds.overlaps(bounds)) { results->pushback(i,true); }
+		}
+		return results->m_count;
+	}
+
+	for (int32_t x = int32_t(low[0]); x <= int32_t(high[0]); x++) {
+		for (int32_t y = int32_t(low[1]); y <= int32_t(high[1]); y++) {
+			for (int32_t z = int32_t(low[2]); z <= int32_t(high[2]); z++) {
+				uint32_t b = bucket(x,y,z);
+				for (uint32_t s = m_bucket_start[b]; s < m_bucket_start[b+1]; s++) {
+					const spatial_hash_item &item = m_items[ m_sorted[s] ];
+
+					// other cells can share the bucket
+					if (item.m_cell[0] != x || item.m_cell[1] != y || item.m_cell[2] != z) { continue; }
+					if (item.m_bounds.overlaps(bounds)) { results->pushback(m_sorted[s],true); }
+				}
+			}
+		}
+	}
+	return results->m_count;
+}
+
+uint32_t spatial_hash::findpairs(_array<potential_contact> *pairs) {
+
+	uint32_t count = 0;
+	m_filtered_count = 0;
+	for (uint32_t i = 0; i < m_items.m_count; i++) {
+		const spatial_hash_item &item = m_items[i];
+
+		for (int32_t x = item.m_cell[0]-1; x <= item.m_cell[0]+1; x++) {
+			for (int32_t y = item.m_cell[1]-1; y <= item.m_cell[1]+1; y++) {
+				for (int32_t z = item.m_cell[2]-1; z <= item.m_cell[2]+1; z++) {
+					uint32_t b = bucket(x,y,z);
+					for (uint32_t s = m_bucket_start[b]; s < m_bucket_start[b+1]; s++) {
+
+						// only report each pair once
+						uint32_t j = m_sorted[s];
+						if (j <= i) { continue; }
+
+						const spatial_hash_item &other = m_items[j];
+						if (other.m_cell[0] != x || other.m_cell[1] != y || other.m_cell[2] != z) { continue; }
+						if (!item.m_bounds.overlaps(other.m_bounds)) { continue; }
+						if (!item.m_primitive->collideswith(*other.m_primitive)) { m_filtered_count++; continue; }
+
+						if (count >= pairs->m_count) { pairs->pushback(potential_contact(),true); }
+						potential_contact &pair = (*pairs)[count++];
+						pair.m_primitive[0] = item.m_primitive;
+						pair.m_primitive[1] = other.m_primitive;
+						pair.m_type[0]      = item.m_type;
+						pair.m_type[1]      = other.m_type;
+					}
+				}
+			}
+		}
+	}
+	return count;
+}
+
+dynamic_aabb_tree::dynamic_aabb_tree() {
+	m_margin         = 0.1f;
+	m_root           = aabb_null_node;
+	m_free_list      = aabb_null_node;
+	m_leaf_count     = 0;
+	m_reinsert_count = 0;
+	m_pair_count     = 0;
+	m_filtered_count = 0;
+}
+
+uint32_t dynamic_aabb_tree::allocatenode() {
+
+	uint32_t index;
+	if (m_free_list != aabb_null_node) {
+		index       = m_free_list;
+		m_free_list = m_nodes[index].m_parent;
+	} else {
+		index = m_nodes.m_count;
+		m_nodes.pushback(aabb_tree_node(),true);
+	}
+
+	aabb_tree_node &node = m_nodes[index];
+	node.m_primitive = NULL;
+	node.m_type      = primitive_sphere;
+	node.m_parent    = aabb_null_node;
+	node.m_child[0]  = aabb_null_node;
+	node.m_child[1]  = aabb_null_node;
+	node.m_height    = 0;
+	return index;
+}
+
+void dynamic_aabb_tree::freenode(uint32_t node) {
+	m_nodes[node].m_parent    = m_free_list;
+	m_nodes[node].m_primitive = NULL;
+	m_nodes[node].m_height    = -1;
+	m_free_list = node;
+}
+
+uint32_t dynamic_aabb_tree::insert(collision_primitive *primitive, primitive_type type) {
+
+	uint32_t proxy = allocatenode();
+	aabb_tree_node &leaf = m_nodes[proxy];
+	leaf.m_primitive = primitive;
+	leaf.m_type      = type;
+	leaf.m_bounds    = bounding_box::fromprimitive(primitive, type).grow(m_margin);
+
+	insertleaf(proxy);
+	m_leaf_count++;
+	return proxy;
+}
+
+void dynamic_aabb_tree::remove(uint32_t proxy) {
+	if (proxy >= m_nodes.m_count || m_nodes[proxy].m_height != 0) { return; }
+
+	removeleaf(proxy);
+	freenode(proxy);
+	m_leaf_count--;
+}
+
+bool dynamic_aabb_tree::update(uint32_t proxy) {
+
+	aabb_tree_node &leaf = m_nodes[proxy];
+	bounding_box bounds = bounding_box::fromprimitive(leaf.m_primitive, leaf.m_type);
+	if (leaf.m_bounds.contains(bounds)) { return false; }
+
+	removeleaf(proxy);
+	leaf.m_bounds = bounds.grow(m_margin);
+	insertleaf(proxy);
+	return true;
+}
+
+/*
+ * a leaf is resting when the body of its primitive is asleep, or it
+ * has none. a resting leaf doesn't move, and two resting leaves can't
+ * have come into contact.
+ */
+static inline bool restingleaf(const aabb_tree_node &leaf) {
+	return !leaf.m_primitive->m_body || !leaf.m_primitive->m_body->getawake();
+}
+
+void dynamic_aabb_tree::refit() {
+	m_reinsert_count = 0;
+	for (uint32_t i = 0; i < m_nodes.m_count; i++) {
+		if (m_nodes[i].m_height != 0 || restingleaf(m_nodes[i])) { continue; }
+		if (update(i)) { m_reinsert_count++; }
+	}
+}
+
+void dynamic_aabb_tree::clear() {
+	m_nodes.clear();
+	m_pairs.clear();
+	m_stack.clear();
+	m_root           = aabb_null_node;
+	m_free_list      = aabb_null_node;
+	m_leaf_count     = 0;
+	m_reinsert_count = 0;
+	m_pair_count     = 0;
+}
+
+void dynamic_aabb_tree::insertleaf(uint32_t leaf) {
+
+	if (m_root == aabb_null_node) {
+		m_root = leaf;
+		m_nodes[leaf].m_parent = aabb_null_node;
+		return;
+	}
+
+	// walk down the tree looking for the best sibling. the cost of a
+	// node is its surface area, and every ancestor of the new node
+	// grows to enclose it, so that growth is inherited by both choices.
+	bounding_box bounds = m_nodes[leaf].m_bounds;
+	uint32_t index = m_root;
+	while (!m_nodes[index].isleaf()) {
+		const aabb_tree_node &node = m_nodes[index];
+
+		float area         = node.m_bounds.area();
+		float combinedarea = node.m_bounds.merge(bounds).area();
+
+		// the cost of making a new parent for this node and the leaf
+		float cost        = 2.0f * combinedarea;
+		float inheritance = 2.0f * (combinedarea - area);
+
+		// the cost of descending into each child
+		float childcost[2];
+		for (uint32_t i = 0; i < 2; i++) {
+			const aabb_tree_node &child = m_nodes[ node.m_child[i] ];
+			childcost[i] = child.m_bounds.merge(bounds).area() + inheritance;
+			if (!child.isleaf()) { childcost[i] -= child.m_bounds.area(); }
+		}
+
+		if (cost < childcost[0] && cost < childcost[1]) { break; }
+		index = (childcost[0] < childcost[1]) ? node.m_child[0] : node.m_child[1];
+	}
+	uint32_t sibling = index;
+
+	// make a new parent for the sibling and the leaf. the node array
+	// may grow here, so no references are held across the call.
+	uint32_t oldparent = m_nodes[sibling].m_parent;
+	uint32_t newparent = allocatenode();
+	aabb_tree_node &parent = m_nodes[newparent];
+	parent.m_parent   = oldparent;
+	parent.m_bounds   = m_nodes[sibling].m_bounds.merge(bounds);
+	parent.m_height   = m_nodes[sibling].m_height + 1;
+	parent.m_child[0] = sibling;
+	parent.m_child[1] = leaf;
+
+	if (oldparent != aabb_null_node) {
+		aabb_tree_node &old = m_nodes[oldparent];
+		if (old.m_child[0] == sibling) { old.m_child[0] = newparent; }
+		else { old.m_child[1] = newparent; }
+	} else {
+		m_root = newparent;
+	}
+	m_nodes[sibling].m_parent = newparent;
+	m_nodes[leaf].m_parent    = newparent;
+
+	fixupwards(newparent);
+}
+
+void dynamic_aabb_tree::removeleaf(uint32_t leaf) {
+
+	if (leaf == m_root) {
+		m_root = aabb_null_node;
+		return;
+	}
+
+	// the sibling of the leaf takes the place of their parent.
+	uint32_t parent      = m_nodes[leaf].m_parent;
+	uint32_t grandparent = m_nodes[parent].m_parent;
+	uint32_t sibling     = (m_nodes[parent].m_child[0] == leaf) ?
+		m_nodes[parent].m_child[1] : m_nodes[parent].m_child[0];
+
+	if (grandparent != aabb_null_node) {
+		aabb_tree_node &node = m_nodes[grandparent];
+		if (node.m_child[0] == parent) { node.m_child[0] = sibling; }
+		else { node.m_child[1] = sibling; }
+		m_nodes[sibling].m_parent = grandparent;
+		freenode(parent);
+		fixupwards(grandparent);
+	} else {
+		m_root = sibling;
+		m_nodes[sibling].m_parent = aabb_null_node;
+		freenode(parent);
+	}
+}
+
+void dynamic_aabb_tree::fixupwards(uint32_t index) {
+	while (index != aabb_null_node) {
+		index = balance(index);
+
+		aabb_tree_node &node = m_nodes[index];
+		const aabb_tree_node &one = m_nodes[ node.m_child[0] ];
+		const aabb_tree_node &two = m_nodes[ node.m_child[1] ];
+		node.m_height = 1 + ((one.m_height > two.m_height) ? one.m_height : two.m_height);
+		node.m_bounds = one.m_bounds.merge(two.m_bounds);
+
+		index = node.m_parent;
+	}
+}
+
+uint32_t dynamic_aabb_tree::balance(uint32_t a) {
+
+	aabb_tree_node &nodea = m_nodes[a];
+	if (nodea.isleaf() || nodea.m_height < 2) { return a; }
+
+	uint32_t b = nodea.m_child[0];
+	uint32_t c = nodea.m_child[1];
+
+	int32_t difference = m_nodes[c].m_height - m_nodes[b].m_height;
+	if (difference >= -1 && difference <= 1) { return a; }
+
+	// the taller child is rotated up to replace a, and a takes the
+	// shorter of its children in exchange.
+	uint32_t up   = (difference > 0) ? c : b;
+	uint32_t side = (difference > 0) ? 1 : 0;
+	aabb_tree_node &nodeup    = m_nodes[up];
+	aabb_tree_node &nodestays = m_nodes[ nodea.m_child[1-side] ];
+
+	uint32_t f = nodeup.m_child[0];
+	uint32_t g = nodeup.m_child[1];
+
+	nodeup.m_child[0] = a;
+	nodeup.m_parent   = nodea.m_parent;
+	nodea.m_parent    = up;
+
+	if (nodeup.m_parent != aabb_null_node) {
+		aabb_tree_node &parent = m_nodes[nodeup.m_parent];
+		if (parent.m_child[0] == a) { parent.m_child[0] = up; }
+		else { parent.m_child[1] = up; }
+	} else {
+		m_root = up;
+	}
+
+	// the taller grandchild stays with the rotated node
+	uint32_t keep  = (m_nodes[f].m_height > m_nodes[g].m_height) ? f : g;
+	uint32_t given = (keep == f) ? g : f;
+	nodeup.m_child[1]       = keep;
+	nodea.m_child[side]     = given;
+	m_nodes[given].m_parent = a;
+
+	const aabb_tree_node &nodegiven = m_nodes[given];
+	const aabb_tree_node &nodekeep  = m_nodes[keep];
+	nodea.m_bounds  = nodestays.m_bounds.merge(nodegiven.m_bounds);
+	nodea.m_height  = 1 + ((nodestays.m_height > nodegiven.m_height) ? nodestays.m_height : nodegiven.m_height);
+	nodeup.m_bounds = nodea.m_bounds.merge(nodekeep.m_bounds);
+	nodeup.m_height = 1 + ((nodea.m_height > nodekeep.m_height) ? nodea.m_height : nodekeep.m_height);
+
+	return up;
+}
+
+uint32_t dynamic_aabb_tree::findpairs() {
+
+	// query the tree with every leaf that isn't resting. a pair of
+	// moving leaves is found from both, so it is only reported from the
+	// one with the lower handle. a pair with a resting leaf is only
+	// found from the other, and two resting leaves are never paired.
+	m_pair_count     = 0;
+	m_filtered_count = 0;
+	for (uint32_t i = 0; i < m_nodes.m_count; i++) {
+		if (m_nodes[i].m_height != 0 || restingleaf(m_nodes[i])) { continue; }
+
+		m_stack.m_count = 0;
+		if (m_root != aabb_null_node) { m_stack.pushback(m_root,true); }
+
+		while (m_stack.m_count) {
+			uint32_t index = m_stack[--m_stack.m_count];
+			if (index == i) { continue; }
+
+			const aabb_tree_node &node = m_nodes[index];
+			const aabb_tree_node &leaf = m_nodes[i];
+			if (!node.m_bounds.overlaps(leaf.m_bounds)) { continue; }
+
+			if (!node.isleaf()) {
+				m_stack.pushback(node.m_child[0],true);
+				m_stack.pushback(node.m_child[1],true);
+				continue;
+			}
+			if (index < i && !restingleaf(node)) { continue; }
+			if (!leaf.m_primitive->collideswith(*node.m_primitive)) { m_filtered_count++; continue; }
+
+			if (m_pair_count >= m_pairs.m_count) { m_pairs.pushback(potential_contact(),true); }
+			potential_contact &pair = m_pairs[m_pair_count++];
+			pair.m_primitive[0] = leaf.m_primitive;
+			pair.m_primitive[1] = node.m_primitive;
+			pair.m_type[0]      = leaf.m_type;
+			pair.m_type[1]      = node.m_type;
+		}
+	}
+	return m_pair_count;
+}
+
+uint32_t dynamic_aabb_tree::query(const bounding_box &bounds, _array<uint32_t> *results) {
+
+	results->m_count = 0;
+	m_stack.m_count  = 0;
+	if (m_root != aabb_null_node) { m_stack.pushback(m_root,true); }
+
+	while (m_stack.m_count) {
+		uint32_t index = m_stack[--m_stack.m_count];
+		const aabb_tree_node &node = m_nodes[index];
+		if (!node.m_bounds.overlaps(bounds)) { continue; }
+
+		if (node.isleaf()) {
+			results->pushback(index,true);
+		} else {
+			m_stack.pushback(node.m_child[0],true);
+			m_stack.pushback(node.m_child[1],true);
+		}
+	}
+	return results->m_count;
+}
+
+uint32_t dynamic_aabb_tree::raycast(const _vec3 &origin, const _vec3 &direction, float max_distance, _array<uint32_t> *results) {
+
+	// a zero component gives an infinite reciprocal, which
+	// intersectsray takes as a ray parallel to that pair of slabs.
+	_vec3 inverse(1.0f/direction.x, 1.0f/direction.y, 1.0f/direction.z);
+
+	results->m_count = 0;
+	m_stack.m_count  = 0;
+	if (m_root != aabb_null_node) { m_stack.pushback(m_root,true); }
+
+	while (m_stack.m_count) {
+		uint32_t index = m_stack[--m_stack.m_count];
+		const aabb_tree_node &node = m_nodes[index];
+		if (!node.m_bounds.intersectsray(origin, inverse, max_distance)) { continue; }
+
+		if (node.isleaf()) {
+			results->pushback(index,true);
+		} else {
+			m_stack.pushback(node.m_child[0],true);
+			m_stack.pushback(node.m_child[1],true);
+		}
+	}
+	return results->m_count;
+}
@@ -0,0 +1,514 @@
+#pragma once
+
+/**
+* this file contains the coarse collision detection system. it is
+* used to return pairs of primitives that may be in contact, which
+* can then be passed to the fine grained collision detection system
+* in collide_fine.h.
+*
+* the coarse system works on axis aligned bounding boxes: it is
+* cheap to test two boxes against each other, and cheap to keep a
+* set of them sorted along an axis as the simulation moves forward.
+*/
+
+#include "collide_fine.h"
+
+/**
+* identifies the shape of a primitive stored in the coarse
+* collision system, so the correct fine grained test can be
+* chosen for each potential contact.
+*/
+enum primitive_type { primitive_sphere = 0, primitive_box };
+
+/**
+* an axis aligned bounding box in world coordinates.
+*/
+struct bounding_box {
+
+	/** holds the minimum corner of the box. */
+	_vec3 m_min;
+
+	/** holds the maximum corner of the box. */
+	_vec3 m_max;
+
+	bounding_box() {}
+	bounding_box(const _vec3 &min, const _vec3 &max) : m_min(min), m_max(max) {}
+
+	/**
+	* creates a bounding box that encloses the given oriented box.
+	* the transform of the box must be up to date.
+	*/
+	static bounding_box frombox(const collision_box &box);
+
+	/**
+	* creates a bounding box that encloses the given sphere.
+	*/
+	static bounding_box fromsphere(const collision_sphere &sphere);
+
+	/**
+	* creates a bounding box for the given primitive, based on its type.
+	*/
+	static bounding_box fromprimitive(const collision_primitive *primitive, primitive_type type);
+
+	/**
+	* checks if the bounding boxes overlap.
+	*/
+	bool overlaps(const bounding_box &other) const {
+		return
+			m_min.x <= other.m_max.x && other.m_min.x <= m_max.x &&
+			m_min.y <= other.m_max.y && other.m_min.y <= m_max.y &&
+			m_min.z <= other.m_max.z && other.m_min.z <= m_max.z;
+	}
+
+	/**
+	* checks if the other bounding box lies completely inside this one.
+	*/
+	bool contains(const bounding_box &other) const {
+		return
+			m_min.x <= other.m_min.x && other.m_max.x <= m_max.x &&
+			m_min.y <= other.m_min.y && other.m_max.y <= m_max.y &&
+			m_min.z <= other.m_min.z && other.m_max.z <= m_max.z;
+	}
+
+	/**
+	* returns a bounding box that encloses both this box and the other.
+	*/
+	bounding_box merge(const bounding_box &other) const {
+		bounding_box result;
+		for (uint32_t i = 0; i < 3; i++) {
+			result.m_min[i] = (m_min[i] < other.m_min[i]) ? m_min[i] : other.m_min[i];
+			result.m_max[i] = (m_max[i] > other.m_max[i]) ? m_max[i] : other.m_max[i];
+		}
+		return result;
+	}
+
+	/**
+	* returns a copy of the box grown by the given margin on every side.
+	*/
+	bounding_box grow(float margin) const {
+		_vec3 extent(margin);
+		return bounding_box(m_min - extent, m_max + extent);
+	}
+
+	/**
+	* returns half the surface area of the box, used as the cost of
+	* a node when building bounding volume trees.
+	*/
+	float area() const {
+		_vec3 size = m_max - m_min;
+		return size.x*size.y + size.y*size.z + size.z*size.x;
+	}
+
+	/**
+	* checks if a ray hits the box before the given distance. the
+	* ray is given by its origin and the reciprocal of its direction,
+	* so a ray can be tested against many boxes without a division.
+	* distances are measured in multiples of the direction. a zero
+	* component of the direction, an infinite reciprocal, is a ray
+	* parallel to that pair of slabs.
+	*/
+	bool intersectsray(const _vec3 &origin, const _vec3 &inverse_direction, float max_distance) const;
+};
+
+/**
+* stores a potential contact to check later.
+*/
+struct potential_contact {
+
+	/**
+	* holds the primitives that might be in contact.
+	*/
+	collision_primitive * m_primitive[2];
+
+	/**
+	* holds the shape of each primitive.
+	*/
+	primitive_type m_type[2];
+};
+
+/**
+* one entry in the sweep and prune structure.
+*/
+struct sap_proxy {
+
+	/** the primitive this proxy stands for. */
+	collision_primitive * m_primitive;
+
+	/** the shape of the primitive. */
+	primitive_type m_type;
+
+	/** the bounds calculated at the last update. */
+	bounding_box m_bounds;
+
+	/** false once the proxy has been removed. */
+	bool m_used;
+};
+
+/**
+* the start or end of a proxy's extent along the sweep axis.
+*/
+struct sap_endpoint {
+
+	/** the position of the endpoint along the sweep axis. */
+	float m_value;
+
+	/**
+	* the index of the proxy, with the top bit set if this
+	* is the maximum endpoint.
+	*/
+	uint32_t m_proxy;
+};
+
+#define sap_max_endpoint 0x80000000
+
+/**
+* an incremental sweep and prune broadphase.
+*
+* every proxy has a minimum and maximum endpoint along a single
+* axis. the endpoints are kept sorted between updates, and because
+* bodies only move a little each frame, the insertion sort used to
+* restore the order runs in close to linear time. a sweep along the
+* sorted list then finds every pair whose extents overlap on the
+* axis, and those pairs are checked on the remaining two axes before
+* being reported.
+*
+* proxies can be inserted and removed at any time; removed proxies
+* are dropped from the endpoint list at the next update.
+*/
+struct sweep_and_prune {
+
+	sweep_and_prune();
+
+	/**
+	* the axis (0, 1 or 2) that endpoints are sorted along. this
+	* should be the axis along which the primitives are most spread
+	* out. changing it takes effect at the next update.
+	*/
+	uint32_t m_axis;
+
+	/** holds every proxy, used or not. */
+	_array<sap_proxy> m_proxies;
+
+	/** holds the indices of proxies that can be reused. */
+	_array<uint32_t> m_free_proxies;
+
+	/** holds proxies removed since the last update. */
+	_array<uint32_t> m_removed_proxies;
+
+	/** holds the endpoints, sorted along the sweep axis. */
+	_array<sap_endpoint> m_endpoints;
+
+	/** holds the proxies whose extent is open during the sweep. */
+	_array<uint32_t> m_open;
+
+	/** holds the overlapping pairs found by the last update. */
+	_array<potential_contact> m_pairs;
+
+	/** the number of overlapping pairs found by the last update. */
+	uint32_t m_pair_count;
+
+	/**
+	* the number of overlapping pairs left out by the last update,
+	* because their categories and masks don't let them collide.
+	*/
+	uint32_t m_filtered_count;
+
+	/** the number of endpoint swaps made by the last sort. */
+	uint32_t m_swap_count;
+
+	/**
+	* adds a primitive and returns the proxy handle for it. the
+	* primitive's transform must be up to date before the next update.
+	*/
+	uint32_t insert(collision_primitive *primitive, primitive_type type);
+
+	/**
+	* removes the proxy with the given handle. the handle must not
+	* be used again.
+	*/
+	void remove(uint32_t proxy);
+
+	/**
+	* recalculates the bounds of every proxy from its primitive,
+	* restores the endpoint order and finds the overlapping pairs
+	* whose categories and masks let them collide.
+	*/
+	void update();
+
+	/**
+	* removes every proxy.
+	*/
+	void clear();
+};
+
+/**
+* one entry in the spatial hash.
+*/
+struct spatial_hash_item {
+
+	/** the primitive this item stands for. */
+	collision_primitive * m_primitive;
+
+	/** the shape of the primitive. */
+	primitive_type m_type;
+
+	/** the bounds of the primitive when it was inserted. */
+	bounding_box m_bounds;
+
+	/** the grid cell that holds the centre of the bounds. */
+	int32_t m_cell[3];
+};
+
+/**
+* a uniform grid of cells, stored in a hash table so the grid
+* does not need to be bounded.
+*
+* the hash is meant for large numbers of small primitives, such as
+* rounds, that move too fast for the sorted lists of the sweep and
+* prune to stay coherent. it is rebuilt every step: clear it, insert
+* every primitive, then call build before making queries.
+*
+* each item is stored in the single cell that holds the centre of
+* its bounds. as long as no item is larger than a cell, any two
+* overlapping items are in the same or neighbouring cells, so a pair
+* search only has to look at the 27 cells around each item.
+*/
+struct spatial_hash {
+
+	spatial_hash();
+
+	/** the edge length of a grid cell. */
+	float m_cell_size;
+
+	/** the largest half extent of any item inserted since the last clear. */
+	float m_max_extent;
+
+	/**
+	* the number of overlapping pairs left out by the last findpairs,
+	* because their categories and masks don't let them collide.
+	*/
+	uint32_t m_filtered_count;
+
+	/** the number of buckets in the table, always a power of two. */
+	uint32_t m_bucket_count;
+
+	/** holds the items inserted since the last clear. */
+	_array<spatial_hash_item> m_items;
+
+	/**
+	* holds the first sorted item of each bucket. the items of bucket
+	* b are m_sorted[ m_bucket_start[b] ] up to m_bucket_start[b+1].
+	*/
+	_array<uint32_t> m_bucket_start;
+
+	/** holds the item indices, sorted by bucket. */
+	_array<uint32_t> m_sorted;
+
+	/**
+	* sets the edge length of the grid cells. this should be at
+	* least the diameter of the largest item that will be inserted.
+	*/
+	void setcellsize(float size);
+
+	/**
+	* removes every item.
+	*/
+	void clear();
+
+	/**
+	* adds a primitive and returns its item index. the primitive's
+	* transform must be up to date.
+	*/
+	uint32_t insert(collision_primitive *primitive, primitive_type type);
+
+	/**
+	* sorts the inserted items into their buckets. this must be
+	* called after the last insert and before any query.
+	*/
+	void build();
+
+	/**
+	* finds the items whose bounds overlap the given bounds, and writes
+	* their indices into results. returns the number of items found.
+	*/
+	uint32_t query(const bounding_box &bounds, _array<uint32_t> *results);
+
+	/**
+	* finds every pair of items whose bounds overlap, and whose
+	* categories and masks let them collide, and writes them into
+	* pairs. returns the number of pairs found.
+	*/
+	uint32_t findpairs(_array<potential_contact> *pairs);
+
+	/**
+	* returns the bucket that holds the given cell.
+	*/
+	uint32_t bucket(int32_t x, int32_t y, int32_t z) const {
+		return ( uint32_t(x)*73856093u ^ uint32_t(y)*19349663u ^ uint32_t(z)*83492791u ) & (m_bucket_count-1);
+	}
+
+	/**
+	* returns the cell that holds the given coordinate.
+	*/
+	int32_t cell(float value) const { return int32_t( floor(value / m_cell_size) ); }
+};
+
+#define aabb_null_node 0xffffffff
+
+/**
+* one node in the dynamic bounding volume tree. leaves hold a
+* primitive, every other node has exactly two children and encloses
+* them both.
+*/
+struct aabb_tree_node {
+
+	/**
+	* holds the bounds of the node. for a leaf these are the bounds of
+	* its primitive grown by the tree's margin.
+	*/
+	bounding_box m_bounds;
+
+	/** the primitive held by a leaf, NULL for other nodes. */
+	collision_primitive * m_primitive;
+
+	/** the shape of the primitive. */
+	primitive_type m_type;
+
+	/** the parent of the node, or the next free node when unused. */
+	uint32_t m_parent;
+
+	/** the children of the node, aabb_null_node for leaves. */
+	uint32_t m_child[2];
+
+	/** leaves have a height of 0 and unused nodes a height of -1. */
+	int32_t m_height;
+
+	bool isleaf() const { return m_child[0] == aabb_null_node; }
+};
+
+/**
+* a dynamic bounding volume tree.
+*
+* every primitive is stored in a leaf whose bounds are grown by a
+* margin, so a primitive that moves a little stays inside its leaf
+* and the tree is left alone. only when a primitive leaves its bounds
+* is it removed and inserted again. insertion picks the sibling that
+* adds the least surface area to the tree, and the tree is kept
+* balanced by rotating nodes on the way back up to the root.
+*
+* queries descend only into nodes whose bounds are hit, so they run
+* in logarithmic time for primitives that are spread out. static
+* geometry can be inserted as well and is never moved.
+*/
+struct dynamic_aabb_tree {
+
+	dynamic_aabb_tree();
+
+	/** the distance the leaf bounds are grown by on every side. */
+	float m_margin;
+
+	/** the root node of the tree. */
+	uint32_t m_root;
+
+	/** holds every node, used or not. */
+	_array<aabb_tree_node> m_nodes;
+
+	/** the first node of the list of unused nodes. */
+	uint32_t m_free_list;
+
+	/** the number of leaves in the tree. */
+	uint32_t m_leaf_count;
+
+	/** the number of leaves inserted again by the last refit. */
+	uint32_t m_reinsert_count;
+
+	/** holds the overlapping pairs found by the last findpairs. */
+	_array<potential_contact> m_pairs;
+
+	/** the number of overlapping pairs found by the last findpairs. */
+	uint32_t m_pair_count;
+
+	/**
+	* the number of overlapping pairs left out by the last findpairs,
+	* because their categories and masks don't let them collide.
+	*/
+	uint32_t m_filtered_count;
+
+	/** holds the nodes still to visit during a query. */
+	_array<uint32_t> m_stack;
+
+	/**
+	* adds a primitive and returns the proxy handle for it. the
+	* primitive's transform must be up to date.
+	*/
+	uint32_t insert(collision_primitive *primitive, primitive_type type);
+
+	/**
+	* removes the proxy with the given handle. the handle must not
+	* be used again.
+	*/
+	void remove(uint32_t proxy);
+
+	/**
+	* recalculates the bounds of the proxy's primitive, and moves the
+	* proxy in the tree if they have left its leaf. returns true if
+	* the proxy was moved.
+	*/
+	bool update(uint32_t proxy);
+
+	/**
+	* calls update for every proxy in the tree whose body is awake.
+	* a sleeping body doesn't move, so its proxy is left alone.
+	*/
+	void refit();
+
+	/**
+	* removes every proxy.
+	*/
+	void clear();
+
+	/**
+	* finds every pair of proxies whose bounds overlap, and writes them
+	* into m_pairs. returns the number of pairs found. pairs where
+	* neither body is awake, or that have no bodies, are left out, as
+	* are pairs whose categories and masks don't let them collide.
+	*/
+	uint32_t findpairs();
+
+	/**
+	* finds the proxies whose bounds overlap the given bounds, and writes
+	* their handles into results. returns the number of proxies found.
+	*/
+	uint32_t query(const bounding_box &bounds, _array<uint32_t> *results);
+
+	/**
+	* finds the proxies whose bounds are hit by the ray before the given
+	* distance, and writes their handles into results in no particular
+	* order. returns the number of proxies found.
+	*/
+	uint32_t raycast(const _vec3 &origin, const _vec3 &direction, float max_distance, _array<uint32_t> *results);
+
+	/**
+	* returns the leaf node with the given proxy handle.
+	*/
+	const aabb_tree_node& getproxy(uint32_t proxy) const { return m_nodes[proxy]; }
+
+protected:
+
+	uint32_t allocatenode();
+	void freenode(uint32_t node);
+	void insertleaf(uint32_t leaf);
+	void removeleaf(uint32_t leaf);
+
+	/**
+	* recalculates the bounds and height of every node from the given
+	* node up to the root, rotating unbalanced nodes on the way.
+	*/
+	void fixupwards(uint32_t node);
+
+	/**
+	* rotates the given node if one child is more than one level taller
+	* than the other. returns the node that took its place.
+	*/
+	uint32_t balance(uint32_t node);
+};
@@ -1,641 +1,1606 @@
-#include "collide_fine.h"
-
-#include <memory.h>
-#include <cstdlib>
-#include <cstdio>
-
-void collision_primitive::calculateinternals() {
-    m_transform = m_body->gettransform() * m_offset;
-}
-
-bool intersection_tests::sphereandhalfspace( const collision_sphere &sphere, const collision_plane &plane) {
-    // find the distance from the origin
-    float balldistance =_dot( plane.m_direction,sphere.getaxis(3) ) - sphere.m_radius;
-
-    // check for the intersection
-    return balldistance <= plane.m_offset;
-}
-
-bool intersection_tests::sphereandsphere( const collision_sphere &one, const collision_sphere &two) {
-    // find the vector between the objects
-    _vec3 midline = one.getaxis(3) - two.getaxis(3);
-
-    // see if it is large enough.
-    return midline.squaremagnitude() < (one.m_radius+two.m_radius)*(one.m_radius+two.m_radius);
-}
-
-static inline float transformtoaxis( const collision_box &box, const _vec3 &axis ) {
-    return
-        box.m_half_size.x * abs( _dot( axis , box.getaxis(0) ) ) +
-        box.m_half_size.y * abs( _dot( axis , box.getaxis(1) ) ) +
-        box.m_half_size.z * abs( _dot( axis , box.getaxis(2) ) );
-}
-
-/**
- * this function checks if the two boxes overlap
- * along the given axis. the final parameter tocentre
- * is used to pass in the vector between the boxes centre
- * points, to avoid having to recalculate it each time.
- */
-static inline bool overlaponaxis(
-    const collision_box &one,
-    const collision_box &two,
-    const _vec3 &axis,
-    const _vec3 &tocentre
-    )
-{
-    // project the half-size of one onto axis
-    float oneproject = transformtoaxis(one, axis);
-    float twoproject = transformtoaxis(two, axis);
-
-    // project this onto the axis
-    float distance = abs( _dot(tocentre , axis) );
-
-    // check for overlap
-    return (distance < oneproject + twoproject);
-}
-
-// this preprocessor definition is only used as a convenience
-// in the boxandbox intersection  method.
-#define test_overlap(axis) overlaponaxis(one, two, (axis), tocentre)
-
-bool intersection_tests::boxandbox(
-	const collision_box &one,
-	const collision_box &two
-	)
-{
-	// find the vector between the two centres
-	_vec3 tocentre = two.getaxis(3) - one.getaxis(3);
-
-	return (
-		// check on box one's axes first
-		test_overlap(one.getaxis(0)) &&
-		test_overlap(one.getaxis(1)) &&
-		test_overlap(one.getaxis(2)) &&
-
-		// and on two's
-		test_overlap(two.getaxis(0)) &&
-		test_overlap(two.getaxis(1)) &&
-		test_overlap(two.getaxis(2)) &&
-
-		// now on the cross products
-		test_overlap( _cross( one.getaxis(0) , two.getaxis(0) ) ) &&
-		test_overlap( _cross( one.getaxis(0) , two.getaxis(1) ) ) &&
-		test_overlap( _cross( one.getaxis(0) , two.getaxis(2) ) ) &&
-		test_overlap( _cross( one.getaxis(1) , two.getaxis(0) ) ) &&
-		test_overlap( _cross( one.getaxis(1) , two.getaxis(1) ) ) &&
-		test_overlap( _cross( one.getaxis(1) , two.getaxis(2) ) ) &&
-		test_overlap( _cross( one.getaxis(2) , two.getaxis(0) ) ) &&
-		test_overlap( _cross( one.getaxis(2) , two.getaxis(1) ) ) &&
-		test_overlap( _cross( one.getaxis(2) , two.getaxis(2) ) )
-		);
-}
-#undef test_overlap
-
-bool intersection_tests::boxandhalfspace(
-    const collision_box &box,
-    const collision_plane &plane
-    )
-{
-    // work out the projected radius of the box onto the plane direction
-    float projectedradius = transformtoaxis(box, plane.m_direction);
-
-    // work out how far the box is from the origin
-    float boxdistance = _dot( plane.m_direction , box.getaxis(3) ) - projectedradius;
-
-    // check for the intersection
-    return boxdistance <= plane.m_offset;
-}
-
-uint32_t collision_detector::sphereandtrueplane(
-    const collision_sphere &sphere,
-    const collision_plane &plane,
-    collision_data *data
-    )
-{
-    // make sure we have contacts
-	if (data->m_contacts_left <= 0) { return 0; }
-
-    // cache the sphere position
-    _vec3 position = sphere.getaxis(3);
-
-    // find the distance from the plane
-    float centredistance = _dot( plane.m_direction , position ) - plane.m_offset;
-
-    // check if we're within radius
-    if (centredistance*centredistance > sphere.m_radius*sphere.m_radius) { return 0; }
-
-    // check which side of the plane we're on
-    _vec3 normal = plane.m_direction;
-    float penetration = -centredistance;
-    if (centredistance < 0) {
-        normal *= -1;
-        penetration = -penetration;
-    }
-    penetration += sphere.m_radius;
-
-    // create the contact - it has a normal in the plane direction.
-    contact* contact = data->m_contacts;
-    contact->m_contact_normal = normal;
-    contact->m_penetration = penetration;
-    contact->m_contact_point = position - plane.m_direction * centredistance;
-    contact->setbodydata(sphere.m_body, NULL,data->m_friction, data->m_restitution);
-
-    data->addcontacts(1);
-    return 1;
-}
-
-uint32_t collision_detector::sphereandhalfspace(
-    const collision_sphere &sphere,
-    const collision_plane &plane,
-    collision_data *data
-    )
-{
-    // make sure we have contacts
-	if (data->m_contacts_left <= 0) { return 0; }
-
-    // cache the sphere position
-    _vec3 position = sphere.getaxis(3);
-
-    // find the distance from the plane
-    float balldistance = _dot( plane.m_direction , position) - sphere.m_radius - plane.m_offset;
-
-	if (balldistance >= 0) { return 0; }
-
-    // create the contact - it has a normal in the plane direction.
-    contact* contact = data->m_contacts;
-    contact->m_contact_normal = plane.m_direction;
-    contact->m_penetration = -balldistance;
-    contact->m_contact_point =  position - plane.m_direction * (balldistance + sphere.m_radius);
-    contact->setbodydata(sphere.m_body, NULL, data->m_friction, data->m_restitution);
-
-    data->addcontacts(1);
-    return 1;
-}
-
-uint32_t collision_detector::sphereandsphere(
-    const collision_sphere &one,
-    const collision_sphere &two,
-    collision_data *data
-    )
-{
-    // make sure we have contacts
-	if (data->m_contacts_left <= 0) { return 0; }
-
-    // cache the sphere positions
-    _vec3 positionone = one.getaxis(3);
-    _vec3 positiontwo = two.getaxis(3);
-
-    // find the vector between the objects
-    _vec3 midline = positionone - positiontwo;
-    float size = midline.magnitude();
-
-    // see if it is large enough.
-    if (size <= 0.0f || size >= one.m_radius+two.m_radius) { return 0; }
-
-    // we manually create the normal, because we have the
-    // size to hand.
-    _vec3 normal = midline * (1.0f/size);
-
-    contact* contact = data->m_contacts;
-    contact->m_contact_normal = normal;
-    contact->m_contact_point = positionone + midline * 0.5f;
-    contact->m_penetration = (one.m_radius+two.m_radius - size);
-    contact->setbodydata(one.m_body, two.m_body,data->m_friction, data->m_restitution);
-
-    data->addcontacts(1);
-    return 1;
-}
-
-
-
-
-/*
- * this function checks if the two boxes overlap
- * along the given axis, returning the ammount of overlap.
- * the final parameter tocentre
- * is used to pass in the vector between the boxes centre
- * points, to avoid having to recalculate it each time.
- */
-static inline float penetrationonaxis(
-    const collision_box &one,
-    const collision_box &two,
-    const _vec3 &axis,
-    const _vec3 &tocentre
-    )
-{
-    // project the half-size of one onto axis
-    float oneproject = transformtoaxis(one, axis);
-    float twoproject = transformtoaxis(two, axis);
-
-    // project this onto the axis
-    float distance = abs( _dot( tocentre , axis ) );
-
-    // return the overlap (i.e. positive indicates
-    // overlap, negative indicates separation).
-    return oneproject + twoproject - distance;
-}
-
-
-static inline bool tryaxis(
-    const collision_box &one,
-    const collision_box &two,
-    _vec3 axis,
-    const _vec3& tocentre,
-    uint32_t index,
-
-    // these values may be updated
-    float& smallestpenetration,
-    uint32_t &smallestcase
-    )
-{
-    // make sure we have a normalized axis, and don't check almost parallel axes
-	if (axis.squaremagnitude() < 0.0001f) { return true; }
-    axis.normalise();
-
-    float penetration = penetrationonaxis(one, two, axis, tocentre);
-
-	if (penetration < 0) { return false; }
-    if (penetration < smallestpenetration) {
-        smallestpenetration = penetration;
-        smallestcase = index;
-    }
-    return true;
-}
-
-void fillpointfaceboxbox(
-    const collision_box &one,
-    const collision_box &two,
-    const _vec3 &tocentre,
-    collision_data *data,
-    uint32_t best,
-    float pen
-    )
-{
-    // this method is called when we know that a vertex from
-    // box two is in contact with box one.
-
-    contact* contact = data->m_contacts;
-
-    // we know which axis the collision is on (i.e. best),
-    // but we need to work out which of the two faces on
-    // this axis.
-    _vec3 normal = one.getaxis(best);
-    if ( _dot( one.getaxis(best) , tocentre ) > 0) { normal = normal * -1.0f; }
-
-    // work out which vertex of box two we're colliding with.
-    // using tocentre doesn't work!
-    _vec3 vertex = two.m_half_size;
-    if ( _dot( two.getaxis(0) , normal ) < 0) { vertex.x = -vertex.x; }
-    if ( _dot( two.getaxis(1) , normal ) < 0) { vertex.y = -vertex.y; }
-	if ( _dot( two.getaxis(2) , normal ) < 0) { vertex.z = -vertex.z; }
-
-    // create the contact data
-    contact->m_contact_normal = normal;
-    contact->m_penetration = pen;
-    contact->m_contact_point = two.gettransform() * vertex;
-    contact->setbodydata(one.m_body, two.m_body,data->m_friction, data->m_restitution);
-}
-
-static inline _vec3 contactpoint(
-    const _vec3 &pone,
-    const _vec3 &done,
-    float onesize,
-    const _vec3 &ptwo,
-    const _vec3 &dtwo,
-    float twosize,
-
-    // if this is true, and the contact point is outside
-    // the edge (in the case of an edge-face contact) then
-    // we use one's midpoint, otherwise we use two's.
-    bool useone)
-{
-    _vec3 tost, cone, ctwo;
-    float dpstaone, dpstatwo, dponetwo, smone, smtwo;
-    float denom, mua, mub;
-
-    smone = done.squaremagnitude();
-    smtwo = dtwo.squaremagnitude();
-    dponetwo = _dot( dtwo , done );
-
-    tost = pone - ptwo;
-    dpstaone = _dot( done , tost );
-    dpstatwo = _dot( dtwo , tost );
-
-    denom = smone * smtwo - dponetwo * dponetwo;
-
-    // zero denominator indicates parrallel lines
-    if ( abs(denom) < 0.0001f ) { return useone?pone:ptwo; }
-
-    mua = (dponetwo * dpstatwo - smtwo * dpstaone) / denom;
-    mub = (smone * dpstatwo - dponetwo * dpstaone) / denom;
-
-    // if either of the edges has the nearest point out
-    // of bounds, then the edges aren't crossed, we have
-    // an edge-face contact. our point is on the edge, which
-    // we know from the useone parameter.
-    if (mua > onesize ||
-        mua < -onesize ||
-		mub > twosize ||
-		mub < -twosize)
-	{
-		return useone?pone:ptwo;
-	}
-	else {
-		cone = pone + done * mua;
-		ctwo = ptwo + dtwo * mub;
-
-		return cone * 0.5 + ctwo * 0.5;
-	}
-}
-
-// this preprocessor definition is only used as a convenience
-// in the boxandbox contact generation method.
-#define _check_overlap(axis, index) \
-	if (!tryaxis(one, two, (axis), tocentre, (index), pen, best)) { return 0; }
-
-uint32_t collision_detector::boxandbox(
-    const collision_box &one,
-    const collision_box &two,
-    collision_data *data
-    )
-{
-    //if (!intersection_tests::boxandbox(one, two)) return 0;
-
-    // find the vector between the two centres
-    _vec3 tocentre = two.getaxis(3) - one.getaxis(3);
-
-    // we start assuming there is no contact
-    float pen = FLT_MAX;
-    uint32_t best = 0xffffff;
-
-    // now we check each axes, returning if it gives us
-    // a separating axis, and keeping track of the axis with
-    // the smallest penetration otherwise.
-    _check_overlap(one.getaxis(0), 0);
-    _check_overlap(one.getaxis(1), 1);
-    _check_overlap(one.getaxis(2), 2);
-
-    _check_overlap(two.getaxis(0), 3);
-    _check_overlap(two.getaxis(1), 4);
-    _check_overlap(two.getaxis(2), 5);
-
-    // store the best axis-major, in case we run into almost
-    // parallel edge collisions later
-    uint32_t bestsingleaxis = best;
-
-    _check_overlap( _cross( one.getaxis(0) , two.getaxis(0) ), 6);
-    _check_overlap( _cross( one.getaxis(0) , two.getaxis(1) ), 7);
-    _check_overlap( _cross( one.getaxis(0) , two.getaxis(2) ), 8);
-    _check_overlap( _cross( one.getaxis(1) , two.getaxis(0) ), 9);
-    _check_overlap( _cross( one.getaxis(1) , two.getaxis(1) ), 10);
-    _check_overlap( _cross( one.getaxis(1) , two.getaxis(2) ), 11);
-    _check_overlap( _cross( one.getaxis(2) , two.getaxis(0) ), 12);
-    _check_overlap( _cross( one.getaxis(2) , two.getaxis(1) ), 13);
-    _check_overlap( _cross( one.getaxis(2) , two.getaxis(2) ), 14);
-
-    // make sure we've got a result.
-	if(best == 0xffffff){ application_error("best");  }
-
-    // we now know there's a collision, and we know which
-    // of the axes gave the smallest penetration. we now
-    // can deal with it in different ways depending on
-    // the case.
-    if (best < 3) {
-        // we've got a vertex of box two on a face of box one.
-        fillpointfaceboxbox(one, two, tocentre, data, best, pen);
-        data->addcontacts(1);
-        return 1;
-    }else if (best < 6){
-        // we've got a vertex of box one on a face of box two.
-        // we use the same algorithm as above, but swap around
-        // one and two (and therefore also the vector between their
-        // centres).
-        fillpointfaceboxbox(two, one, tocentre*-1.0f, data, best-3, pen);
-        data->addcontacts(1);
-        return 1;
-    }else {
-        // we've got an edge-edge contact. find out which axes
-        best -= 6;
-        uint32_t oneaxisindex = best / 3;
-        uint32_t twoaxisindex = best % 3;
-
-
-        _vec3 oneaxis = one.getaxis(oneaxisindex);
-        _vec3 twoaxis = two.getaxis(twoaxisindex);
-        _vec3 axis = _cross( oneaxis , twoaxis);
-        axis.normalise();
-
-        // the axis should point from box one to box two.
-        if ( _dot(axis , tocentre) > 0) axis = axis * -1.0f;
-
-        // we have the axes, but not the edges: each axis has 4 edges parallel
-        // to it, we need to find which of the 4 for each object. we do
-        // that by finding the point in the centre of the edge. we know
-        // its component in the direction of the box's collision axis is zero
-        // (its a mid-point) and we determine which of the extremes in each
-        // of the other axes is closest.
-        _vec3 ptononeedge = one.m_half_size;
-        _vec3 ptontwoedge = two.m_half_size;
-        for (uint32_t i = 0; i < 3; i++) {
-            if (i == oneaxisindex) ptononeedge[i] = 0;
-			else if ( _dot( one.getaxis(i) , axis ) > 0) { ptononeedge[i] = -ptononeedge[i]; }
-
-            if (i == twoaxisindex) ptontwoedge[i] = 0;
-			else if ( _dot( two.getaxis(i) , axis ) < 0) { ptontwoedge[i] = -ptontwoedge[i]; }
-        }
-
-        // move them into world coordinates (they are already oriented
-        // correctly, since they have been derived from the axes).
-        ptononeedge = one.m_transform * ptononeedge;
-        ptontwoedge = two.m_transform * ptontwoedge;
-
-        // so we have a point and a direction for the colliding edges.
-        // we need to find out point of closest approach of the two
-        // line-segments.
-        _vec3 vertex = contactpoint(
-            ptononeedge, oneaxis, one.m_half_size[oneaxisindex],
-            ptontwoedge, twoaxis, two.m_half_size[twoaxisindex],
-            bestsingleaxis > 2
-            );
-
-        // we can fill the contact.
-        contact* contact = data->m_contacts;
-
-        contact->m_penetration = pen;
-        contact->m_contact_normal = axis;
-        contact->m_contact_point = vertex;
-        contact->setbodydata(one.m_body, two.m_body,
-            data->m_friction, data->m_restitution);
-
-        data->addcontacts(1);
-        return 1;
-    }
-    return 0;
-}
-#undef _check_overlap
-
-
-
-
-uint32_t collision_detector::boxandpoint(
-    const collision_box &box,
-    const _vec3 &point,
-    collision_data *data
-    )
-{
-    // transform the point into box coordinates
-    _vec3 relpt = box.m_transform.transforminverse(point);
-
-    _vec3 normal;
-
-    // check each axis, looking for the axis on which the
-    // penetration is least deep.
-    float min_depth = box.m_half_size.x - abs(relpt.x);
-	if (min_depth < 0) { return 0; }
-
-    normal = box.getaxis(0) * ((relpt.x < 0)?-1.0f:1.0f);
-
-    float depth = box.m_half_size.y - abs(relpt.y);
-	if (depth < 0) { return 0; }
-    else if (depth < min_depth) {
-        min_depth = depth;
-        normal = box.getaxis(1) * ((relpt.y < 0)?-1.0f:1.0f);
-    }
-
-    depth = box.m_half_size.z - abs(relpt.z);
-	if (depth < 0) { return 0; }
-    else if (depth < min_depth) {
-        min_depth = depth;
-        normal = box.getaxis(2) * ((relpt.z < 0)?-1.0f:1.0f);
-    }
-
-    // compile the contact
-    contact* contact = data->m_contacts;
-    contact->m_contact_normal = normal;
-    contact->m_contact_point = point;
-    contact->m_penetration = min_depth;
-
-    // note that we don't know what rigid body the point
-    // belongs to, so we just use null. where this is called
-    // this value can be left, or filled in.
-    contact->setbodydata(box.m_body, NULL, data->m_friction, data->m_restitution);
-
-    data->addcontacts(1);
-    return 1;
-}
-
-uint32_t collision_detector::boxandsphere(
-    const collision_box &box,
-    const collision_sphere &sphere,
-    collision_data *data
-    )
-{
-    // transform the centre of the sphere into box coordinates
-    _vec3 centre = sphere.getaxis(3);
-    _vec3 relcentre = box.m_transform.transforminverse(centre);
-
-    // early out check to see if we can exclude the contact
-    if (abs(relcentre.x) - sphere.m_radius > box.m_half_size.x ||
-        abs(relcentre.y) - sphere.m_radius > box.m_half_size.y ||
-        abs(relcentre.z) - sphere.m_radius > box.m_half_size.z)
-    {
-        return 0;
-    }
-
-    _vec3 closestpt(0,0,0);
-    float dist;
-
-    // clamp each coordinate to the box.
-    dist = relcentre.x;
-	if (dist > box.m_half_size.x) { dist = box.m_half_size.x; }
-	if (dist < -box.m_half_size.x) { dist = -box.m_half_size.x; }
-    closestpt.x = dist;
-
-    dist = relcentre.y;
-	if (dist > box.m_half_size.y) { dist = box.m_half_size.y; }
-	if (dist < -box.m_half_size.y) { dist = -box.m_half_size.y; }
-    closestpt.y = dist;
-
-    dist = relcentre.z;
-	if (dist > box.m_half_size.z)  { dist = box.m_half_size.z; }
-	if (dist < -box.m_half_size.z) { dist = -box.m_half_size.z; }
-    closestpt.z = dist;
-
-    // check we're in contact
-    dist = (closestpt - relcentre).squaremagnitude();
-	if (dist > sphere.m_radius * sphere.m_radius) { return 0; }
-
-    // compile the contact
-    _vec3 closestptworld = box.m_transform.transform(closestpt);
-
-    contact* contact = data->m_contacts;
-    contact->m_contact_normal = (closestptworld - centre);
-    contact->m_contact_normal.normalise();
-
-
-    contact->m_contact_point = closestptworld;
-    contact->m_penetration = sphere.m_radius - sqrt(dist);
-    contact->setbodydata(box.m_body, sphere.m_body,data->m_friction, data->m_restitution);
-
-    data->addcontacts(1);
-    return 1;
-}
-
-uint32_t collision_detector::boxandhalfspace(
-    const collision_box &box,
-    const collision_plane &plane,
-    collision_data *data
-    )
-{
-    // make sure we have contacts
-	if (data->m_contacts_left <= 0) { return 0; }
-
-    // check for intersection
-    if (!intersection_tests::boxandhalfspace(box, plane)) { return 0; }
-
-    // we have an intersection, so find the intersection points. we can make
-    // do with only checking vertices. if the box is resting on a plane
-    // or on an edge, it will be reported as four or two contact points.
-
-    // go through each combination of + and - for each half-size
-    static float mults[8][3] = {{1,1,1},{-1,1,1},{1,-1,1},{-1,-1,1},
-                               {1,1,-1},{-1,1,-1},{1,-1,-1},{-1,-1,-1}};
-
-    contact* contact = data->m_contacts;
-    uint32_t contactsused = 0;
-    for (uint32_t i = 0; i < 8; i++) {
-
-        // calculate the position of each vertex
-        _vec3 vertexpos(mults[i][0], mults[i][1], mults[i][2]);
-        vertexpos.componentproductupdate(box.m_half_size);
-        vertexpos = box.m_transform.transform(vertexpos);
-
-        // calculate the distance from the plane
-        float vertexdistance = _dot( vertexpos , plane.m_direction );
-
-        // compare this to the plane's distance
-        if (vertexdistance <= plane.m_offset) {
-            // create the contact data.
-
-            // the contact point is halfway between the vertex and the
-            // plane - we multiply the direction by half the separation
-            // distance and add the vertex location.
-            contact->m_contact_point  = plane.m_direction;
-            contact->m_contact_point *= (vertexdistance-plane.m_offset);
-            contact->m_contact_point += vertexpos;
-            contact->m_contact_normal = plane.m_direction;
-            contact->m_penetration    = plane.m_offset - vertexdistance;
-            // write the appropriate data
-            contact->setbodydata(box.m_body, NULL,data->m_friction, data->m_restitution);
-
-            // move onto the next contact
-            contact++;
-            contactsused++;
-			if (contactsused == (uint32_t)data->m_contacts_left) { return contactsused; }
-        }
-    }
-
-    data->addcontacts(contactsused);
-    return contactsused;
-}
+#include "collide_fine.h"
+
+#include <memory.h>
+#include <cstdlib>
+#include <cstdio>
+
+#ifdef physics_simd
+#include <emmintrin.h>
+#endif
+
+bool collision_detector::s_simd = true;
+bool collision_detector::s_reduce = true;
+
+void collision_primitive::calculateinternals() {
+    m_transform = m_body->gettransform() * m_offset;
+}
+
+collision_data::collision_data() {
+    m_contact_array  = NULL;
+    m_contacts       = NULL;
+    m_contacts_left  = 0;
+    m_contact_count  = 0;
+    m_contact_limit  = 0;
+    m_reduced_count  = 0;
+    m_overflow_count = 0;
+    m_high_water     = 0;
+    m_grow_count     = 0;
+    m_friction       = 0.0f;
+    m_restitution    = 0.0f;
+}
+
+bool collision_data::create( uint32_t capacity, uint32_t limit ) {
+    destroy();
+
+    if (capacity < 1) { capacity = 1; }
+    if (limit && capacity > limit) { capacity = limit; }
+    m_buffer.alloc(capacity);
+    if (!m_buffer.m_data) { application_throw("collision_data create"); }
+
+    m_contact_limit = limit;
+    m_high_water    = 0;
+    m_grow_count    = 0;
+    reset();
+    return true;
+}
+
+void collision_data::destroy() {
+    m_buffer.clear();
+    m_contact_limit = 0;
+    reset();
+}
+
+uint32_t collision_data::reserve( uint32_t count ) {
+    if (m_contacts_left >= int32_t(count)) { return count; }
+
+    // grow by half again, or to fit, whichever is more, but never
+    // past the limit.
+    uint32_t needed = m_contact_count + count;
+    uint32_t size   = m_buffer.m_size + m_buffer.m_size/2;
+    if (size < needed) { size = needed; }
+    if (m_contact_limit && size > m_contact_limit) { size = m_contact_limit; }
+
+    if (size > m_buffer.m_size) {
+        m_buffer.alloc(size);
+        m_grow_count++;
+
+        // the contacts found so far have moved with the array
+        m_contact_array = m_buffer.m_data;
+        m_contacts      = m_contact_array + m_contact_count;
+        m_contacts_left = int32_t(m_buffer.m_size - m_contact_count);
+    }
+
+    uint32_t room = (m_contacts_left > 0) ? uint32_t(m_contacts_left) : 0;
+    if (room >= count) { return count; }
+
+    // the contacts dropped still count towards the high water, it is
+    // how many were found that shows how much room is needed.
+    m_overflow_count += count - room;
+    uint32_t found = m_contact_count + room + m_overflow_count;
+    if (found > m_high_water) { m_high_water = found; }
+    return room;
+}
+
+bool intersection_tests::sphereandhalfspace( const collision_sphere &sphere, const collision_plane &plane) {
+    // find the distance from the origin
+    float balldistance =_dot( plane.m_direction,sphere.getaxis(3) ) - sphere.m_radius;
+
+    // check for the intersection
+    return balldistance <= plane.m_offset;
+}
+
+bool intersection_tests::sphereandsphere( const collision_sphere &one, const collision_sphere &two) {
+    // find the vector between the objects
+    _vec3 midline = one.getaxis(3) - two.getaxis(3);
+
+    // see if it is large enough.
+    return midline.squaremagnitude() < (one.m_radius+two.m_radius)*(one.m_radius+two.m_radius);
+}
+
+/*
+ * identifies a plane in a contact's feature id, from the bits of its
+ * direction and offset, so contacts against different planes of the
+ * scenery are told apart by the contact cache.
+ */
+static inline uint32_t planefeature( const collision_plane &plane ) {
+    uint32_t bits[4];
+    memcpy(&bits[0], &plane.m_direction.x, sizeof(float));
+    memcpy(&bits[1], &plane.m_direction.y, sizeof(float));
+    memcpy(&bits[2], &plane.m_direction.z, sizeof(float));
+    memcpy(&bits[3], &plane.m_offset, sizeof(float));
+    return bits[0]*73856093u ^ bits[1]*19349663u ^ bits[2]*83492791u ^ bits[3]*2654435761u;
+}
+
+/*
+ * swaps the deepest of the contacts to the front.
+ */
+static inline void keepdeepest( contact *contacts, uint32_t count ) {
+    uint32_t best = 0;
+    for (uint32_t i = 1; i < count; i++) {
+        if (contacts[i].m_penetration > contacts[best].m_penetration) { best = i; }
+    }
+    if (best) {
+        contact kept = contacts[best];
+        contacts[best] = contacts[0];
+        contacts[0] = kept;
+    }
+}
+
+/*
+ * writes the contacts of one manifold, reduced when s_reduce is set.
+ * the deepest is kept if there's only room for some of them.
+ */
+static uint32_t addmanifold( contact *found, uint32_t contactsfound, const _vec3 &normal, collision_data *data ) {
+    uint32_t contactsused = contactsfound;
+    if (collision_detector::s_reduce) { contactsused = collision_detector::reducemanifold(found, contactsfound, normal); }
+    data->m_reduced_count += contactsfound - contactsused;
+
+    // a reduced manifold has the deepest first. one that is not is
+    // given it first when there's room for only some, so it is kept.
+    uint32_t room = data->reserve(contactsused);
+    if (room < contactsused) { keepdeepest(found, contactsused); }
+    for (uint32_t i = 0; i < room; i++) { data->m_contacts[i] = found[i]; }
+    data->addcontacts(room);
+    return room;
+}
+
+static inline float transformtoaxis( const collision_box &box, const _vec3 &axis ) {
+    return
+        box.m_half_size.x * abs( _dot( axis , box.getaxis(0) ) ) +
+        box.m_half_size.y * abs( _dot( axis , box.getaxis(1) ) ) +
+        box.m_half_size.z * abs( _dot( axis , box.getaxis(2) ) );
+}
+
+/**
+ * this function checks if the two boxes overlap
+ * along the given axis. the final parameter tocentre
+ * is used to pass in the vector between the boxes centre
+ * points, to avoid having to recalculate it each time.
+ */
+static inline bool overlaponaxis(
+    const collision_box &one,
+    const collision_box &two,
+    const _vec3 &axis,
+    const _vec3 &tocentre
+    )
+{
+    // project the half-size of one onto axis
+    float oneproject = transformtoaxis(one, axis);
+    float twoproject = transformtoaxis(two, axis);
+
+    // project this onto the axis
+    float distance = abs( _dot(tocentre , axis) );
+
+    // check for overlap
+    return (distance < oneproject + twoproject);
+}
+
+#ifdef physics_simd
+
+/*
+ * the 15 separating axes of two boxes, four to a register: the face
+ * axes of one, then of two, then the nine edge cross products, in
+ * the order of the scalar tests. the last lane is unused.
+ */
+struct box_axes {
+    __m128 x[4];
+    __m128 y[4];
+    __m128 z[4];
+};
+
+static inline __m128 absps( __m128 v ) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+
+static inline __m128 dotps( __m128 x, __m128 y, __m128 z, const _vec3 &v ) {
+    return _mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(x, _mm_set1_ps(v.x)),
+        _mm_mul_ps(y, _mm_set1_ps(v.y))),
+        _mm_mul_ps(z, _mm_set1_ps(v.z)));
+}
+
+/* the sse version of transformtoaxis, for four axes at once */
+static inline __m128 transformtoaxes( const collision_box &box, __m128 x, __m128 y, __m128 z ) {
+    return _mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(_mm_set1_ps(box.m_half_size.x), absps(dotps(x, y, z, box.getaxis(0)))),
+        _mm_mul_ps(_mm_set1_ps(box.m_half_size.y), absps(dotps(x, y, z, box.getaxis(1))))),
+        _mm_mul_ps(_mm_set1_ps(box.m_half_size.z), absps(dotps(x, y, z, box.getaxis(2)))));
+}
+
+/*
+ * adds the cross products of the lhs and rhs axes to the axes in a
+ * register. lanes that hold a face axis are given zero vectors to
+ * cross, so they are left as they are.
+ */
+static inline void crossps(
+    __m128 *x, __m128 *y, __m128 *z,
+    const _vec3 &l0, const _vec3 &l1, const _vec3 &l2, const _vec3 &l3,
+    const _vec3 &r0, const _vec3 &r1, const _vec3 &r2, const _vec3 &r3
+    )
+{
+    __m128 lx = _mm_setr_ps(l0.x, l1.x, l2.x, l3.x);
+    __m128 ly = _mm_setr_ps(l0.y, l1.y, l2.y, l3.y);
+    __m128 lz = _mm_setr_ps(l0.z, l1.z, l2.z, l3.z);
+    __m128 rx = _mm_setr_ps(r0.x, r1.x, r2.x, r3.x);
+    __m128 ry = _mm_setr_ps(r0.y, r1.y, r2.y, r3.y);
+    __m128 rz = _mm_setr_ps(r0.z, r1.z, r2.z, r3.z);
+
+    *x = _mm_add_ps(*x, _mm_sub_ps(_mm_mul_ps(ly, rz), _mm_mul_ps(lz, ry)));
+    *y = _mm_add_ps(*y, _mm_sub_ps(_mm_mul_ps(lz, rx), _mm_mul_ps(lx, rz)));
+    *z = _mm_add_ps(*z, _mm_sub_ps(_mm_mul_ps(lx, ry), _mm_mul_ps(ly, rx)));
+}
+
+static inline void boxaxes( const collision_box &one, const collision_box &two, box_axes *axes ) {
+    _vec3 a0 = one.getaxis(0), a1 = one.getaxis(1), a2 = one.getaxis(2);
+    _vec3 b0 = two.getaxis(0), b1 = two.getaxis(1), b2 = two.getaxis(2);
+    _vec3 zero(0,0,0);
+
+    axes->x[0] = _mm_setr_ps(a0.x, a1.x, a2.x, b0.x);
+    axes->y[0] = _mm_setr_ps(a0.y, a1.y, a2.y, b0.y);
+    axes->z[0] = _mm_setr_ps(a0.z, a1.z, a2.z, b0.z);
+
+    axes->x[1] = _mm_setr_ps(b1.x, b2.x, 0, 0);
+    axes->y[1] = _mm_setr_ps(b1.y, b2.y, 0, 0);
+    axes->z[1] = _mm_setr_ps(b1.z, b2.z, 0, 0);
+    crossps(&axes->x[1], &axes->y[1], &axes->z[1], zero, zero, a0, a0, zero, zero, b0, b1);
+
+    axes->x[2] = axes->y[2] = axes->z[2] = _mm_setzero_ps();
+    crossps(&axes->x[2], &axes->y[2], &axes->z[2], a0, a1, a1, a1, b2, b0, b1, b2);
+
+    // the unused lane is given a face axis, so it stays finite
+    axes->x[3] = _mm_setr_ps(0, 0, 0, a0.x);
+    axes->y[3] = _mm_setr_ps(0, 0, 0, a0.y);
+    axes->z[3] = _mm_setr_ps(0, 0, 0, a0.z);
+    crossps(&axes->x[3], &axes->y[3], &axes->z[3], a2, a2, a2, zero, b0, b1, b2, zero);
+}
+
+static bool boxandboxsimd( const collision_box &one, const collision_box &two ) {
+
+    box_axes axes;
+    boxaxes(one, two, &axes);
+    _vec3 tocentre = two.getaxis(3) - one.getaxis(3);
+
+    uint32_t overlap = 0;
+    for (uint32_t i = 0; i < 4; i++) {
+        __m128 project = _mm_add_ps(
+            transformtoaxes(one, axes.x[i], axes.y[i], axes.z[i]),
+            transformtoaxes(two, axes.x[i], axes.y[i], axes.z[i]));
+        __m128 distance = absps(dotps(axes.x[i], axes.y[i], axes.z[i], tocentre));
+        overlap |= uint32_t(_mm_movemask_ps(_mm_cmplt_ps(distance, project))) << (i*4);
+    }
+    return (overlap & 0x7fff) == 0x7fff;
+}
+
+#endif
+
+bool intersection_tests::boxandbox(
+	const collision_box &one,
+	const collision_box &two
+	)
+{
+#ifdef physics_simd
+	if (collision_detector::s_simd) { return boxandboxsimd(one, two); }
+#endif
+	return boxandboxscalar(one, two);
+}
+
+// this preprocessor definition is only used as a convenience
+// in the boxandbox intersection  method.
+#define test_overlap(axis) overlaponaxis(one, two, (axis), tocentre)
+
+bool intersection_tests::boxandboxscalar(
+	const collision_box &one,
+	const collision_box &two
+	)
+{
+	// find the vector between the two centres
+	_vec3 tocentre = two.getaxis(3) - one.getaxis(3);
+
+	return (
+		// check on box one's axes first
+		test_overlap(one.getaxis(0)) &&
+		test_overlap(one.getaxis(1)) &&
+		test_overlap(one.getaxis(2)) &&
+
+		// and on two's
+		test_overlap(two.getaxis(0)) &&
+		test_overlap(two.getaxis(1)) &&
+		test_overlap(two.getaxis(2)) &&
+
+		// now on the cross products
+		test_overlap( _cross( one.getaxis(0) , two.getaxis(0) ) ) &&
+		test_overlap( _cross( one.getaxis(0) , two.getaxis(1) ) ) &&
+		test_overlap( _cross( one.getaxis(0) , two.getaxis(2) ) ) &&
+		test_overlap( _cross( one.getaxis(1) , two.getaxis(0) ) ) &&
+		test_overlap( _cross( one.getaxis(1) , two.getaxis(1) ) ) &&
+		test_overlap( _cross( one.getaxis(1) , two.getaxis(2) ) ) &&
+		test_overlap( _cross( one.getaxis(2) , two.getaxis(0) ) ) &&
+		test_overlap( _cross( one.getaxis(2) , two.getaxis(1) ) ) &&
+		test_overlap( _cross( one.getaxis(2) , two.getaxis(2) ) )
+		);
+}
+#undef test_overlap
+
+bool intersection_tests::boxandhalfspace(
+    const collision_box &box,
+    const collision_plane &plane
+    )
+{
+    // work out the projected radius of the box onto the plane direction
+    float projectedradius = transformtoaxis(box, plane.m_direction);
+
+    // work out how far the box is from the origin
+    float boxdistance = _dot( plane.m_direction , box.getaxis(3) ) - projectedradius;
+
+    // check for the intersection
+    return boxdistance <= plane.m_offset;
+}
+
+/*
+ * finds the point of the box, given by its half-sizes, closest to the
+ * given point in the box's coordinates.
+ */
+static inline _vec3 closestpointonbox( const _vec3 &halfsize, const _vec3 &point ) {
+    _vec3 closest = point;
+    for (uint32_t i = 0; i < 3; i++) {
+        if (closest[i] >  halfsize[i]) { closest[i] =  halfsize[i]; }
+        if (closest[i] < -halfsize[i]) { closest[i] = -halfsize[i]; }
+    }
+    return closest;
+}
+
+/* the most steps taken to close in on the box near its edges and corners */
+#define sweep_iterations 16
+
+/* how near the sphere has to get to the box to count as touching it */
+#define sweep_tolerance 0.001f
+
+/*
+ * sweeps a sphere from start to end, given in the box's coordinates,
+ * and finds the first time it touches the box. fills in the point of
+ * the box it touches.
+ */
+static bool sweepsphereinbox(
+    const _vec3 &halfsize,
+    float radius,
+    const _vec3 &start,
+    const _vec3 &end,
+    float *time,
+    _vec3 *closest
+    )
+{
+    // a sphere touching the box at the start is left to the static tests
+    _vec3 point = closestpointonbox(halfsize, start);
+    if ((start - point).squaremagnitude() <= radius*radius) { return false; }
+
+    // clip the path to the box grown by the radius. the rounded box
+    // the sphere's centre can't enter lies inside it, so the search
+    // starts where the path enters the grown box.
+    _vec3 motion = end - start;
+    float enter = 0.0f;
+    float leave = 1.0f;
+    for (uint32_t i = 0; i < 3; i++) {
+        float extent = halfsize[i] + radius;
+        if (abs(motion[i]) < FLT_EPSILON) {
+            if (abs(start[i]) > extent) { return false; }
+            continue;
+        }
+        float inverse = 1.0f / motion[i];
+        float near_ = (-extent - start[i]) * inverse;
+        float far_  = ( extent - start[i]) * inverse;
+        if (near_ > far_) { float swap = near_; near_ = far_; far_ = swap; }
+        if (near_ > enter) { enter = near_; }
+        if (far_  < leave) { leave = far_; }
+        if (enter > leave) { return false; }
+    }
+
+    // on a face of the grown box that is the point of impact. near
+    // the edges and corners it is rounded, so step forward by the
+    // distance left, which can never step past the box.
+    float length = motion.magnitude();
+    if (length < FLT_EPSILON) { return false; }
+    float t = enter;
+    for (uint32_t i = 0; i < sweep_iterations; i++) {
+        _vec3 centre = start + motion * t;
+        point = closestpointonbox(halfsize, centre);
+        float gap = (centre - point).magnitude() - radius;
+        if (gap <= sweep_tolerance) {
+            *time = t;
+            *closest = point;
+            return true;
+        }
+        t += gap / length;
+        if (t > leave) { return false; }
+    }
+
+    // a path that only grazes the box is taken to miss it
+    return false;
+}
+
+bool intersection_tests::boxandsphere(
+    const collision_box &box,
+    const collision_sphere &sphere
+    )
+{
+    _vec3 relcentre = box.m_transform.transforminverse(sphere.getaxis(3));
+    _vec3 closest = closestpointonbox(box.m_half_size, relcentre);
+    return (closest - relcentre).squaremagnitude() <= sphere.m_radius * sphere.m_radius;
+}
+
+bool intersection_tests::sweptsphereandhalfspace(
+    const collision_sphere &sphere,
+    const _vec3 &start,
+    const collision_plane &plane,
+    float *time
+    )
+{
+    // find the distance from the plane at either end of the path
+    float startdistance = _dot( plane.m_direction, start ) - sphere.m_radius - plane.m_offset;
+    float enddistance   = _dot( plane.m_direction, sphere.getaxis(3) ) - sphere.m_radius - plane.m_offset;
+
+    if (startdistance <= 0 || enddistance > 0) { return false; }
+
+    *time = startdistance / (startdistance - enddistance);
+    return true;
+}
+
+bool intersection_tests::sweptsphereandbox(
+    const collision_box &box,
+    const collision_sphere &sphere,
+    const _vec3 &start,
+    float *time
+    )
+{
+    _vec3 closest;
+    return sweepsphereinbox(
+        box.m_half_size,
+        sphere.m_radius,
+        box.m_transform.transforminverse(start),
+        box.m_transform.transforminverse(sphere.getaxis(3)),
+        time, &closest);
+}
+
+bool intersection_tests::rayandhalfspace(
+    const collision_plane &plane,
+    const _vec3 &origin,
+    const _vec3 &direction,
+    float radius,
+    float max_distance,
+    float *distance,
+    _vec3 *normal
+    )
+{
+    // the cast has to start clear of the plane and move towards it
+    float startdistance = _dot( plane.m_direction, origin ) - radius - plane.m_offset;
+    float speed = _dot( plane.m_direction, direction );
+    if (startdistance < 0 || speed >= 0) { return false; }
+
+    float t = -startdistance / speed;
+    if (t > max_distance) { return false; }
+
+    *distance = t;
+    *normal = plane.m_direction;
+    return true;
+}
+
+bool intersection_tests::rayandsphere(
+    const collision_sphere &sphere,
+    const _vec3 &origin,
+    const _vec3 &direction,
+    float radius,
+    float max_distance,
+    float *distance,
+    _vec3 *normal
+    )
+{
+    // the cast sphere touches the other when its centre is within
+    // the sum of the radii, so this is a ray against the larger sphere
+    _vec3 centre = sphere.getaxis(3);
+    _vec3 relorigin = origin - centre;
+    float reach = sphere.m_radius + radius;
+
+    float b = _dot( relorigin, direction );
+    float c = relorigin.squaremagnitude() - reach*reach;
+    if (c <= 0 || b > 0) { return false; }
+
+    float discriminant = b*b - c;
+    if (discriminant < 0) { return false; }
+
+    float t = -b - sqrt(discriminant);
+    if (t > max_distance) { return false; }
+
+    *distance = t;
+    *normal = (relorigin + direction * t) * (1.0f / reach);
+    return true;
+}
+
+bool intersection_tests::rayandbox(
+    const collision_box &box,
+    const _vec3 &origin,
+    const _vec3 &direction,
+    float radius,
+    float max_distance,
+    float *distance,
+    _vec3 *normal
+    )
+{
+    // cast in box coordinates
+    _vec3 localorigin = box.m_transform.transforminverse(origin);
+    _vec3 localdirection = box.m_transform.transforminversedirection(direction);
+
+    float time;
+    _vec3 closest;
+    if (!sweepsphereinbox(box.m_half_size, radius, localorigin,
+        localorigin + localdirection * max_distance, &time, &closest)) {
+        return false;
+    }
+    *distance = time * max_distance;
+
+    // the normal points from the box to the centre of the cast. a ray
+    // ends on the box itself, so it takes the face it is closest to.
+    _vec3 localnormal = localorigin + localdirection * (*distance) - closest;
+    if (localnormal.squaremagnitude() > sweep_tolerance*sweep_tolerance) {
+        localnormal.normalise();
+    } else {
+        uint32_t face = 0;
+        float best = -1.0f;
+        for (uint32_t i = 0; i < 3; i++) {
+            float depth = abs(closest[i]) / box.m_half_size[i];
+            if (depth > best) { best = depth; face = i; }
+        }
+        localnormal = _vec3(0,0,0);
+        localnormal[face] = (closest[face] < 0) ? -1.0f : 1.0f;
+    }
+    *normal = box.m_transform.transformdirection(localnormal);
+    return true;
+}
+
+uint32_t collision_detector::sphereandtrueplane(
+    const collision_sphere &sphere,
+    const collision_plane &plane,
+    collision_data *data
+    )
+{
+    // cache the sphere position
+    _vec3 position = sphere.getaxis(3);
+
+    // find the distance from the plane
+    float centredistance = _dot( plane.m_direction , position ) - plane.m_offset;
+
+    // check if we're within radius
+    if (centredistance*centredistance > sphere.m_radius*sphere.m_radius) { return 0; }
+
+    // check which side of the plane we're on
+    _vec3 normal = plane.m_direction;
+    float penetration = -centredistance;
+    if (centredistance < 0) {
+        normal *= -1;
+        penetration = -penetration;
+    }
+    penetration += sphere.m_radius;
+
+    // create the contact - it has a normal in the plane direction.
+    // make sure there is room for it
+    if (!data->reserve(1)) { return 0; }
+
+    contact* contact = data->m_contacts;
+    contact->m_contact_normal = normal;
+    contact->m_penetration = penetration;
+    contact->m_contact_point = position - plane.m_direction * centredistance;
+    contact->m_feature = planefeature(plane);
+    contact->setbodydata(sphere.m_body, NULL,data->m_friction, data->m_restitution);
+
+    data->addcontacts(1);
+    return 1;
+}
+
+uint32_t collision_detector::sphereandhalfspace(
+    const collision_sphere &sphere,
+    const collision_plane &plane,
+    collision_data *data
+    )
+{
+    // cache the sphere position
+    _vec3 position = sphere.getaxis(3);
+
+    // find the distance from the plane
+    float balldistance = _dot( plane.m_direction , position) - sphere.m_radius - plane.m_offset;
+
+	if (balldistance >= 0) { return 0; }
+
+    // create the contact - it has a normal in the plane direction.
+    // make sure there is room for it
+    if (!data->reserve(1)) { return 0; }
+
+    contact* contact = data->m_contacts;
+    contact->m_contact_normal = plane.m_direction;
+    contact->m_penetration = -balldistance;
+    contact->m_contact_point =  position - plane.m_direction * (balldistance + sphere.m_radius);
+    contact->m_feature = planefeature(plane);
+    contact->setbodydata(sphere.m_body, NULL, data->m_friction, data->m_restitution);
+
+    data->addcontacts(1);
+    return 1;
+}
+
+void plane_set::add( const collision_plane &plane ) {
+    m_x.pushback(plane.m_direction.x, true);
+    m_y.pushback(plane.m_direction.y, true);
+    m_z.pushback(plane.m_direction.z, true);
+    m_offset.pushback(plane.m_offset, true);
+    m_feature.pushback(planefeature(plane), true);
+}
+
+void plane_set::clear() {
+    m_x.m_count = m_y.m_count = m_z.m_count = 0;
+    m_offset.m_count = m_feature.m_count = 0;
+}
+
+/*
+ * writes the contact of a sphere with a plane of the set, given the
+ * distance of the sphere from the plane, as sphereandhalfspace does.
+ */
+static inline bool fillsphereandplane(
+    const collision_sphere &sphere,
+    const plane_set &planes,
+    uint32_t plane,
+    float balldistance,
+    collision_data *data
+    )
+{
+    if (!data->reserve(1)) { return false; }
+
+    _vec3 direction(planes.m_x[plane], planes.m_y[plane], planes.m_z[plane]);
+
+    contact* contact = data->m_contacts;
+    contact->m_contact_normal = direction;
+    contact->m_penetration = -balldistance;
+    contact->m_contact_point = sphere.getaxis(3) - direction * (balldistance + sphere.m_radius);
+    contact->m_feature = planes.m_feature[plane];
+    contact->setbodydata(sphere.m_body, NULL, data->m_friction, data->m_restitution);
+
+    data->addcontacts(1);
+    return true;
+}
+
+uint32_t collision_detector::spheresandhalfspaces(
+    collision_sphere * const spheres[],
+    uint32_t count,
+    const plane_set &planes,
+    uint32_t *hits,
+    collision_data *data
+    )
+{
+    uint32_t planecount = planes.count();
+    uint32_t used = 0;
+    uint32_t i = 0;
+
+#ifdef physics_simd
+    // four spheres at a time, against each plane in turn. a sphere
+    // keeps the first plane it goes through.
+    for (; i + 4 <= count; i += 4) {
+
+        _vec3 p0 = spheres[i  ]->getaxis(3);
+        _vec3 p1 = spheres[i+1]->getaxis(3);
+        _vec3 p2 = spheres[i+2]->getaxis(3);
+        _vec3 p3 = spheres[i+3]->getaxis(3);
+        __m128 x = _mm_setr_ps(p0.x, p1.x, p2.x, p3.x);
+        __m128 y = _mm_setr_ps(p0.y, p1.y, p2.y, p3.y);
+        __m128 z = _mm_setr_ps(p0.z, p1.z, p2.z, p3.z);
+        __m128 radius = _mm_setr_ps(spheres[i]->m_radius, spheres[i+1]->m_radius, spheres[i+2]->m_radius, spheres[i+3]->m_radius);
+
+        float distance[4];
+        hits[i] = hits[i+1] = hits[i+2] = hits[i+3] = plane_set_none;
+        uint32_t found = 0;
+        for (uint32_t p = 0; p < planecount && found != 0xf; p++) {
+            __m128 balldistance = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_set1_ps(planes.m_x[p]), x),
+                _mm_mul_ps(_mm_set1_ps(planes.m_y[p]), y)),
+                _mm_mul_ps(_mm_set1_ps(planes.m_z[p]), z)),
+                radius),
+                _mm_set1_ps(planes.m_offset[p]));
+
+            uint32_t inside = uint32_t(_mm_movemask_ps(_mm_cmplt_ps(balldistance, _mm_setzero_ps()))) & ~found;
+            if (!inside) { continue; }
+
+            float lanes[4];
+            _mm_storeu_ps(lanes, balldistance);
+            for (uint32_t lane = 0; lane < 4; lane++) {
+                if (inside & (1 << lane)) {
+                    hits[i+lane]   = p;
+                    distance[lane] = lanes[lane];
+                }
+            }
+            found |= inside;
+        }
+
+        for (uint32_t lane = 0; lane < 4; lane++) {
+            if (found & (1 << lane)) {
+                if (fillsphereandplane(*spheres[i+lane], planes, hits[i+lane], distance[lane], data)) { used++; }
+            }
+        }
+    }
+#endif
+
+    // the rest one at a time
+    for (; i < count; i++) {
+        hits[i] = plane_set_none;
+
+        _vec3 position = spheres[i]->getaxis(3);
+        for (uint32_t p = 0; p < planecount; p++) {
+            float balldistance = planes.m_x[p]*position.x + planes.m_y[p]*position.y + planes.m_z[p]*position.z
+                - spheres[i]->m_radius - planes.m_offset[p];
+            if (balldistance < 0) {
+                hits[i] = p;
+                if (fillsphereandplane(*spheres[i], planes, p, balldistance, data)) { used++; }
+                break;
+            }
+        }
+    }
+    return used;
+}
+
+uint32_t collision_detector::sphereandsphere(
+    const collision_sphere &one,
+    const collision_sphere &two,
+    collision_data *data
+    )
+{
+    // cache the sphere positions
+    _vec3 positionone = one.getaxis(3);
+    _vec3 positiontwo = two.getaxis(3);
+
+    // find the vector between the objects
+    _vec3 midline = positionone - positiontwo;
+    float size = midline.magnitude();
+
+    // see if it is large enough.
+    if (size <= 0.0f || size >= one.m_radius+two.m_radius) { return 0; }
+
+    // we manually create the normal, because we have the
+    // size to hand.
+    _vec3 normal = midline * (1.0f/size);
+
+    // make sure there is room for it
+    if (!data->reserve(1)) { return 0; }
+
+    contact* contact = data->m_contacts;
+    contact->m_contact_normal = normal;
+    contact->m_contact_point = positionone + midline * 0.5f;
+    contact->m_penetration = (one.m_radius+two.m_radius - size);
+    contact->m_feature = 0;
+    contact->setbodydata(one.m_body, two.m_body,data->m_friction, data->m_restitution);
+
+    data->addcontacts(1);
+    return 1;
+}
+
+
+
+
+/*
+ * this function checks if the two boxes overlap
+ * along the given axis, returning the ammount of overlap.
+ * the final parameter tocentre
+ * is used to pass in the vector between the boxes centre
+ * points, to avoid having to recalculate it each time.
+ */
+static inline float penetrationonaxis(
+    const collision_box &one,
+    const collision_box &two,
+    const _vec3 &axis,
+    const _vec3 &tocentre
+    )
+{
+    // project the half-size of one onto axis
+    float oneproject = transformtoaxis(one, axis);
+    float twoproject = transformtoaxis(two, axis);
+
+    // project this onto the axis
+    float distance = abs( _dot( tocentre , axis ) );
+
+    // return the overlap (i.e. positive indicates
+    // overlap, negative indicates separation).
+    return oneproject + twoproject - distance;
+}
+
+
+static inline bool tryaxis(
+    const collision_box &one,
+    const collision_box &two,
+    _vec3 axis,
+    const _vec3& tocentre,
+    uint32_t index,
+
+    // these values may be updated
+    float& smallestpenetration,
+    uint32_t &smallestcase
+    )
+{
+    // make sure we have a normalized axis, and don't check almost parallel axes
+	if (axis.squaremagnitude() < 0.0001f) { return true; }
+    axis.normalise();
+
+    float penetration = penetrationonaxis(one, two, axis, tocentre);
+
+	if (penetration < 0) { return false; }
+    if (penetration < smallestpenetration) {
+        smallestpenetration = penetration;
+        smallestcase = index;
+    }
+    return true;
+}
+
+void fillpointfaceboxbox(
+    const collision_box &one,
+    const collision_box &two,
+    const _vec3 &tocentre,
+    collision_data *data,
+    uint32_t best,
+    float pen
+    )
+{
+    // this method is called when we know that a vertex from
+    // box two is in contact with box one.
+
+    contact* contact = data->m_contacts;
+
+    // we know which axis the collision is on (i.e. best),
+    // but we need to work out which of the two faces on
+    // this axis.
+    _vec3 normal = one.getaxis(best);
+    if ( _dot( one.getaxis(best) , tocentre ) > 0) { normal = normal * -1.0f; }
+
+    // work out which vertex of box two we're colliding with.
+    // using tocentre doesn't work!
+    _vec3 vertex = two.m_half_size;
+    uint32_t vertexindex = 0;
+    if ( _dot( two.getaxis(0) , normal ) < 0) { vertex.x = -vertex.x; vertexindex |= 1; }
+    if ( _dot( two.getaxis(1) , normal ) < 0) { vertex.y = -vertex.y; vertexindex |= 2; }
+	if ( _dot( two.getaxis(2) , normal ) < 0) { vertex.z = -vertex.z; vertexindex |= 4; }
+
+    // create the contact data, the feature is the face axis of box one
+    // and the vertex of box two.
+    contact->m_contact_normal = normal;
+    contact->m_penetration = pen;
+    contact->m_contact_point = two.gettransform() * vertex;
+    contact->m_feature = (best << 3) | vertexindex;
+    contact->setbodydata(one.m_body, two.m_body,data->m_friction, data->m_restitution);
+}
+
+/*
+ * a point of the incident face as it is clipped: its place, its tag
+ * for the contact's feature, and which edge runs on from it to the
+ * next point, 0 to 3 for the edges of the face and 4 to 7 for the
+ * side planes of the reference face.
+ */
+struct clip_point {
+    _vec3    m_point;
+    uint32_t m_tag;
+    uint32_t m_edge;
+};
+
+/*
+ * clips the polygon to the side of the plane its direction points
+ * away from, writing the result into out and returning its size. a
+ * point made where an edge crosses the plane is tagged with the edge
+ * and the plane, so it keeps its feature from step to step.
+ */
+static uint32_t clippolygon(
+    const clip_point *in,
+    uint32_t count,
+    const _vec3 &direction,
+    float offset,
+    uint32_t plane,
+    clip_point *out
+    )
+{
+    uint32_t outcount = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const clip_point &a = in[i];
+        const clip_point &b = in[(i+1) % count];
+        float da = _dot(direction, a.m_point) - offset;
+        float db = _dot(direction, b.m_point) - offset;
+
+        if (da <= 0) { out[outcount++] = a; }
+        if ((da <= 0) == (db <= 0)) { continue; }
+
+        // the edge crosses the plane. leaving it, the polygon runs on
+        // along the plane, entering it, along the edge.
+        clip_point &cross = out[outcount++];
+        cross.m_point = a.m_point + (b.m_point - a.m_point) * (da / (da - db));
+        cross.m_tag   = 8 + a.m_edge*4 + plane;
+        cross.m_edge  = (da <= 0) ? 4 + plane : a.m_edge;
+    }
+    return outcount;
+}
+
+/*
+ * fills the contacts of a face of box one resting on box two: the face
+ * of box two most turned against it is clipped to the sides of box
+ * one's face, and each point of it under that face is a contact. best
+ * is the axis of the face of box one, first is 0 or 3 for the feature,
+ * as box one is the first box of the pair or the second. returns the
+ * number of contacts found, written into found.
+ */
+static uint32_t fillfaceboxbox(
+    const collision_box &one,
+    const collision_box &two,
+    const _vec3 &tocentre,
+    uint32_t best,
+    uint32_t first,
+    contact *found
+    )
+{
+    // the reference face, on the side of box one facing box two
+    _vec3 normal = one.getaxis(best);
+    if ( _dot( normal , tocentre ) < 0) { normal = normal * -1.0f; }
+    float faceoffset = _dot( normal , one.getaxis(3) ) + one.m_half_size[best];
+
+    // the incident face, of box two, the one most turned against it
+    uint32_t incident = 0;
+    float mostturned = 0.0f;
+    for (uint32_t i = 0; i < 3; i++) {
+        float turned = abs( _dot( two.getaxis(i) , normal ) );
+        if (turned > mostturned) { mostturned = turned; incident = i; }
+    }
+    float side = ( _dot( two.getaxis(incident) , normal ) > 0) ? -1.0f : 1.0f;
+
+    // its four corners, in order round the face, tagged with the index
+    // of the vertex as fillpointfaceboxbox numbers them
+    static const float signu[4] = { 1,-1,-1, 1 };
+    static const float signv[4] = { 1, 1,-1,-1 };
+    uint32_t u = (incident + 1) % 3;
+    uint32_t v = (incident + 2) % 3;
+    clip_point polygon[2][8];
+    for (uint32_t i = 0; i < 4; i++) {
+        _vec3 corner;
+        corner[incident] = side * two.m_half_size[incident];
+        corner[u] = signu[i] * two.m_half_size[u];
+        corner[v] = signv[i] * two.m_half_size[v];
+
+        clip_point &point = polygon[0][i];
+        point.m_point = two.m_transform * corner;
+        point.m_tag   = ((side < 0) ? (1u << incident) : 0) | ((signu[i] < 0) ? (1u << u) : 0) | ((signv[i] < 0) ? (1u << v) : 0);
+        point.m_edge  = i;
+    }
+
+    // clipped to the four sides of the reference face
+    uint32_t count = 4;
+    uint32_t current = 0;
+    for (uint32_t plane = 0; plane < 4 && count; plane++) {
+        uint32_t axis = (best + 1 + plane/2) % 3;
+        _vec3 direction = one.getaxis(axis) * ((plane & 1) ? -1.0f : 1.0f);
+        float offset = _dot( direction , one.getaxis(3) ) + one.m_half_size[axis];
+        count = clippolygon(polygon[current], count, direction, offset, plane, polygon[current^1]);
+        current ^= 1;
+    }
+
+    // the points under the reference face are the contacts, the
+    // normal points back to box one.
+    uint32_t contactsfound = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const clip_point &point = polygon[current][i];
+        float depth = faceoffset - _dot( normal , point.m_point );
+        if (depth < 0) { continue; }
+
+        contact* contact = &found[contactsfound++];
+        contact->m_contact_normal = normal * -1.0f;
+        contact->m_penetration = depth;
+        contact->m_contact_point = point.m_point;
+        contact->m_feature = ((first + best) << 6) | point.m_tag;
+    }
+    return contactsfound;
+}
+
+static inline _vec3 contactpoint(
+    const _vec3 &pone,
+    const _vec3 &done,
+    float onesize,
+    const _vec3 &ptwo,
+    const _vec3 &dtwo,
+    float twosize,
+
+    // if this is true, and the contact point is outside
+    // the edge (in the case of an edge-face contact) then
+    // we use one's midpoint, otherwise we use two's.
+    bool useone)
+{
+    _vec3 tost, cone, ctwo;
+    float dpstaone, dpstatwo, dponetwo, smone, smtwo;
+    float denom, mua, mub;
+
+    smone = done.squaremagnitude();
+    smtwo = dtwo.squaremagnitude();
+    dponetwo = _dot( dtwo , done );
+
+    tost = pone - ptwo;
+    dpstaone = _dot( done , tost );
+    dpstatwo = _dot( dtwo , tost );
+
+    denom = smone * smtwo - dponetwo * dponetwo;
+
+    // zero denominator indicates parrallel lines
+    if ( abs(denom) < 0.0001f ) { return useone?pone:ptwo; }
+
+    mua = (dponetwo * dpstatwo - smtwo * dpstaone) / denom;
+    mub = (smone * dpstatwo - dponetwo * dpstaone) / denom;
+
+    // if either of the edges has the nearest point out
+    // of bounds, then the edges aren't crossed, we have
+    // an edge-face contact. our point is on the edge, which
+    // we know from the useone parameter.
+    if (mua > onesize ||
+        mua < -onesize ||
+		mub > twosize ||
+		mub < -twosize)
+	{
+		return useone?pone:ptwo;
+	}
+	else {
+		cone = pone + done * mua;
+		ctwo = ptwo + dtwo * mub;
+
+		return cone * 0.5 + ctwo * 0.5;
+	}
+}
+
+/*
+ * writes the contact for two boxes, once the axis of least penetration
+ * is known. best is the index of the axis, and bestsingleaxis the best
+ * of the face axes alone.
+ */
+static uint32_t fillboxandbox(
+    const collision_box &one,
+    const collision_box &two,
+    const _vec3 &tocentre,
+    collision_data *data,
+    uint32_t best,
+    float pen,
+    uint32_t bestsingleaxis
+    )
+{
+    // boxes resting face to face have edge axes that penetrate about
+    // as little as the face axes. a face is taken unless an edge
+    // penetrates clearly less, and box one's faces over box two's
+    // likewise, so the manifold doesn't flip between them from one
+    // step to the next.
+    float onepen = FLT_MAX, twopen = FLT_MAX;
+    uint32_t oneface = 0, twoface = 3;
+    for (uint32_t i = 0; i < 3; i++) {
+        float penetration = penetrationonaxis(one, two, one.getaxis(i), tocentre);
+        if (penetration < onepen) { onepen = penetration; oneface = i; }
+        penetration = penetrationonaxis(one, two, two.getaxis(i), tocentre);
+        if (penetration < twopen) { twopen = penetration; twoface = i + 3; }
+    }
+    uint32_t face = (onepen <= twopen*box_face_relative + box_face_absolute) ? oneface : twoface;
+    float facepen = (face < 3) ? onepen : twopen;
+    if (best >= 6 && facepen <= pen*box_face_relative + box_face_absolute) { best = face; pen = facepen; }
+    else if (best < 6) { best = face; pen = facepen; }
+
+    // we now know there's a collision, and we know which
+    // of the axes gave the smallest penetration. we now
+    // can deal with it in different ways depending on
+    // the case.
+    if (best < 6) {
+        // we've got a face of one box resting on the other. the face
+        // of the other box under it is clipped to it, for up to eight
+        // contacts. for box two's face, one and two are swapped round
+        // (and therefore also the vector between their centres).
+        contact found[8];
+        const collision_box &reference = (best < 3) ? one : two;
+        const collision_box &incident  = (best < 3) ? two : one;
+        _vec3 toincident = (best < 3) ? tocentre : tocentre*-1.0f;
+        uint32_t contactsfound = fillfaceboxbox(reference, incident, toincident, best % 3, best - best % 3, found);
+
+        // only a face barely touching can be clipped away entirely,
+        // then the deepest vertex is used, as for a single contact.
+        if (!contactsfound) {
+            if (!data->reserve(1)) { return 0; }
+            fillpointfaceboxbox(reference, incident, toincident, data, best % 3, pen);
+            data->addcontacts(1);
+            return 1;
+        }
+        for (uint32_t i = 0; i < contactsfound; i++) {
+            found[i].setbodydata(reference.m_body, incident.m_body, data->m_friction, data->m_restitution);
+        }
+        return addmanifold(found, contactsfound, found[0].m_contact_normal, data);
+    }else {
+        // an edge and edge contact is a single point
+        if (!data->reserve(1)) { return 0; }
+
+        // we've got an edge-edge contact. find out which axes
+        // we've got an edge-edge contact. find out which axes
+        best -= 6;
+        uint32_t oneaxisindex = best / 3;
+        uint32_t twoaxisindex = best % 3;
+
+
+        _vec3 oneaxis = one.getaxis(oneaxisindex);
+        _vec3 twoaxis = two.getaxis(twoaxisindex);
+        _vec3 axis = _cross( oneaxis , twoaxis);
+        axis.normalise();
+
+        // the axis should point from box one to box two.
+        if ( _dot(axis , tocentre) > 0) axis = axis * -1.0f;
+
+        // we have the axes, but not the edges: each axis has 4 edges parallel
+        // to it, we need to find which of the 4 for each object. we do
+        // that by finding the point in the centre of the edge. we know
+        // its component in the direction of the box's collision axis is zero
+        // (its a mid-point) and we determine which of the extremes in each
+        // of the other axes is closest.
+        _vec3 ptononeedge = one.m_half_size;
+        _vec3 ptontwoedge = two.m_half_size;
+        for (uint32_t i = 0; i < 3; i++) {
+            if (i == oneaxisindex) ptononeedge[i] = 0;
+			else if ( _dot( one.getaxis(i) , axis ) > 0) { ptononeedge[i] = -ptononeedge[i]; }
+
+            if (i == twoaxisindex) ptontwoedge[i] = 0;
+			else if ( _dot( two.getaxis(i) , axis ) < 0) { ptontwoedge[i] = -ptontwoedge[i]; }
+        }
+
+        // move them into world coordinates (they are already oriented
+        // correctly, since they have been derived from the axes).
+        ptononeedge = one.m_transform * ptononeedge;
+        ptontwoedge = two.m_transform * ptontwoedge;
+
+        // so we have a point and a direction for the colliding edges.
+        // we need to find out point of closest approach of the two
+        // line-segments.
+        _vec3 vertex = contactpoint(
+            ptononeedge, oneaxis, one.m_half_size[oneaxisindex],
+            ptontwoedge, twoaxis, two.m_half_size[twoaxisindex],
+            bestsingleaxis > 2
+            );
+
+        // we can fill the contact.
+        contact* contact = data->m_contacts;
+
+        contact->m_penetration = pen;
+        contact->m_contact_normal = axis;
+        contact->m_contact_point = vertex;
+        contact->m_feature = 0x400 | best;
+        contact->setbodydata(one.m_body, two.m_body,
+            data->m_friction, data->m_restitution);
+
+        data->addcontacts(1);
+        return 1;
+    }
+    return 0;
+}
+
+// this preprocessor definition is only used as a convenience
+// in the boxandbox contact generation method.
+#define _check_overlap(axis, index) \
+	if (!tryaxis(one, two, (axis), tocentre, (index), pen, best)) { return 0; }
+
+uint32_t collision_detector::boxandboxscalar(
+    const collision_box &one,
+    const collision_box &two,
+    collision_data *data
+    )
+{
+    //if (!intersection_tests::boxandbox(one, two)) return 0;
+
+    // find the vector between the two centres
+    _vec3 tocentre = two.getaxis(3) - one.getaxis(3);
+
+    // we start assuming there is no contact
+    float pen = FLT_MAX;
+    uint32_t best = 0xffffff;
+
+    // now we check each axes, returning if it gives us
+    // a separating axis, and keeping track of the axis with
+    // the smallest penetration otherwise.
+    _check_overlap(one.getaxis(0), 0);
+    _check_overlap(one.getaxis(1), 1);
+    _check_overlap(one.getaxis(2), 2);
+
+    _check_overlap(two.getaxis(0), 3);
+    _check_overlap(two.getaxis(1), 4);
+    _check_overlap(two.getaxis(2), 5);
+
+    // store the best axis-major, in case we run into almost
+    // parallel edge collisions later
+    uint32_t bestsingleaxis = best;
+
+    _check_overlap( _cross( one.getaxis(0) , two.getaxis(0) ), 6);
+    _check_overlap( _cross( one.getaxis(0) , two.getaxis(1) ), 7);
+    _check_overlap( _cross( one.getaxis(0) , two.getaxis(2) ), 8);
+    _check_overlap( _cross( one.getaxis(1) , two.getaxis(0) ), 9);
+    _check_overlap( _cross( one.getaxis(1) , two.getaxis(1) ), 10);
+    _check_overlap( _cross( one.getaxis(1) , two.getaxis(2) ), 11);
+    _check_overlap( _cross( one.getaxis(2) , two.getaxis(0) ), 12);
+    _check_overlap( _cross( one.getaxis(2) , two.getaxis(1) ), 13);
+    _check_overlap( _cross( one.getaxis(2) , two.getaxis(2) ), 14);
+
+    // make sure we've got a result.
+	if(best == 0xffffff){ application_error("best");  }
+
+    return fillboxandbox(one, two, tocentre, data, best, pen, bestsingleaxis);
+}
+#undef _check_overlap
+
+#ifdef physics_simd
+
+/*
+ * finds the penetration of the boxes on all 15 axes, four at a time,
+ * and picks the axis of least penetration as the scalar tests do:
+ * almost parallel edge axes are skipped, and the first of equal
+ * axes is kept. returns false if an axis separates the boxes.
+ */
+static bool boxandboxaxessimd(
+    const collision_box &one,
+    const collision_box &two,
+    const _vec3 &tocentre,
+    float *pen,
+    uint32_t *best,
+    uint32_t *bestsingleaxis
+    )
+{
+    box_axes axes;
+    boxaxes(one, two, &axes);
+
+    float penetration[16];
+    uint32_t parallel = 0;
+    for (uint32_t i = 0; i < 4; i++) {
+
+        // normalise the axes, parallel ones are given a length of one
+        // so they stay finite until they are skipped
+        __m128 squaremagnitude = _mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(axes.x[i], axes.x[i]),
+            _mm_mul_ps(axes.y[i], axes.y[i])),
+            _mm_mul_ps(axes.z[i], axes.z[i]));
+        __m128 isparallel = _mm_cmplt_ps(squaremagnitude, _mm_set1_ps(0.0001f));
+        __m128 magnitude = _mm_sqrt_ps(_mm_or_ps(
+            _mm_andnot_ps(isparallel, squaremagnitude),
+            _mm_and_ps(isparallel, _mm_set1_ps(1.0f))));
+        __m128 x = _mm_div_ps(axes.x[i], magnitude);
+        __m128 y = _mm_div_ps(axes.y[i], magnitude);
+        __m128 z = _mm_div_ps(axes.z[i], magnitude);
+
+        __m128 project = _mm_add_ps(transformtoaxes(one, x, y, z), transformtoaxes(two, x, y, z));
+        __m128 distance = absps(dotps(x, y, z, tocentre));
+        _mm_storeu_ps(&penetration[i*4], _mm_sub_ps(project, distance));
+        parallel |= uint32_t(_mm_movemask_ps(isparallel)) << (i*4);
+    }
+
+    for (uint32_t i = 0; i < 15; i++) {
+        if (parallel & (1 << i)) { continue; }
+        if (penetration[i] < 0) { return false; }
+        if (penetration[i] < *pen) {
+            *pen = penetration[i];
+            *best = i;
+        }
+        if (i == 5) { *bestsingleaxis = *best; }
+    }
+    return true;
+}
+
+#endif
+
+uint32_t collision_detector::boxandbox(
+    const collision_box &one,
+    const collision_box &two,
+    collision_data *data
+    )
+{
+#ifdef physics_simd
+    if (s_simd) {
+        _vec3 tocentre = two.getaxis(3) - one.getaxis(3);
+        float pen = FLT_MAX;
+        uint32_t best = 0xffffff;
+        uint32_t bestsingleaxis = 0xffffff;
+        if (!boxandboxaxessimd(one, two, tocentre, &pen, &best, &bestsingleaxis)) { return 0; }
+        if(best == 0xffffff){ application_error("best");  }
+
+        return fillboxandbox(one, two, tocentre, data, best, pen, bestsingleaxis);
+    }
+#endif
+    return boxandboxscalar(one, two, data);
+}
+
+
+
+
+uint32_t collision_detector::boxandpoint(
+    const collision_box &box,
+    const _vec3 &point,
+    collision_data *data
+    )
+{
+    // transform the point into box coordinates
+    _vec3 relpt = box.m_transform.transforminverse(point);
+
+    _vec3 normal;
+
+    // check each axis, looking for the axis on which the
+    // penetration is least deep.
+    float min_depth = box.m_half_size.x - abs(relpt.x);
+	if (min_depth < 0) { return 0; }
+
+    normal = box.getaxis(0) * ((relpt.x < 0)?-1.0f:1.0f);
+
+    float depth = box.m_half_size.y - abs(relpt.y);
+	if (depth < 0) { return 0; }
+    else if (depth < min_depth) {
+        min_depth = depth;
+        normal = box.getaxis(1) * ((relpt.y < 0)?-1.0f:1.0f);
+    }
+
+    depth = box.m_half_size.z - abs(relpt.z);
+	if (depth < 0) { return 0; }
+    else if (depth < min_depth) {
+        min_depth = depth;
+        normal = box.getaxis(2) * ((relpt.z < 0)?-1.0f:1.0f);
+    }
+
+    // compile the contact
+    // make sure there is room for it
+    if (!data->reserve(1)) { return 0; }
+
+    contact* contact = data->m_contacts;
+    contact->m_contact_normal = normal;
+    contact->m_contact_point = point;
+    contact->m_penetration = min_depth;
+    contact->m_feature = 0;
+
+    // note that we don't know what rigid body the point
+    // belongs to, so we just use null. where this is called
+    // this value can be left, or filled in.
+    contact->setbodydata(box.m_body, NULL, data->m_friction, data->m_restitution);
+
+    data->addcontacts(1);
+    return 1;
+}
+
+uint32_t collision_detector::boxandsphere(
+    const collision_box &box,
+    const collision_sphere &sphere,
+    collision_data *data
+    )
+{
+    // transform the centre of the sphere into box coordinates
+    _vec3 centre = sphere.getaxis(3);
+    _vec3 relcentre = box.m_transform.transforminverse(centre);
+
+    // early out check to see if we can exclude the contact
+    if (abs(relcentre.x) - sphere.m_radius > box.m_half_size.x ||
+        abs(relcentre.y) - sphere.m_radius > box.m_half_size.y ||
+        abs(relcentre.z) - sphere.m_radius > box.m_half_size.z)
+    {
+        return 0;
+    }
+
+    _vec3 closestpt(0,0,0);
+    float dist;
+
+    // clamp each coordinate to the box.
+    dist = relcentre.x;
+	if (dist > box.m_half_size.x) { dist = box.m_half_size.x; }
+	if (dist < -box.m_half_size.x) { dist = -box.m_half_size.x; }
+    closestpt.x = dist;
+
+    dist = relcentre.y;
+	if (dist > box.m_half_size.y) { dist = box.m_half_size.y; }
+	if (dist < -box.m_half_size.y) { dist = -box.m_half_size.y; }
+    closestpt.y = dist;
+
+    dist = relcentre.z;
+	if (dist > box.m_half_size.z)  { dist = box.m_half_size.z; }
+	if (dist < -box.m_half_size.z) { dist = -box.m_half_size.z; }
+    closestpt.z = dist;
+
+    // check we're in contact
+    dist = (closestpt - relcentre).squaremagnitude();
+	if (dist > sphere.m_radius * sphere.m_radius) { return 0; }
+
+    // compile the contact
+    _vec3 closestptworld = box.m_transform.transform(closestpt);
+
+    // make sure there is room for it
+    if (!data->reserve(1)) { return 0; }
+
+    contact* contact = data->m_contacts;
+    contact->m_contact_normal = (closestptworld - centre);
+    contact->m_contact_normal.normalise();
+
+
+    contact->m_contact_point = closestptworld;
+    contact->m_penetration = sphere.m_radius - sqrt(dist);
+    contact->m_feature = 0;
+    contact->setbodydata(box.m_body, sphere.m_body,data->m_friction, data->m_restitution);
+
+    data->addcontacts(1);
+    return 1;
+}
+
+uint32_t collision_detector::boxandhalfspace(
+    const collision_box &box,
+    const collision_plane &plane,
+    collision_data *data
+    )
+{
+    // check for intersection
+    if (!intersection_tests::boxandhalfspace(box, plane)) { return 0; }
+
+    // we have an intersection, so find the intersection points. we can make
+    // do with only checking vertices. if the box is resting on a plane
+    // or on an edge, it will be reported as four or two contact points.
+
+    // go through each combination of + and - for each half-size, the
+    // vertices are kept a component to an array so they can all be
+    // transformed into world space together.
+    static const float multx[8] = { 1,-1, 1,-1, 1,-1, 1,-1 };
+    static const float multy[8] = { 1, 1,-1,-1, 1, 1,-1,-1 };
+    static const float multz[8] = { 1, 1, 1, 1,-1,-1,-1,-1 };
+
+    float vertexx[8], vertexy[8], vertexz[8];
+    for (uint32_t i = 0; i < 8; i++) {
+        vertexx[i] = multx[i] * box.m_half_size.x;
+        vertexy[i] = multy[i] * box.m_half_size.y;
+        vertexz[i] = multz[i] * box.m_half_size.z;
+    }
+    _transformpoints(box.m_transform, vertexx, vertexy, vertexz, vertexx, vertexy, vertexz, 8);
+
+    // the contacts are gathered first, so they can be reduced
+    contact found[8];
+    uint32_t contactsfound = 0;
+    for (uint32_t i = 0; i < 8; i++) {
+
+        // the position of each vertex
+        _vec3 vertexpos(vertexx[i], vertexy[i], vertexz[i]);
+
+        // calculate the distance from the plane
+        float vertexdistance = _dot( vertexpos , plane.m_direction );
+
+        // compare this to the plane's distance
+        if (vertexdistance <= plane.m_offset) {
+            // create the contact data.
+
+            // the contact point is halfway between the vertex and the
+            // plane - we multiply the direction by half the separation
+            // distance and add the vertex location.
+            contact* contact = &found[contactsfound++];
+            contact->m_contact_point  = plane.m_direction;
+            contact->m_contact_point *= (vertexdistance-plane.m_offset);
+            contact->m_contact_point += vertexpos;
+            contact->m_contact_normal = plane.m_direction;
+            contact->m_penetration    = plane.m_offset - vertexdistance;
+            contact->m_feature        = (planefeature(plane) << 3) | i;
+            // write the appropriate data
+            contact->setbodydata(box.m_body, NULL,data->m_friction, data->m_restitution);
+        }
+    }
+
+    return addmanifold(found, contactsfound, plane.m_direction, data);
+}
+
+/*
+ * the area of the triangle of the three points, seen along the normal.
+ * it is negative when they wind clockwise.
+ */
+static inline float windingarea( const _vec3 &a, const _vec3 &b, const _vec3 &c, const _vec3 &normal ) {
+    return _dot( _cross(b - a, c - a), normal );
+}
+
+/*
+ * swaps the contact into the given place, returning its point.
+ */
+static inline _vec3 keepcontact( contact *contacts, uint32_t place, uint32_t index ) {
+    if (index != place) {
+        contact kept = contacts[index];
+        contacts[index] = contacts[place];
+        contacts[place] = kept;
+    }
+    return contacts[place].m_contact_point;
+}
+
+uint32_t collision_detector::reducemanifold(
+    contact *contacts,
+    uint32_t count,
+    const _vec3 &normal
+    )
+{
+    if (count <= manifold_max_contacts) { return count; }
+
+    // the deepest contact
+    keepdeepest(contacts, count);
+    _vec3 a = contacts[0].m_contact_point;
+
+    // the contact farthest from it
+    uint32_t best = 1;
+    float bestvalue = -1.0f;
+    for (uint32_t i = 1; i < count; i++) {
+        float value = (contacts[i].m_contact_point - a).squaremagnitude();
+        if (value > bestvalue) { bestvalue = value; best = i; }
+    }
+    _vec3 b = keepcontact(contacts, 1, best);
+
+    // the contact making the largest triangle with those two
+    bestvalue = -1.0f;
+    for (uint32_t i = 2; i < count; i++) {
+        float value = abs( windingarea(a, b, contacts[i].m_contact_point, normal) );
+        if (value > bestvalue) { bestvalue = value; best = i; }
+    }
+    _vec3 c = keepcontact(contacts, 2, best);
+
+    // the contact furthest outside the triangle adds the most area. if
+    // they are all inside, the deepest of them is kept.
+    float winding = (windingarea(a, b, c, normal) < 0) ? -1.0f : 1.0f;
+    uint32_t deepest = 3;
+    bestvalue = 0.0f;
+    best = count;
+    for (uint32_t i = 3; i < count; i++) {
+        const _vec3 &p = contacts[i].m_contact_point;
+        float outside = -winding * windingarea(a, b, p, normal);
+        float value;
+        if ((value = -winding * windingarea(b, c, p, normal)) > outside) { outside = value; }
+        if ((value = -winding * windingarea(c, a, p, normal)) > outside) { outside = value; }
+        if (outside > bestvalue) { bestvalue = outside; best = i; }
+        if (contacts[i].m_penetration > contacts[deepest].m_penetration) { deepest = i; }
+    }
+    keepcontact(contacts, 3, (best < count) ? best : deepest);
+
+    return manifold_max_contacts;
+}
+
+uint32_t collision_detector::sweptsphereandhalfspace(
+    const collision_sphere &sphere,
+    const _vec3 &start,
+    const collision_plane &plane,
+    float *time,
+    collision_data *data
+    )
+{
+    if (!intersection_tests::sweptsphereandhalfspace(sphere, start, plane, time)) { return 0; }
+
+    // the contact is where the sphere meets the plane
+    _vec3 position = start + (sphere.getaxis(3) - start) * (*time);
+
+    // make sure there is room for it
+    if (!data->reserve(1)) { return 0; }
+
+    contact* contact = data->m_contacts;
+    contact->m_contact_normal = plane.m_direction;
+    contact->m_penetration = 0;
+    contact->m_contact_point = position - plane.m_direction * sphere.m_radius;
+    contact->m_feature = planefeature(plane);
+    contact->setbodydata(sphere.m_body, NULL, data->m_friction, data->m_restitution);
+
+    data->addcontacts(1);
+    return 1;
+}
+
+uint32_t collision_detector::sweptsphereandbox(
+    const collision_box &box,
+    const collision_sphere &sphere,
+    const _vec3 &start,
+    float *time,
+    collision_data *data
+    )
+{
+    // sweep the sphere in box coordinates
+    _vec3 localstart = box.m_transform.transforminverse(start);
+    _vec3 localend   = box.m_transform.transforminverse(sphere.getaxis(3));
+    _vec3 closestpt;
+    if (!sweepsphereinbox(box.m_half_size, sphere.m_radius, localstart, localend, time, &closestpt)) { return 0; }
+
+    // compile the contact as boxandsphere does, at the point of impact
+    _vec3 centre = start + (sphere.getaxis(3) - start) * (*time);
+    _vec3 closestptworld = box.m_transform.transform(closestpt);
+
+    // make sure there is room for it
+    if (!data->reserve(1)) { return 0; }
+
+    contact* contact = data->m_contacts;
+    contact->m_contact_normal = (closestptworld - centre);
+    contact->m_contact_normal.normalise();
+
+    contact->m_contact_point = closestptworld;
+    contact->m_penetration = 0;
+    contact->m_feature = 0;
+    contact->setbodydata(box.m_body, sphere.m_body, data->m_friction, data->m_restitution);
+
+    data->addcontacts(1);
+    return 1;
+}
@@ -1,248 +1,594 @@
-#pragma once
-
-/**
-* this file contains the fine grained collision detection system.
-* it is used to return contacts between pairs of primitives.
-*
-* there are two groups of tests in this file. intersection tests
-* use the fastest separating axis method to check if two objects
-* intersect, and the collision tests generate the contacts. the
-* collision tests typically use the intersection tests as an early
-* out.
-*/
-
-#include "contacts.h"
-
-/**
-* represents a primitive to detect collisions against.
-*/
-struct collision_primitive {
-
-	/**
-	* the rigid body that is represented by this primitive.
-	*/
-	rigid_body * m_body;
-
-	/**
-	* the offset of this primitive from the given rigid body.
-	*/
-	_mat4 m_offset;
-
-	/**
-	* calculates the internals for the primitive.
-	*/
-	void calculateinternals();
-
-	/**
-	* this is a convenience function to allow access to the
-	* axis vectors in the transform for this primitive.
-	*/
-	_vec3 getaxis(uint32_t index) const { return m_transform.getaxisvector(index); }
-
-	/**
-	* returns the resultant transform of the primitive, calculated from
-	* the combined offset of the primitive and the transform
-	* (orientation + position) of the rigid body to which it is
-	* attached.
-	*/
-	const _mat4 & gettransform() const { return m_transform; }
-
-	/**
-	* the resultant transform of the primitive. this is
-	* calculated by combining the offset of the primitive
-	* with the transform of the rigid body.
-	*/
-	_mat4 m_transform;
-};
-
-/**
-* represents a rigid body that can be treated as a sphere
-* for collision detection.
-*/
-struct collision_sphere : public collision_primitive {
-	/**
-	* the radius of the sphere.
-	*/
-	float m_radius;
-};
-
-/**
-* the plane is not a primitive: it doesn't represent another
-* rigid body. it is used for contacts with the immovable
-* world geometry.
-*/
-struct collision_plane {
-	/**
-	* the plane normal
-	*/
-	_vec3 m_direction;
-
-	/**
-	* the distance of the plane from the origin.
-	*/
-	float m_offset;
-};
-
-/**
-* represents a rigid body that can be treated as an aligned bounding
-* box for collision detection.
-*/
-struct collision_box : public collision_primitive {
-	/**
-	* holds the half-sizes of the box along each of its local axes.
-	*/
-	_vec3 m_half_size;
-};
-
-/**
-* a wrapper class that holds fast intersection tests. these
-* can be used to drive the coarse collision detection system or
-* as an early out in the full collision tests below.
-*/
-struct intersection_tests {
-public:
-
-	static bool sphereandhalfspace( 
-		const collision_sphere &sphere, 
-		const collision_plane &plane
-		);
-	static bool sphereandsphere(
-		const collision_sphere &one,
-		const collision_sphere &two
-		);
-	static bool boxandbox(
-		const collision_box &one,
-		const collision_box &two
-		);
-
-	/**
-	* does an intersection test on an arbitrarily aligned box and a
-	* half-space.
-	*
-	* the box is given as a transform matrix, including
-	* position, and a vector of half-sizes for the extend of the
-	* box along each local axis.
-	*
-	* the half-space is given as a direction (i.e. unit) vector and the
-	* offset of the limiting plane from the origin, along the given
-	* direction.
-	*/
-	static bool boxandhalfspace( const collision_box &box, const collision_plane &plane);
-};
-
-
-/**
-* a helper structure that contains information for the detector to use
-* in building its contact data.
-*/
-struct collision_data {
-
-	/**
-	* holds the base of the collision data: the first contact
-	* in the array. this is used so that the contact pointer (below)
-	* can be incremented each time a contact is detected, while
-	* this pointer points to the first contact found.
-	*/
-	contact * m_contact_array;
-
-	/** holds the contact array to write into. */
-	contact * m_contacts;
-
-	/** holds the maximum number of contacts the array can take. */
-	int32_t   m_contacts_left;
-
-	/** holds the number of contacts found so far. */
-	uint32_t  m_contact_count;
-
-	/** holds the friction value to write into any collisions. */
-	float     m_friction;
-
-	/** holds the restitution value to write into any collisions. */
-	float     m_restitution;
-
-	/**
-	* checks if there are more contacts available in the contact
-	* data.
-	*/
-	bool hasmorecontacts() { return m_contacts_left > 0; }
-
-	/**
-	* resets the data so that it has no used contacts recorded.
-	*/
-	void reset( uint32_t maxcontacts) {
-		m_contacts_left = maxcontacts;
-		m_contact_count = 0;
-		m_contacts = m_contact_array;
-	}
-
-	/**
-	* notifies the data that the given number of contacts have
-	* been added.
-	*/
-	void addcontacts( uint32_t count) {
-		// reduce the number of contacts remaining, add number used
-		m_contacts_left -= count;
-		m_contact_count += count;
-
-		// move the array forward
-		m_contacts += count;
-	}
-};
-
-/**
-* a wrapper class that holds the fine grained collision detection
-* routines.
-*
-* each of the functions has the same format: it takes the details
-* of two objects, and a pointer to a contact array to fill. it
-* returns the number of contacts it wrote into the array.
-*/
-struct collision_detector {
-
-	static uint32_t sphereandhalfspace(
-		const collision_sphere &sphere,
-		const collision_plane &plane,
-		collision_data *data );
-
-	static uint32_t sphereandtrueplane(
-		const collision_sphere &sphere,
-		const collision_plane &plane,
-		collision_data *data
-		);
-
-	static uint32_t sphereandsphere(
-		const collision_sphere &one,
-		const collision_sphere &two,
-		collision_data *data
-		);
-
-	/**
-	* does a collision test on a collision box and a plane representing
-	* a half-space (i.e. the normal of the plane
-	* points out of the half-space).
-	*/
-	static uint32_t boxandhalfspace(
-		const collision_box &box,
-		const collision_plane &plane,
-		collision_data *data
-		);
-
-	static uint32_t boxandbox(
-		const collision_box &one,
-		const collision_box &two,
-		collision_data *data
-		);
-
-	static uint32_t boxandpoint(
-		const collision_box &box,
-		const _vec3 &point,
-		collision_data *data
-		);
-
-	static uint32_t boxandsphere(
-		const collision_box &box,
-		const collision_sphere &sphere,
-		collision_data *data
-		);
-};
-
+#pragma once
+
+/**
+* this file contains the fine grained collision detection system.
+* it is used to return contacts between pairs of primitives.
+*
+* there are two groups of tests in this file. intersection tests
+* use the fastest separating axis method to check if two objects
+* intersect, and the collision tests generate the contacts. the
+* collision tests typically use the intersection tests as an early
+* out.
+*/
+
+#include "contacts.h"
+
+/** the category a primitive is in unless it is given others. */
+#define collision_category_default 0x00000001
+
+/** a mask that lets a primitive collide with every category. */
+#define collision_mask_all 0xffffffff
+
+/**
+* represents a primitive to detect collisions against.
+*/
+struct collision_primitive {
+
+	collision_primitive() : m_body(NULL), m_category(collision_category_default), m_mask(collision_mask_all), m_trigger(false) {}
+
+	/**
+	* the rigid body that is represented by this primitive.
+	*/
+	rigid_body * m_body;
+
+	/**
+	* holds the categories the primitive is in, one bit each, and the
+	* categories it collides with. a pair is only passed on by the
+	* coarse collision detection when each primitive is in a category
+	* the mask of the other has.
+	*/
+	uint32_t m_category;
+	uint32_t m_mask;
+
+	/**
+	* set for a primitive that only reports what it overlaps, such as
+	* a region that notices something entering it. no contacts are
+	* made for it, so it pushes nothing, and casts pass through it.
+	*/
+	bool m_trigger;
+
+	/**
+	* returns true if the categories and masks of the two primitives
+	* let them collide.
+	*/
+	bool collideswith(const collision_primitive &other) const {
+		return (m_category & other.m_mask) && (other.m_category & m_mask);
+	}
+
+	/**
+	* the offset of this primitive from the given rigid body.
+	*/
+	_aff m_offset;
+
+	/**
+	* calculates the internals for the primitive.
+	*/
+	void calculateinternals();
+
+	/**
+	* this is a convenience function to allow access to the
+	* axis vectors in the transform for this primitive.
+	*/
+	_vec3 getaxis(uint32_t index) const { return m_transform.getaxisvector(index); }
+
+	/**
+	* returns the resultant transform of the primitive, calculated from
+	* the combined offset of the primitive and the transform
+	* (orientation + position) of the rigid body to which it is
+	* attached.
+	*/
+	const _aff & gettransform() const { return m_transform; }
+
+	/**
+	* the resultant transform of the primitive. this is
+	* calculated by combining the offset of the primitive
+	* with the transform of the rigid body.
+	*/
+	_aff m_transform;
+};
+
+/**
+* represents a rigid body that can be treated as a sphere
+* for collision detection.
+*/
+struct collision_sphere : public collision_primitive {
+	/**
+	* the radius of the sphere.
+	*/
+	float m_radius;
+};
+
+/**
+* the plane is not a primitive: it doesn't represent another
+* rigid body. it is used for contacts with the immovable
+* world geometry.
+*/
+struct collision_plane {
+	/**
+	* the plane normal
+	*/
+	_vec3 m_direction;
+
+	/**
+	* the distance of the plane from the origin.
+	*/
+	float m_offset;
+};
+
+#define plane_set_none 0xffffffff
+
+/**
+* a set of planes that never move, such as the walls of a room,
+* stored a component to an array so many spheres can be tested
+* against all of them at once.
+*/
+struct plane_set {
+
+	/** hold the components of the plane normals. */
+	_array<float> m_x;
+	_array<float> m_y;
+	_array<float> m_z;
+
+	/** holds the distances of the planes from the origin. */
+	_array<float> m_offset;
+
+	/** holds the feature id of each plane, for the contact cache. */
+	_array<uint32_t> m_feature;
+
+	/** the number of planes in the set. */
+	uint32_t count() const { return m_offset.m_count; }
+
+	/** adds a plane to the set. */
+	void add(const collision_plane &plane);
+
+	/** removes every plane. */
+	void clear();
+};
+
+/**
+* represents a rigid body that can be treated as an aligned bounding
+* box for collision detection.
+*/
+struct collision_box : public collision_primitive {
+	/**
+	* holds the half-sizes of the box along each of its local axes.
+	*/
+	_vec3 m_half_size;
+};
+
+/**
+* a wrapper class that holds fast intersection tests. these
+* can be used to drive the coarse collision detection system or
+* as an early out in the full collision tests below.
+*/
+struct intersection_tests {
+public:
+
+	static bool sphereandhalfspace( 
+		const collision_sphere &sphere, 
+		const collision_plane &plane
+		);
+	static bool sphereandsphere(
+		const collision_sphere &one,
+		const collision_sphere &two
+		);
+	/**
+	* checks the boxes against the 15 separating axes. this calls the
+	* sse version when there is one, and collision_detector::s_simd
+	* is set.
+	*/
+	static bool boxandbox(
+		const collision_box &one,
+		const collision_box &two
+		);
+
+	/**
+	* the scalar version of boxandbox, testing one axis at a time. it
+	* is kept as the reference the sse version must agree with.
+	*/
+	static bool boxandboxscalar(
+		const collision_box &one,
+		const collision_box &two
+		);
+
+	/**
+	* does an intersection test on an arbitrarily aligned box and a
+	* half-space.
+	*
+	* the box is given as a transform matrix, including
+	* position, and a vector of half-sizes for the extend of the
+	* box along each local axis.
+	*
+	* the half-space is given as a direction (i.e. unit) vector and the
+	* offset of the limiting plane from the origin, along the given
+	* direction.
+	*/
+	static bool boxandhalfspace( const collision_box &box, const collision_plane &plane);
+
+	/**
+	* checks if the sphere touches the box.
+	*/
+	static bool boxandsphere( const collision_box &box, const collision_sphere &sphere);
+
+	/**
+	* sweeps the sphere from the given start position to where it is
+	* now, and finds the first time it touches the half-space. the
+	* time runs from 0 at the start to 1 at the current position.
+	* returns false if the sphere doesn't reach the plane, or already
+	* touches it at the start, which is left to the tests above.
+	*/
+	static bool sweptsphereandhalfspace(
+		const collision_sphere &sphere,
+		const _vec3 &start,
+		const collision_plane &plane,
+		float *time
+		);
+
+	/**
+	* sweeps the sphere from the given start position to where it is
+	* now, and finds the first time it touches the box. the box is
+	* taken to be still, at its current position. returns false if
+	* the sphere misses the box, or already touches it at the start.
+	*/
+	static bool sweptsphereandbox(
+		const collision_box &box,
+		const collision_sphere &sphere,
+		const _vec3 &start,
+		float *time
+		);
+
+	/**
+	* the ray tests find where a sphere of the given radius, moving
+	* from the origin along the direction, first touches the object.
+	* a radius of zero casts a plain ray. the direction must be unit
+	* length. they write the distance travelled and the normal of
+	* the surface that was hit, and return false if nothing is hit
+	* within the maximum distance, or the cast starts out touching
+	* the object.
+	*/
+	static bool rayandhalfspace(
+		const collision_plane &plane,
+		const _vec3 &origin,
+		const _vec3 &direction,
+		float radius,
+		float max_distance,
+		float *distance,
+		_vec3 *normal
+		);
+
+	static bool rayandsphere(
+		const collision_sphere &sphere,
+		const _vec3 &origin,
+		const _vec3 &direction,
+		float radius,
+		float max_distance,
+		float *distance,
+		_vec3 *normal
+		);
+
+	static bool rayandbox(
+		const collision_box &box,
+		const _vec3 &origin,
+		const _vec3 &direction,
+		float radius,
+		float max_distance,
+		float *distance,
+		_vec3 *normal
+		);
+};
+
+
+/**
+* the most contacts kept between a box and a plane or another box.
+* four points spread over the face resting on it are enough to hold
+* the box still, the rest only give the resolver more work.
+*/
+#define manifold_max_contacts 4
+
+/**
+* how much more two boxes may penetrate on a face axis than on an
+* edge axis, and still be given the face's manifold: the face is kept
+* while its penetration is within box_face_relative times the edge's,
+* plus box_face_absolute. box one's faces are kept over box two's the
+* same way.
+*/
+#define box_face_relative 1.05f
+#define box_face_absolute 0.005f
+
+/**
+* a pair of primitives found overlapping where one of them is a
+* trigger, so no contact was made.
+*/
+struct collision_overlap {
+
+	/** holds the primitives that overlap, the trigger may be either. */
+	collision_primitive * m_primitive[2];
+};
+
+/**
+* a helper structure that contains information for the detector to use
+* in building its contact data.
+*
+* the contacts are written into an array owned by the data, which is
+* sized up front by create and grows when a step finds more, up to a
+* limit. contacts found past the limit are dropped and counted, so a
+* crowded scene loses its contacts in a way that can be seen.
+*/
+struct collision_data {
+
+	collision_data();
+
+	/** holds the contacts, the array is reused from step to step. */
+	_array<contact> m_buffer;
+
+	/**
+	* holds the base of the collision data: the first contact
+	* in the array. this is used so that the contact pointer (below)
+	* can be incremented each time a contact is detected, while
+	* this pointer points to the first contact found. it moves when
+	* the array grows.
+	*/
+	contact * m_contact_array;
+
+	/** holds the contact array to write into. */
+	contact * m_contacts;
+
+	/** holds the number of contacts the array has room for still. */
+	int32_t   m_contacts_left;
+
+	/** holds the number of contacts found so far. */
+	uint32_t  m_contact_count;
+
+	/**
+	* holds the most contacts the array may grow to, or zero to let it
+	* grow as far as it needs.
+	*/
+	uint32_t  m_contact_limit;
+
+	/**
+	* holds the number of contacts found but dropped by manifold
+	* reduction, since the last reset.
+	*/
+	uint32_t  m_reduced_count;
+
+	/**
+	* holds the number of contacts found but dropped for want of room,
+	* since the last reset.
+	*/
+	uint32_t  m_overflow_count;
+
+	/**
+	* holds the most contacts found in one step since create, those
+	* dropped for want of room included.
+	*/
+	uint32_t  m_high_water;
+
+	/** holds the number of times the array has grown since create. */
+	uint32_t  m_grow_count;
+
+	/**
+	* holds the overlaps found with triggers since the last reset, in
+	* place of contacts.
+	*/
+	_array<collision_overlap> m_overlaps;
+
+	/** holds the friction value to write into any collisions. */
+	float     m_friction;
+
+	/** holds the restitution value to write into any collisions. */
+	float     m_restitution;
+
+	/**
+	* makes room for the given number of contacts up front, and sets
+	* the most the array may grow to.
+	*/
+	bool create( uint32_t capacity, uint32_t limit);
+
+	/** frees the array. */
+	void destroy();
+
+	/**
+	* checks if there are more contacts available in the contact
+	* data, without growing it.
+	*/
+	bool hasmorecontacts() { return m_contacts_left > 0; }
+
+	/**
+	* makes room for the given number of contacts, growing the array
+	* when it is allowed to, and returns how many of them fit. the
+	* rest are counted as overflow, the detectors call this once they
+	* know they have a contact to write.
+	*/
+	uint32_t reserve( uint32_t count);
+
+	/**
+	* resets the data so that it has no used contacts recorded.
+	*/
+	void reset() {
+		m_contacts_left  = m_buffer.m_size;
+		m_contact_count  = 0;
+		m_reduced_count  = 0;
+		m_overflow_count = 0;
+		m_contact_array  = m_buffer.m_data;
+		m_contacts       = m_contact_array;
+		m_overlaps.m_count = 0;
+	}
+
+	/**
+	* records that the two primitives overlap, when one is a trigger.
+	*/
+	void addoverlap( collision_primitive *one, collision_primitive *two) {
+		collision_overlap overlap;
+		overlap.m_primitive[0] = one;
+		overlap.m_primitive[1] = two;
+		m_overlaps.pushback(overlap,true);
+	}
+
+	/**
+	* notifies the data that the given number of contacts have
+	* been added.
+	*/
+	void addcontacts( uint32_t count) {
+		// reduce the number of contacts remaining, add number used
+		m_contacts_left -= count;
+		m_contact_count += count;
+		if (m_contact_count + m_overflow_count > m_high_water) { m_high_water = m_contact_count + m_overflow_count; }
+
+		// move the array forward
+		m_contacts += count;
+	}
+};
+
+/**
+* a wrapper class that holds the fine grained collision detection
+* routines.
+*
+* each of the functions has the same format: it takes the details
+* of two objects, and a pointer to a contact array to fill. it
+* returns the number of contacts it wrote into the array.
+*/
+struct collision_detector {
+
+	static uint32_t sphereandhalfspace(
+		const collision_sphere &sphere,
+		const collision_plane &plane,
+		collision_data *data );
+
+	static uint32_t sphereandtrueplane(
+		const collision_sphere &sphere,
+		const collision_plane &plane,
+		collision_data *data
+		);
+
+	static uint32_t sphereandsphere(
+		const collision_sphere &one,
+		const collision_sphere &two,
+		collision_data *data
+		);
+
+	/**
+	* tests a batch of spheres against every plane of the set at once,
+	* four spheres at a time on sse. each sphere gets at most one
+	* contact, as from sphereandhalfspace, with the first plane of the
+	* set it goes through. the index of that plane, or plane_set_none,
+	* is written into hits for each sphere, even if its contact could
+	* not be kept for want of room.
+	*/
+	static uint32_t spheresandhalfspaces(
+		collision_sphere * const spheres[],
+		uint32_t count,
+		const plane_set &planes,
+		uint32_t *hits,
+		collision_data *data
+		);
+
+	/**
+	* does a collision test on a collision box and a plane representing
+	* a half-space (i.e. the normal of the plane
+	* points out of the half-space).
+	*
+	* a box sunk into the plane can have up to 8 vertices under it.
+	* when s_reduce is set, no more than manifold_max_contacts of them
+	* are kept, see reducemanifold.
+	*/
+	static uint32_t boxandhalfspace(
+		const collision_box &box,
+		const collision_plane &plane,
+		collision_data *data
+		);
+
+	/**
+	* set to run the box and box tests on sse, where it is built in.
+	* clear it to compare against the scalar tests.
+	*/
+	static bool s_simd;
+
+	/**
+	* set to cut the contacts of each box and plane, and each pair of
+	* boxes, down to manifold_max_contacts. clear it to compare against
+	* keeping them all.
+	*/
+	static bool s_reduce;
+
+	/**
+	* keeps no more than manifold_max_contacts of the given contacts,
+	* which must share a normal, and returns how many are kept. they
+	* are chosen to hold the bodies up over the largest area, with the
+	* deepest: the deepest contact first, then the one farthest from
+	* it, then the one making the largest triangle with those two,
+	* then the one adding the most area to that triangle. the contacts
+	* kept are moved to the front of the array.
+	*/
+	static uint32_t reducemanifold(
+		contact *contacts,
+		uint32_t count,
+		const _vec3 &normal
+		);
+
+	/**
+	* does a collision test on two boxes. the penetration on all 15
+	* separating axes is found four axes at a time on sse, when
+	* s_simd is set, otherwise one at a time.
+	*
+	* boxes meeting edge to edge get a single contact. where a face of
+	* one box meets the other, the face of the other most turned
+	* against it is clipped to its sides, and every point of that under
+	* the face is a contact, up to eight, reduced as s_reduce says. an
+	* edge axis must penetrate clearly less than the face axes to be
+	* taken, see box_face_relative.
+	*/
+	static uint32_t boxandbox(
+		const collision_box &one,
+		const collision_box &two,
+		collision_data *data
+		);
+
+	/**
+	* the scalar version of boxandbox, kept as the reference. both
+	* write the same contact for the same boxes.
+	*/
+	static uint32_t boxandboxscalar(
+		const collision_box &one,
+		const collision_box &two,
+		collision_data *data
+		);
+
+	static uint32_t boxandpoint(
+		const collision_box &box,
+		const _vec3 &point,
+		collision_data *data
+		);
+
+	static uint32_t boxandsphere(
+		const collision_box &box,
+		const collision_sphere &sphere,
+		collision_data *data
+		);
+
+	/**
+	* the swept tests write the contact found where the sphere first
+	* touches the other object on its way from the given start
+	* position, rather than where it is now. the time of impact is
+	* written into time. they are used for bodies set to be
+	* continuous, which could otherwise pass straight through.
+	*
+	* the contact has no penetration: the caller is expected to move
+	* the sphere back to the point of impact.
+	*/
+	static uint32_t sweptsphereandhalfspace(
+		const collision_sphere &sphere,
+		const _vec3 &start,
+		const collision_plane &plane,
+		float *time,
+		collision_data *data
+		);
+
+	static uint32_t sweptsphereandbox(
+		const collision_box &box,
+		const collision_sphere &sphere,
+		const _vec3 &start,
+		float *time,
+		collision_data *data
+		);
+};
+
@@ -0,0 +1,187 @@
+#include "collide_query.h"
+
+#include <cstdio>
+
+collision_query::collision_query() {
+	m_tree        = NULL;
+	m_planes      = NULL;
+	m_plane_count = 0;
+	m_plane_category = collision_category_default;
+	m_pool        = NULL;
+}
+
+bool collision_query::raycast(const _vec3 &origin, const _vec3 &direction, float max_distance, raycast_hit *hit, uint32_t mask) const {
+	return spherecast(origin, direction, 0.0f, max_distance, hit, mask);
+}
+
+bool collision_query::spherecast(const _vec3 &origin, const _vec3 &direction, float radius, float max_distance, raycast_hit *hit, uint32_t mask) const {
+	raycast_query query;
+	query.m_origin       = origin;
+	query.m_direction    = direction;
+	query.m_radius       = radius;
+	query.m_max_distance = max_distance;
+	query.m_mask         = mask;
+	return cast(query, hit);
+}
+
+bool collision_query::cast(const raycast_query &query, raycast_hit *hit) const {
+
+	hit->m_primitive = NULL;
+	hit->m_type      = primitive_sphere;
+	hit->m_body      = NULL;
+	hit->m_plane     = NULL;
+	hit->m_distance  = query.m_max_distance;
+
+	_vec3 direction = query.m_direction;
+	direction.normalise();
+	if (direction.squaremagnitude() == 0) { return false; }
+
+	// walking the tree depth first never holds more than its height
+	// and one nodes on the stack.
+	bool walk = m_tree && m_tree->m_root != aabb_null_node;
+	if (walk && m_tree->m_nodes[m_tree->m_root].m_height >= query_stack_size) { application_throw("collision_query stack"); }
+
+	const _vec3 &origin = query.m_origin;
+	float radius = query.m_radius;
+	float distance;
+	_vec3 normal;
+
+	for (uint32_t i = 0; i < m_plane_count && (m_plane_category & query.m_mask); i++) {
+		if (intersection_tests::rayandhalfspace(m_planes[i], origin, direction, radius, hit->m_distance, &distance, &normal)) {
+			hit->m_plane    = &m_planes[i];
+			hit->m_distance = distance;
+			hit->m_normal   = normal;
+		}
+	}
+
+	if (walk) {
+
+		// a zero component gives an infinite reciprocal, which
+		// intersectsray takes as a ray parallel to that pair of slabs.
+		_vec3 inverse(1.0f/direction.x, 1.0f/direction.y, 1.0f/direction.z);
+		_vec3 grow(radius, radius, radius);
+
+		// walk the tree with a stack of our own, so casts can run at once.
+		// nodes further away than the nearest hit so far are skipped.
+		uint32_t stack[query_stack_size];
+		uint32_t top = 0;
+		stack[top++] = m_tree->m_root;
+
+		while (top) {
+			const aabb_tree_node &node = m_tree->m_nodes[ stack[--top] ];
+			bounding_box bounds(node.m_bounds.m_min - grow, node.m_bounds.m_max + grow);
+			if (!bounds.intersectsray(origin, inverse, hit->m_distance)) { continue; }
+
+			if (!node.isleaf()) {
+				stack[top++] = node.m_child[0];
+				stack[top++] = node.m_child[1];
+				continue;
+			}
+			if (node.m_primitive->m_trigger || !(node.m_primitive->m_category & query.m_mask)) { continue; }
+
+			bool found = false;
+			switch (node.m_type) {
+			case primitive_sphere:
+				found = intersection_tests::rayandsphere(*(collision_sphere*)node.m_primitive,
+					origin, direction, radius, hit->m_distance, &distance, &normal);
+				break;
+			case primitive_box:
+				found = intersection_tests::rayandbox(*(collision_box*)node.m_primitive,
+					origin, direction, radius, hit->m_distance, &distance, &normal);
+				break;
+			}
+			if (found && distance < hit->m_distance) {
+				hit->m_primitive = node.m_primitive;
+				hit->m_type      = node.m_type;
+				hit->m_body      = node.m_primitive->m_body;
+				hit->m_plane     = NULL;
+				hit->m_distance  = distance;
+				hit->m_normal    = normal;
+			}
+		}
+	}
+
+	if (!hit->hit()) { return false; }
+
+	// the surface point lies one radius back along the normal from the
+	// centre of the cast
+	hit->m_point = origin + direction * hit->m_distance - hit->m_normal * radius;
+	return true;
+}
+
+/**
+* what each job of a batch of casts works on: either whole queries,
+* or rays that share the rest of one query.
+*/
+struct query_batch {
+	const collision_query * m_query;
+	const raycast_query   * m_queries;
+	const _vec3           * m_origins;
+	const _vec3           * m_directions;
+	raycast_query           m_ray;
+	raycast_hit           * m_hits;
+	uint32_t                m_count;
+};
+
+static void castbatchjob(void *data, uint32_t index) {
+	query_batch *batch = (query_batch*)data;
+
+	uint32_t first = index * query_batch_size;
+	uint32_t last  = first + query_batch_size;
+	if (last > batch->m_count) { last = batch->m_count; }
+
+	if (batch->m_queries) {
+		for (uint32_t i = first; i < last; i++) { batch->m_query->cast(batch->m_queries[i], &batch->m_hits[i]); }
+		return;
+	}
+	raycast_query ray = batch->m_ray;
+	for (uint32_t i = first; i < last; i++) {
+		ray.m_origin    = batch->m_origins[i];
+		ray.m_direction = batch->m_directions[i];
+		batch->m_query->cast(ray, &batch->m_hits[i]);
+	}
+}
+
+/* runs the jobs of a batch, over the pool if there is one, and counts the hits */
+static uint32_t runbatch(thread_pool *pool, query_batch *batch) {
+
+	uint32_t jobs = (batch->m_count + query_batch_size - 1) / query_batch_size;
+	if (pool) {
+		pool->run(castbatchjob, batch, jobs);
+	} else {
+		for (uint32_t i = 0; i < jobs; i++) { castbatchjob(batch, i); }
+	}
+
+	uint32_t hitcount = 0;
+	for (uint32_t i = 0; i < batch->m_count; i++) {
+		if (batch->m_hits[i].hit()) { hitcount++; }
+	}
+	return hitcount;
+}
+
+uint32_t collision_query::castbatch(const raycast_query *queries, raycast_hit *hits, uint32_t count) const {
+
+	query_batch batch;
+	batch.m_query      = this;
+	batch.m_queries    = queries;
+	batch.m_origins    = NULL;
+	batch.m_directions = NULL;
+	batch.m_hits       = hits;
+	batch.m_count      = count;
+	return runbatch(m_pool, &batch);
+}
+
+uint32_t collision_query::raycastbatch(const _vec3 *origins, const _vec3 *directions, float max_distance, raycast_hit *hits,
+	uint32_t count, uint32_t mask) const {
+
+	query_batch batch;
+	batch.m_query      = this;
+	batch.m_queries    = NULL;
+	batch.m_origins    = origins;
+	batch.m_directions = directions;
+	batch.m_ray.m_max_distance = max_distance;
+	batch.m_ray.m_mask         = mask;
+	batch.m_hits       = hits;
+	batch.m_count      = count;
+	return runbatch(m_pool, &batch);
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+/**
+* this file contains queries against the collision scene: casting
+* rays and spheres into it to find what they hit, without creating
+* a body. the primitives are found through the bounding volume tree
+* of the coarse collision system, so a cast only tests the few
+* primitives near its path.
+*/
+
+#include "collide_coarse.h"
+#include "thread_pool.h"
+
+/**
+* the most nodes a single cast holds to walk the tree, one more than
+* the height of the tallest tree it can walk.
+*/
+#define query_stack_size 128
+
+/** the number of casts of a batch run together as one job. */
+#define query_batch_size 64
+
+/**
+* describes one cast. a radius of zero casts a ray, anything
+* larger casts a sphere of that radius.
+*/
+struct raycast_query {
+
+	raycast_query() : m_radius(0.0f), m_max_distance(0.0f), m_mask(collision_mask_all) {}
+
+	/** holds the point the cast starts from. */
+	_vec3 m_origin;
+
+	/** holds the direction of the cast, it need not be unit length. */
+	_vec3 m_direction;
+
+	/** holds the radius of the sphere cast. */
+	float m_radius;
+
+	/** holds how far the cast goes. */
+	float m_max_distance;
+
+	/**
+	* holds the categories of primitive the cast can hit. triggers are
+	* never hit.
+	*/
+	uint32_t m_mask;
+};
+
+/**
+* holds the first thing a cast hit.
+*/
+struct raycast_hit {
+
+	/** the primitive hit, NULL if a plane or nothing was hit. */
+	collision_primitive * m_primitive;
+
+	/** the shape of the primitive hit. */
+	primitive_type m_type;
+
+	/** the body of the primitive hit, NULL for the planes. */
+	rigid_body * m_body;
+
+	/** the plane hit, NULL if a primitive or nothing was hit. */
+	const collision_plane * m_plane;
+
+	/** holds the point of the surface that was hit. */
+	_vec3 m_point;
+
+	/** holds the normal of the surface that was hit. */
+	_vec3 m_normal;
+
+	/** holds how far the cast went before it hit. */
+	float m_distance;
+
+	/** returns true if the cast hit anything. */
+	bool hit() const { return m_primitive || m_plane; }
+};
+
+/**
+* casts rays and spheres against the primitives of a bounding
+* volume tree and a set of planes.
+*
+* the tree is only read, so any number of casts can run at once, as
+* long as it isn't changed while they do.
+*/
+struct collision_query {
+
+	collision_query();
+
+	/** the tree holding the primitives to cast against. */
+	dynamic_aabb_tree * m_tree;
+
+	/** the planes to cast against, treated as half-spaces. */
+	const collision_plane * m_planes;
+
+	/** the number of planes. */
+	uint32_t m_plane_count;
+
+	/**
+	* the category of the planes, they are hit only by casts whose
+	* mask holds it.
+	*/
+	uint32_t m_plane_category;
+
+	/** if set, large batches are spread over the threads of this pool. */
+	thread_pool * m_pool;
+
+	/**
+	* finds the first primitive or plane hit by the ray. returns
+	* false if nothing is hit before the maximum distance. only
+	* primitives in a category of the mask are hit, and the planes
+	* only if it holds m_plane_category.
+	*/
+	bool raycast(const _vec3 &origin, const _vec3 &direction, float max_distance, raycast_hit *hit,
+		uint32_t mask = collision_mask_all) const;
+
+	/**
+	* finds the first primitive or plane touched by a sphere of the
+	* given radius moving along the ray.
+	*/
+	bool spherecast(const _vec3 &origin, const _vec3 &direction, float radius, float max_distance, raycast_hit *hit,
+		uint32_t mask = collision_mask_all) const;
+
+	/**
+	* runs one cast, as described by the query. a tree too tall for
+	* query_stack_size is an error, and nothing is hit.
+	*/
+	bool cast(const raycast_query &query, raycast_hit *hit) const;
+
+	/**
+	* runs a batch of casts, writing the result of each query into the
+	* hit with the same index. returns the number of casts that hit.
+	*/
+	uint32_t castbatch(const raycast_query *queries, raycast_hit *hits, uint32_t count) const;
+
+	/**
+	* casts a batch of rays that share a maximum distance and a mask,
+	* such as the pellets of one shot, writing the result of each ray
+	* into the hit with the same index. returns the number that hit.
+	*/
+	uint32_t raycastbatch(const _vec3 *origins, const _vec3 *directions, float max_distance, raycast_hit *hits,
+		uint32_t count, uint32_t mask = collision_mask_all) const;
+};
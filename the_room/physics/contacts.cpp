@@ -1,615 +1,1123 @@
-
-
-#include "contacts.h"
-#include <memory.h>
-
-#include <body.h>
-
-// contact implementation
-
-void contact::setbodydata(rigid_body* one, rigid_body *two, float friction, float restitution) {
-    m_body[0] = one;
-    m_body[1] = two;
-    m_friction = friction;
-    m_restitution = restitution;
-}
-
-void contact::matchawakestate() {
-    // collisions with the world never cause a body to wake up.
-    if (!m_body[1]) { return; }
-
-    bool body0awake = m_body[0]->getawake();
-    bool body1awake = m_body[1]->getawake();
-
-    // wake up only the sleeping one
-    if (body0awake ^ body1awake) {
-		if (body0awake) { m_body[1]->setawake(); }
-		else { m_body[0]->setawake(); }
-    }
-}
-
-/*
- * swaps the bodies in the current contact, so body 0 is at body 1 and
- * vice versa. this also changes the direction of the contact normal,
- * but doesn't update any calculated internal data. if you are calling
- * this method manually, then call calculateinternals afterwards to
- * make sure the internal data is up to date.
- */
-void contact::swapbodies() {
-
-	m_contact_normal *= -1;
-
-    rigid_body *temp = m_body[0];
-    m_body[0] = m_body[1];
-    m_body[1] = temp;
-}
-
-/*
- * constructs an arbitrary orthonormal basis for the contact.  this is
- * stored as a 3x3 matrix, where each vector is a column (in other
- * words the matrix transforms contact space into world space). the x
- * direction is generated from the contact normal, and the y and z
- * directionss are set so they are at right angles to it.
- */
-inline
-void contact::calculatecontactbasis() {
-
-    _vec3 contacttangent[2];
-
-    // check whether the z-axis is nearer to the x or y axis
-    if ( abs(m_contact_normal.x) > abs(m_contact_normal.y) ) {
-        // scaling factor to ensure the results are normalised
-        const float s = (float)1.0/sqrt(m_contact_normal.z * m_contact_normal.z + m_contact_normal.x*m_contact_normal.x);
-
-        // the new x-axis is at right angles to the world y-axis
-        contacttangent[0].x =  m_contact_normal.z*s;
-        contacttangent[0].y =  0;
-        contacttangent[0].z = -m_contact_normal.x*s;
-
-        // the new y-axis is at right angles to the new x- and z- axes
-        contacttangent[1].x =  m_contact_normal.y*contacttangent[0].x;
-        contacttangent[1].y =  m_contact_normal.z*contacttangent[0].x - m_contact_normal.x*contacttangent[0].z;
-        contacttangent[1].z = -m_contact_normal.y*contacttangent[0].x;
-	} else {
-        // scaling factor to ensure the results are normalised
-        const float s = (float)1.0/sqrt( m_contact_normal.z*m_contact_normal.z + m_contact_normal.y*m_contact_normal.y);
-
-        // the new x-axis is at right angles to the world x-axis
-        contacttangent[0].x =  0;
-        contacttangent[0].y = -m_contact_normal.z*s;
-        contacttangent[0].z =  m_contact_normal.y*s;
-
-        // the new y-axis is at right angles to the new x- and z- axes
-        contacttangent[1].x =  m_contact_normal.y*contacttangent[0].z - m_contact_normal.z*contacttangent[0].y;
-        contacttangent[1].y = -m_contact_normal.x*contacttangent[0].z;
-        contacttangent[1].z =  m_contact_normal.x*contacttangent[0].y;
-    }
-
-    // make a matrix from the three vectors.
-    m_contact_to_world.setcomponents(
-        m_contact_normal,
-        contacttangent[0],
-        contacttangent[1]);
-}
-
-_vec3 contact::calculatelocalvelocity(uint32_t bodyindex, float duration) {
-
-	rigid_body *thisbody = m_body[bodyindex];
-
-    // work out the velocity of the contact point.
-    _vec3 velocity = _cross( thisbody->getrotation() , m_relative_contact_position[bodyindex] );
-    velocity += thisbody->getvelocity();
-
-    // turn the velocity into contact-coordinates.
-	_vec3 contactvelocity = m_contact_to_world.transformtranspose(velocity);
-
-    // calculate the ammount of velocity that is due to forces without
-    // reactions.
-    _vec3 accvelocity = thisbody->getlastframeacceleration() * duration;
-
-    // calculate the velocity in contact-coordinates.
-    accvelocity = m_contact_to_world.transformtranspose(accvelocity);
-
-    // we ignore any component of acceleration in the contact normal
-    // direction, we are only interested in planar acceleration
-    accvelocity.x = 0;
-
-    // add the planar velocities - if there's enough friction they will
-    // be removed during velocity resolution
-    contactvelocity += accvelocity;
-
-    // and return it
-    return contactvelocity;
-}
-
-
-void contact::calculatedesireddeltavelocity(float duration) {
-
-	const static float velocitylimit = 0.25f;
-
-    // calculate the acceleration induced velocity accumulated this frame
-    float velocityfromacc = 0;
-
-    if (m_body[0]->getawake()) {
-		velocityfromacc += _dot( (m_body[0]->getlastframeacceleration()*duration) , m_contact_normal );
-	}
-    if ( m_body[1] && m_body[1]->getawake() ){
-        velocityfromacc -= _dot( (m_body[1]->getlastframeacceleration() * duration), m_contact_normal);
-    }
-
-    // if the velocity is very slow, limit the restitution
-    float thisrestitution = m_restitution;
-    if ( abs(m_contact_velocity.x) < velocitylimit) { thisrestitution = 0.0f; }
-
-    // combine the bounce velocity with the removed
-    // acceleration velocity.
-    m_desired_delta_velocity = -m_contact_velocity.x -thisrestitution * (m_contact_velocity.x - velocityfromacc);
-}
-
-
-void contact::calculateinternals( float duration) {
-
-	// check if the first object is null, and swap if it is.
-	if (!m_body[0]) { swapbodies(); }
-
-	if(!m_body[0]){ application_error("null ptr"); }
-
-    // calculate an set of axis at the contact point.
-    calculatecontactbasis();
-
-    // store the relative position of the contact relative to each body
-    m_relative_contact_position[0] = m_contact_point - m_body[0]->getposition();
-    if (m_body[1]) {
-        m_relative_contact_position[1] = m_contact_point - m_body[1]->getposition();
-    }
-
-    // find the relative velocity of the bodies at the contact point.
-    m_contact_velocity = calculatelocalvelocity(0, duration);
-    if (m_body[1]) {
-        m_contact_velocity -= calculatelocalvelocity(1, duration);
-    }
-
-    // calculate the desired change in velocity for resolution
-    calculatedesireddeltavelocity(duration);
-}
-
-void contact::applyvelocitychange ( _vec3 velocitychange[2] , _vec3 rotationchange[2]) {
-    // get hold of the inverse mass and inverse inertia tensor, both in
-    // world coordinates.
-    _mat3 inverseinertiatensor[2];
-    m_body[0]->getinverseinertiatensorworld(&inverseinertiatensor[0]);
-    if (m_body[1]) { m_body[1]->getinverseinertiatensorworld(&inverseinertiatensor[1]); }
-
-    // we will calculate the impulse for each contact axis
-    _vec3 impulsecontact;
-
-    if (m_friction == 0.0f) {
-        // use the short format for frictionless contacts
-        impulsecontact = calculatefrictionlessimpulse(inverseinertiatensor);
-    }else {
-        // otherwise we may have impulses that aren't in the direction of the
-        // contact, so we need the more complex version.
-        impulsecontact = calculatefrictionimpulse(inverseinertiatensor);
-    }
-
-    // convert impulse to world coordinates
-    _vec3 impulse = m_contact_to_world.transform(impulsecontact);
-
-    // split in the impulse into linear and rotational components
-    _vec3 impulsivetorque = _cross(m_relative_contact_position[0] , impulse );
-    rotationchange[0] = inverseinertiatensor[0].transform(impulsivetorque);
-    velocitychange[0].clear();
-    velocitychange[0].addscaledvector(impulse, m_body[0]->getinversemass());
-
-    // apply the changes
-    m_body[0]->addvelocity(velocitychange[0]);
-    m_body[0]->addrotation(rotationchange[0]);
-
-    if (m_body[1])
-    {
-        // work out body one's linear and angular changes
-        _vec3 impulsivetorque = _cross( impulse , m_relative_contact_position[1]);
-        rotationchange[1] = inverseinertiatensor[1].transform(impulsivetorque);
-        velocitychange[1].clear();
-        velocitychange[1].addscaledvector(impulse, -m_body[1]->getinversemass());
-
-        // and apply them.
-        m_body[1]->addvelocity(velocitychange[1]);
-        m_body[1]->addrotation(rotationchange[1]);
-    }
-}
-
-inline
-_vec3 contact::calculatefrictionlessimpulse( _mat3 * inverseinertiatensor) {
-    _vec3 impulsecontact;
-
-    // build a vector that shows the change in velocity in
-    // world space for a unit impulse in the direction of the contact
-    // normal.
-    _vec3 deltavelworld = _cross(m_relative_contact_position[0] , m_contact_normal);
-    deltavelworld = inverseinertiatensor[0].transform(deltavelworld);
-    deltavelworld = _cross(deltavelworld , m_relative_contact_position[0]);
-
-    // work out the change in velocity in contact coordiantes.
-    float deltavelocity = _dot( deltavelworld , m_contact_normal);
-
-    // add the linear component of velocity change
-    deltavelocity += m_body[0]->getinversemass();
-
-    // check if we need to the second body's data
-    if (m_body[1]) {
-
-        // go through the same transformation sequence again
-        _vec3 deltavelworld = _cross( m_relative_contact_position[1] , m_contact_normal);
-        deltavelworld = inverseinertiatensor[1].transform(deltavelworld);
-        deltavelworld = _cross( deltavelworld , m_relative_contact_position[1]);
-
-        // add the change in velocity due to rotation
-        deltavelocity += _dot( deltavelworld , m_contact_normal);
-
-        // add the change in velocity due to linear motion
-        deltavelocity += m_body[1]->getinversemass();
-    }
-
-    // calculate the required size of the impulse
-    impulsecontact.x = m_desired_delta_velocity / deltavelocity;
-    impulsecontact.y = 0;
-    impulsecontact.z = 0;
-    return impulsecontact;
-}
-
-inline
-_vec3 contact::calculatefrictionimpulse( _mat3 * inverseinertiatensor) {
-    _vec3 impulsecontact;
-    float inversemass = m_body[0]->getinversemass();
-
-    // the equivalent of a cross product in matrices is multiplication
-    // by a skew symmetric matrix - we build the matrix for converting
-    // between linear and angular quantities.
-    _mat3 impulsetotorque;
-    impulsetotorque.setskewsymmetric(m_relative_contact_position[0]);
-
-    // build the matrix to convert contact impulse to change in velocity
-    // in world coordinates.
-    _mat3 deltavelworld = impulsetotorque;
-    deltavelworld *= inverseinertiatensor[0];
-    deltavelworld *= impulsetotorque;
-    deltavelworld *= -1;
-
-    // check if we need to add body two's data
-    if (m_body[1]) {
-        // set the cross product matrix
-        impulsetotorque.setskewsymmetric(m_relative_contact_position[1]);
-
-        // calculate the velocity change matrix
-		_mat3 deltavelworld2 = impulsetotorque;
-		deltavelworld2 *= inverseinertiatensor[1];
-		deltavelworld2 *= impulsetotorque;
-		deltavelworld2 *= -1;
-
-        // add to the total delta velocity.
-        deltavelworld += deltavelworld2;
-
-        // add to the inverse mass
-        inversemass += m_body[1]->getinversemass();
-    }
-
-    // do a change of basis to convert into contact coordinates.
-    _mat3 deltavelocity = _transpose( m_contact_to_world );
-    deltavelocity *= deltavelworld;
-    deltavelocity *= m_contact_to_world;
-
-    // add in the linear velocity change
-    deltavelocity[0][0] += inversemass;
-    deltavelocity[1][1] += inversemass;
-    deltavelocity[2][2] += inversemass;
-
-    // invert to get the impulse needed per unit velocity
-    _mat3 impulsematrix = deltavelocity.inverse();
-
-    // find the target velocities to kill
-    _vec3 velkill( m_desired_delta_velocity, -m_contact_velocity.y, -m_contact_velocity.z );
-
-    // find the impulse to kill target velocities
-    impulsecontact = impulsematrix.transform(velkill);
-
-    // check for exceeding friction
-    float planarimpulse = sqrt(
-        impulsecontact.y*impulsecontact.y +
-        impulsecontact.z*impulsecontact.z
-        );
-    if (planarimpulse > impulsecontact.x * m_friction) {
-        // we need to use dynamic friction
-        impulsecontact.y /= planarimpulse;
-        impulsecontact.z /= planarimpulse;
-
-        impulsecontact.x = 
-			deltavelocity[0][0] +
-            deltavelocity[1][0] * m_friction * impulsecontact.y +
-            deltavelocity[2][0] * m_friction * impulsecontact.z;
-        impulsecontact.x   = m_desired_delta_velocity / impulsecontact.x;
-        impulsecontact.y  *= m_friction * impulsecontact.x;
-        impulsecontact.z  *= m_friction * impulsecontact.x;
-    }
-    return impulsecontact;
-}
-
-void contact::applypositionchange( _vec3 linearchange[2], _vec3 angularchange[2], float penetration) {
-
-	
-	const float angularlimit = 0.2f;
-	float angularmove[2];
-	float linearmove[2];
-
-	float totalinertia = 0;
-	float linearinertia[2];
-	float angularinertia[2];
-
-	// we need to work out the inertia of each object in the direction
-	// of the contact normal, due to angular inertia only.
-	for (uint32_t i = 0; i < 2; i++) {
-
-		if (m_body[i]) {
-			_mat3 inverseinertiatensor;
-			m_body[i]->getinverseinertiatensorworld(&inverseinertiatensor);
-
-			// use the same procedure as for calculating frictionless
-			// velocity change to work out the angular inertia.
-			_vec3 angularinertiaworld = _cross( m_relative_contact_position[i] , m_contact_normal);
-			angularinertiaworld = inverseinertiatensor.transform(angularinertiaworld);
-			angularinertiaworld = _cross( angularinertiaworld , m_relative_contact_position[i]);
-			angularinertia[i]   = _dot( angularinertiaworld , m_contact_normal );
-
-			// the linear component is simply the inverse mass
-			linearinertia[i] = m_body[i]->getinversemass();
-
-			// keep track of the total inertia from all components
-			totalinertia += linearinertia[i] + angularinertia[i];
-
-			// we break the loop here so that the totalinertia value is
-			// completely calculated (by both iterations) before
-			// continuing.
-		}
-
-	}
-
-	// loop through again calculating and applying the changes
-	for (uint32_t i = 0; i < 2; i++) {
-
-		if (m_body[i]) {
-			// the linear and angular movements required are in proportion to
-			// the two inverse inertias.
-			float sign = (i == 0)?1.0f:-1.0f;
-			angularmove[i] = sign * penetration * (angularinertia[i] / totalinertia);
-			linearmove[i]  = sign * penetration * (linearinertia[i] / totalinertia);
-
-			// to avoid angular projections that are too great (when mass is large
-			// but inertia tensor is small) limit the angular move.
-			_vec3 projection = m_relative_contact_position[i];
-			projection.addscaledvector( m_contact_normal, -(_dot( m_relative_contact_position[i] , m_contact_normal)) );
-
-			// use the small angle approximation for the sine of the angle (i.e.
-			// the magnitude would be sine(angularlimit) * projection.magnitude
-			// but we approximate sine(angularlimit) to angularlimit).
-			float maxmagnitude = angularlimit * projection.magnitude();
-
-			if (angularmove[i] < -maxmagnitude) {
-				float totalmove = angularmove[i] + linearmove[i];
-				angularmove[i] = -maxmagnitude;
-				linearmove[i] = totalmove - angularmove[i];
-			}else if (angularmove[i] > maxmagnitude) {
-				float totalmove = angularmove[i] + linearmove[i];
-				angularmove[i] = maxmagnitude;
-				linearmove[i] = totalmove - angularmove[i];
-			}
-
-			// we have the linear amount of movement required by turning
-			// the rigid body (in angularmove[i]). we now need to
-			// calculate the desired rotation to achieve that.
-			if (angularmove[i] == 0) {
-				// easy case - no angular movement means no rotation.
-				angularchange[i].clear();
-			}else {
-				// work out the direction we'd like to rotate in.
-				_vec3 targetangulardirection =_cross( m_relative_contact_position[i] , m_contact_normal );
-
-				_mat3 inverseinertiatensor;
-				m_body[i]->getinverseinertiatensorworld(&inverseinertiatensor);
-
-				// work out the direction we'd need to rotate to achieve that
-				angularchange[i] = inverseinertiatensor.transform(targetangulardirection) * (angularmove[i] / angularinertia[i]);
-			}
-
-			// velocity change is easier - it is just the linear movement
-			// along the contact normal.
-			linearchange[i] = m_contact_normal * linearmove[i];
-
-			// now we can start to apply the values we've calculated.
-			// apply the linear movement
-			_vec3 pos;
-			m_body[i]->getposition(&pos);
-			pos.addscaledvector(m_contact_normal, linearmove[i]);
-			m_body[i]->setposition(pos);
-
-			// and the change in orientation
-			_quaternion q;
-			m_body[i]->getorientation(&q);
-			q.addscaledvector( angularchange[i] , 1.0f );
-			m_body[i]->setorientation(q);
-
-			// we need to calculate the derived data for any body that is
-			// asleep, so that the changes are reflected in the object's
-			// data. otherwise the resolution will not change the position
-			// of the object, and the next collision detection round will
-			// have the same penetration.
-			if (!m_body[i]->getawake()) { m_body[i]->calculatederiveddata(); }
-		}
-	}
-}
-
-// contact resolver implementation
-
-contact_resolver::contact_resolver(
-	uint32_t iterations, 
-	float velocityepsilon, 
-	float positionepsilon
-	) 
-{
-		setiterations(iterations, iterations);
-		setepsilon(velocityepsilon, positionepsilon);
-}
-
-contact_resolver::contact_resolver(
-	uint32_t velocityiterations,
-	uint32_t positioniterations,
-	float velocityepsilon,
-	float positionepsilon
-	)
-{
-	setiterations(velocityiterations);
-	setepsilon(velocityepsilon, positionepsilon);
-}
-
-void contact_resolver::setiterations(uint32_t iterations) { setiterations(iterations, iterations); }
-
-void contact_resolver::setiterations(uint32_t velocityiterations,  uint32_t positioniterations) {
-    m_velocity_iterations = velocityiterations;
-    m_position_iterations = positioniterations;
-}
-
-void contact_resolver::setepsilon(float velocityepsilon,float positionepsilon){
-    m_velocity_epsilon = velocityepsilon;
-    m_position_epsilon = positionepsilon;
-}
-
-void contact_resolver::resolvecontacts(contact *contacts, uint32_t numcontacts,float duration){
-    // make sure we have something to do.
-	if (numcontacts == 0) { return; }
-	if (!isvalid()) { return; }
-
-
-    // prepare the contacts for processing
-    preparecontacts(contacts, numcontacts, duration);
-
-    // resolve the interpenetration problems with the contacts.
-    adjustpositions(contacts, numcontacts, duration);
-
-    // resolve the velocity problems with the contacts.
-    adjustvelocities(contacts, numcontacts, duration);
-
-}
-
-void contact_resolver::preparecontacts(contact* contacts,uint32_t numcontacts,float duration) {
-    // generate contact velocity and axis information.
-    contact* lastcontact = contacts + numcontacts;
-    for (contact* contact_=contacts; contact_ < lastcontact; contact_++) {
-        // calculate the internal contact data (inertia, basis, etc).
-        contact_->calculateinternals(duration);
-    }
-}
-
-void contact_resolver::adjustvelocities(contact *c, uint32_t numcontacts, float duration) {
-
-	_vec3 velocitychange[2], rotationchange[2];
-    _vec3 deltavel;
-
-    // iteratively handle impacts in order of severity.
-    m_velocity_iterations_used = 0;
-    while ( m_velocity_iterations_used < m_velocity_iterations ) {
-        // find contact with maximum magnitude of probable velocity change.
-        float max = m_velocity_epsilon;
-        uint32_t index = numcontacts;
-        for (uint32_t i = 0; i < numcontacts; i++) {
-
-            if (c[i].m_desired_delta_velocity > max) {
-                max = c[i].m_desired_delta_velocity;
-                index = i;
-            }
-
-        }
-		if (index == numcontacts) { break; }
-
-        // match the awake state at the contact
-        c[index].matchawakestate();
-
-        // do the resolution on the contact that came out at the top (index) .
-        c[index].applyvelocitychange(velocitychange, rotationchange);
-
-        // with the change in velocity of the two bodies, the update of
-        // contact velocities means that some of the relative closing
-        // velocities need recomputing.
-		for (uint32_t i = 0; i < numcontacts; i++) {
-			// check each body in the contact
-			for (uint32_t b = 0; b < 2; b++) {
-				if (c[i].m_body[b]) {
-					// check for a match with each body in the newly
-					// resolved contact
-					for (uint32_t d = 0; d < 2; d++) {
-
-						if (c[i].m_body[b] == c[index].m_body[d]) {
-							deltavel = velocitychange[d] + _cross(rotationchange[d],c[i].m_relative_contact_position[b]);
-
-							// the sign of the change is negative if we're dealing
-							// with the second body in a contact.
-							c[i].m_contact_velocity += c[i].m_contact_to_world.transformtranspose(deltavel) * (b?-1.0f:1.0f);
-							c[i].calculatedesireddeltavelocity(duration);
-						}
-					}
-				}
-			}
-        }
-        m_velocity_iterations_used++;
-    }
-}
-
-void contact_resolver::adjustpositions(contact *c,uint32_t numcontacts, float duration) {
-
-	uint32_t i,index;
-    _vec3 linearchange[2], angularchange[2];
-    float max;
-    _vec3 deltaposition;
-
-    // iteratively resolve interpenetrations in order of severity.
-    m_position_iterations_used = 0;
-    while ( m_position_iterations_used < m_position_iterations ) {
-        // find biggest penetration
-        max = m_position_epsilon;
-        index = numcontacts;
-        for (i=0; i<numcontacts; i++) {
-            if (c[i].m_penetration > max) {
-                max = c[i].m_penetration;
-                index = i;
-            }
-        }
-		if (index == numcontacts) { break; }
-
-        // match the awake state at the contact
-        c[index].matchawakestate();
-
-        // resolve the penetration.
-        c[index].applypositionchange(linearchange,angularchange,max);
-
-        // again this action may have changed the penetration of other
-        // bodies, so we update contacts.
-        for (i = 0; i < numcontacts; i++) {
-            // check each body in the contact
-            for (uint32_t b = 0; b < 2; b++) if (c[i].m_body[b]) {
-                // check for a match with each body in the newly
-                // resolved contact
-                for (uint32_t d = 0; d < 2; d++) {
-                    if (c[i].m_body[b] == c[index].m_body[d]) {
-                        deltaposition = linearchange[d] + _cross(angularchange[d] , c[i].m_relative_contact_position[b]);
-
-                        // the sign of the change is positive if we're
-                        // dealing with the second body in a contact
-                        // and negative otherwise (because we're
-                        // subtracting the resolution)..
-                        c[i].m_penetration += _dot( deltaposition,c[i].m_contact_normal) * (b?1:-1);
-                    }
-                }
-            }
-        }
-        m_position_iterations_used++;
-    }
-    
-}
+
+
+#include "contacts.h"
+#include <memory.h>
+
+#include <body.h>
+
+/*
+ * bodies with infinite mass are never moved by the resolution, nor woken
+ * or put to sleep with an island. they are only read, so islands that
+ * share one can be resolved at once.
+ */
+static inline bool movable(const rigid_body *body) { return body && body->getinversemass() > 0.0f; }
+
+// contact implementation
+
+void contact::setbodydata(rigid_body* one, rigid_body *two, float friction, float restitution) {
+    m_body[0] = one;
+    m_body[1] = two;
+    m_friction = friction;
+    m_restitution = restitution;
+}
+
+/*
+ * swaps the bodies in the current contact, so body 0 is at body 1 and
+ * vice versa. this also changes the direction of the contact normal,
+ * but doesn't update any calculated internal data. if you are calling
+ * this method manually, then call calculateinternals afterwards to
+ * make sure the internal data is up to date.
+ */
+void contact::swapbodies() {
+
+	m_contact_normal *= -1;
+
+    rigid_body *temp = m_body[0];
+    m_body[0] = m_body[1];
+    m_body[1] = temp;
+}
+
+/*
+ * constructs an arbitrary orthonormal basis for the contact.  this is
+ * stored as a 3x3 matrix, where each vector is a column (in other
+ * words the matrix transforms contact space into world space). the x
+ * direction is generated from the contact normal, and the y and z
+ * directionss are set so they are at right angles to it.
+ */
+inline
+void contact::calculatecontactbasis() {
+
+    _vec3 contacttangent[2];
+
+    // check whether the z-axis is nearer to the x or y axis
+    if ( abs(m_contact_normal.x) > abs(m_contact_normal.y) ) {
+        // scaling factor to ensure the results are normalised
+        const float s = (float)1.0/sqrt(m_contact_normal.z * m_contact_normal.z + m_contact_normal.x*m_contact_normal.x);
+
+        // the new x-axis is at right angles to the world y-axis
+        contacttangent[0].x =  m_contact_normal.z*s;
+        contacttangent[0].y =  0;
+        contacttangent[0].z = -m_contact_normal.x*s;
+
+        // the new y-axis is at right angles to the new x- and z- axes
+        contacttangent[1].x =  m_contact_normal.y*contacttangent[0].x;
+        contacttangent[1].y =  m_contact_normal.z*contacttangent[0].x - m_contact_normal.x*contacttangent[0].z;
+        contacttangent[1].z = -m_contact_normal.y*contacttangent[0].x;
+	} else {
+        // scaling factor to ensure the results are normalised
+        const float s = (float)1.0/sqrt( m_contact_normal.z*m_contact_normal.z + m_contact_normal.y*m_contact_normal.y);
+
+        // the new x-axis is at right angles to the world x-axis
+        contacttangent[0].x =  0;
+        contacttangent[0].y = -m_contact_normal.z*s;
+        contacttangent[0].z =  m_contact_normal.y*s;
+
+        // the new y-axis is at right angles to the new x- and z- axes
+        contacttangent[1].x =  m_contact_normal.y*contacttangent[0].z - m_contact_normal.z*contacttangent[0].y;
+        contacttangent[1].y = -m_contact_normal.x*contacttangent[0].z;
+        contacttangent[1].z =  m_contact_normal.x*contacttangent[0].y;
+    }
+
+    // make a matrix from the three vectors.
+    m_contact_to_world.setcomponents(
+        m_contact_normal,
+        contacttangent[0],
+        contacttangent[1]);
+}
+
+_vec3 contact::calculatelocalvelocity(uint32_t bodyindex, float duration) {
+
+	rigid_body *thisbody = m_body[bodyindex];
+
+    // work out the velocity of the contact point.
+    _vec3 velocity = _cross( thisbody->getrotation() , m_relative_contact_position[bodyindex] );
+    velocity += thisbody->getvelocity();
+
+    // turn the velocity into contact-coordinates.
+	_vec3 contactvelocity = m_contact_to_world.transformtranspose(velocity);
+
+    // calculate the ammount of velocity that is due to forces without
+    // reactions.
+    _vec3 accvelocity = thisbody->getlastframeacceleration() * duration;
+
+    // calculate the velocity in contact-coordinates.
+    accvelocity = m_contact_to_world.transformtranspose(accvelocity);
+
+    // we ignore any component of acceleration in the contact normal
+    // direction, we are only interested in planar acceleration
+    accvelocity.x = 0;
+
+    // add the planar velocities - if there's enough friction they will
+    // be removed during velocity resolution
+    contactvelocity += accvelocity;
+
+    // and return it
+    return contactvelocity;
+}
+
+
+void contact::calculatedesireddeltavelocity(float duration) {
+
+	const static float velocitylimit = 0.25f;
+
+    // calculate the acceleration induced velocity accumulated this frame
+    float velocityfromacc = 0;
+
+    if (m_body[0]->getawake()) {
+		velocityfromacc += _dot( (m_body[0]->getlastframeacceleration()*duration) , m_contact_normal );
+	}
+    if ( m_body[1] && m_body[1]->getawake() ){
+        velocityfromacc -= _dot( (m_body[1]->getlastframeacceleration() * duration), m_contact_normal);
+    }
+
+    // if the velocity is very slow, limit the restitution
+    float thisrestitution = m_restitution;
+    if ( abs(m_contact_velocity.x) < velocitylimit) { thisrestitution = 0.0f; }
+
+    // combine the bounce velocity with the removed
+    // acceleration velocity.
+    m_desired_delta_velocity = -m_contact_velocity.x -thisrestitution * (m_contact_velocity.x - velocityfromacc);
+}
+
+
+_vec3 contact::calculaterelativevelocity() const {
+    _vec3 velocity = _cross( m_body[0]->getrotation() , m_relative_contact_position[0] );
+    velocity += m_body[0]->getvelocity();
+    if (m_body[1]) {
+        velocity -= _cross( m_body[1]->getrotation() , m_relative_contact_position[1] );
+        velocity -= m_body[1]->getvelocity();
+    }
+    return m_contact_to_world.transformtranspose(velocity);
+}
+
+void contact::applycontactimpulse(const _vec3 &impulsecontact) {
+    _vec3 impulse = m_contact_to_world.transform(impulsecontact);
+    _mat3 inverseinertiatensor;
+
+    if (movable(m_body[0])) {
+        m_body[0]->getinverseinertiatensorworld(&inverseinertiatensor);
+        m_body[0]->addvelocity( impulse * m_body[0]->getinversemass() );
+        m_body[0]->addrotation( inverseinertiatensor.transform( _cross(m_relative_contact_position[0], impulse) ) );
+    }
+
+    if (movable(m_body[1])) {
+        // the second body gets the opposite impulse
+        m_body[1]->getinverseinertiatensorworld(&inverseinertiatensor);
+        m_body[1]->addvelocity( impulse * -m_body[1]->getinversemass() );
+        m_body[1]->addrotation( inverseinertiatensor.transform( _cross(impulse, m_relative_contact_position[1]) ) );
+    }
+}
+
+void contact::calculateimpulsedata() {
+    _mat3 inverseinertiatensor[2];
+    m_body[0]->getinverseinertiatensorworld(&inverseinertiatensor[0]);
+    if (m_body[1]) { m_body[1]->getinverseinertiatensorworld(&inverseinertiatensor[1]); }
+
+    // the velocity change per unit impulse along each axis is the
+    // linear part plus the rotation the impulse causes about each body.
+    for (uint32_t i = 0; i < 3; i++) {
+        _vec3 axis(0.0f,0.0f,0.0f);
+        axis[i] = 1.0f;
+        axis = m_contact_to_world.transform(axis);
+
+        float velocityperimpulse = 0.0f;
+        for (uint32_t b = 0; b < 2; b++) {
+            if (!m_body[b]) { continue; }
+            _vec3 torqueperimpulse = _cross(m_relative_contact_position[b], axis);
+            _vec3 rotationperimpulse = inverseinertiatensor[b].transform(torqueperimpulse);
+            velocityperimpulse += m_body[b]->getinversemass();
+            velocityperimpulse += _dot( _cross(rotationperimpulse, m_relative_contact_position[b]), axis );
+        }
+        m_effective_mass[i] = (velocityperimpulse > 0.0f) ? 1.0f / velocityperimpulse : 0.0f;
+    }
+
+    // the desired delta velocity already holds the bounce, and leaves
+    // resting contacts with no closing velocity.
+    m_target_velocity = m_contact_velocity.x + m_desired_delta_velocity;
+
+    // this solver settles every contact of a stack together, so a
+    // bounce is handed on from body to body like a newton's cradle
+    // and throws the top off. only a hard impact bounces.
+    const static float bouncelimit = 2.0f;
+    if (abs(m_contact_velocity.x) < bouncelimit) { m_target_velocity = 0.0f; }
+}
+
+void contact::calculateinternals( float duration) {
+
+	// check if the first object is null, and swap if it is.
+	if (!m_body[0]) { swapbodies(); }
+
+	if(!m_body[0]){ application_error("null ptr"); }
+
+    // calculate an set of axis at the contact point.
+    calculatecontactbasis();
+
+    // store the relative position of the contact relative to each body
+    m_relative_contact_position[0] = m_contact_point - m_body[0]->getposition();
+    if (m_body[1]) {
+        m_relative_contact_position[1] = m_contact_point - m_body[1]->getposition();
+    }
+
+    // find the relative velocity of the bodies at the contact point.
+    m_contact_velocity = calculatelocalvelocity(0, duration);
+    if (m_body[1]) {
+        m_contact_velocity -= calculatelocalvelocity(1, duration);
+    }
+
+    // calculate the desired change in velocity for resolution
+    calculatedesireddeltavelocity(duration);
+}
+
+void contact::applyvelocitychange ( _vec3 velocitychange[2] , _vec3 rotationchange[2]) {
+    // get hold of the inverse mass and inverse inertia tensor, both in
+    // world coordinates.
+    _mat3 inverseinertiatensor[2];
+    m_body[0]->getinverseinertiatensorworld(&inverseinertiatensor[0]);
+    if (m_body[1]) { m_body[1]->getinverseinertiatensorworld(&inverseinertiatensor[1]); }
+
+    // we will calculate the impulse for each contact axis
+    _vec3 impulsecontact;
+
+    if (m_friction == 0.0f) {
+        // use the short format for frictionless contacts
+        impulsecontact = calculatefrictionlessimpulse(inverseinertiatensor);
+    }else {
+        // otherwise we may have impulses that aren't in the direction of the
+        // contact, so we need the more complex version.
+        impulsecontact = calculatefrictionimpulse(inverseinertiatensor);
+    }
+
+    // convert impulse to world coordinates
+    _vec3 impulse = m_contact_to_world.transform(impulsecontact);
+
+    // split in the impulse into linear and rotational components
+    _vec3 impulsivetorque = _cross(m_relative_contact_position[0] , impulse );
+    rotationchange[0] = inverseinertiatensor[0].transform(impulsivetorque);
+    velocitychange[0].clear();
+    velocitychange[0].addscaledvector(impulse, m_body[0]->getinversemass());
+
+    // apply the changes
+    if (movable(m_body[0])) {
+        m_body[0]->addvelocity(velocitychange[0]);
+        m_body[0]->addrotation(rotationchange[0]);
+    }
+
+    if (m_body[1])
+    {
+        // work out body one's linear and angular changes
+        _vec3 impulsivetorque = _cross( impulse , m_relative_contact_position[1]);
+        rotationchange[1] = inverseinertiatensor[1].transform(impulsivetorque);
+        velocitychange[1].clear();
+        velocitychange[1].addscaledvector(impulse, -m_body[1]->getinversemass());
+
+        // and apply them.
+        if (movable(m_body[1])) {
+            m_body[1]->addvelocity(velocitychange[1]);
+            m_body[1]->addrotation(rotationchange[1]);
+        }
+    }
+}
+
+inline
+_vec3 contact::calculatefrictionlessimpulse( _mat3 * inverseinertiatensor) {
+    _vec3 impulsecontact;
+
+    // build a vector that shows the change in velocity in
+    // world space for a unit impulse in the direction of the contact
+    // normal.
+    _vec3 deltavelworld = _cross(m_relative_contact_position[0] , m_contact_normal);
+    deltavelworld = inverseinertiatensor[0].transform(deltavelworld);
+    deltavelworld = _cross(deltavelworld , m_relative_contact_position[0]);
+
+    // work out the change in velocity in contact coordiantes.
+    float deltavelocity = _dot( deltavelworld , m_contact_normal);
+
+    // add the linear component of velocity change
+    deltavelocity += m_body[0]->getinversemass();
+
+    // check if we need to the second body's data
+    if (m_body[1]) {
+
+        // go through the same transformation sequence again
+        _vec3 deltavelworld = _cross( m_relative_contact_position[1] , m_contact_normal);
+        deltavelworld = inverseinertiatensor[1].transform(deltavelworld);
+        deltavelworld = _cross( deltavelworld , m_relative_contact_position[1]);
+
+        // add the change in velocity due to rotation
+        deltavelocity += _dot( deltavelworld , m_contact_normal);
+
+        // add the change in velocity due to linear motion
+        deltavelocity += m_body[1]->getinversemass();
+    }
+
+    // calculate the required size of the impulse
+    impulsecontact.x = m_desired_delta_velocity / deltavelocity;
+    impulsecontact.y = 0;
+    impulsecontact.z = 0;
+    return impulsecontact;
+}
+
+inline
+_vec3 contact::calculatefrictionimpulse( _mat3 * inverseinertiatensor) {
+    _vec3 impulsecontact;
+    float inversemass = m_body[0]->getinversemass();
+
+    // the equivalent of a cross product in matrices is multiplication
+    // by a skew symmetric matrix - we build the matrix for converting
+    // between linear and angular quantities.
+    _mat3 impulsetotorque;
+    impulsetotorque.setskewsymmetric(m_relative_contact_position[0]);
+
+    // build the matrix to convert contact impulse to change in velocity
+    // in world coordinates.
+    _mat3 deltavelworld = impulsetotorque;
+    deltavelworld *= inverseinertiatensor[0];
+    deltavelworld *= impulsetotorque;
+    deltavelworld *= -1;
+
+    // check if we need to add body two's data
+    if (m_body[1]) {
+        // set the cross product matrix
+        impulsetotorque.setskewsymmetric(m_relative_contact_position[1]);
+
+        // calculate the velocity change matrix
+		_mat3 deltavelworld2 = impulsetotorque;
+		deltavelworld2 *= inverseinertiatensor[1];
+		deltavelworld2 *= impulsetotorque;
+		deltavelworld2 *= -1;
+
+        // add to the total delta velocity.
+        deltavelworld += deltavelworld2;
+
+        // add to the inverse mass
+        inversemass += m_body[1]->getinversemass();
+    }
+
+    // do a change of basis to convert into contact coordinates.
+    _mat3 deltavelocity = _transpose( m_contact_to_world );
+    deltavelocity *= deltavelworld;
+    deltavelocity *= m_contact_to_world;
+
+    // add in the linear velocity change
+    deltavelocity[0][0] += inversemass;
+    deltavelocity[1][1] += inversemass;
+    deltavelocity[2][2] += inversemass;
+
+    // invert to get the impulse needed per unit velocity
+    _mat3 impulsematrix = deltavelocity.inverse();
+
+    // find the target velocities to kill
+    _vec3 velkill( m_desired_delta_velocity, -m_contact_velocity.y, -m_contact_velocity.z );
+
+    // find the impulse to kill target velocities
+    impulsecontact = impulsematrix.transform(velkill);
+
+    // check for exceeding friction
+    float planarimpulse = sqrt(
+        impulsecontact.y*impulsecontact.y +
+        impulsecontact.z*impulsecontact.z
+        );
+    if (planarimpulse > impulsecontact.x * m_friction) {
+        // we need to use dynamic friction
+        impulsecontact.y /= planarimpulse;
+        impulsecontact.z /= planarimpulse;
+
+        impulsecontact.x = 
+			deltavelocity[0][0] +
+            deltavelocity[1][0] * m_friction * impulsecontact.y +
+            deltavelocity[2][0] * m_friction * impulsecontact.z;
+        impulsecontact.x   = m_desired_delta_velocity / impulsecontact.x;
+        impulsecontact.y  *= m_friction * impulsecontact.x;
+        impulsecontact.z  *= m_friction * impulsecontact.x;
+    }
+    return impulsecontact;
+}
+
+void contact::applypositionchange( _vec3 linearchange[2], _vec3 angularchange[2], float penetration) {
+
+	
+	const float angularlimit = 0.2f;
+	float angularmove[2];
+	float linearmove[2];
+
+	float totalinertia = 0;
+	float linearinertia[2];
+	float angularinertia[2];
+
+	// we need to work out the inertia of each object in the direction
+	// of the contact normal, due to angular inertia only.
+	for (uint32_t i = 0; i < 2; i++) {
+
+		if (m_body[i]) {
+			_mat3 inverseinertiatensor;
+			m_body[i]->getinverseinertiatensorworld(&inverseinertiatensor);
+
+			// use the same procedure as for calculating frictionless
+			// velocity change to work out the angular inertia.
+			_vec3 angularinertiaworld = _cross( m_relative_contact_position[i] , m_contact_normal);
+			angularinertiaworld = inverseinertiatensor.transform(angularinertiaworld);
+			angularinertiaworld = _cross( angularinertiaworld , m_relative_contact_position[i]);
+			angularinertia[i]   = _dot( angularinertiaworld , m_contact_normal );
+
+			// the linear component is simply the inverse mass
+			linearinertia[i] = m_body[i]->getinversemass();
+
+			// keep track of the total inertia from all components
+			totalinertia += linearinertia[i] + angularinertia[i];
+
+			// we break the loop here so that the totalinertia value is
+			// completely calculated (by both iterations) before
+			// continuing.
+		}
+
+	}
+
+	// loop through again calculating and applying the changes
+	for (uint32_t i = 0; i < 2; i++) {
+
+		if (m_body[i]) {
+			// the linear and angular movements required are in proportion to
+			// the two inverse inertias.
+			float sign = (i == 0)?1.0f:-1.0f;
+			angularmove[i] = sign * penetration * (angularinertia[i] / totalinertia);
+			linearmove[i]  = sign * penetration * (linearinertia[i] / totalinertia);
+
+			// to avoid angular projections that are too great (when mass is large
+			// but inertia tensor is small) limit the angular move.
+			_vec3 projection = m_relative_contact_position[i];
+			projection.addscaledvector( m_contact_normal, -(_dot( m_relative_contact_position[i] , m_contact_normal)) );
+
+			// use the small angle approximation for the sine of the angle (i.e.
+			// the magnitude would be sine(angularlimit) * projection.magnitude
+			// but we approximate sine(angularlimit) to angularlimit).
+			float maxmagnitude = angularlimit * projection.magnitude();
+
+			if (angularmove[i] < -maxmagnitude) {
+				float totalmove = angularmove[i] + linearmove[i];
+				angularmove[i] = -maxmagnitude;
+				linearmove[i] = totalmove - angularmove[i];
+			}else if (angularmove[i] > maxmagnitude) {
+				float totalmove = angularmove[i] + linearmove[i];
+				angularmove[i] = maxmagnitude;
+				linearmove[i] = totalmove - angularmove[i];
+			}
+
+			// we have the linear amount of movement required by turning
+			// the rigid body (in angularmove[i]). we now need to
+			// calculate the desired rotation to achieve that.
+			if (angularmove[i] == 0) {
+				// easy case - no angular movement means no rotation.
+				angularchange[i].clear();
+			}else {
+				// work out the direction we'd like to rotate in.
+				_vec3 targetangulardirection =_cross( m_relative_contact_position[i] , m_contact_normal );
+
+				_mat3 inverseinertiatensor;
+				m_body[i]->getinverseinertiatensorworld(&inverseinertiatensor);
+
+				// work out the direction we'd need to rotate to achieve that
+				angularchange[i] = inverseinertiatensor.transform(targetangulardirection) * (angularmove[i] / angularinertia[i]);
+			}
+
+			// velocity change is easier - it is just the linear movement
+			// along the contact normal.
+			linearchange[i] = m_contact_normal * linearmove[i];
+
+			// a body with infinite mass has no move to make, and is
+			// left untouched.
+			if (!movable(m_body[i])) { continue; }
+
+			// now we can start to apply the values we've calculated.
+			// apply the linear movement
+			_vec3 pos;
+			m_body[i]->getposition(&pos);
+			pos.addscaledvector(m_contact_normal, linearmove[i]);
+			m_body[i]->setposition(pos);
+
+			// and the change in orientation
+			_quaternion q;
+			m_body[i]->getorientation(&q);
+			q.addscaledvector( angularchange[i] , 1.0f );
+			m_body[i]->setorientation(q);
+
+			// we need to calculate the derived data for any body that is
+			// asleep, so that the changes are reflected in the object's
+			// data. otherwise the resolution will not change the position
+			// of the object, and the next collision detection round will
+			// have the same penetration.
+			if (!m_body[i]->getawake()) { m_body[i]->calculatederiveddata(); }
+		}
+	}
+}
+
+// contact cache implementation
+
+contact_cache::contact_cache() { m_hits = 0; }
+
+uint32_t contact_cache::slot(const rigid_body *one, const rigid_body *two, uint32_t feature) const {
+    uint32_t hash =
+        uint32_t( uintptr_t(one) >> 4 ) * 73856093u ^
+        uint32_t( uintptr_t(two) >> 4 ) * 19349663u ^
+        feature * 83492791u;
+    return hash & (m_entries.m_count-1);
+}
+
+const contact_cache_entry* contact_cache::find(const contact &contact_) const {
+    if (!m_entries.m_count) { return NULL; }
+
+    uint32_t mask = m_entries.m_count-1;
+    for (uint32_t i = slot(contact_.m_body[0], contact_.m_body[1], contact_.m_feature); ; i = (i+1) & mask) {
+        const contact_cache_entry &entry = m_entries[i];
+        if (!entry.m_body[0]) { return NULL; }
+        if (entry.m_body[0] == contact_.m_body[0] &&
+            entry.m_body[1] == contact_.m_body[1] &&
+            entry.m_feature == contact_.m_feature) { return &entry; }
+    }
+}
+
+void contact_cache::store(const contact *contacts, uint32_t numcontacts) {
+
+    // keep the table at most half full, so probes stay short.
+    uint32_t size = 64;
+    while (size < numcontacts*2) { size *= 2; }
+    if (m_entries.m_count < size) {
+        m_entries.clear();
+        m_entries.allocate(size);
+    } else {
+        for (uint32_t i = 0; i < m_entries.m_count; i++) { m_entries[i].m_body[0] = NULL; }
+    }
+
+    uint32_t mask = m_entries.m_count-1;
+    for (uint32_t i = 0; i < numcontacts; i++) {
+        const contact &contact_ = contacts[i];
+
+        uint32_t index = slot(contact_.m_body[0], contact_.m_body[1], contact_.m_feature);
+        while (m_entries[index].m_body[0]) { index = (index+1) & mask; }
+
+        contact_cache_entry &entry = m_entries[index];
+        entry.m_body[0] = contact_.m_body[0];
+        entry.m_body[1] = contact_.m_body[1];
+        entry.m_feature = contact_.m_feature;
+        entry.m_impulse = contact_.m_contact_to_world.transform(contact_.m_accumulated_impulse);
+    }
+}
+
+void contact_cache::clear() {
+    m_entries.clear();
+    m_hits = 0;
+}
+
+// contact resolver implementation
+
+contact_resolver::contact_resolver(
+	uint32_t iterations, 
+	float velocityepsilon, 
+	float positionepsilon
+	) 
+{
+		setiterations(iterations, iterations);
+		setepsilon(velocityepsilon, positionepsilon);
+		m_island_count       = 0;
+		m_pool               = NULL;
+		m_parallel_islands   = 0;
+		m_sleeping_islands   = 0;
+		m_prepared_contacts  = NULL;
+		m_body_count         = 0;
+		m_mode               = solver_iterative;
+		m_impulse_iterations = 16;
+}
+
+contact_resolver::contact_resolver(
+	uint32_t velocityiterations,
+	uint32_t positioniterations,
+	float velocityepsilon,
+	float positionepsilon
+	)
+{
+	setiterations(velocityiterations);
+	setepsilon(velocityepsilon, positionepsilon);
+	m_island_count       = 0;
+	m_pool               = NULL;
+	m_parallel_islands   = 0;
+	m_sleeping_islands   = 0;
+	m_prepared_contacts  = NULL;
+	m_body_count         = 0;
+	m_mode               = solver_iterative;
+	m_impulse_iterations = 16;
+}
+
+void contact_resolver::setiterations(uint32_t iterations) { setiterations(iterations, iterations); }
+
+void contact_resolver::setiterations(uint32_t velocityiterations,  uint32_t positioniterations) {
+    m_velocity_iterations = velocityiterations;
+    m_position_iterations = positioniterations;
+}
+
+void contact_resolver::setepsilon(float velocityepsilon,float positionepsilon){
+    m_velocity_epsilon = velocityepsilon;
+    m_position_epsilon = positionepsilon;
+}
+
+/* runs on the thread pool, resolving one of the islands handed to it */
+static void resolveislandjob(void *data, uint32_t index) {
+    contact_resolver *resolver = (contact_resolver*)data;
+    contact_island *island = &resolver->m_islands[ resolver->m_job_islands[index] ];
+    resolver->resolveisland(resolver->m_job_contacts, island, resolver->m_job_duration);
+}
+
+void contact_resolver::resolvecontacts(contact *contacts, uint32_t numcontacts,float duration){
+    // make sure we have something to do.
+	if (numcontacts == 0) { return; }
+	if (!isvalid()) { return; }
+
+
+    // group the contacts into islands of connected bodies, and wake
+    // every island touched by an awake body.
+    buildislands(contacts, numcontacts);
+    wakeislands(contacts);
+
+    // prepare the contacts for processing
+    preparecontacts(contacts, numcontacts, duration);
+
+    // hand the islands to the pool, skipping the sleeping ones.
+    m_job_islands.m_count = 0;
+    for (uint32_t i = 0; i < m_island_count; i++) {
+        if (!m_islands[i].m_asleep) { m_job_islands.pushback(i,true); }
+    }
+    m_parallel_islands = 0;
+    if (m_pool && m_job_islands.m_count > 1) {
+        m_job_contacts = contacts;
+        m_job_duration = duration;
+        m_parallel_islands = m_job_islands.m_count;
+        m_pool->run(resolveislandjob, this, m_job_islands.m_count);
+    } else {
+        m_job_islands.m_count = 0;
+    }
+
+    // resolve whatever the pool didn't, in island order.
+    uint32_t positioniterations = 0;
+    uint32_t velocityiterations = 0;
+    for (uint32_t i = 0, job = 0; i < m_island_count; i++) {
+        if (m_islands[i].m_asleep) { continue; }
+        if (job < m_job_islands.m_count && m_job_islands[job] == i) { job++; }
+        else { resolveisland(contacts, &m_islands[i], duration); }
+
+        positioniterations += m_islands[i].m_position_iterations;
+        velocityiterations += m_islands[i].m_velocity_iterations;
+    }
+    m_position_iterations_used = positioniterations;
+    m_velocity_iterations_used = velocityiterations;
+
+    // islands that have come to rest go to sleep together.
+    sleepislands(contacts);
+
+    // remember the impulses for the next step.
+    if (m_mode == solver_sequential_impulse) { m_cache.store(contacts, numcontacts); }
+    else { m_cache.clear(); }
+}
+
+void contact_resolver::resolveisland(contact *contacts, contact_island *island, float duration) {
+    contact *first = contacts + island->m_first;
+
+    // resolve the interpenetration problems with the contacts.
+    island->m_position_iterations = adjustpositions(first, island->m_count, duration);
+
+    // resolve the velocity problems with the contacts.
+    if (m_mode == solver_sequential_impulse) {
+        island->m_velocity_iterations = solveimpulses(first, island->m_count);
+    } else {
+        island->m_velocity_iterations = adjustvelocities(first, island->m_count, duration);
+    }
+}
+
+uint32_t contact_resolver::findisland(uint32_t body) {
+    // path halving: point every other body on the way at its grandparent.
+    while (m_island_parent[body] != body) {
+        m_island_parent[body] = m_island_parent[ m_island_parent[body] ];
+        body = m_island_parent[body];
+    }
+    return body;
+}
+
+void contact_resolver::wakeislands(contact *contacts) {
+    m_sleeping_islands = 0;
+    for (uint32_t i = 0; i < m_island_count; i++) {
+        contact_island &island = m_islands[i];
+        contact *first = contacts + island.m_first;
+        contact *last  = first + island.m_count;
+
+        island.m_asleep = true;
+        for (contact *c = first; c < last && island.m_asleep; c++) {
+            for (uint32_t b = 0; b < 2; b++) {
+                if (movable(c->m_body[b]) && c->m_body[b]->getawake()) { island.m_asleep = false; }
+            }
+        }
+        if (island.m_asleep) {
+            island.m_position_iterations = island.m_velocity_iterations = 0;
+            m_sleeping_islands++;
+            continue;
+        }
+
+        for (contact *c = first; c < last; c++) {
+            for (uint32_t b = 0; b < 2; b++) {
+                if (movable(c->m_body[b]) && !c->m_body[b]->getawake()) { c->m_body[b]->setawake(); }
+            }
+        }
+    }
+}
+
+void contact_resolver::sleepislands(contact *contacts) {
+    for (uint32_t i = 0; i < m_island_count; i++) {
+        contact_island &island = m_islands[i];
+        if (island.m_asleep) { continue; }
+        contact *first = contacts + island.m_first;
+        contact *last  = first + island.m_count;
+
+        // the bodies of the island are left to the resolver to put to
+        // sleep, and it waits until every one of them is ready.
+        bool sleepy = true;
+        rigid_body *root = NULL;
+        for (contact *c = first; c < last; c++) {
+            for (uint32_t b = 0; b < 2; b++) {
+                rigid_body *body = c->m_body[b];
+                if (!movable(body)) { continue; }
+                body->m_pool->m_in_island[body->m_index] = true;
+                if (!body->getsleepy()) { sleepy = false; }
+                if (!root) { root = body; }
+            }
+        }
+        if (!sleepy || !root) { continue; }
+
+        // link the bodies into a ring, so waking one wakes them all.
+        // a body of another pool can't join, and sleeps on its own.
+        for (contact *c = first; c < last; c++) {
+            for (uint32_t b = 0; b < 2; b++) {
+                rigid_body *body = c->m_body[b];
+                if (movable(body) && body->m_pool == root->m_pool) { root->m_pool->addtoisland(root->m_index, body->m_index); }
+            }
+        }
+        for (contact *c = first; c < last; c++) {
+            for (uint32_t b = 0; b < 2; b++) {
+                if (movable(c->m_body[b]) && c->m_body[b]->getawake()) { c->m_body[b]->setawake(false); }
+            }
+        }
+        m_sleeping_islands++;
+    }
+}
+
+uint32_t contact_resolver::buildislands(contact *contacts, uint32_t numcontacts) {
+
+    // give every body touched by the contacts its own set.
+    for (uint32_t i = 0; i < numcontacts; i++) {
+        for (uint32_t b = 0; b < 2; b++) {
+            if (contacts[i].m_body[b]) { contacts[i].m_body[b]->m_island = island_unassigned; }
+        }
+    }
+    m_island_parent.m_count = 0;
+    for (uint32_t i = 0; i < numcontacts; i++) {
+        for (uint32_t b = 0; b < 2; b++) {
+            rigid_body *body = contacts[i].m_body[b];
+            if (body && body->m_island == island_unassigned) {
+                body->m_island = m_island_parent.m_count;
+                m_island_parent.pushback(body->m_island,true);
+            }
+        }
+    }
+
+    // join the sets of bodies that share a contact. immovable bodies
+    // are never changed by the resolution, so they don't join islands.
+    // the lower root is kept, so the result doesn't depend on the
+    // order of the joins.
+    for (uint32_t i = 0; i < numcontacts; i++) {
+        rigid_body *one = contacts[i].m_body[0];
+        rigid_body *two = contacts[i].m_body[1];
+        if (!two || one->getinversemass() <= 0.0f || two->getinversemass() <= 0.0f) { continue; }
+
+        uint32_t a = findisland(one->m_island);
+        uint32_t b = findisland(two->m_island);
+        if (a < b) { m_island_parent[b] = a; }
+        else if (b < a) { m_island_parent[a] = b; }
+    }
+
+    // find the root of each contact's island. a contact with one
+    // immovable body belongs to the island of the other.
+    m_contact_island.m_count = 0;
+    for (uint32_t i = 0; i < numcontacts; i++) {
+        rigid_body *body = contacts[i].m_body[0];
+        if (body->getinversemass() <= 0.0f && contacts[i].m_body[1]) { body = contacts[i].m_body[1]; }
+        m_contact_island.pushback(findisland(body->m_island),true);
+    }
+
+    // number the islands in the order their first contact appears and
+    // count their contacts. the parent of each root is reused to hold
+    // its island, offset so it can't be mistaken for the root itself.
+    uint32_t bodycount = m_island_parent.m_count;
+    m_body_count = bodycount;
+    m_island_count = 0;
+    for (uint32_t i = 0; i < numcontacts; i++) {
+        uint32_t root = m_contact_island[i];
+        if (m_island_parent[root] == root) {
+            if (m_island_count >= m_islands.m_count) { m_islands.pushback(contact_island(),true); }
+            m_islands[m_island_count].m_count = 0;
+            m_island_parent[root] = bodycount + m_island_count++;
+        }
+        m_contact_island[i] = m_island_parent[root] - bodycount;
+        m_islands[ m_contact_island[i] ].m_count++;
+    }
+
+    uint32_t first = 0;
+    for (uint32_t i = 0; i < m_island_count; i++) {
+        m_islands[i].m_first = first;
+        first += m_islands[i].m_count;
+    }
+    if (m_island_count < 2) { return m_island_count; }
+
+    // sort the contacts by island, keeping their order within each.
+    if (m_island_contacts.m_size < numcontacts) {
+        m_island_contacts.clear();
+        m_island_contacts.alloc(numcontacts);
+    }
+    for (uint32_t i = 0; i < m_island_count; i++) { m_islands[i].m_count = 0; }
+    for (uint32_t i = 0; i < numcontacts; i++) {
+        contact_island &island = m_islands[ m_contact_island[i] ];
+        m_island_contacts[ island.m_first + island.m_count++ ] = contacts[i];
+    }
+    for (uint32_t i = 0; i < numcontacts; i++) { contacts[i] = m_island_contacts[i]; }
+
+    return m_island_count;
+}
+
+void contact_resolver::preparecontacts(contact* contacts,uint32_t numcontacts,float duration) {
+    // generate contact velocity and axis information.
+    contact* lastcontact = contacts + numcontacts;
+    for (contact* contact_=contacts; contact_ < lastcontact; contact_++) {
+        // calculate the internal contact data (inertia, basis, etc).
+        contact_->calculateinternals(duration);
+    }
+
+    // list the contacts of each movable body. resolving a contact never
+    // moves a body with infinite mass, so those bodies are left out,
+    // which also keeps each list inside a single island.
+    m_prepared_contacts = contacts;
+    m_body_contact_start.m_count = 0;
+    for (uint32_t i = 0; i <= m_body_count; i++) { m_body_contact_start.pushback(0,true); }
+
+    for (contact* contact_=contacts; contact_ < lastcontact; contact_++) {
+        for (uint32_t b = 0; b < 2; b++) {
+            rigid_body *body = contact_->m_body[b];
+            if (body && body->getinversemass() > 0.0f) { m_body_contact_start[body->m_island + 1]++; }
+        }
+    }
+    for (uint32_t i = 0; i < m_body_count; i++) { m_body_contact_start[i+1] += m_body_contact_start[i]; }
+
+    // fill the lists using each body's start as a cursor, which leaves
+    // it at the start of the next body, then shift the starts back down.
+    uint32_t total = m_body_contact_start[m_body_count];
+    if (m_body_contacts.m_size < total) { m_body_contacts.alloc(total); }
+    m_body_contacts.m_count = total;
+    for (contact* contact_=contacts; contact_ < lastcontact; contact_++) {
+        for (uint32_t b = 0; b < 2; b++) {
+            rigid_body *body = contact_->m_body[b];
+            if (body && body->getinversemass() > 0.0f) { m_body_contacts[ m_body_contact_start[body->m_island]++ ] = contact_; }
+        }
+    }
+    for (uint32_t i = m_body_count; i > 0; i--) { m_body_contact_start[i] = m_body_contact_start[i-1]; }
+    m_body_contact_start[0] = 0;
+
+    if (m_heap_items.m_size < numcontacts) {
+        m_heap_items.alloc(numcontacts);
+        m_heap_place.alloc(numcontacts);
+        m_heap_keys.alloc(numcontacts);
+    }
+
+    // start each contact from the impulse it had last step, moved into
+    // the new contact basis and clamped to what the contact can hold.
+    if (m_mode != solver_sequential_impulse) { return; }
+
+    m_cache.m_hits = 0;
+    for (contact* contact_=contacts; contact_ < lastcontact; contact_++) {
+        contact_->calculateimpulsedata();
+        contact_->m_accumulated_impulse.clear();
+
+        const contact_cache_entry *entry = m_cache.find(*contact_);
+        if (!entry) { continue; }
+        m_cache.m_hits++;
+
+        _vec3 impulse = contact_->m_contact_to_world.transformtranspose(entry->m_impulse);
+        if (impulse.x <= 0.0f) { continue; }
+
+        float limit      = contact_->m_friction * impulse.x;
+        float tangential = sqrt(impulse.y*impulse.y + impulse.z*impulse.z);
+        if (tangential > limit) {
+            impulse.y *= limit / tangential;
+            impulse.z *= limit / tangential;
+        }
+        contact_->m_accumulated_impulse = impulse;
+    }
+}
+
+contact_heap contact_resolver::getheap(contact *c) {
+    uint32_t offset = uint32_t(c - m_prepared_contacts);
+
+    contact_heap heap;
+    heap.m_items = m_heap_items.m_data + offset;
+    heap.m_place = m_heap_place.m_data + offset;
+    heap.m_keys  = m_heap_keys.m_data + offset;
+    heap.m_count = 0;
+    return heap;
+}
+
+// contact heap implementation
+
+void contact_heap::build(uint32_t count) {
+    m_count = count;
+    for (uint32_t i = 0; i < count; i++) { m_items[i] = i; m_place[i] = i; }
+    for (uint32_t i = count/2; i > 0; i--) { siftdown(i-1); }
+}
+
+void contact_heap::update(uint32_t item, float key) {
+    float old = m_keys[item];
+    m_keys[item] = key;
+    if (key > old) { siftup(m_place[item]); }
+    else if (key < old) { siftdown(m_place[item]); }
+}
+
+void contact_heap::siftup(uint32_t place) {
+    uint32_t item = m_items[place];
+    while (place > 0) {
+        uint32_t parent = (place-1) / 2;
+        if (m_keys[ m_items[parent] ] >= m_keys[item]) { break; }
+
+        m_items[place] = m_items[parent];
+        m_place[ m_items[place] ] = place;
+        place = parent;
+    }
+    m_items[place] = item;
+    m_place[item]  = place;
+}
+
+void contact_heap::siftdown(uint32_t place) {
+    uint32_t item = m_items[place];
+    for (;;) {
+        uint32_t child = place*2 + 1;
+        if (child >= m_count) { break; }
+        if (child+1 < m_count && m_keys[ m_items[child+1] ] > m_keys[ m_items[child] ]) { child++; }
+        if (m_keys[ m_items[child] ] <= m_keys[item]) { break; }
+
+        m_items[place] = m_items[child];
+        m_place[ m_items[place] ] = place;
+        place = child;
+    }
+    m_items[place] = item;
+    m_place[item]  = place;
+}
+
+uint32_t contact_resolver::adjustvelocities(contact *c, uint32_t numcontacts, float duration) {
+
+	_vec3 velocitychange[2], rotationchange[2];
+    _vec3 deltavel;
+
+    // order the contacts by the size of their probable velocity change.
+    contact_heap heap = getheap(c);
+    for (uint32_t i = 0; i < numcontacts; i++) { heap.m_keys[i] = c[i].m_desired_delta_velocity; }
+    heap.build(numcontacts);
+
+    // iteratively handle impacts in order of severity.
+    uint32_t iterationsused = 0;
+    while ( iterationsused < m_velocity_iterations ) {
+        // find contact with maximum magnitude of probable velocity change.
+        uint32_t index = heap.top();
+        if (heap.m_keys[index] <= m_velocity_epsilon) { break; }
+
+        // do the resolution on the contact that came out at the top (index) .
+        c[index].applyvelocitychange(velocitychange, rotationchange);
+
+        // with the change in velocity of the two bodies, the update of
+        // contact velocities means that some of the relative closing
+        // velocities need recomputing. only the contacts of the two
+        // bodies can have changed.
+        for (uint32_t d = 0; d < 2; d++) {
+            rigid_body *body = c[index].m_body[d];
+            if (!body || body->getinversemass() <= 0.0f) { continue; }
+
+            uint32_t last = m_body_contact_start[body->m_island + 1];
+            for (uint32_t i = m_body_contact_start[body->m_island]; i < last; i++) {
+                contact *other = m_body_contacts[i];
+                uint32_t b = (other->m_body[0] == body) ? 0 : 1;
+
+                deltavel = velocitychange[d] + _cross(rotationchange[d],other->m_relative_contact_position[b]);
+
+                // the sign of the change is negative if we're dealing
+                // with the second body in a contact.
+                other->m_contact_velocity += other->m_contact_to_world.transformtranspose(deltavel) * (b?-1.0f:1.0f);
+                other->calculatedesireddeltavelocity(duration);
+                heap.update(uint32_t(other - c), other->m_desired_delta_velocity);
+            }
+        }
+        iterationsused++;
+    }
+    return iterationsused;
+}
+
+uint32_t contact_resolver::adjustpositions(contact *c,uint32_t numcontacts, float duration) {
+
+    _vec3 linearchange[2], angularchange[2];
+    _vec3 deltaposition;
+
+    // order the contacts by their penetration.
+    contact_heap heap = getheap(c);
+    for (uint32_t i = 0; i < numcontacts; i++) { heap.m_keys[i] = c[i].m_penetration; }
+    heap.build(numcontacts);
+
+    // iteratively resolve interpenetrations in order of severity.
+    uint32_t iterationsused = 0;
+    while ( iterationsused < m_position_iterations ) {
+        // find biggest penetration
+        uint32_t index = heap.top();
+        float max = heap.m_keys[index];
+        if (max <= m_position_epsilon) { break; }
+
+        // resolve the penetration.
+        c[index].applypositionchange(linearchange,angularchange,max);
+
+        // again this action may have changed the penetration of other
+        // bodies, so we update the contacts of the two bodies.
+        for (uint32_t d = 0; d < 2; d++) {
+            rigid_body *body = c[index].m_body[d];
+            if (!body || body->getinversemass() <= 0.0f) { continue; }
+
+            uint32_t last = m_body_contact_start[body->m_island + 1];
+            for (uint32_t i = m_body_contact_start[body->m_island]; i < last; i++) {
+                contact *other = m_body_contacts[i];
+                uint32_t b = (other->m_body[0] == body) ? 0 : 1;
+
+                deltaposition = linearchange[d] + _cross(angularchange[d] , other->m_relative_contact_position[b]);
+
+                // the sign of the change is positive if we're
+                // dealing with the second body in a contact
+                // and negative otherwise (because we're
+                // subtracting the resolution)..
+                other->m_penetration += _dot( deltaposition,other->m_contact_normal) * (b?1:-1);
+                heap.update(uint32_t(other - c), other->m_penetration);
+            }
+        }
+        iterationsused++;
+    }
+    return iterationsused;
+}
+
+uint32_t contact_resolver::solveimpulses(contact *c, uint32_t numcontacts) {
+
+    // apply the impulses carried over from the last step.
+    for (uint32_t i = 0; i < numcontacts; i++) {
+        c[i].applycontactimpulse(c[i].m_accumulated_impulse);
+    }
+
+    // visit every contact in turn, correcting its velocity with the
+    // impulse it needs. the total impulse at a contact is clamped
+    // rather than each correction, so a later pass can take back part
+    // of an earlier one.
+    uint32_t iterationsused = 0;
+    while ( iterationsused < m_impulse_iterations ) {
+        iterationsused++;
+
+        float maxchange = 0.0f;
+        for (uint32_t i = 0; i < numcontacts; i++) {
+            contact &contact_ = c[i];
+            _vec3 old = contact_.m_accumulated_impulse;
+            _vec3 impulse = old;
+
+            // the normal impulse can push the bodies apart but never
+            // pull them together.
+            _vec3 velocity = contact_.calculaterelativevelocity();
+            impulse.x += (contact_.m_target_velocity - velocity.x) * contact_.m_effective_mass.x;
+            if (impulse.x < 0.0f) { impulse.x = 0.0f; }
+            contact_.applycontactimpulse( _vec3(impulse.x - old.x, 0.0f, 0.0f) );
+
+            // friction removes the sliding velocity, up to the limit
+            // the new normal impulse allows.
+            velocity = contact_.calculaterelativevelocity();
+            impulse.y -= velocity.y * contact_.m_effective_mass.y;
+            impulse.z -= velocity.z * contact_.m_effective_mass.z;
+
+            float limit      = contact_.m_friction * impulse.x;
+            float tangential = sqrt(impulse.y*impulse.y + impulse.z*impulse.z);
+            if (tangential > limit) {
+                impulse.y *= limit / tangential;
+                impulse.z *= limit / tangential;
+            }
+            contact_.applycontactimpulse( _vec3(0.0f, impulse.y - old.y, impulse.z - old.z) );
+            contact_.m_accumulated_impulse = impulse;
+
+            // track the largest velocity change made this pass.
+            _vec3 delta = impulse - old;
+            for (uint32_t a = 0; a < 3; a++) {
+                if (contact_.m_effective_mass[a] <= 0.0f) { continue; }
+                float change = abs(delta[a]) / contact_.m_effective_mass[a];
+                if (change > maxchange) { maxchange = change; }
+            }
+        }
+        if (maxchange < m_velocity_epsilon) { break; }
+    }
+    return iterationsused;
+}
@@ -1,376 +1,689 @@
-#pragma once
-
-/**
-* this file contains the contact resolution system for cyclone,
-* although it is called the contact resolution system, it handles
-* collisions, contacts (sliding and resting), and constraints (such
-* as joints).
-*
-* the resolver uses an iterative satisfaction algorithm; it loops
-* through each contact and tries to resolve it. this is a very fast
-* algorithm but can be unstable when the contacts are highly
-* inter-related.
-*/
-#include "body.h"
-/*
-* forward declaration, see full declaration below for complete
-* documentation.
-*/
-struct contact_resolver;
-
-/**
-* a contact represents two bodies in contact. resolving a
-* contact removes their interpenetration, and applies sufficient
-* impulse to keep them apart. colliding bodies may also rebound.
-* contacts can be used to represent positional joints, by making
-* the contact constraint keep the bodies in their correct
-* orientation.
-*
-* it can be a good idea to create a contact object even when the
-* contact isn't violated. because resolving one contact can violate
-* another, contacts that are close to being violated should be
-* sent to the resolver; that way if one resolution moves the body,
-* the contact may be violated, and can be resolved. if the contact
-* is not violated, it will not be resolved, so you only loose a
-* small amount of execution time.
-*
-* the contact has no callable functions, it just holds the contact
-* details. to resolve a set of contacts, use the contact resolver
-* class.
-*/
-
-struct contact {
-	/**
-	* holds the bodies that are involved in the contact. the
-	* second of these can be null, for contacts with the scenery.
-	*/
-	rigid_body * m_body[2];
-
-	/**
-	* holds the lateral friction coefficient at the contact.
-	*/
-	float m_friction;
-
-	/**
-	* holds the normal restitution coefficient at the contact.
-	*/
-	float m_restitution;
-
-	/**
-	* holds the position of the contact in world coordinates.
-	*/
-	_vec3 m_contact_point;
-
-	/**
-	* holds the direction of the contact in world coordinates.
-	*/
-	_vec3 m_contact_normal;
-
-	/**
-	* holds the depth of penetration at the contact point. if both
-	* bodies are specified then the contact point should be midway
-	* between the inter-penetrating points.
-	*/
-	float m_penetration;
-
-	/**
-	* sets the data that doesn't normally depend on the position
-	* of the contact (i.e. the bodies, and their material properties).
-	*/
-	void setbodydata(rigid_body* one, rigid_body *two,float friction, float restitution);
-
-	/**
-	* a transform matrix that converts co-ordinates in the contact's
-	* frame of reference to world co-ordinates. the columns of this
-	* matrix form an orthonormal set of vectors.
-	*/
-	_mat3 m_contact_to_world;
-
-	/**
-	* holds the closing velocity at the point of contact. this is set
-	* when the calculateinternals function is run.
-	*/
-	_vec3 m_contact_velocity;
-
-	/**
-	* holds the required change in velocity for this contact to be
-	* resolved.
-	*/
-	float m_desired_delta_velocity;
-
-	/**
-	* holds the world space position of the contact point relative to
-	* centre of each body. this is set when the calculateinternals
-	* function is run.
-	*/
-	_vec3 m_relative_contact_position[2];
-
-	/**
-	* calculates internal data from state data. this is called before
-	* the resolution algorithm tries to do any resolution. it should
-	* never need to be called manually.
-	*/
-	void calculateinternals( float duration);
-
-	/**
-	* reverses the contact. this involves swapping the two rigid bodies
-	* and reversing the contact normal. the internal values should then
-	* be recalculated using calculateinternals (this is not done  automatically).
-	*/
-	void swapbodies();
-
-	/**
-	* updates the awake state of rigid bodies that are taking
-	* place in the given contact. a body will be made awake if it
-	* is in contact with a body that is awake.
-	*/
-	void matchawakestate();
-
-	/**
-	* calculates and sets the internal value for the desired delta
-	* velocity.
-	*/
-	void calculatedesireddeltavelocity(float duration);
-
-	/**
-	* calculates and returns the velocity of the contact
-	* point on the given body.
-	*/
-	_vec3 calculatelocalvelocity(uint32_t bodyindex, float duration);
-
-	/**
-	* calculates an orthonormal basis for the contact point, based on
-	* the primary friction direction (for anisotropic friction) or
-	* a random orientation (for isotropic friction).
-	*/
-	void calculatecontactbasis();
-
-	/**
-	* applies an impulse to the given body, returning the
-	* change in velocities.
-	*/
-	void applyimpulse(const _vec3 &impulse, rigid_body *body,_vec3 *velocitychange, _vec3 *rotationchange);
-
-	/**
-	* performs an inertia-weighted impulse based resolution of this
-	* contact alone.
-	*/
-	void applyvelocitychange(_vec3 velocitychange[2],_vec3 rotationchange[2]);
-
-	/**
-	* performs an inertia weighted penetration resolution of this
-	* contact alone.
-	*/
-	void applypositionchange(_vec3 linearchange[2], _vec3 angularchange[2], float penetration);
-
-	/**
-	* calculates the impulse needed to resolve this contact,
-	* given that the contact has no friction. a pair of inertia
-	* tensors - one for each contact object - is specified to
-	* save calculation time: the calling function has access to
-	* these anyway.
-	*/
-	_vec3 calculatefrictionlessimpulse( _mat3 *inverseinertiatensor);
-
-	/**
-	* calculates the impulse needed to resolve this contact,
-	* given that the contact has a non-zero coefficient of
-	* friction. a pair of inertia tensors - one for each contact
-	* object - is specified to save calculation time: the calling
-	* function has access to these anyway.
-	*/
-	_vec3 calculatefrictionimpulse(_mat3 *inverseinertiatensor);
-};
-
-/**
-* the contact resolution routine. one resolver instance
-* can be shared for the whole simulation, as long as you need
-* roughly the same parameters each time (which is normal).
-*
-* resolution algorithm
-*
-* the resolver uses an iterative satisfaction algorithm; it loops
-* through each contact and tries to resolve it. each contact is
-* resolved locally, which may in turn put other contacts in a worse
-* position. the algorithm then revisits other contacts and repeats
-* the process up to a specified iteration limit. it can be proved
-* that given enough iterations, the simulation will get to the
-* correct result. as with all approaches, numerical stability can
-* cause problems that make a correct resolution impossible.
-*
-* strengths
-*
-* this algorithm is very fast, much faster than other physics
-* approaches. even using many more iterations than there are
-* contacts, it will be faster than global approaches.
-*
-* many global algorithms are unstable under high friction, this
-* approach is very robust indeed for high friction and low
-* restitution values.
-*
-* the algorithm produces visually believable behaviour. tradeoffs
-* have been made to err on the side of visual realism rather than
-* computational expense or numerical accuracy.
-*
-* weaknesses
-*
-* the algorithm does not cope well with situations with many
-* inter-related contacts: stacked boxes, for example. in this
-* case the simulation may appear to jiggle slightly, which often
-* dislodges a box from the stack, allowing it to collapse.
-*
-* another issue with the resolution mechanism is that resolving
-* one contact may make another contact move sideways against
-* friction, because each contact is handled independently, this
-* friction is not taken into account. if one object is pushing
-* against another, the pushed object may move across its support
-* without friction, even though friction is set between those bodies.
-*
-* in general this resolver is not suitable for stacks of bodies,
-* but is perfect for handling impact, explosive, and flat resting
-* situations.
-*/
-
-struct contact_resolver {
-
-	/**
-	* holds the number of iterations to perform when resolving
-	* velocity.
-	*/
-	uint32_t m_velocity_iterations;
-
-	/**
-	* holds the number of iterations to perform when resolving
-	* position.
-	*/
-	uint32_t m_position_iterations;
-
-	/**
-	* to avoid instability velocities smaller
-	* than this value are considered to be zero. too small and the
-	* simulation may be unstable, too large and the bodies may
-	* interpenetrate visually. a good starting point is the default
-	* of 0.01.
-	*/
-	float m_velocity_epsilon;
-
-	/**
-	* to avoid instability penetrations
-	* smaller than this value are considered to be not interpenetrating.
-	* too small and the simulation may be unstable, too large and the
-	* bodies may interpenetrate visually. a good starting point is
-	* the default of0.01.
-	*/
-	float m_position_epsilon;
-
-	/**
-	* stores the number of velocity iterations used in the
-	* last call to resolve contacts.
-	*/
-	uint32_t m_velocity_iterations_used;
-
-	/**
-	* stores the number of position iterations used in the
-	* last call to resolve contacts.
-	*/
-	uint32_t m_position_iterations_used;
-
-	/**
-	* keeps track of whether the internal settings are valid.
-	*/
-	bool m_valid_settings;
-
-	/**
-	* creates a new contact resolver with the given number of iterations
-	* per resolution call, and optional epsilon values.
-	*/
-	contact_resolver(
-		uint32_t iterations,
-		float velocityepsilon = 0.01f,
-		float positionepsilon = 0.01f
-		);
-
-	/**
-	* creates a new contact resolver with the given number of iterations
-	* for each kind of resolution, and optional epsilon values.
-	*/
-	contact_resolver(
-		uint32_t velocityiterations,
-		uint32_t positioniterations,
-		float velocityepsilon = 0.01f,
-		float positionepsilon = 0.01f
-		);
-
-	/**
-	* returns true if the resolver has valid settings and is ready to go.
-	*/
-	bool isvalid() {
-		return (m_velocity_iterations > 0) &&
-			(m_position_iterations > 0) &&
-			(m_position_epsilon >= 0.0f) &&
-			(m_position_epsilon >= 0.0f);
-	}
-
-	/**
-	* sets the number of iterations for each resolution stage.
-	*/
-	void setiterations(uint32_t velocityiterations, uint32_t positioniterations);
-
-	/**
-	* sets the number of iterations for both resolution stages.
-	*/
-	void setiterations(uint32_t iterations);
-
-	/**
-	* sets the tolerance value for both velocity and position.
-	*/
-	void setepsilon(float velocityepsilon, float positionepsilon);
-
-	/**
-	* resolves a set of contacts for both penetration and velocity.
-	*
-	* contacts that cannot interact with
-	* each other should be passed to separate calls to resolvecontacts,
-	* as the resolution algorithm takes much longer for lots of
-	* contacts than it does for the same number of contacts in small
-	* sets.
-	*
-	*/
-	void resolvecontacts(contact *contactarray, uint32_t numcontacts, float duration);
-
-	/**
-	* sets up contacts ready for processing. this makes sure their
-	* internal data is configured correctly and the correct set of bodies
-	* is made alive.
-	*/
-	void preparecontacts(contact *contactarray, uint32_t numcontacts, float duration);
-
-	/**
-	* resolves the velocity issues with the given array of constraints,
-	* using the given number of iterations.
-	*/
-	void adjustvelocities(contact *contactarray, uint32_t numcontacts, float duration);
-
-	/**
-	* resolves the positional issues with the given array of constraints,
-	* using the given number of iterations.
-	*/
-	void adjustpositions(contact *contacts,uint32_t numcontacts, float duration);
-};
-
-/**
-* this is the basic polymorphic interface for contact generators
-* applying to rigid bodies.
-*/
-struct  contact_generator {
-
-	/**
-	* fills the given contact structure with the generated
-	* contact. the contact pointer should point to the first
-	* available contact in a contact array, where limit is the
-	* maximum number of contacts in the array that can be written
-	* to. the method returns the number of contacts that have
-	* been written.
-	*/
-	virtual uint32_t addcontact(contact *contact, uint32_t limit) const = 0;
-};
+#pragma once
+
+/**
+* this file contains the contact resolution system for cyclone,
+* although it is called the contact resolution system, it handles
+* collisions, contacts (sliding and resting), and constraints (such
+* as joints).
+*
+* the resolver uses an iterative satisfaction algorithm; it loops
+* through each contact and tries to resolve it. this is a very fast
+* algorithm but can be unstable when the contacts are highly
+* inter-related.
+*/
+#include "body.h"
+#include "thread_pool.h"
+/*
+* forward declaration, see full declaration below for complete
+* documentation.
+*/
+struct contact_resolver;
+
+/**
+* a contact represents two bodies in contact. resolving a
+* contact removes their interpenetration, and applies sufficient
+* impulse to keep them apart. colliding bodies may also rebound.
+* contacts can be used to represent positional joints, by making
+* the contact constraint keep the bodies in their correct
+* orientation.
+*
+* it can be a good idea to create a contact object even when the
+* contact isn't violated. because resolving one contact can violate
+* another, contacts that are close to being violated should be
+* sent to the resolver; that way if one resolution moves the body,
+* the contact may be violated, and can be resolved. if the contact
+* is not violated, it will not be resolved, so you only loose a
+* small amount of execution time.
+*
+* the contact has no callable functions, it just holds the contact
+* details. to resolve a set of contacts, use the contact resolver
+* class.
+*/
+
+struct contact {
+	/**
+	* holds the bodies that are involved in the contact. the
+	* second of these can be null, for contacts with the scenery.
+	*/
+	rigid_body * m_body[2];
+
+	/**
+	* holds the lateral friction coefficient at the contact.
+	*/
+	float m_friction;
+
+	/**
+	* holds the normal restitution coefficient at the contact.
+	*/
+	float m_restitution;
+
+	/**
+	* holds the position of the contact in world coordinates.
+	*/
+	_vec3 m_contact_point;
+
+	/**
+	* holds the direction of the contact in world coordinates.
+	*/
+	_vec3 m_contact_normal;
+
+	/**
+	* holds the depth of penetration at the contact point. if both
+	* bodies are specified then the contact point should be midway
+	* between the inter-penetrating points.
+	*/
+	float m_penetration;
+
+	/**
+	* sets the data that doesn't normally depend on the position
+	* of the contact (i.e. the bodies, and their material properties).
+	*/
+	void setbodydata(rigid_body* one, rigid_body *two,float friction, float restitution);
+
+	/**
+	* a transform matrix that converts co-ordinates in the contact's
+	* frame of reference to world co-ordinates. the columns of this
+	* matrix form an orthonormal set of vectors.
+	*/
+	_mat3 m_contact_to_world;
+
+	/**
+	* holds the closing velocity at the point of contact. this is set
+	* when the calculateinternals function is run.
+	*/
+	_vec3 m_contact_velocity;
+
+	/**
+	* holds the required change in velocity for this contact to be
+	* resolved.
+	*/
+	float m_desired_delta_velocity;
+
+	/**
+	* holds the world space position of the contact point relative to
+	* centre of each body. this is set when the calculateinternals
+	* function is run.
+	*/
+	_vec3 m_relative_contact_position[2];
+
+	/**
+	* identifies the features (vertex, edge or face) of the two
+	* primitives that made the contact. together with the two bodies
+	* it lets a contact be matched with the same contact in the last
+	* step. it is set by the collision detector.
+	*/
+	uint32_t m_feature;
+
+	/**
+	* holds the impulse applied at the contact so far by the sequential
+	* impulse solver, in contact coordinates.
+	*/
+	_vec3 m_accumulated_impulse;
+
+	/**
+	* holds the effective mass of the contact along each contact axis:
+	* the impulse needed to change the closing velocity by one.
+	*/
+	_vec3 m_effective_mass;
+
+	/**
+	* holds the closing velocity along the normal that the sequential
+	* impulse solver aims for. a contact closing slower than two units
+	* a second aims for none, so it doesn't bounce.
+	*/
+	float m_target_velocity;
+
+	/**
+	* returns the velocity of the first body relative to the second
+	* at the contact point, in contact coordinates, as the bodies are
+	* moving now.
+	*/
+	_vec3 calculaterelativevelocity() const;
+
+	/**
+	* applies an impulse, given in contact coordinates, to the first
+	* body and its opposite to the second.
+	*/
+	void applycontactimpulse(const _vec3 &impulse);
+
+	/**
+	* calculates the effective mass and target velocity used by the
+	* sequential impulse solver. calculateinternals must be run first.
+	*/
+	void calculateimpulsedata();
+
+	/**
+	* calculates internal data from state data. this is called before
+	* the resolution algorithm tries to do any resolution. it should
+	* never need to be called manually.
+	*/
+	void calculateinternals( float duration);
+
+	/**
+	* reverses the contact. this involves swapping the two rigid bodies
+	* and reversing the contact normal. the internal values should then
+	* be recalculated using calculateinternals (this is not done  automatically).
+	*/
+	void swapbodies();
+
+	/**
+	* calculates and sets the internal value for the desired delta
+	* velocity.
+	*/
+	void calculatedesireddeltavelocity(float duration);
+
+	/**
+	* calculates and returns the velocity of the contact
+	* point on the given body.
+	*/
+	_vec3 calculatelocalvelocity(uint32_t bodyindex, float duration);
+
+	/**
+	* calculates an orthonormal basis for the contact point, based on
+	* the primary friction direction (for anisotropic friction) or
+	* a random orientation (for isotropic friction).
+	*/
+	void calculatecontactbasis();
+
+	/**
+	* applies an impulse to the given body, returning the
+	* change in velocities.
+	*/
+	void applyimpulse(const _vec3 &impulse, rigid_body *body,_vec3 *velocitychange, _vec3 *rotationchange);
+
+	/**
+	* performs an inertia-weighted impulse based resolution of this
+	* contact alone.
+	*/
+	void applyvelocitychange(_vec3 velocitychange[2],_vec3 rotationchange[2]);
+
+	/**
+	* performs an inertia weighted penetration resolution of this
+	* contact alone.
+	*/
+	void applypositionchange(_vec3 linearchange[2], _vec3 angularchange[2], float penetration);
+
+	/**
+	* calculates the impulse needed to resolve this contact,
+	* given that the contact has no friction. a pair of inertia
+	* tensors - one for each contact object - is specified to
+	* save calculation time: the calling function has access to
+	* these anyway.
+	*/
+	_vec3 calculatefrictionlessimpulse( _mat3 *inverseinertiatensor);
+
+	/**
+	* calculates the impulse needed to resolve this contact,
+	* given that the contact has a non-zero coefficient of
+	* friction. a pair of inertia tensors - one for each contact
+	* object - is specified to save calculation time: the calling
+	* function has access to these anyway.
+	*/
+	_vec3 calculatefrictionimpulse(_mat3 *inverseinertiatensor);
+};
+
+/**
+* a group of contacts whose bodies are connected to each other,
+* directly or through other contacts. resolving the contacts of one
+* island never changes the contacts of another, so each island can
+* be resolved on its own.
+*/
+struct contact_island {
+
+	/** holds the index of the first contact of the island. */
+	uint32_t m_first;
+
+	/** holds the number of contacts in the island. */
+	uint32_t m_count;
+
+	/**
+	* true if every movable body of the island is asleep, the island
+	* is then left as it is. an island with any body awake has all of
+	* them woken before it is resolved.
+	*/
+	bool m_asleep;
+
+	/** holds the iterations used to resolve the island. */
+	uint32_t m_position_iterations;
+	uint32_t m_velocity_iterations;
+};
+
+#define island_unassigned 0xffffffff
+
+/**
+* selects how the contact resolver solves velocities.
+*
+* solver_iterative resolves the worst contact first and forgets
+* every impulse at the end of the step, as cyclone does.
+*
+* solver_sequential_impulse is projected gauss-seidel: every contact
+* is visited in turn, and the impulse accumulated at each one is
+* clamped so it never pulls the bodies together. the accumulated
+* impulses are kept in a cache and used as the starting point of the
+* next step, so stacks settle in far fewer iterations.
+*/
+enum solver_mode { solver_iterative = 0, solver_sequential_impulse };
+
+/**
+* one contact remembered by the contact cache.
+*/
+struct contact_cache_entry {
+
+	/** the bodies of the contact, the first is NULL for empty entries. */
+	rigid_body * m_body[2];
+
+	/** the features that made the contact. */
+	uint32_t m_feature;
+
+	/** the impulse accumulated at the contact, in world coordinates. */
+	_vec3 m_impulse;
+};
+
+/**
+* remembers the impulses of the last step, keyed by the two bodies
+* and the feature id of each contact. the impulse is kept in world
+* coordinates, since the contact basis is rebuilt every step.
+*
+* a contact only matches if its bodies come in the same order as
+* last step; a pair that is found the other way round simply starts
+* cold for one step.
+*/
+struct contact_cache {
+
+	contact_cache();
+
+	/** holds the entries, an open addressed table whose size is a power of two. */
+	_array<contact_cache_entry> m_entries;
+
+	/** the number of contacts matched by the last lookups. */
+	uint32_t m_hits;
+
+	/**
+	* returns the entry for the given contact, or NULL if the contact
+	* was not stored last step.
+	*/
+	const contact_cache_entry* find(const contact &contact_) const;
+
+	/**
+	* replaces the contents of the cache with the given contacts.
+	*/
+	void store(const contact *contacts, uint32_t numcontacts);
+
+	/**
+	* forgets every contact.
+	*/
+	void clear();
+
+	/**
+	* returns the first slot to look in for the given key.
+	*/
+	uint32_t slot(const rigid_body *one, const rigid_body *two, uint32_t feature) const;
+};
+
+/**
+* a binary max-heap over the contacts of an island, ordered by how
+* badly each contact needs resolving. a contact's key can change at
+* any time, and its place in the heap is restored in logarithmic time,
+* so the worst contact is always found at the top.
+*
+* the heap doesn't own its storage: it works on slices of arrays held
+* by the contact resolver, so islands can be resolved side by side.
+*/
+struct contact_heap {
+
+	/** holds the contacts, as indices into the island, in heap order. */
+	uint32_t * m_items;
+
+	/** holds where each contact is in m_items. */
+	uint32_t * m_place;
+
+	/** holds the key of each contact. */
+	float *    m_keys;
+
+	/** the number of contacts in the heap. */
+	uint32_t   m_count;
+
+	/**
+	* puts contacts 0 to count-1 in the heap. their keys must be set.
+	*/
+	void build(uint32_t count);
+
+	/**
+	* returns the contact with the largest key.
+	*/
+	uint32_t top() const { return m_items[0]; }
+
+	/**
+	* changes the key of the given contact, and moves it to its new place.
+	*/
+	void update(uint32_t item, float key);
+
+	void siftup(uint32_t place);
+	void siftdown(uint32_t place);
+};
+
+/**
+* the contact resolution routine. one resolver instance
+* can be shared for the whole simulation, as long as you need
+* roughly the same parameters each time (which is normal).
+*
+* resolution algorithm
+*
+* the resolver uses an iterative satisfaction algorithm; it loops
+* through each contact and tries to resolve it. each contact is
+* resolved locally, which may in turn put other contacts in a worse
+* position. the algorithm then revisits other contacts and repeats
+* the process up to a specified iteration limit. it can be proved
+* that given enough iterations, the simulation will get to the
+* correct result. as with all approaches, numerical stability can
+* cause problems that make a correct resolution impossible.
+*
+* strengths
+*
+* this algorithm is very fast, much faster than other physics
+* approaches. even using many more iterations than there are
+* contacts, it will be faster than global approaches.
+*
+* many global algorithms are unstable under high friction, this
+* approach is very robust indeed for high friction and low
+* restitution values.
+*
+* the algorithm produces visually believable behaviour. tradeoffs
+* have been made to err on the side of visual realism rather than
+* computational expense or numerical accuracy.
+*
+* weaknesses
+*
+* the algorithm does not cope well with situations with many
+* inter-related contacts: stacked boxes, for example. in this
+* case the simulation may appear to jiggle slightly, which often
+* dislodges a box from the stack, allowing it to collapse.
+*
+* another issue with the resolution mechanism is that resolving
+* one contact may make another contact move sideways against
+* friction, because each contact is handled independently, this
+* friction is not taken into account. if one object is pushing
+* against another, the pushed object may move across its support
+* without friction, even though friction is set between those bodies.
+*
+* in general this resolver is not suitable for stacks of bodies,
+* but is perfect for handling impact, explosive, and flat resting
+* situations.
+*/
+
+struct contact_resolver {
+
+	/**
+	* holds the number of iterations to perform when resolving
+	* velocity.
+	*/
+	uint32_t m_velocity_iterations;
+
+	/**
+	* holds the number of iterations to perform when resolving
+	* position.
+	*/
+	uint32_t m_position_iterations;
+
+	/**
+	* selects how velocities are solved, see solver_mode.
+	*/
+	solver_mode m_mode;
+
+	/**
+	* holds the number of passes over the contacts made by the
+	* sequential impulse solver. it stops early once no contact
+	* velocity changes by more than the velocity epsilon.
+	*/
+	uint32_t m_impulse_iterations;
+
+	/**
+	* holds the impulses of the last step for warm starting.
+	*/
+	contact_cache m_cache;
+
+	/**
+	* to avoid instability velocities smaller
+	* than this value are considered to be zero. too small and the
+	* simulation may be unstable, too large and the bodies may
+	* interpenetrate visually. a good starting point is the default
+	* of 0.01.
+	*/
+	float m_velocity_epsilon;
+
+	/**
+	* to avoid instability penetrations
+	* smaller than this value are considered to be not interpenetrating.
+	* too small and the simulation may be unstable, too large and the
+	* bodies may interpenetrate visually. a good starting point is
+	* the default of0.01.
+	*/
+	float m_position_epsilon;
+
+	/**
+	* stores the number of velocity iterations used in the
+	* last call to resolve contacts.
+	*/
+	uint32_t m_velocity_iterations_used;
+
+	/**
+	* stores the number of position iterations used in the
+	* last call to resolve contacts.
+	*/
+	uint32_t m_position_iterations_used;
+
+	/**
+	* keeps track of whether the internal settings are valid.
+	*/
+	bool m_valid_settings;
+
+	/** holds the islands found by the last call to resolve contacts. */
+	_array<contact_island> m_islands;
+
+	/** the number of islands found by the last call to resolve contacts. */
+	uint32_t m_island_count;
+
+	/**
+	* holds the union-find parent of each body while the islands
+	* are built.
+	*/
+	_array<uint32_t> m_island_parent;
+
+	/** holds the island of each contact while the islands are built. */
+	_array<uint32_t> m_contact_island;
+
+	/** holds the contacts while they are sorted into islands. */
+	_array<contact> m_island_contacts;
+
+	/**
+	* the thread pool islands are resolved on, or NULL to resolve
+	* them all on the calling thread. islands never share a body that
+	* the resolution changes, and bodies with infinite mass are only
+	* read, so the result is the same on any number of threads.
+	*/
+	thread_pool * m_pool;
+
+	/** the number of islands resolved on the pool by the last call. */
+	uint32_t m_parallel_islands;
+
+	/**
+	* the number of islands left asleep, or put to sleep, by the last
+	* call to resolve contacts.
+	*/
+	uint32_t m_sleeping_islands;
+
+	/** holds the islands handed to the pool. */
+	_array<uint32_t> m_job_islands;
+
+	/** the contacts and duration being resolved by the pool. */
+	contact * m_job_contacts;
+	float     m_job_duration;
+
+	/**
+	* the contacts given to the last preparecontacts. the adjust
+	* functions find their heap storage and contact lists through it.
+	*/
+	contact * m_prepared_contacts;
+
+	/** the number of bodies given an index by buildislands. */
+	uint32_t m_body_count;
+
+	/**
+	* holds the contacts of each movable body, built by preparecontacts.
+	* the contacts of body b are m_body_contacts[ m_body_contact_start[b] ]
+	* up to m_body_contact_start[b+1].
+	*/
+	_array<uint32_t> m_body_contact_start;
+	_array<contact*> m_body_contacts;
+
+	/** holds the storage of the severity heaps, one slice per island. */
+	_array<uint32_t> m_heap_items;
+	_array<uint32_t> m_heap_place;
+	_array<float>    m_heap_keys;
+
+	/**
+	* creates a new contact resolver with the given number of iterations
+	* per resolution call, and optional epsilon values.
+	*/
+	contact_resolver(
+		uint32_t iterations,
+		float velocityepsilon = 0.01f,
+		float positionepsilon = 0.01f
+		);
+
+	/**
+	* creates a new contact resolver with the given number of iterations
+	* for each kind of resolution, and optional epsilon values.
+	*/
+	contact_resolver(
+		uint32_t velocityiterations,
+		uint32_t positioniterations,
+		float velocityepsilon = 0.01f,
+		float positionepsilon = 0.01f
+		);
+
+	/**
+	* returns true if the resolver has valid settings and is ready to go.
+	*/
+	bool isvalid() {
+		return (m_velocity_iterations > 0) &&
+			(m_position_iterations > 0) &&
+			(m_position_epsilon >= 0.0f) &&
+			(m_position_epsilon >= 0.0f);
+	}
+
+	/**
+	* sets the number of iterations for each resolution stage.
+	*/
+	void setiterations(uint32_t velocityiterations, uint32_t positioniterations);
+
+	/**
+	* sets the number of iterations for both resolution stages.
+	*/
+	void setiterations(uint32_t iterations);
+
+	/**
+	* sets the tolerance value for both velocity and position.
+	*/
+	void setepsilon(float velocityepsilon, float positionepsilon);
+
+	/**
+	* resolves a set of contacts for both penetration and velocity.
+	*
+	* the resolution algorithm takes much longer for lots of contacts
+	* than it does for the same number of contacts in small sets, so
+	* the contacts are first split into islands that cannot interact
+	* with each other, and each island is given the full number of
+	* iterations. the iterations used are summed over the islands.
+	*
+	*/
+	void resolvecontacts(contact *contactarray, uint32_t numcontacts, float duration);
+
+	/**
+	* splits the contacts into islands of connected bodies. the contacts
+	* are reordered so each island is a contiguous range of the array,
+	* keeping their relative order. bodies with infinite mass don't
+	* connect the contacts that touch them. returns the number of islands.
+	*/
+	uint32_t buildislands(contact *contactarray, uint32_t numcontacts);
+
+	/**
+	* returns the root of the given body in the island union-find.
+	*/
+	uint32_t findisland(uint32_t body);
+
+	/**
+	* wakes every body of an island that has any body awake, waking
+	* the islands they were put to sleep with in turn, so a touch
+	* spreads through a pile in a single step. islands left with every
+	* body asleep are marked m_asleep.
+	*/
+	void wakeislands(contact *contactarray);
+
+	/**
+	* puts the islands to sleep whose bodies are all sleepy, linking
+	* their bodies so they are woken together. an island sleeps as a
+	* whole or not at all, so a pile doesn't settle a body at a time.
+	*/
+	void sleepislands(contact *contactarray);
+
+	/**
+	* resolves the positions and velocities of a single island.
+	*/
+	void resolveisland(contact *contactarray, contact_island *island, float duration);
+
+	/**
+	* sets up contacts ready for processing. this makes sure their
+	* internal data is configured correctly and the correct set of bodies
+	* is made alive. it also lists the contacts of each movable body, so
+	* a resolution step only revisits the contacts it can have changed.
+	* the bodies must have been indexed by buildislands.
+	*/
+	void preparecontacts(contact *contactarray, uint32_t numcontacts, float duration);
+
+	/**
+	* returns a severity heap for the given contacts, which must be part
+	* of the array given to the last preparecontacts.
+	*/
+	contact_heap getheap(contact *contactarray);
+
+	/**
+	* resolves the velocity issues with the given array of constraints,
+	* using the given number of iterations. returns the number of
+	* iterations used. it only reads the resolver's settings, so it can
+	* run on several threads at once.
+	*/
+	uint32_t adjustvelocities(contact *contactarray, uint32_t numcontacts, float duration);
+
+	/**
+	* resolves the positional issues with the given array of constraints,
+	* using the given number of iterations. returns the number of
+	* iterations used. it only reads the resolver's settings, so it can
+	* run on several threads at once.
+	*/
+	uint32_t adjustpositions(contact *contacts,uint32_t numcontacts, float duration);
+
+	/**
+	* solves the velocities of the given contacts with sequential
+	* impulses, starting from their accumulated impulses. returns the
+	* number of passes used. it can run on several threads at once.
+	*/
+	uint32_t solveimpulses(contact *contacts, uint32_t numcontacts);
+};
+
+/**
+* this is the basic polymorphic interface for contact generators
+* applying to rigid bodies.
+*/
+struct  contact_generator {
+
+	/**
+	* fills the given contact structure with the generated
+	* contact. the contact pointer should point to the first
+	* available contact in a contact array, where limit is the
+	* maximum number of contacts in the array that can be written
+	* to. the method returns the number of contacts that have
+	* been written.
+	*/
+	virtual uint32_t addcontact(contact *contact, uint32_t limit) const = 0;
+};
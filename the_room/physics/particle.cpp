@@ -0,0 +1,533 @@
+#include "particle.h"
+
+#include <memory.h>
+
+#ifdef physics_simd
+#include <emmintrin.h>
+#endif
+
+particle_pool::particle_pool() {
+	m_capacity = 0;
+	m_count    = 0;
+	m_active   = NULL;
+}
+
+particle_pool::~particle_pool() { destroy(); }
+
+/**
+* the arrays of floats held by the pool. they are allocated, cleared
+* and freed together.
+*/
+#define particle_float_arrays 16
+
+static void _floatarrays(particle_pool *pool, float **arrays[particle_float_arrays]) {
+	soa_vec3 *vectors[] = { &pool->m_position, &pool->m_previous_position, &pool->m_velocity, &pool->m_acceleration };
+
+	uint32_t n = 0;
+	arrays[n++] = &pool->m_inverse_mass;
+	arrays[n++] = &pool->m_damping;
+	arrays[n++] = &pool->m_damping_factor;
+	arrays[n++] = &pool->m_radius;
+	for (uint32_t i = 0; i < sizeof(vectors)/sizeof(vectors[0]); i++) {
+		arrays[n++] = &vectors[i]->m_x;
+		arrays[n++] = &vectors[i]->m_y;
+		arrays[n++] = &vectors[i]->m_z;
+	}
+}
+
+bool particle_pool::create(uint32_t capacity) {
+	destroy();
+
+	m_capacity = (capacity + 3) & ~3u;
+	m_count    = 0;
+	m_factor_duration = 0;
+
+	float **arrays[particle_float_arrays];
+	_floatarrays(this, arrays);
+	for (uint32_t i = 0; i < particle_float_arrays; i++) {
+		*arrays[i] = new float[m_capacity];
+		memset(*arrays[i], 0, sizeof(float)*m_capacity);
+	}
+
+	m_active = new bool[m_capacity];
+	memset(m_active, 0, m_capacity);
+	return true;
+}
+
+void particle_pool::destroy() {
+	if (!m_active) { return; }
+
+	float **arrays[particle_float_arrays];
+	_floatarrays(this, arrays);
+	for (uint32_t i = 0; i < particle_float_arrays; i++) { delete [] *arrays[i]; }
+
+	delete [] m_active;
+	m_active   = NULL;
+	m_capacity = 0;
+	m_count    = 0;
+}
+
+uint32_t particle_pool::allocate() {
+	if (m_count >= m_capacity) { application_error("particle_pool full"); return particle_none; }
+	return m_count++;
+}
+
+void particle_pool::setstate(uint32_t particle, const _vec3 &position, const _vec3 &velocity,
+	float mass, float damping, float radius) {
+
+	setposition(particle, position);
+	m_previous_position.m_x[particle] = position.x;
+	m_previous_position.m_y[particle] = position.y;
+	m_previous_position.m_z[particle] = position.z;
+	setvelocity(particle, velocity);
+
+	m_inverse_mass[particle] = (mass != 0) ? 1.0f/mass : 0.0f;
+	m_damping[particle]      = damping;
+	m_radius[particle]       = radius;
+	m_factor_duration        = 0;
+	m_active[particle]       = true;
+}
+
+void particle_pool::deactivate(uint32_t particle) {
+	if (particle < m_count) { m_active[particle] = false; }
+}
+
+_vec3 particle_pool::getposition(uint32_t particle) const {
+	return _vec3(m_position.m_x[particle], m_position.m_y[particle], m_position.m_z[particle]);
+}
+
+void particle_pool::setposition(uint32_t particle, const _vec3 &position) {
+	m_position.m_x[particle] = position.x;
+	m_position.m_y[particle] = position.y;
+	m_position.m_z[particle] = position.z;
+}
+
+_vec3 particle_pool::getpreviousposition(uint32_t particle) const {
+	return _vec3(m_previous_position.m_x[particle], m_previous_position.m_y[particle], m_previous_position.m_z[particle]);
+}
+
+_vec3 particle_pool::getvelocity(uint32_t particle) const {
+	return _vec3(m_velocity.m_x[particle], m_velocity.m_y[particle], m_velocity.m_z[particle]);
+}
+
+void particle_pool::setvelocity(uint32_t particle, const _vec3 &velocity) {
+	m_velocity.m_x[particle] = velocity.x;
+	m_velocity.m_y[particle] = velocity.y;
+	m_velocity.m_z[particle] = velocity.z;
+}
+
+void particle_pool::setacceleration(uint32_t particle, const _vec3 &acceleration) {
+	m_acceleration.m_x[particle] = acceleration.x;
+	m_acceleration.m_y[particle] = acceleration.y;
+	m_acceleration.m_z[particle] = acceleration.z;
+}
+
+_vec3 particle_pool::getinterpolatedposition(uint32_t particle, const float alpha) const {
+	_vec3 previous = getpreviousposition(particle);
+	return previous + (getposition(particle) - previous) * alpha;
+}
+
+void particle_pool::integrate(float duration) {
+
+	// the damping factors only change with the step or the damping.
+	if (duration != m_factor_duration) {
+		for (uint32_t i = 0; i < m_count; i++) { m_damping_factor[i] = pow(m_damping[i], duration); }
+		m_factor_duration = duration;
+	}
+
+	uint32_t i = 0;
+
+#ifdef physics_simd
+	const __m128 dt = _mm_set1_ps(duration);
+
+	for (; i < m_count; i += 4) {
+
+		if (!(m_active[i] | m_active[i+1] | m_active[i+2] | m_active[i+3])) { continue; }
+
+		// the lanes of inactive particles are worked out too, but not stored.
+		const __m128 active = _mm_castsi128_ps(_mm_set_epi32(
+			-int(m_active[i+3]), -int(m_active[i+2]), -int(m_active[i+1]), -int(m_active[i])));
+
+#define particle_load(array)          _mm_loadu_ps((array) + i)
+#define particle_store(array, value)  _mm_storeu_ps((array) + i, _mm_or_ps(_mm_and_ps(active, value), _mm_andnot_ps(active, particle_load(array))))
+
+		__m128 px = particle_load(m_position.m_x);
+		__m128 py = particle_load(m_position.m_y);
+		__m128 pz = particle_load(m_position.m_z);
+		particle_store(m_previous_position.m_x, px);
+		particle_store(m_previous_position.m_y, py);
+		particle_store(m_previous_position.m_z, pz);
+
+		// update the velocity from the acceleration, and impose drag.
+		__m128 factor = particle_load(m_damping_factor);
+		__m128 vx = _mm_mul_ps(_mm_add_ps(particle_load(m_velocity.m_x), _mm_mul_ps(particle_load(m_acceleration.m_x), dt)), factor);
+		__m128 vy = _mm_mul_ps(_mm_add_ps(particle_load(m_velocity.m_y), _mm_mul_ps(particle_load(m_acceleration.m_y), dt)), factor);
+		__m128 vz = _mm_mul_ps(_mm_add_ps(particle_load(m_velocity.m_z), _mm_mul_ps(particle_load(m_acceleration.m_z), dt)), factor);
+		particle_store(m_velocity.m_x, vx);
+		particle_store(m_velocity.m_y, vy);
+		particle_store(m_velocity.m_z, vz);
+
+		// update the position.
+		particle_store(m_position.m_x, _mm_add_ps(px, _mm_mul_ps(vx, dt)));
+		particle_store(m_position.m_y, _mm_add_ps(py, _mm_mul_ps(vy, dt)));
+		particle_store(m_position.m_z, _mm_add_ps(pz, _mm_mul_ps(vz, dt)));
+
+#undef particle_load
+#undef particle_store
+	}
+#endif
+
+	for (; i < m_count; i++) {
+		if (!m_active[i]) { continue; }
+
+		_vec3 position = getposition(i);
+		m_previous_position.m_x[i] = position.x;
+		m_previous_position.m_y[i] = position.y;
+		m_previous_position.m_z[i] = position.z;
+
+		_vec3 velocity = getvelocity(i);
+		velocity.addscaledvector(_vec3(m_acceleration.m_x[i], m_acceleration.m_y[i], m_acceleration.m_z[i]), duration);
+		velocity *= m_damping_factor[i];
+		setvelocity(i, velocity);
+
+		position.addscaledvector(velocity, duration);
+		setposition(i, position);
+	}
+}
+
+void particle_pool::resolve(const particle_contact *contacts, uint32_t count, float restitution) {
+
+	for (const particle_contact *contact_ = contacts; contact_ < contacts+count; contact_++) {
+
+		uint32_t one = contact_->m_particle[0];
+		uint32_t two = contact_->m_particle[1];
+		const _vec3 &normal = contact_->m_contact_normal;
+
+		float inversemassone = m_inverse_mass[one];
+		float inversemasstwo = (two != particle_none) ? m_inverse_mass[two] : 0.0f;
+
+		// a body that can't move is no different from the world
+		rigid_body *body = contact_->m_body;
+		if (body && body->getinversemass() <= 0) { body = NULL; }
+
+		// find the closing velocity, and what a unit impulse along the
+		// normal does to it.
+		_vec3 velocity = getvelocity(one);
+		_vec3 relative;
+		_mat3 inverseinertia;
+		_vec3 torqueperunit;
+		float deltavelocity = inversemassone + inversemasstwo;
+		if (body) {
+			relative = contact_->m_contact_point - body->getposition();
+			velocity -= body->getvelocity() + _cross(body->getrotation(), relative);
+
+			body->getinverseinertiatensorworld(&inverseinertia);
+			torqueperunit = inverseinertia * _cross(relative, normal);
+			deltavelocity += body->getinversemass() + _dot( _cross(torqueperunit, relative), normal );
+		} else if (two != particle_none) {
+			velocity -= getvelocity(two);
+		}
+		if (deltavelocity <= 0) { continue; }
+
+		float separating = _dot(velocity, normal);
+		if (separating < 0) {
+			float impulse = -(1 + restitution) * separating / deltavelocity;
+
+			setvelocity(one, getvelocity(one) + normal * (impulse * inversemassone));
+			if (two != particle_none) { setvelocity(two, getvelocity(two) - normal * (impulse * inversemasstwo)); }
+			if (body) {
+				if (!body->getawake()) { body->setawake(); }
+				body->addvelocity(normal * (-impulse * body->getinversemass()));
+				body->addrotation(torqueperunit * -impulse);
+			}
+		}
+
+		// move the particles apart, the body stays where it is.
+		float totalinversemass = inversemassone + inversemasstwo;
+		if (contact_->m_penetration > 0 && totalinversemass > 0) {
+			_vec3 move = normal * (contact_->m_penetration / totalinversemass);
+			setposition(one, getposition(one) + move * inversemassone);
+			if (two != particle_none) { setposition(two, getposition(two) - move * inversemasstwo); }
+		}
+	}
+}
+
+/*
+ * adds a contact to the array.
+ */
+static inline void _addcontact(
+	_array<particle_contact> *contacts,
+	uint32_t one,
+	uint32_t two,
+	rigid_body *body,
+	const _vec3 &point,
+	const _vec3 &normal,
+	float penetration
+	)
+{
+	particle_contact contact_;
+	contact_.m_particle[0]    = one;
+	contact_.m_particle[1]    = two;
+	contact_.m_body           = body;
+	contact_.m_contact_point  = point;
+	contact_.m_contact_normal = normal;
+	contact_.m_penetration    = penetration;
+	contacts->pushback(contact_, true);
+}
+
+uint32_t particle_detector::particleandhalfspace(
+	const particle_pool &particles,
+	uint32_t particle,
+	const collision_plane &plane,
+	_array<particle_contact> *contacts
+	)
+{
+	_vec3 position = particles.getposition(particle);
+	float radius = particles.m_radius[particle];
+
+	// find the distance from the plane
+	float balldistance = _dot( plane.m_direction, position ) - radius - plane.m_offset;
+	if (balldistance >= 0) { return 0; }
+
+	_addcontact(contacts, particle, particle_none, NULL,
+		position - plane.m_direction * (balldistance + radius), plane.m_direction, -balldistance);
+	return 1;
+}
+
+uint32_t particle_detector::particlesandhalfspaces(
+	const particle_pool &particles,
+	const plane_set &planes,
+	uint32_t *hits,
+	_array<particle_contact> *contacts
+	)
+{
+	uint32_t planecount = planes.count();
+	uint32_t used = 0;
+	uint32_t i = 0;
+
+#ifdef physics_simd
+	// four particles at a time, straight from the pool's arrays,
+	// against each plane in turn. a particle keeps the first plane it
+	// goes through.
+	for (; i < particles.m_count; i += 4) {
+
+		hits[i] = hits[i+1] = hits[i+2] = hits[i+3] = plane_set_none;
+
+		uint32_t active = (particles.m_active[i]   ? 1 : 0) | (particles.m_active[i+1] ? 2 : 0) |
+		                  (particles.m_active[i+2] ? 4 : 0) | (particles.m_active[i+3] ? 8 : 0);
+		if (!active) { continue; }
+
+		__m128 x = _mm_loadu_ps(particles.m_position.m_x + i);
+		__m128 y = _mm_loadu_ps(particles.m_position.m_y + i);
+		__m128 z = _mm_loadu_ps(particles.m_position.m_z + i);
+		__m128 radius = _mm_loadu_ps(particles.m_radius + i);
+
+		float distance[4];
+		uint32_t found = 0;
+		for (uint32_t p = 0; p < planecount && found != active; p++) {
+			__m128 balldistance = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_set1_ps(planes.m_x[p]), x),
+				_mm_mul_ps(_mm_set1_ps(planes.m_y[p]), y)),
+				_mm_mul_ps(_mm_set1_ps(planes.m_z[p]), z)),
+				radius),
+				_mm_set1_ps(planes.m_offset[p]));
+
+			uint32_t inside = uint32_t(_mm_movemask_ps(_mm_cmplt_ps(balldistance, _mm_setzero_ps()))) & active & ~found;
+			if (!inside) { continue; }
+
+			float lanes[4];
+			_mm_storeu_ps(lanes, balldistance);
+			for (uint32_t lane = 0; lane < 4; lane++) {
+				if (inside & (1 << lane)) {
+					hits[i+lane]   = p;
+					distance[lane] = lanes[lane];
+				}
+			}
+			found |= inside;
+		}
+
+		for (uint32_t lane = 0; lane < 4; lane++) {
+			if (found & (1 << lane)) {
+				uint32_t p = hits[i+lane];
+				_vec3 direction(planes.m_x[p], planes.m_y[p], planes.m_z[p]);
+				_addcontact(contacts, i+lane, particle_none, NULL,
+					particles.getposition(i+lane) - direction * (distance[lane] + particles.m_radius[i+lane]),
+					direction, -distance[lane]);
+				used++;
+			}
+		}
+	}
+#endif
+
+	// the rest one at a time
+	for (; i < particles.m_count; i++) {
+		hits[i] = plane_set_none;
+		if (!particles.m_active[i]) { continue; }
+
+		_vec3 position = particles.getposition(i);
+		for (uint32_t p = 0; p < planecount; p++) {
+			float balldistance = planes.m_x[p]*position.x + planes.m_y[p]*position.y + planes.m_z[p]*position.z
+				- particles.m_radius[i] - planes.m_offset[p];
+			if (balldistance < 0) {
+				_vec3 direction(planes.m_x[p], planes.m_y[p], planes.m_z[p]);
+				hits[i] = p;
+				_addcontact(contacts, i, particle_none, NULL,
+					position - direction * (balldistance + particles.m_radius[i]), direction, -balldistance);
+				used++;
+				break;
+			}
+		}
+	}
+	return used;
+}
+
+uint32_t particle_detector::particleandbox(
+	const particle_pool &particles,
+	uint32_t particle,
+	const collision_box &box,
+	_array<particle_contact> *contacts
+	)
+{
+	// transform the particle into box coordinates
+	_vec3 centre = particles.getposition(particle);
+	_vec3 relcentre = box.m_transform.transforminverse(centre);
+	float radius = particles.m_radius[particle];
+
+	// early out check to see if we can exclude the contact
+	if (abs(relcentre.x) - radius > box.m_half_size.x ||
+		abs(relcentre.y) - radius > box.m_half_size.y ||
+		abs(relcentre.z) - radius > box.m_half_size.z)
+	{
+		return 0;
+	}
+
+	// clamp each coordinate to the box.
+	_vec3 closestpt = relcentre;
+	for (uint32_t i = 0; i < 3; i++) {
+		if (closestpt[i] >  box.m_half_size[i]) { closestpt[i] =  box.m_half_size[i]; }
+		if (closestpt[i] < -box.m_half_size[i]) { closestpt[i] = -box.m_half_size[i]; }
+	}
+
+	// check we're in contact
+	float dist = (relcentre - closestpt).squaremagnitude();
+	if (dist > radius * radius) { return 0; }
+
+	// a particle whose centre is inside the box is pushed out through
+	// the nearest face, else it would pass on through a thin box.
+	if (dist <= 0) {
+		uint32_t axis = 0;
+		float depth = box.m_half_size.x - abs(relcentre.x);
+		for (uint32_t i = 1; i < 3; i++) {
+			float facedepth = box.m_half_size[i] - abs(relcentre[i]);
+			if (facedepth < depth) { depth = facedepth; axis = i; }
+		}
+
+		float side = (relcentre[axis] < 0) ? -1.0f : 1.0f;
+		_vec3 facept = relcentre;
+		facept[axis] = box.m_half_size[axis] * side;
+
+		_addcontact(contacts, particle, particle_none, box.m_body, box.m_transform.transform(facept),
+			box.getaxis(axis) * side, radius + depth);
+		return 1;
+	}
+
+	_vec3 closestptworld = box.m_transform.transform(closestpt);
+	_vec3 normal = centre - closestptworld;
+	normal.normalise();
+
+	_addcontact(contacts, particle, particle_none, box.m_body, closestptworld, normal, radius - sqrt(dist));
+	return 1;
+}
+
+uint32_t particle_detector::particleandparticle(
+	const particle_pool &particles,
+	uint32_t one,
+	uint32_t two,
+	_array<particle_contact> *contacts
+	)
+{
+	// find the vector between the particles
+	_vec3 positionone = particles.getposition(one);
+	_vec3 midline = positionone - particles.getposition(two);
+	float size = midline.magnitude();
+
+	// see if it is large enough.
+	float radii = particles.m_radius[one] + particles.m_radius[two];
+	if (size <= 0.0f || size >= radii) { return 0; }
+
+	_vec3 normal = midline * (1.0f/size);
+	_addcontact(contacts, one, two, NULL, positionone - midline * 0.5f, normal, radii - size);
+	return 1;
+}
+
+/*
+ * finds the direction and length of the last step of a particle.
+ */
+static inline bool _particlestep(
+	const particle_pool &particles,
+	uint32_t particle,
+	_vec3 *start,
+	_vec3 *direction,
+	float *length
+	)
+{
+	*start = particles.getpreviousposition(particle);
+	*direction = particles.getposition(particle) - *start;
+	*length = direction->magnitude();
+	if (*length <= 0) { return false; }
+
+	*direction *= 1.0f / *length;
+	return true;
+}
+
+bool particle_detector::sweptparticleandhalfspace(
+	const particle_pool &particles,
+	uint32_t particle,
+	const collision_plane &plane,
+	float *time,
+	_vec3 *normal
+	)
+{
+	_vec3 start, direction;
+	float length, distance;
+	if (!_particlestep(particles, particle, &start, &direction, &length)) { return false; }
+	if (!intersection_tests::rayandhalfspace(plane, start, direction, particles.m_radius[particle], length, &distance, normal)) { return false; }
+
+	*time = distance / length;
+	return true;
+}
+
+bool particle_detector::sweptparticleandbox(
+	const particle_pool &particles,
+	uint32_t particle,
+	const collision_box &box,
+	float *time,
+	_vec3 *normal
+	)
+{
+	_vec3 start, direction;
+	float length, distance;
+	if (!_particlestep(particles, particle, &start, &direction, &length)) { return false; }
+	if (!intersection_tests::rayandbox(box, start, direction, particles.m_radius[particle], length, &distance, normal)) { return false; }
+
+	*time = distance / length;
+	return true;
+}
+
+uint32_t particle_detector::sweptcontact(
+	particle_pool *particles,
+	uint32_t particle,
+	rigid_body *body,
+	float time,
+	const _vec3 &normal,
+	_array<particle_contact> *contacts
+	)
+{
+	_vec3 start = particles->getpreviousposition(particle);
+	_vec3 position = start + (particles->getposition(particle) - start) * time;
+	particles->setposition(particle, position);
+
+	_addcontact(contacts, particle, particle_none, body,
+		position - normal * particles->m_radius[particle], normal, 0);
+	return 1;
+}
@@ -0,0 +1,259 @@
+#pragma once
+
+/**
+* this file contains a lighter simulation path for small, fast
+* objects, such as rounds, that never need to turn. a particle has a
+* position, a velocity, a mass, damping and a radius, but no
+* orientation or inertia tensor, so it is much cheaper to store and
+* to integrate than a rigid body.
+*
+* particles are kept in a particle_pool as a structure of arrays,
+* and integrated together. they collide with boxes, planes and each
+* other through the particle_detector below, and the contacts found
+* are resolved by the pool with a single impulse each.
+*/
+
+#include "collide_fine.h"
+
+/** the index given when there is no particle. */
+#define particle_none 0xffffffff
+
+/**
+* a contact between a particle and a rigid body, another particle,
+* or the world when it has neither.
+*/
+struct particle_contact {
+
+	/**
+	* holds the particles in contact. the second is particle_none
+	* when the particle touches a body or the world.
+	*/
+	uint32_t m_particle[2];
+
+	/**
+	* holds the body the first particle touches, or NULL.
+	*/
+	rigid_body *m_body;
+
+	/**
+	* holds the position of the contact in world coordinates.
+	*/
+	_vec3 m_contact_point;
+
+	/**
+	* holds the direction of the contact in world coordinates,
+	* pointing towards the first particle.
+	*/
+	_vec3 m_contact_normal;
+
+	/**
+	* holds the depth of penetration at the contact point.
+	*/
+	float m_penetration;
+};
+
+/**
+* holds a set of particles, with one array per value, so the
+* integrator and the plane tests can work on four at a time.
+*
+* the pool is given its capacity once, by create, and the index of
+* a particle stays the same until the pool is destroyed.
+*/
+struct particle_pool {
+
+	particle_pool();
+	~particle_pool();
+
+	/**
+	* the number of particles the arrays have room for, a multiple of
+	* four so the sse loops never run off their end.
+	*/
+	uint32_t m_capacity;
+
+	/** the number of particles handed out. */
+	uint32_t m_count;
+
+	/**
+	* set for the particles being simulated. the others are left
+	* where they are by the integrator, and skipped by the plane tests.
+	*/
+	bool *m_active;
+
+	/** holds the position of each particle in world space. */
+	soa_vec3 m_position;
+
+	/**
+	* holds the position of each particle at the start of the last
+	* integration step.
+	*/
+	soa_vec3 m_previous_position;
+
+	/** holds the velocity of each particle in world space. */
+	soa_vec3 m_velocity;
+
+	/** holds the constant acceleration of each particle, such as gravity. */
+	soa_vec3 m_acceleration;
+
+	/**
+	* holds the inverse of the mass of each particle. zero is an
+	* immovable particle.
+	*/
+	float *m_inverse_mass;
+
+	/** holds the damping applied to the velocity of each particle. */
+	float *m_damping;
+
+	/**
+	* holds the damping of each particle raised to the power of the
+	* duration last integrated over, worked out again when the
+	* duration changes or m_factor_duration is cleared.
+	*/
+	float *m_damping_factor;
+	float m_factor_duration;
+
+	/** holds the radius each particle collides with. */
+	float *m_radius;
+
+	/**
+	* makes room for the given number of particles, releasing any
+	* held before.
+	*/
+	bool create(uint32_t capacity);
+
+	/** frees the arrays. */
+	void destroy();
+
+	/**
+	* hands out the next particle and returns its index, or
+	* particle_none if the pool is full. it starts inactive, at rest
+	* at the origin.
+	*/
+	uint32_t allocate();
+
+	/**
+	* sets a particle moving from the given position, with the given
+	* velocity. the particle is made active.
+	*/
+	void setstate(uint32_t particle, const _vec3 &position, const _vec3 &velocity,
+		float mass, float damping, float radius);
+
+	/**
+	* stops simulating a particle, leaving it where it is. setstate
+	* makes it active again.
+	*/
+	void deactivate(uint32_t particle);
+
+	_vec3 getposition(uint32_t particle) const;
+	void setposition(uint32_t particle, const _vec3 &position);
+
+	_vec3 getpreviousposition(uint32_t particle) const;
+
+	_vec3 getvelocity(uint32_t particle) const;
+	void setvelocity(uint32_t particle, const _vec3 &velocity);
+
+	void setacceleration(uint32_t particle, const _vec3 &acceleration);
+
+	/**
+	* gets the position of the particle the given fraction of the way
+	* from the start of the last integration step to now.
+	*/
+	_vec3 getinterpolatedposition(uint32_t particle, const float alpha) const;
+
+	/**
+	* integrates every active particle forward in time by the given
+	* amount, with the same newton-euler step as the rigid bodies.
+	* the position before the step is kept as the previous position.
+	*/
+	void integrate(float duration);
+
+	/**
+	* resolves the given contacts one at a time, with an impulse that
+	* takes out the closing velocity along the normal, scaled by the
+	* restitution, and by moving the particles out of the penetration.
+	* bodies take their share of the impulse, and are woken up, but
+	* are left where they are.
+	*/
+	void resolve(const particle_contact *contacts, uint32_t count, float restitution);
+};
+
+/**
+* a wrapper class that holds the collision tests for particles.
+*
+* each test takes the pool and the index of the particle, and adds
+* the contacts it finds to the given array, returning their number.
+*/
+struct particle_detector {
+
+	static uint32_t particleandhalfspace(
+		const particle_pool &particles,
+		uint32_t particle,
+		const collision_plane &plane,
+		_array<particle_contact> *contacts
+		);
+
+	/**
+	* tests every active particle of the pool against every plane of
+	* the set, four particles at a time on sse. each particle gets at
+	* most one contact, with the first plane of the set it goes
+	* through. the index of that plane, or plane_set_none, is written
+	* into hits for each particle, which must have room for the
+	* capacity of the pool.
+	*/
+	static uint32_t particlesandhalfspaces(
+		const particle_pool &particles,
+		const plane_set &planes,
+		uint32_t *hits,
+		_array<particle_contact> *contacts
+		);
+
+	static uint32_t particleandbox(
+		const particle_pool &particles,
+		uint32_t particle,
+		const collision_box &box,
+		_array<particle_contact> *contacts
+		);
+
+	static uint32_t particleandparticle(
+		const particle_pool &particles,
+		uint32_t one,
+		uint32_t two,
+		_array<particle_contact> *contacts
+		);
+
+	/**
+	* the swept tests find the first time the particle touches the
+	* other object on its way from its previous position to where it
+	* is now, from 0 at the start to 1 at the end, and the normal of
+	* the surface touched. they return false if it is missed, or
+	* touched at the start already.
+	*/
+	static bool sweptparticleandhalfspace(
+		const particle_pool &particles,
+		uint32_t particle,
+		const collision_plane &plane,
+		float *time,
+		_vec3 *normal
+		);
+
+	static bool sweptparticleandbox(
+		const particle_pool &particles,
+		uint32_t particle,
+		const collision_box &box,
+		float *time,
+		_vec3 *normal
+		);
+
+	/**
+	* moves the particle back to where a swept test found it touching
+	* the given body, or the world if it is NULL, and adds the contact
+	* there, with no penetration.
+	*/
+	static uint32_t sweptcontact(
+		particle_pool *particles,
+		uint32_t particle,
+		rigid_body *body,
+		float time,
+		const _vec3 &normal,
+		_array<particle_contact> *contacts
+		);
+};
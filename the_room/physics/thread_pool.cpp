@@ -0,0 +1,222 @@
+#include "thread_pool.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+/* platform wrappers ******************************************************/
+#ifdef _WIN32
+static void mutexinit(pool_mutex *m)    { InitializeCriticalSection(m); }
+static void mutexdestroy(pool_mutex *m) { DeleteCriticalSection(m); }
+static void mutexlock(pool_mutex *m)    { EnterCriticalSection(m); }
+static void mutexunlock(pool_mutex *m)  { LeaveCriticalSection(m); }
+
+static void conditioninit(pool_condition *c)    { InitializeConditionVariable(c); }
+static void conditiondestroy(pool_condition *c) {}
+static void conditionwait(pool_condition *c, pool_mutex *m) { SleepConditionVariableCS(c, m, INFINITE); }
+static void conditionbroadcast(pool_condition *c) { WakeAllConditionVariable(c); }
+#else
+static void mutexinit(pool_mutex *m)    { pthread_mutex_init(m, NULL); }
+static void mutexdestroy(pool_mutex *m) { pthread_mutex_destroy(m); }
+static void mutexlock(pool_mutex *m)    { pthread_mutex_lock(m); }
+static void mutexunlock(pool_mutex *m)  { pthread_mutex_unlock(m); }
+
+static void conditioninit(pool_condition *c)    { pthread_cond_init(c, NULL); }
+static void conditiondestroy(pool_condition *c) { pthread_cond_destroy(c); }
+static void conditionwait(pool_condition *c, pool_mutex *m) { pthread_cond_wait(c, m); }
+static void conditionbroadcast(pool_condition *c) { pthread_cond_broadcast(c); }
+#endif
+/**************************************************************************/
+
+/* the loop run by each worker thread */
+static void workerloop(pool_worker *worker) {
+
+	thread_pool *pool = worker->m_pool;
+	uint32_t batch = 0;
+
+	mutexlock(&pool->m_lock);
+	for (;;) {
+		while (!pool->m_quit && pool->m_batch == batch) { conditionwait(&pool->m_start, &pool->m_lock); }
+		if (pool->m_quit) { break; }
+
+		// a batch that finished before the worker woke up is skipped,
+		// the queues may already be dealt for the next one.
+		batch = pool->m_batch;
+		if (!pool->m_remaining) { continue; }
+		pool->m_active++;
+		mutexunlock(&pool->m_lock);
+
+		pool->work(worker->m_index);
+
+		mutexlock(&pool->m_lock);
+		if (--pool->m_active == 0) { conditionbroadcast(&pool->m_done); }
+	}
+	mutexunlock(&pool->m_lock);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI workerproc(LPVOID parameter) { workerloop((pool_worker*)parameter); return 0; }
+#else
+static void* workerproc(void *parameter) { workerloop((pool_worker*)parameter); return NULL; }
+#endif
+
+thread_pool::thread_pool() {
+	m_thread_count = 1;
+	m_steal_count  = 0;
+	m_batch        = 0;
+	m_remaining    = 0;
+	m_active       = 0;
+	m_quit         = false;
+	m_function     = NULL;
+	m_data         = NULL;
+
+	mutexinit(&m_lock);
+	conditioninit(&m_start);
+	conditioninit(&m_done);
+	for (uint32_t i = 0; i < pool_max_threads; i++) {
+		mutexinit(&m_queues[i].m_lock);
+		m_queues[i].m_head = m_queues[i].m_tail = 0;
+	}
+}
+
+thread_pool::~thread_pool() {
+	destroy();
+
+	for (uint32_t i = 0; i < pool_max_threads; i++) { mutexdestroy(&m_queues[i].m_lock); }
+	conditiondestroy(&m_done);
+	conditiondestroy(&m_start);
+	mutexdestroy(&m_lock);
+}
+
+bool thread_pool::create(uint32_t threads) {
+	destroy();
+
+	if (threads < 1) { threads = 1; }
+	if (threads > pool_max_threads) { threads = pool_max_threads; }
+
+	m_quit = false;
+	for (uint32_t i = 1; i < threads; i++) {
+		m_workers[i].m_pool  = this;
+		m_workers[i].m_index = i;
+
+#ifdef _WIN32
+		m_threads[i] = CreateThread(NULL, 0, workerproc, &m_workers[i], 0, NULL);
+		bool started = (m_threads[i] != NULL);
+#else
+		bool started = (pthread_create(&m_threads[i], NULL, workerproc, &m_workers[i]) == 0);
+#endif
+		if (!started) {
+			m_thread_count = i;
+			destroy();
+			application_throw("thread_pool create");
+		}
+		m_thread_count = i+1;
+	}
+	return true;
+}
+
+void thread_pool::destroy() {
+	if (m_thread_count <= 1) { return; }
+
+	mutexlock(&m_lock);
+	m_quit = true;
+	conditionbroadcast(&m_start);
+	mutexunlock(&m_lock);
+
+	for (uint32_t i = 1; i < m_thread_count; i++) {
+#ifdef _WIN32
+		WaitForSingleObject(m_threads[i], INFINITE);
+		CloseHandle(m_threads[i]);
+#else
+		pthread_join(m_threads[i], NULL);
+#endif
+	}
+	m_thread_count = 1;
+	m_quit = false;
+}
+
+void thread_pool::run(pool_job function, void *data, uint32_t count) {
+
+	m_steal_count = 0;
+	if (!count) { return; }
+
+	// with no workers there is nothing to schedule.
+	if (m_thread_count == 1 || count == 1) {
+		for (uint32_t i = 0; i < count; i++) { function(data, i); }
+		return;
+	}
+
+	// deal the jobs out in contiguous blocks, so neighbouring jobs
+	// start on the same thread; stealing evens out the rest.
+	for (uint32_t t = 0; t < m_thread_count; t++) {
+		pool_queue &queue = m_queues[t];
+		uint32_t first = (count * t) / m_thread_count;
+		uint32_t last  = (count * (t+1)) / m_thread_count;
+
+		queue.m_jobs.alloc(last - first + 1);
+		queue.m_head = 0;
+		queue.m_tail = last - first;
+		for (uint32_t i = first; i < last; i++) { queue.m_jobs[i - first] = i; }
+	}
+
+	mutexlock(&m_lock);
+	m_function  = function;
+	m_data      = data;
+	m_remaining = count;
+	m_batch++;
+	conditionbroadcast(&m_start);
+	mutexunlock(&m_lock);
+
+	work(0);
+
+	// wait for the last jobs, and for every worker to leave the batch
+	// so none of them can touch the queues while the next is dealt.
+	mutexlock(&m_lock);
+	while (m_remaining || m_active) { conditionwait(&m_done, &m_lock); }
+	mutexunlock(&m_lock);
+}
+
+void thread_pool::work(uint32_t index) {
+
+	for (;;) {
+		uint32_t job   = 0;
+		bool     found = false;
+
+		// take the newest job of our own queue
+		pool_queue &own = m_queues[index];
+		mutexlock(&own.m_lock);
+		if (own.m_head < own.m_tail) { job = own.m_jobs[--own.m_tail]; found = true; }
+		mutexunlock(&own.m_lock);
+
+		// otherwise steal the oldest job of another thread's queue
+		for (uint32_t i = 1; !found && i < m_thread_count; i++) {
+			pool_queue &other = m_queues[(index + i) % m_thread_count];
+			mutexlock(&other.m_lock);
+			if (other.m_head < other.m_tail) { job = other.m_jobs[other.m_head++]; found = true; }
+			mutexunlock(&other.m_lock);
+			if (found) {
+				mutexlock(&m_lock);
+				m_steal_count++;
+				mutexunlock(&m_lock);
+			}
+		}
+		if (!found) { return; }
+
+		m_function(m_data, job);
+
+		mutexlock(&m_lock);
+		if (--m_remaining == 0) { conditionbroadcast(&m_done); }
+		mutexunlock(&m_lock);
+	}
+}
+
+uint32_t thread_pool::hardwarethreads() {
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	uint32_t count = info.dwNumberOfProcessors;
+#else
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	return (count > 0) ? uint32_t(count) : 1;
+}
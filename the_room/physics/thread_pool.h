@@ -0,0 +1,145 @@
+#pragma once
+
+/**
+* this file contains a small work-stealing thread pool used to
+* spread independent pieces of the simulation, such as contact
+* islands, over the available cores.
+*
+* the pool runs batches of jobs: every job of a batch calls the same
+* function with its own index. the calling thread takes part in the
+* batch, and the call returns once every job has finished.
+*/
+
+#include "core.h"
+
+#ifdef _WIN32
+#include <windows.h>
+typedef CRITICAL_SECTION   pool_mutex;
+typedef CONDITION_VARIABLE pool_condition;
+typedef HANDLE             pool_thread;
+#else
+#include <pthread.h>
+typedef pthread_mutex_t    pool_mutex;
+typedef pthread_cond_t     pool_condition;
+typedef pthread_t          pool_thread;
+#endif
+
+#define pool_max_threads 16
+
+/**
+* the function called for each job of a batch. data is the pointer
+* given to thread_pool::run, and index the index of the job.
+*/
+typedef void (*pool_job)(void *data, uint32_t index);
+
+/**
+* the jobs waiting to be run by one thread. the owner takes jobs
+* from the back, other threads steal from the front.
+*/
+struct pool_queue {
+
+	/** guards the queue. */
+	pool_mutex m_lock;
+
+	/** holds the indices of the jobs. */
+	_array<uint32_t> m_jobs;
+
+	/** the first job that has not been taken. */
+	uint32_t m_head;
+
+	/** one past the last job that has not been taken. */
+	uint32_t m_tail;
+};
+
+struct thread_pool;
+
+/**
+* what each worker thread is given when it starts.
+*/
+struct pool_worker {
+
+	/** the pool the worker belongs to. */
+	thread_pool * m_pool;
+
+	/** the index of the worker's queue. */
+	uint32_t m_index;
+};
+
+struct thread_pool {
+
+	thread_pool();
+	~thread_pool();
+
+	/**
+	* the number of threads that run jobs, counting the calling thread.
+	* a pool with one thread runs every job on the calling thread.
+	*/
+	uint32_t m_thread_count;
+
+	/** the number of jobs taken from another thread's queue in the last batch. */
+	uint32_t m_steal_count;
+
+	/** holds one queue per thread, the calling thread uses the first. */
+	pool_queue m_queues[pool_max_threads];
+
+	/** holds the worker threads. */
+	pool_thread m_threads[pool_max_threads];
+
+	/** holds what each worker thread was started with. */
+	pool_worker m_workers[pool_max_threads];
+
+	/** guards the batch state below. */
+	pool_mutex m_lock;
+
+	/** signalled when a batch starts, or the pool is shutting down. */
+	pool_condition m_start;
+
+	/** signalled when the last job of a batch finishes. */
+	pool_condition m_done;
+
+	/** counts the batches run, so workers can tell a new batch has started. */
+	uint32_t m_batch;
+
+	/** the number of jobs of the current batch that have not finished. */
+	uint32_t m_remaining;
+
+	/** the number of worker threads still working on the current batch. */
+	uint32_t m_active;
+
+	/** set when the worker threads should exit. */
+	bool m_quit;
+
+	/** the function and data of the current batch. */
+	pool_job m_function;
+	void *   m_data;
+
+	/**
+	* starts the given number of threads, counting the calling thread.
+	* any threads already running are stopped first. returns false if
+	* the threads could not be started.
+	*/
+	bool create(uint32_t threads);
+
+	/**
+	* stops the worker threads. jobs are then run on the calling thread.
+	*/
+	void destroy();
+
+	/**
+	* runs the jobs 0 to count-1 and returns when they have all finished.
+	* jobs may run in any order and on any thread, so they must not
+	* depend on each other.
+	*/
+	void run(pool_job function, void *data, uint32_t count);
+
+	/**
+	* runs jobs from the given queue, stealing from the others once it
+	* is empty, until no jobs are left.
+	*/
+	void work(uint32_t queue);
+
+	/**
+	* returns the number of hardware threads of the machine.
+	*/
+	static uint32_t hardwarethreads();
+};
@@ -0,0 +1,327 @@
+#include "world.h"
+
+physics_world::physics_world() : m_resolver(world_resolver_iterations, 0.02f, 0.02f) {
+	m_friction    = world_default_friction;
+	m_restitution = world_default_restitution;
+	m_pair_tests  = 0;
+	m_round_collisions = false;
+	m_tunnel_count     = 0;
+	m_resolver.m_pool = &m_pool;
+}
+
+physics_world::~physics_world() { destroy(); }
+
+bool physics_world::create(uint32_t box_capacity, uint32_t contact_capacity, uint32_t contact_limit, uint32_t threads,
+	uint32_t round_capacity) {
+	destroy();
+
+	if (!m_bodies.create(box_capacity)) { return false; }
+	if (!m_cdata.create(contact_capacity, contact_limit)) { return false; }
+	if (!m_pool.create(threads)) { return false; }
+	m_boxes.alloc(box_capacity);
+	m_box_proxies.alloc(box_capacity);
+
+	// each round keeps the same particle for as long as the world lasts
+	if (round_capacity) {
+		if (!m_particles.create(round_capacity)) { return false; }
+		m_rounds.alloc(round_capacity);
+		for (uint32_t i = 0; i < m_rounds.m_size; i++) { m_rounds[i].m_particle = m_particles.allocate(); }
+		m_round_planes.alloc(m_particles.m_capacity);
+	}
+	return true;
+}
+
+void physics_world::destroy() {
+	m_pool.destroy();
+	m_broadphase.clear();
+	m_boxes.clear();
+	m_box_proxies.clear();
+	m_rounds.clear();
+	m_particles.destroy();
+	m_particle_contacts.clear();
+	m_round_planes.clear();
+	m_round_hash.clear();
+	m_planes.clear();
+	m_plane_set.clear();
+	m_cdata.destroy();
+	m_bodies.destroy();
+	m_pair_tests   = 0;
+	m_tunnel_count = 0;
+}
+
+collision_box* physics_world::createbox() {
+	if (m_boxes.m_count >= m_boxes.m_size) { return NULL; }
+
+	rigid_body *body = m_bodies.allocate();
+	if (!body) { return NULL; }
+
+	collision_box *box = &m_boxes[m_boxes.m_count++];
+	*box = collision_box();
+	box->m_body = body;
+	m_box_proxies.pushback(aabb_null_node, true);
+	return box;
+}
+
+uint32_t physics_world::addbox(collision_box *box) {
+	box->calculateinternals();
+	uint32_t proxy = m_broadphase.insert(box, primitive_box);
+	m_box_proxies[ boxindex(box) ] = proxy;
+	return proxy;
+}
+
+void physics_world::addplane(const _vec3 &direction, float offset) {
+	collision_plane plane;
+	plane.m_direction = direction;
+	plane.m_offset    = offset;
+	m_planes.pushback(plane, true);
+	m_plane_set.add(plane);
+}
+
+uint32_t physics_world::fireround(const _vec3 &position, const _vec3 &velocity, float mass, float radius,
+	bool continuous, uint32_t category, uint32_t mask) {
+
+	uint32_t slot = m_rounds.acquire();
+	if (slot >= m_rounds.m_size) { return slot; }
+
+	physics_round &round = m_rounds[slot];
+	round.m_radius     = radius;
+	round.m_continuous = continuous;
+	round.m_category   = category;
+	round.m_mask       = mask;
+	round.m_age        = 0.0f;
+	m_particles.setstate(round.m_particle, position, velocity, mass, 0.99f, radius);
+	m_particles.setacceleration(round.m_particle, _vec3(0.0f, 0.0f, 0.0f));
+	round.m_transform = _aff( _translate(position) );
+	return slot;
+}
+
+void physics_world::releaseround(physics_round *round) {
+	if (m_rounds.release( m_rounds.slot(round) )) { m_particles.deactivate(round->m_particle); }
+}
+
+void physics_world::integrate(float duration) {
+
+	for (uint32_t i = 0; i < m_boxes.m_count; i++) { m_boxes[i].m_body->storeprevious(); }
+
+	// run the physics of every round, and every awake box, at once.
+	// the particles keep their own previous positions.
+	m_particles.integrate(duration);
+	m_bodies.integrate(duration);
+
+	// the sleeping boxes haven't moved
+	for (uint32_t i = 0; i < m_boxes.m_count; i++) {
+		if (m_boxes[i].m_body->getawake()) { m_boxes[i].calculateinternals(); }
+	}
+
+	// the live rounds are walked backwards, as releasing one moves the
+	// last into its place.
+	for (uint32_t i = m_rounds.m_count; i-- > 0; ) {
+		physics_round *round = &m_rounds.active(i);
+		round->m_transform = _aff( _translate( m_particles.getposition(round->m_particle) ) );
+		round->m_age += duration;
+		if (round->m_age > world_round_lifetime) { releaseround(round); }
+	}
+}
+
+void physics_world::generatecontacts() {
+
+	// the contacts grow as far as the limit, past that each test
+	// drops what it finds and counts it as overflow, so every pair is
+	// still tested and the overflow shows how much was lost.
+	m_cdata.reset();
+	m_cdata.m_friction    = m_friction;
+	m_cdata.m_restitution = m_restitution;
+
+	// the boxes' bounds are brought up to date first
+	m_broadphase.refit();
+	m_pair_tests = 0;
+
+	// a sleeping box stays where the planes last held it, and a
+	// trigger is never pushed out of them.
+	for (uint32_t i = 0; i < m_boxes.m_count; i++) {
+		collision_box *box = &m_boxes[i];
+		if (!box->m_body->getawake() || box->m_trigger) { continue; }
+
+		for (uint32_t j = 0; j < m_planes.m_count; j++) {
+			collision_detector::boxandhalfspace(*box, m_planes[j], &m_cdata);
+		}
+	}
+
+	// find the pairs of boxes whose bounds overlap, only these are
+	// passed to the fine grained collision detection. pairs of sleeping
+	// boxes are left out.
+	m_broadphase.findpairs();
+
+	for (uint32_t i = 0; i < m_broadphase.m_pair_count; i++) {
+
+		potential_contact &pair = m_broadphase.m_pairs[i];
+		collision_box *one = (collision_box*)pair.m_primitive[0];
+		collision_box *two = (collision_box*)pair.m_primitive[1];
+		m_pair_tests++;
+
+		// a trigger only reports that it is overlapped, it never pushes back
+		if (one->m_trigger || two->m_trigger) {
+			if (intersection_tests::boxandbox(*one, *two)) { m_cdata.addoverlap(one, two); }
+			continue;
+		}
+
+		collision_detector::boxandbox(*one, *two, &m_cdata);
+	}
+
+	generateroundcontacts();
+}
+
+void physics_world::generateroundcontacts() {
+
+	// rounds are filed in the spatial hash as they are checked against
+	// the planes, so they can be found quickly by the boxes and by
+	// each other.
+	m_round_hash.clear();
+	m_particle_contacts.m_count = 0;
+	if (!m_rounds.m_count) { return; }
+
+	for (uint32_t i = m_rounds.m_count; i-- > 0; ) {
+		physics_round *round = &m_rounds.active(i);
+		if (round->m_continuous) { sweepround(round); }
+		else if (roundtunnelled(round)) { m_tunnel_count++; }
+	}
+
+	// all the rounds are tested against the planes in one pass,
+	// straight from the particle arrays.
+	particle_detector::particlesandhalfspaces(m_particles, m_plane_set, m_round_planes.m_data, &m_particle_contacts);
+	for (uint32_t i = m_rounds.m_count; i-- > 0; ) {
+		physics_round *round = &m_rounds.active(i);
+		if (m_round_planes[round->m_particle] != plane_set_none) { releaseround(round); }
+		else { m_round_hash.insert(round, primitive_sphere); }
+	}
+	m_round_hash.build();
+
+	// check for collisions between each box and the rounds near it
+	for (uint32_t b = 0; b < m_boxes.m_count; b++) {
+		collision_box *box = &m_boxes[b];
+		if (m_box_proxies[b] == aabb_null_node) { continue; }
+
+		m_round_hash.query(m_broadphase.getproxy(m_box_proxies[b]).m_bounds, &m_round_results);
+		for (uint32_t i = 0; i < m_round_results.m_count; i++) {
+
+			// the round may already have hit something this step
+			physics_round *round = (physics_round*)m_round_hash.m_items[ m_round_results[i] ].m_primitive;
+			if (!m_rounds.inuse( m_rounds.slot(round) ) || !round->collideswith(*box)) { continue; }
+			m_pair_tests++;
+
+			// a round flies on through a trigger
+			if (box->m_trigger) {
+				if (intersection_tests::boxandsphere(*box, *round)) { m_cdata.addoverlap(box, round); }
+				continue;
+			}
+
+			// a round that hits is used up
+			if (particle_detector::particleandbox(m_particles, round->m_particle, *box, &m_particle_contacts)) {
+				releaseround(round);
+			}
+		}
+	}
+
+	// check for collisions between rounds, the hash leaves out the
+	// pairs their masks reject, but there is no need to look at all
+	// while none of them collide.
+	if (m_round_collisions) {
+
+		uint32_t count = m_round_hash.findpairs(&m_round_pairs);
+		for (uint32_t i = 0; i < count; i++) {
+
+			physics_round *one = (physics_round*)m_round_pairs[i].m_primitive[0];
+			physics_round *two = (physics_round*)m_round_pairs[i].m_primitive[1];
+			if (!m_rounds.inuse( m_rounds.slot(one) ) || !m_rounds.inuse( m_rounds.slot(two) )) { continue; }
+			m_pair_tests++;
+
+			particle_detector::particleandparticle(m_particles, one->m_particle, two->m_particle, &m_particle_contacts);
+		}
+	}
+}
+
+bool physics_world::sweepround(physics_round *round) {
+
+	uint32_t particle = round->m_particle;
+	_vec3 start = m_particles.getpreviousposition(particle);
+	float earliest = 2.0f;
+	float time;
+	_vec3 normal, earliestnormal;
+	bool hit = false;
+	collision_box *target = NULL;
+
+	for (uint32_t i = 0; i < m_planes.m_count; i++) {
+		if (particle_detector::sweptparticleandhalfspace(m_particles, particle, m_planes[i], &time, &normal) && time < earliest) {
+			earliest = time;
+			earliestnormal = normal;
+			hit = true;
+		}
+	}
+
+	// only the boxes near the path of the round are swept against
+	_vec3 radius(round->m_radius, round->m_radius, round->m_radius);
+	bounding_box bounds = bounding_box::fromsphere(*round).merge( bounding_box(start - radius, start + radius) );
+	m_broadphase.query(bounds, &m_round_results);
+	for (uint32_t i = 0; i < m_round_results.m_count; i++) {
+		collision_box *box = (collision_box*)m_broadphase.getproxy( m_round_results[i] ).m_primitive;
+		if (box->m_trigger || !round->collideswith(*box)) { continue; }
+		m_pair_tests++;
+		if (particle_detector::sweptparticleandbox(m_particles, particle, *box, &time, &normal) && time < earliest) {
+			earliest = time;
+			earliestnormal = normal;
+			target = box;
+			hit = true;
+		}
+	}
+
+	// a round flies on through a trigger, which reports each it
+	// reaches before the round stops. one the round ends inside is
+	// left to generateroundcontacts, unless the round stops here.
+	for (uint32_t i = 0; i < m_round_results.m_count; i++) {
+		collision_box *box = (collision_box*)m_broadphase.getproxy( m_round_results[i] ).m_primitive;
+		if (!box->m_trigger || !round->collideswith(*box)) { continue; }
+		m_pair_tests++;
+		if (!hit && intersection_tests::boxandsphere(*box, *round)) { continue; }
+		if (particle_detector::sweptparticleandbox(m_particles, particle, *box, &time, &normal) && time <= earliest) {
+			m_cdata.addoverlap(box, round);
+		}
+	}
+	if (!hit) { return false; }
+
+	// the round is moved back to where it hit, the contact is relative to it
+	particle_detector::sweptcontact(&m_particles, particle, target ? target->m_body : NULL, earliest, earliestnormal, &m_particle_contacts);
+	round->m_transform = _aff( _translate( m_particles.getposition(particle) ) );
+	releaseround(round);
+	return true;
+}
+
+bool physics_world::roundtunnelled(physics_round *round) {
+
+	_vec3 start = m_particles.getpreviousposition(round->m_particle);
+	_vec3 radius(round->m_radius, round->m_radius, round->m_radius);
+	bounding_box bounds = bounding_box::fromsphere(*round).merge( bounding_box(start - radius, start + radius) );
+	m_broadphase.query(bounds, &m_round_results);
+
+	// a round may pass through a trigger, or a box its mask leaves out
+	float time;
+	for (uint32_t i = 0; i < m_round_results.m_count; i++) {
+		collision_box *box = (collision_box*)m_broadphase.getproxy( m_round_results[i] ).m_primitive;
+		if (box->m_trigger || !round->collideswith(*box)) { continue; }
+		if (intersection_tests::sweptsphereandbox(*box, *round, start, &time) &&
+			!intersection_tests::boxandsphere(*box, *round)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void physics_world::resolvecontacts(float duration) {
+	m_particles.resolve(m_particle_contacts.m_data, m_particle_contacts.m_count, m_cdata.m_restitution);
+	m_resolver.resolvecontacts(m_cdata.m_contact_array, m_cdata.m_contact_count, duration);
+}
+
+void physics_world::step(float duration) {
+	integrate(duration);
+	generatecontacts();
+	resolvecontacts(duration);
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+/**
+* this file contains a world that runs the simulation on its own: it
+* owns the bodies, the boxes they move, the rounds and their
+* particles, the static planes, the contacts and the resolver, and
+* advances them all with step. it needs nothing of windows or
+* direct3d, so it can be built and run from the command line.
+*
+* step is the three calls integrate, generatecontacts and
+* resolvecontacts in turn. a caller that wants to time or look at
+* the stages makes the calls itself.
+*/
+
+#include "collide_coarse.h"
+#include "contacts.h"
+#include "particle.h"
+#include "thread_pool.h"
+
+/** the friction and restitution given to the contacts by default. */
+#define world_default_friction    0.4f
+#define world_default_restitution 1.0f
+
+/** the iterations the resolver is given for each stage. */
+#define world_resolver_iterations 2048
+
+/** how long a round flies before it is released, in seconds. */
+#define world_round_lifetime 5.0f
+
+/**
+* a small, fast sphere, such as a shot, moved by a particle of the
+* world rather than a rigid body, as it never turns.
+*/
+struct physics_round : public collision_sphere {
+
+	physics_round() : m_particle(particle_none), m_continuous(false), m_age(0.0f) {}
+
+	/** holds the index of the round's particle in the world's particle pool. */
+	uint32_t m_particle;
+
+	/**
+	* set when the round is swept from where it started each step,
+	* so it can't pass through a thin box.
+	*/
+	bool m_continuous;
+
+	/** holds how long the round has been flying, in seconds. */
+	float m_age;
+};
+
+struct physics_world {
+
+	physics_world();
+	~physics_world();
+
+	/** holds the state of every body of the world. */
+	rigid_body_pool m_bodies;
+
+	/**
+	* holds the boxes of the world, with room for one per body made by
+	* create. it never grows, so a box stays where it is.
+	*/
+	_array<collision_box> m_boxes;
+
+	/** holds the handle in the broadphase of each box. */
+	_array<uint32_t> m_box_proxies;
+
+	/** holds the particles of the rounds, they don't turn so need no rigid body. */
+	particle_pool m_particles;
+
+	/**
+	* holds the rounds. firing takes a free one, and the live ones
+	* can be walked through m_rounds.m_active without the rest.
+	*/
+	_pool<physics_round> m_rounds;
+
+	/** holds the contacts of the rounds, found every step. */
+	_array<particle_contact> m_particle_contacts;
+
+	/** holds the planes again, a component to an array, for the rounds. */
+	plane_set m_plane_set;
+
+	/** holds the plane each round's particle hit this step, if any. */
+	_array<uint32_t> m_round_planes;
+
+	/** holds the rounds in flight, rebuilt every step. */
+	spatial_hash m_round_hash;
+
+	/** holds the results of the broadphase and spatial hash queries. */
+	_array<uint32_t> m_round_results;
+
+	/** holds the pairs of touching rounds. */
+	_array<potential_contact> m_round_pairs;
+
+	/**
+	* set to test the rounds against each other. each round's mask
+	* still decides which pairs collide.
+	*/
+	bool m_round_collisions;
+
+	/**
+	* counts the rounds that passed through a box without a contact,
+	* checked for the rounds that are not swept. it should stay still
+	* while they are.
+	*/
+	uint32_t m_tunnel_count;
+
+	/** holds the static planes of the world, such as the floor. */
+	_array<collision_plane> m_planes;
+
+	/** holds the bounding volume tree of the boxes. */
+	dynamic_aabb_tree m_broadphase;
+
+	/** holds the contacts found by the last generatecontacts. */
+	collision_data m_cdata;
+
+	/** holds the contact resolver. */
+	contact_resolver m_resolver;
+
+	/** holds the threads the contact islands are resolved on. */
+	thread_pool m_pool;
+
+	/** holds the friction and restitution of the contacts. */
+	float m_friction;
+	float m_restitution;
+
+	/** holds the number of narrowphase pair tests of the last step, the rounds' included. */
+	uint32_t m_pair_tests;
+
+	/**
+	* makes room for the given number of boxes, rounds and contacts,
+	* and starts the given number of threads. the contacts may grow
+	* as far as contact_limit, 0 for no limit. returns false if the
+	* memory or the threads can't be had.
+	*/
+	bool create(uint32_t box_capacity, uint32_t contact_capacity, uint32_t contact_limit, uint32_t threads,
+		uint32_t round_capacity = 0);
+
+	/** releases the bodies, boxes, rounds, planes and contacts. */
+	void destroy();
+
+	/**
+	* hands out a new box with a body of its own, or NULL when there
+	* is no room left. the caller sets up the body and the size, then
+	* adds the box with addbox before the next step.
+	*/
+	collision_box* createbox();
+
+	/**
+	* adds a box from createbox to the broadphase, and returns its
+	* handle there.
+	*/
+	uint32_t addbox(collision_box *box);
+
+	/** returns the index of the given box in m_boxes. */
+	uint32_t boxindex(const collision_box *box) const { return uint32_t(box - m_boxes.m_data); }
+
+	/**
+	* fires a round from the given position, with the given velocity
+	* and no gravity. returns its slot in m_rounds, or m_rounds.m_size
+	* when every round is in flight.
+	*/
+	uint32_t fireround(const _vec3 &position, const _vec3 &velocity, float mass, float radius,
+		bool continuous, uint32_t category, uint32_t mask);
+
+	/**
+	* releases a round, stopping its particle where it is. a round
+	* not in flight is left alone.
+	*/
+	void releaseround(physics_round *round);
+
+	/** adds a static plane. */
+	void addplane(const _vec3 &direction, float offset);
+
+	/**
+	* keeps the transform of every body for drawing between steps,
+	* then integrates the awake ones and the rounds forward by the
+	* given duration. rounds older than world_round_lifetime are
+	* released.
+	*/
+	void integrate(float duration);
+
+	/**
+	* finds the contacts of the awake boxes with the planes and with
+	* each other, then those of the rounds. pairs with a trigger only
+	* record an overlap.
+	*/
+	void generatecontacts();
+
+	/**
+	* resolves the contacts found by generatecontacts, the rounds'
+	* first so the boxes they push are then kept out of the planes
+	* and each other.
+	*/
+	void resolvecontacts(float duration);
+
+	/**
+	* sweeps a continuous round from where it started the step, and
+	* adds a contact for the first plane or box it meets. the round
+	* is moved back to the point of impact and released. boxes its
+	* mask leaves out are passed through, and so are triggers, which
+	* report an overlap instead. returns false if it meets nothing.
+	*/
+	bool sweepround(physics_round *round);
+
+	/**
+	* checks if the round passed through a box during the step without
+	* touching it at the end. triggers and boxes the round's mask
+	* leaves out don't count.
+	*/
+	bool roundtunnelled(physics_round *round);
+
+	/** finds the contacts of the rounds with the planes, the boxes and each other. */
+	void generateroundcontacts();
+
+	/** advances the world by the given duration. */
+	void step(float duration);
+};
@@ -0,0 +1,196 @@
+/**
+* casts rays and spheres into a grid of boxes over a floor through
+* collision_query, and checks what they hit.
+*
+* a ray with a zero component is parallel to a pair of slabs, and
+* must be tested by its origin alone: rays along the faces and edges
+* of a box must hit it, and rays just off them miss, rather than
+* coming out of a nan by luck.
+*
+* a batch of casts, over the thread pool or not, must hit the same
+* things at the same distances as the same casts made one at a time.
+* the planes must only be hit by casts whose mask holds their
+* category, and a tree too tall for the cast's stack must be refused
+* rather than walked in part. exits non zero if a check fails.
+*/
+
+#include "physics.h"
+#include "collide_query.h"
+#include "test.h"
+
+#include <cstdio>
+
+#define test_side     6
+#define test_layers   3
+#define test_boxes    (test_side*test_side*test_layers)
+#define test_casts    1024
+#define test_threads  4
+
+/** a grid of boxes, half of them in a second category, over a floor. */
+static bool testscene(physics_world *world, collision_query *query) {
+	if (!world->create(test_boxes, 64, 4096, test_threads)) { return false; }
+
+	for (uint32_t i = 0; i < test_boxes; i++) {
+		collision_box *box = world->createbox();
+		if (!box) { return false; }
+		box->m_half_size = _vec3(0.5f, 0.5f, 0.5f);
+		box->m_category  = (i & 1) ? 0x2 : collision_category_default;
+
+		rigid_body *body = box->m_body;
+		body->setposition( _vec3(float(i % test_side)*2.0f, 1.0f + float(i / (test_side*test_side))*2.0f, float((i / test_side) % test_side)*2.0f) );
+		body->setorientation(_quaternion());
+		body->calculatederiveddata();
+		world->addbox(box);
+	}
+	world->addplane( _vec3(0.0f, 1.0f, 0.0f), 0.0f );
+
+	query->m_tree        = &world->m_broadphase;
+	query->m_planes      = world->m_planes.m_data;
+	query->m_plane_count = world->m_planes.m_count;
+	query->m_pool        = &world->m_pool;
+	return true;
+}
+
+static void testparallel(physics_world *world, collision_query *query) {
+	printf("rays parallel to the slabs\n");
+
+	// rays along each axis, over the faces and edges of a box and just off them
+	bounding_box bounds( _vec3(-1.0f, -1.0f, -1.0f), _vec3(1.0f, 1.0f, 1.0f) );
+	static const float on[5][2]  = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { -1.0f, 1.0f }, { 1.0f, -1.0f }, { 0.0f, -1.0f } };
+	static const float off[4][2] = { { 1.001f, 0.0f }, { -1.001f, 1.0f }, { 1.0f, -1.001f }, { 0.0f, 1.001f } };
+	uint32_t hits = 0, misses = 0, rays = 0;
+	for (uint32_t axis = 0; axis < 3; axis++) {
+		uint32_t u = (axis + 1) % 3, v = (axis + 2) % 3;
+		_vec3 direction;
+		direction[axis] = 1.0f;
+		_vec3 inverse(1.0f/direction.x, 1.0f/direction.y, 1.0f/direction.z);
+
+		for (uint32_t i = 0; i < 9; i++) {
+			const float *across = (i < 5) ? on[i] : off[i-5];
+			_vec3 origin;
+			origin[axis] = -5.0f;
+			origin[u]    = across[0];
+			origin[v]    = across[1];
+
+			bool hit = bounds.intersectsray(origin, inverse, 10.0f);
+			if (hit && i < 5)   { hits++; }
+			if (!hit && i >= 5) { misses++; }
+			rays++;
+		}
+	}
+	printf("rays %u right %u\n", rays, hits + misses);
+	testcheck(hits + misses == rays, "rays on a face or edge hit, and just off it miss");
+
+	// a ray down a row of boxes, along their centres, finds the first
+	raycast_hit hit;
+	bool found = query->raycast( _vec3(-5.0f, 1.0f, 0.0f), _vec3(1.0f, 0.0f, 0.0f), 100.0f, &hit );
+	testcheck(found && hit.m_primitive == &world->m_boxes[0] && abs(hit.m_distance - 4.5f) < 1e-4f, "a ray along a row hits its first box");
+}
+
+/** origins around the grid, and directions, some of them along the axes. */
+static void testrays(_vec3 *origins, _vec3 *directions) {
+	class random random_(10);
+	float far = float(test_side)*2.0f;
+	for (uint32_t i = 0; i < test_casts; i++) {
+		origins[i]    = random_.randomvector( _vec3(-4.0f, 0.5f, -4.0f), _vec3(far + 4.0f, float(test_layers)*2.0f + 4.0f, far + 4.0f) );
+		directions[i] = random_.randomvector(1.0f);
+		if (i & 1) { directions[i][i % 3] = 0.0f; }
+		if ((i & 3) == 3) { directions[i][(i+1) % 3] = 0.0f; }
+	}
+}
+
+static bool testsame(const raycast_hit &a, const raycast_hit &b) {
+	return a.m_primitive == b.m_primitive && a.m_plane == b.m_plane && a.m_distance == b.m_distance;
+}
+
+static void testbatch(physics_world *world, collision_query *query) {
+	printf("batches of casts\n");
+
+	static _vec3 origins[test_casts], directions[test_casts];
+	static raycast_query queries[test_casts];
+	static raycast_hit single[test_casts], batch[test_casts];
+	testrays(origins, directions);
+
+	// the rays one at a time, then as a batch with and without the pool
+	uint32_t hits = 0;
+	for (uint32_t i = 0; i < test_casts; i++) {
+		if (query->raycast(origins[i], directions[i], 50.0f, &single[i], collision_category_default)) { hits++; }
+	}
+	for (uint32_t pooled = 0; pooled < 2; pooled++) {
+		query->m_pool = pooled ? &world->m_pool : NULL;
+		uint32_t counted = query->raycastbatch(origins, directions, 50.0f, batch, test_casts, collision_category_default);
+
+		uint32_t same = 0;
+		for (uint32_t i = 0; i < test_casts; i++) { if (testsame(single[i], batch[i])) { same++; } }
+		printf("%s: rays %u hit %u batch hit %u same %u\n", pooled ? "pool" : "no pool", test_casts, hits, counted, same);
+		testcheck(counted == hits && same == test_casts, "raycastbatch hits what the rays do one at a time");
+	}
+
+	// spheres of many sizes and masks, one at a time then as a batch
+	hits = 0;
+	for (uint32_t i = 0; i < test_casts; i++) {
+		queries[i].m_origin       = origins[i];
+		queries[i].m_direction    = directions[i];
+		queries[i].m_radius       = float(i % 4) * 0.2f;
+		queries[i].m_max_distance = 10.0f + float(i % 7)*5.0f;
+		queries[i].m_mask         = (i % 3) + 1;
+		if (query->cast(queries[i], &single[i])) { hits++; }
+	}
+	for (uint32_t pooled = 0; pooled < 2; pooled++) {
+		query->m_pool = pooled ? &world->m_pool : NULL;
+		uint32_t counted = query->castbatch(queries, batch, test_casts);
+
+		uint32_t same = 0;
+		for (uint32_t i = 0; i < test_casts; i++) { if (testsame(single[i], batch[i])) { same++; } }
+		printf("%s: casts %u hit %u batch hit %u same %u\n", pooled ? "pool" : "no pool", test_casts, hits, counted, same);
+		testcheck(counted == hits && same == test_casts, "castbatch hits what the casts do one at a time");
+	}
+	testcheck(hits > test_casts/4 && hits < test_casts, "some casts hit and some miss");
+	query->m_pool = &world->m_pool;
+}
+
+static void testplanes(collision_query *query) {
+	printf("casts against the floor\n");
+
+	// straight down, clear of the boxes
+	_vec3 origin(-3.0f, 5.0f, -3.0f), down(0.0f, -1.0f, 0.0f);
+	raycast_hit hit;
+	bool found = query->raycast(origin, down, 100.0f, &hit);
+	testcheck(found && hit.m_plane == &query->m_planes[0] && abs(hit.m_distance - 5.0f) < 1e-4f, "a ray hits the floor");
+
+	query->m_plane_category = 0x2;
+	found = query->raycast(origin, down, 100.0f, &hit, collision_category_default);
+	testcheck(!found && !hit.hit(), "a mask without the planes' category passes through the floor");
+	found = query->raycast(origin, down, 100.0f, &hit, 0x2);
+	testcheck(found && hit.m_plane != NULL, "a mask with it hits the floor");
+	query->m_plane_category = collision_category_default;
+}
+
+static void testheight(physics_world *world, collision_query *query) {
+	printf("a tree too tall to walk\n");
+
+	aabb_tree_node &root = world->m_broadphase.m_nodes[ world->m_broadphase.m_root ];
+	int32_t height = root.m_height;
+	printf("height %d, the stack holds %d\n", height, query_stack_size);
+
+	// a ray that hits a box, then the same with the tree made too tall
+	_vec3 origin(-5.0f, 1.0f, 0.0f), along(1.0f, 0.0f, 0.0f);
+	raycast_hit hit;
+	testcheck(query->raycast(origin, along, 100.0f, &hit) && hit.m_primitive != NULL, "the tree is walked");
+	root.m_height = query_stack_size;
+	testcheck(!query->raycast(origin, along, 100.0f, &hit) && !hit.hit(), "a tree too tall for the stack is refused");
+	root.m_height = height;
+}
+
+int main() {
+	physics_world world;
+	collision_query query;
+	if (!testscene(&world, &query)) { printf("no world\n"); return 1; }
+
+	testparallel(&world, &query);
+	testbatch(&world, &query);
+	testplanes(&query);
+	testheight(&world, &query);
+
+	return testresult();
+}
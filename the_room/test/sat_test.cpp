@@ -0,0 +1,148 @@
+/**
+* runs random pairs of boxes through the sse box and box tests and
+* the scalar ones they replace, and checks they agree.
+*
+* for every pair the overlap test must give the same answer both
+* ways, and the contact tests must write the same number of contacts
+* on the same axis, each with the normal, penetration and contact
+* point agreeing within test_tolerance. the sse code adds some products in
+* another order, so it is not always equal to the bit.
+*
+* two axes may come within rounding of the same penetration, and
+* then either may be picked. such a pair is counted as a tie, not a
+* failure, so long as the penetrations agree.
+*
+* both ways are then timed over the same pairs. exits non zero if a
+* check fails. in a build without sse both ways are the scalar code.
+*/
+
+#include "physics.h"
+#include "test.h"
+
+#include <cstdio>
+#include <ctime>
+
+#define test_pairs       4096
+#define test_repeats     200
+#define test_tolerance   1e-4f
+
+static bool testclose(const _vec3 &a, const _vec3 &b) {
+	return abs(a.x - b.x) <= test_tolerance && abs(a.y - b.y) <= test_tolerance && abs(a.z - b.z) <= test_tolerance;
+}
+
+/* pairs of boxes of any size and turn, near enough that about half touch */
+static bool testboxes(physics_world *world) {
+	if (!world->create(test_pairs*2, 16, 16, 1)) { return false; }
+
+	class random random_(11);
+	for (uint32_t i = 0; i < test_pairs*2; i++) {
+		collision_box *box = world->createbox();
+		if (!box) { return false; }
+		box->m_half_size = random_.randomvector( _vec3(0.2f, 0.2f, 0.2f), _vec3(2.0f, 2.0f, 2.0f) );
+
+		rigid_body *body = box->m_body;
+		body->setposition( (i & 1) ? random_.randomvector( _vec3(-3.0f, -3.0f, -3.0f), _vec3(3.0f, 3.0f, 3.0f) ) : _vec3(0.0f, 0.0f, 0.0f) );
+		body->setorientation( random_.randomquaternion() );
+		body->calculatederiveddata();
+		box->calculateinternals();
+	}
+	return true;
+}
+
+static void testagree(physics_world *world) {
+	collision_data simd, scalar;
+	simd.create(8, 8);
+	scalar.create(8, 8);
+
+	uint32_t overlaps = 0, contacts = 0, ties = 0;
+	uint32_t overlap_errors = 0, count_errors = 0, value_errors = 0;
+	for (uint32_t i = 0; i < test_pairs; i++) {
+		const collision_box &one = world->m_boxes[i*2];
+		const collision_box &two = world->m_boxes[i*2+1];
+
+		bool overlap = intersection_tests::boxandbox(one, two);
+		if (overlap != intersection_tests::boxandboxscalar(one, two)) { overlap_errors++; }
+		if (overlap) { overlaps++; }
+
+		simd.reset();
+		scalar.reset();
+		uint32_t found = collision_detector::boxandbox(one, two, &simd);
+		if (found != collision_detector::boxandboxscalar(one, two, &scalar)) { count_errors++; continue; }
+		if (!found) { continue; }
+		contacts++;
+
+		if (abs(simd.m_contact_array[0].m_penetration - scalar.m_contact_array[0].m_penetration) > test_tolerance) { value_errors++; continue; }
+		if (simd.m_contact_array[0].m_feature != scalar.m_contact_array[0].m_feature) { ties++; continue; }
+		for (uint32_t c = 0; c < found; c++) {
+			const contact &a = simd.m_contact_array[c];
+			const contact &b = scalar.m_contact_array[c];
+			if (a.m_feature != b.m_feature || abs(a.m_penetration - b.m_penetration) > test_tolerance ||
+				!testclose(a.m_contact_normal, b.m_contact_normal) || !testclose(a.m_contact_point, b.m_contact_point)) {
+				value_errors++;
+				break;
+			}
+		}
+	}
+	simd.destroy();
+	scalar.destroy();
+
+	printf("pairs %u overlapping %u contacts %u ties %u\n", test_pairs, overlaps, contacts, ties);
+	printf("errors: overlap %u count %u values %u\n", overlap_errors, count_errors, value_errors);
+	testcheck(overlaps > test_pairs/4 && overlaps < test_pairs*3/4, "about half the pairs overlap");
+	testcheck(overlap_errors == 0, "the overlap tests agree");
+	testcheck(count_errors == 0, "the contact tests find the same contacts");
+	testcheck(value_errors == 0, "the contacts agree");
+	testcheck(ties < contacts/100 + 1, "few pairs are ties");
+}
+
+static void testtime(physics_world *world) {
+	collision_data data;
+	data.create(8, 8);
+
+	static const char *names[2] = { "sse", "scalar" };
+	double seconds[2][2];
+	uint32_t hits[2][2];
+	for (uint32_t way = 0; way < 2; way++) {
+		clock_t start = clock();
+		hits[way][0] = 0;
+		for (uint32_t r = 0; r < test_repeats; r++) {
+			for (uint32_t i = 0; i < test_pairs; i++) {
+				const collision_box &one = world->m_boxes[i*2];
+				const collision_box &two = world->m_boxes[i*2+1];
+				bool overlap = way ? intersection_tests::boxandboxscalar(one, two) : intersection_tests::boxandbox(one, two);
+				if (overlap) { hits[way][0]++; }
+			}
+		}
+		seconds[way][0] = double(clock() - start) / CLOCKS_PER_SEC;
+
+		start = clock();
+		hits[way][1] = 0;
+		for (uint32_t r = 0; r < test_repeats; r++) {
+			for (uint32_t i = 0; i < test_pairs; i++) {
+				const collision_box &one = world->m_boxes[i*2];
+				const collision_box &two = world->m_boxes[i*2+1];
+				data.reset();
+				hits[way][1] += way ? collision_detector::boxandboxscalar(one, two, &data) : collision_detector::boxandbox(one, two, &data);
+			}
+		}
+		seconds[way][1] = double(clock() - start) / CLOCKS_PER_SEC;
+	}
+	data.destroy();
+
+	double tests = double(test_repeats) * test_pairs;
+	printf("ns a pair       overlap   contact\n");
+	for (uint32_t way = 0; way < 2; way++) {
+		printf("  %-10s %9.1f %9.1f\n", names[way], seconds[way][0] * 1e9 / tests, seconds[way][1] * 1e9 / tests);
+	}
+	testcheck(hits[0][0] == hits[1][0] && hits[0][1] == hits[1][1], "the timed runs agree");
+}
+
+int main() {
+	physics_world world;
+	if (!testboxes(&world)) { printf("no world\n"); return 1; }
+
+	testagree(&world);
+	testtime(&world);
+
+	return testresult();
+}
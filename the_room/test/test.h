@@ -0,0 +1,23 @@
+#pragma once
+
+/**
+* the checks the headless tests share. each test is a program of its
+* own that includes this once, makes its checks through testcheck and
+* returns testresult from main.
+*/
+
+#include <cstdio>
+
+static uint32_t s_failures = 0;
+
+/** prints the check and counts it when it fails. */
+static void testcheck(bool passed, const char *what) {
+	printf("%s %s\n", passed ? "pass" : "FAIL", what);
+	if (!passed) { s_failures++; }
+}
+
+/** prints the number of checks that failed, and returns the exit code. */
+static int testresult() {
+	printf("%u failed\n", s_failures);
+	return s_failures ? 1 : 0;
+}
@@ -0,0 +1,191 @@
+/**
+* fires fast rounds at a wall of thin boxes through physics_world and
+* counts the ones that come out the other side.
+*
+* the wall is a grid of boxes a tenth of a unit thick that don't
+* move, at z = 0. rounds are fired at it from behind, at 100 to 300
+* units a second and 30 steps a second, so each moves 3 to 10 units a
+* step, well past the wall. a round found beyond the wall has
+* tunnelled, whatever the world's own count says.
+*
+* with sweeping on, no round may tunnel. with sweeping off most do,
+* and the world's count of them must see each one.
+*
+* then the wall is made a trigger, and after that put in a category
+* the rounds' mask leaves out. swept or not, every round must fly
+* through either wall without counting as a tunnel. the masked wall
+* must report nothing. the trigger must report a round that ends a
+* step inside it, and when swept every round that passes through it,
+* in the one step it does, once for each box it touches.
+* exits non zero if a check fails.
+*/
+
+#include "physics.h"
+#include "test.h"
+
+#include <cstdio>
+
+#define test_rounds      256
+#define test_round_size  0.2f
+#define test_wall_boxes  4
+#define test_wall_half   1.0f
+#define test_wall_depth  0.05f
+#define test_step        (1.0f/30.0f)
+#define test_max_steps   600
+
+/** the category of the wall the rounds are masked against. */
+#define test_wall_category 0x00000002
+
+/**
+* builds the wall, test_wall_boxes boxes a side, centred on the z
+* axis, of triggers or not and in the given category.
+*/
+static bool testwall(physics_world *world, bool trigger, uint32_t category) {
+	uint32_t count = test_wall_boxes*test_wall_boxes;
+	if (!world->create(count, 64, 4096, 1, test_rounds)) { return false; }
+	world->m_round_hash.setcellsize(test_round_size*4.0f);
+
+	_mat3 still;
+	still.setdiagonal(0.0f, 0.0f, 0.0f);
+
+	float start = -float(test_wall_boxes-1) * test_wall_half;
+	for (uint32_t i = 0; i < count; i++) {
+		collision_box *box = world->createbox();
+		if (!box) { return false; }
+		box->m_half_size = _vec3(test_wall_half, test_wall_half, test_wall_depth);
+		box->m_trigger   = trigger;
+		box->m_category  = category;
+
+		rigid_body *body = box->m_body;
+		body->setposition( _vec3(start + float(i % test_wall_boxes)*test_wall_half*2.0f,
+			start + float(i / test_wall_boxes)*test_wall_half*2.0f, 0.0f) );
+		body->setorientation(_quaternion());
+		body->setvelocity( _vec3(0.0f, 0.0f, 0.0f) );
+		body->setrotation( _vec3(0.0f, 0.0f, 0.0f) );
+		body->setinversemass(0.0f);
+		body->setinverseinertiatensor(still);
+		body->setacceleration(0.0f, 0.0f, 0.0f);
+		body->setawake(false);
+		body->calculatederiveddata();
+		body->storeprevious();
+
+		world->addbox(box);
+	}
+
+	// far below the wall, so only a round that misses it reaches it
+	world->addplane( _vec3(0.0f, 1.0f, 0.0f), -100.0f );
+	return true;
+}
+
+/**
+* fires the rounds two a step, from scattered points behind the wall,
+* and steps until every one has hit or gone. returns the number found
+* beyond the wall. counts the rounds reported in overlaps each step,
+* and the overlaps that were not between a trigger and a round or
+* came twice in a step.
+*/
+static uint32_t testfire(physics_world *world, bool continuous, uint32_t mask, uint32_t *fired, uint32_t *overlaps, uint32_t *wrong) {
+	class random random_(9);
+
+	// aimed inside the wall, by a round's width
+	float reach = float(test_wall_boxes) * test_wall_half - test_round_size;
+
+	uint32_t passed = 0;
+	*fired = 0;
+	*overlaps = 0;
+	*wrong = 0;
+	for (uint32_t s = 0; s < test_max_steps; s++) {
+		for (uint32_t n = 0; n < 2 && *fired < test_rounds; n++) {
+			_vec3 position( random_.randomreal(-reach, reach), random_.randomreal(-reach, reach), random_.randomreal(-20.0f, -10.0f) );
+			_vec3 velocity( 0.0f, 0.0f, random_.randomreal(100.0f, 300.0f) );
+			world->fireround(position, velocity, 40.0f, test_round_size, continuous, collision_category_default, mask);
+			(*fired)++;
+		}
+
+		world->step(test_step);
+
+		_array<collision_overlap> &reported = world->m_cdata.m_overlaps;
+		for (uint32_t i = 0; i < reported.m_count; i++) {
+			if (!reported[i].m_primitive[0]->m_trigger || reported[i].m_primitive[1]->m_trigger) { (*wrong)++; }
+
+			// a round is counted once, however many boxes it touched
+			bool counted = false;
+			for (uint32_t j = 0; j < i; j++) {
+				if (reported[i].m_primitive[1] != reported[j].m_primitive[1]) { continue; }
+				if (reported[i].m_primitive[0] == reported[j].m_primitive[0]) { (*wrong)++; }
+				counted = true;
+			}
+			if (!counted) { (*overlaps)++; }
+		}
+
+		// a round still in flight beyond the wall got through it
+		for (uint32_t i = world->m_rounds.m_count; i-- > 0; ) {
+			physics_round *round = &world->m_rounds.active(i);
+			if (world->m_particles.getposition(round->m_particle).z > test_wall_depth + test_round_size) {
+				passed++;
+				world->releaseround(round);
+			}
+		}
+		if (*fired == test_rounds && !world->m_rounds.m_count) { break; }
+	}
+	return passed;
+}
+
+static void testswept() {
+	printf("rounds swept\n");
+
+	physics_world world;
+	if (!testwall(&world, false, collision_category_default)) { testcheck(false, "world created"); return; }
+
+	uint32_t fired, overlaps, wrong;
+	uint32_t passed = testfire(&world, true, collision_mask_all, &fired, &overlaps, &wrong);
+	printf("fired %u passed %u counted %u left %u\n", fired, passed, world.m_tunnel_count, world.m_rounds.m_count);
+	testcheck(passed == 0, "no round passes through the wall");
+	testcheck(world.m_tunnel_count == 0, "the world counts no tunnels");
+	testcheck(world.m_rounds.m_count == 0, "every round is used up");
+}
+
+static void testunswept() {
+	printf("rounds not swept\n");
+
+	physics_world world;
+	if (!testwall(&world, false, collision_category_default)) { testcheck(false, "world created"); return; }
+
+	uint32_t fired, overlaps, wrong;
+	uint32_t passed = testfire(&world, false, collision_mask_all, &fired, &overlaps, &wrong);
+	printf("fired %u passed %u counted %u\n", fired, passed, world.m_tunnel_count);
+	testcheck(passed > 0, "rounds pass through the wall");
+	testcheck(world.m_tunnel_count == passed, "the world counts every one");
+}
+
+/** fires the rounds through a wall they must not stop at, swept and not. */
+static void testthrough(bool trigger) {
+	for (uint32_t continuous = 0; continuous < 2; continuous++) {
+		printf("rounds %s through a %s wall\n", continuous ? "swept" : "not swept", trigger ? "trigger" : "masked out");
+
+		physics_world world;
+		if (!testwall(&world, trigger, test_wall_category)) { testcheck(false, "world created"); return; }
+
+		// the rounds collide with the trigger, but not the masked wall
+		uint32_t mask = trigger ? collision_mask_all : collision_category_default;
+		uint32_t fired, overlaps, wrong;
+		uint32_t passed = testfire(&world, continuous != 0, mask, &fired, &overlaps, &wrong);
+		printf("fired %u passed %u counted %u reported %u wrong %u\n", fired, passed, world.m_tunnel_count, overlaps, wrong);
+		testcheck(passed == fired, "every round passes through the wall");
+		testcheck(world.m_tunnel_count == 0, "the world counts no tunnels");
+		if (!trigger) { testcheck(overlaps == 0, "nothing is reported"); continue; }
+
+		// not swept, a round is only seen by the trigger if it ends a step in it
+		testcheck(continuous ? overlaps == fired : overlaps > 0, continuous ? "the trigger reports every round" : "the trigger reports rounds in it");
+		testcheck(wrong == 0, "each overlap is a round in the trigger, once a step");
+	}
+}
+
+int main() {
+	testswept();
+	testunswept();
+	testthrough(true);
+	testthrough(false);
+
+	return testresult();
+}
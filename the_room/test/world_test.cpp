@@ -0,0 +1,478 @@
+/**
+* drops a pile of boxes onto a floor through physics_world and checks
+* it settles.
+*
+* 27 boxes are dropped in three layers, the top one falls off the
+* others. with sleeping on, every box must be asleep after 20 seconds
+* and none below the floor. with sleeping off, the pile must hold
+* still over the last 2 seconds, its contacts and pair tests changing
+* by no more than a few a step. the pile also prints where it stands
+* every 5 seconds, so runs can be compared across changes.
+*
+* boxandhalfspace transforms its eight vertices together, and must
+* find the same contacts as transforming them one at a time. random
+* boxes across a plane check it does.
+*
+* the world's contacts start small and may only grow so far. boxes
+* resting on the floor, four contacts each, must grow them to the
+* limit and no further, with every contact past it counted as
+* overflow and in the high water. a box cut short must keep its
+* deepest contact, reduced or not.
+*
+* a box resting on another must get a contact at each corner of the
+* face where they meet, the same features when it moves a little, and
+* a box turned on another the eight corners of their octagon, reduced
+* to four.
+*
+* stacks of 4, 8 and 12 boxes dropped onto the floor under the
+* sequential impulse solver must stay standing and go to sleep within
+* 30 seconds. exits non zero if a check fails.
+*/
+
+#include "physics.h"
+#include "test.h"
+
+#include <cstdio>
+
+#define test_boxes         27
+#define test_steps         1200
+#define test_settled_steps 120
+#define test_step          (1.0f/60.0f)
+#define test_print_steps   300
+#define test_plane_boxes   256
+
+/** the contacts the world starts with, and the most it may grow to. */
+#define test_capacity_boxes 4
+#define test_capacity       2
+#define test_limit          10
+
+/** how much the contact count may move once the pile has settled. */
+#define test_contact_spread 8
+
+/** the fastest a settled box may move, squared. */
+#define test_settled_speed 1.0f
+
+/** the longest a stack may take to sleep, and how far its top may stray. */
+#define test_stack_steps   1800
+#define test_stack_drift   0.5f
+
+/** makes the pile in the world, three layers of nine boxes. */
+static bool testpile(physics_world *world, bool cansleep) {
+	if (!world->create(test_boxes, 64, 4096, 4)) { return false; }
+
+	for (uint32_t i = 0; i < test_boxes; i++) {
+		collision_box *box = world->createbox();
+		if (!box) { return false; }
+		box->m_half_size = _vec3(1.0f, 1.0f, 1.0f);
+
+		rigid_body *body = box->m_body;
+		body->setposition( _vec3(float(i%3)*2.5f, 1.0f + float(i/9)*2.2f, float((i/3)%3)*2.5f) );
+		body->setorientation(_quaternion());
+		body->setvelocity( _vec3(0.0f, 0.0f, 0.0f) );
+		body->setrotation( _vec3(0.0f, 0.0f, 0.0f) );
+		body->setmass(8.0f);
+
+		_mat3 tensor;
+		tensor.setblockinertiatensor(box->m_half_size, 8.0f);
+		body->setinertiatensor(tensor);
+
+		body->setlineardamping(0.95f);
+		body->setangulardamping(0.8f);
+		body->setacceleration(0.0f, -10.0f, 0.0f);
+		body->setcansleep(cansleep);
+		body->setawake();
+		body->calculatederiveddata();
+		body->storeprevious();
+
+		world->addbox(box);
+	}
+	world->addplane( _vec3(0.0f, 1.0f, 0.0f), 0.0f );
+	return true;
+}
+
+/** checks no box has sunk into the floor or flown off. */
+static void testbounds(physics_world *world) {
+	float low = 1e9f, high = -1e9f;
+	for (uint32_t i = 0; i < world->m_boxes.m_count; i++) {
+		float y = world->m_boxes[i].m_body->getposition().y;
+		if (y < low)  { low  = y; }
+		if (y > high) { high = y; }
+	}
+	printf("lowest %.3f highest %.3f\n", low, high);
+	testcheck(low > 0.9f, "no box below the floor");
+	testcheck(high < 5.5f, "no box above the pile");
+}
+
+/** prints the contacts, pair tests, boxes awake and height of the pile. */
+static void testprint(physics_world *world, uint32_t step) {
+	uint32_t awake = 0;
+	float low = 1e9f, high = -1e9f;
+	for (uint32_t i = 0; i < world->m_boxes.m_count; i++) {
+		rigid_body *body = world->m_boxes[i].m_body;
+		if (body->getawake()) { awake++; }
+		float y = body->getposition().y;
+		if (y < low)  { low  = y; }
+		if (y > high) { high = y; }
+	}
+	printf("step %u contacts %u pairs %u awake %u miny %.3f maxy %.3f\n",
+		step, world->m_cdata.m_contact_count, world->m_pair_tests, awake, low, high);
+}
+
+static void testsleeping() {
+	printf("pile, sleeping on\n");
+
+	physics_world world;
+	if (!testpile(&world, true)) { testcheck(false, "world created"); return; }
+	for (uint32_t s = 0; s < test_steps; s++) {
+		world.step(test_step);
+		if ((s+1) % test_print_steps == 0) { testprint(&world, s+1); }
+	}
+
+	uint32_t awake = 0;
+	for (uint32_t i = 0; i < world.m_boxes.m_count; i++) {
+		if (world.m_boxes[i].m_body->getawake()) { awake++; }
+	}
+	printf("awake %u contacts %u\n", awake, world.m_cdata.m_contact_count);
+	testcheck(awake == 0, "every box asleep");
+	testcheck(world.m_cdata.m_contact_count == 0, "no contacts between sleeping boxes");
+	testbounds(&world);
+}
+
+static void testawake() {
+	printf("pile, sleeping off\n");
+
+	physics_world world;
+	if (!testpile(&world, false)) { testcheck(false, "world created"); return; }
+	for (uint32_t s = 0; s < test_steps - test_settled_steps; s++) { world.step(test_step); }
+
+	uint32_t contacts[2] = { 0xffffffff, 0 };
+	uint32_t pairs[2]    = { 0xffffffff, 0 };
+	float speed = 0.0f;
+	for (uint32_t s = 0; s < test_settled_steps; s++) {
+		world.step(test_step);
+
+		uint32_t count = world.m_cdata.m_contact_count;
+		if (count < contacts[0]) { contacts[0] = count; }
+		if (count > contacts[1]) { contacts[1] = count; }
+		if (world.m_pair_tests < pairs[0]) { pairs[0] = world.m_pair_tests; }
+		if (world.m_pair_tests > pairs[1]) { pairs[1] = world.m_pair_tests; }
+
+		for (uint32_t i = 0; i < world.m_boxes.m_count; i++) {
+			_vec3 v = world.m_boxes[i].m_body->getvelocity();
+			float squared = v.x*v.x + v.y*v.y + v.z*v.z;
+			if (squared > speed) { speed = squared; }
+		}
+	}
+	printf("contacts %u to %u pairs %u to %u speed %.3f\n", contacts[0], contacts[1], pairs[0], pairs[1], speed);
+	testcheck(contacts[0] > 0, "the pile keeps its contacts");
+	testcheck(contacts[1] - contacts[0] <= test_contact_spread, "the contact count holds steady");
+	testcheck(pairs[1] - pairs[0] <= test_contact_spread, "the pair count holds steady");
+	testcheck(speed < test_settled_speed, "the boxes hold still");
+	testbounds(&world);
+}
+
+static void testhalfspace() {
+	printf("boxes against a plane\n");
+
+	physics_world world;
+	collision_data data;
+	if (!world.create(test_plane_boxes, 64, 4096, 1) || !data.create(8, 8)) { testcheck(false, "world created"); return; }
+
+	collision_plane plane;
+	plane.m_direction = _vec3(0.0f, 1.0f, 0.0f);
+	plane.m_offset    = 0.0f;
+
+	// the contacts are compared before they are reduced
+	bool reduce = collision_detector::s_reduce;
+	collision_detector::s_reduce = false;
+
+	class random random_(20);
+	uint32_t boxes = 0, contacts = 0, mismatches = 0;
+	for (uint32_t b = 0; b < test_plane_boxes; b++) {
+		collision_box *box = world.createbox();
+		if (!box) { break; }
+		box->m_half_size = random_.randomvector( _vec3(0.1f, 0.1f, 0.1f), _vec3(3.0f, 3.0f, 3.0f) );
+		box->m_body->setposition( random_.randomvector( _vec3(-10.0f, -2.0f, -10.0f), _vec3(10.0f, 2.0f, 10.0f) ) );
+		box->m_body->setorientation( random_.randomquaternion() );
+		box->m_body->calculatederiveddata();
+		box->calculateinternals();
+
+		data.reset();
+		uint32_t found = collision_detector::boxandhalfspace(*box, plane, &data);
+		boxes++;
+		contacts += found;
+
+		// the vertices of the box, one at a time, in the order the detector takes them
+		uint32_t expected = 0;
+		for (uint32_t i = 0; i < 8; i++) {
+			_vec3 vertex( (i & 1) ? -box->m_half_size.x : box->m_half_size.x,
+				(i & 2) ? -box->m_half_size.y : box->m_half_size.y,
+				(i & 4) ? -box->m_half_size.z : box->m_half_size.z );
+			vertex = box->m_transform.transform(vertex);
+
+			float distance = _dot(vertex, plane.m_direction);
+			if (distance > plane.m_offset) { continue; }
+			if (expected >= found) { expected++; mismatches++; continue; }
+
+			const contact &c = data.m_contact_array[expected++];
+			_vec3 point = vertex + plane.m_direction * (distance - plane.m_offset);
+			if (c.m_contact_point.x != point.x || c.m_contact_point.y != point.y || c.m_contact_point.z != point.z ||
+				c.m_penetration != plane.m_offset - distance) {
+				mismatches++;
+			}
+		}
+		if (expected != found) { mismatches++; }
+	}
+	collision_detector::s_reduce = reduce;
+
+	printf("boxes %u contacts %u mismatches %u\n", boxes, contacts, mismatches);
+	testcheck(contacts > 0, "some boxes cross the plane");
+	testcheck(mismatches == 0, "the contacts match one vertex at a time");
+	data.destroy();
+}
+
+/** adds a box of unit half size to the world, awake, sunk into the floor at y = 0. */
+static void testsunkbox(physics_world *world, const _vec3 &position, const _quaternion &orientation) {
+	collision_box *box = world->createbox();
+	if (!box) { return; }
+	box->m_half_size = _vec3(1.0f, 1.0f, 1.0f);
+	box->m_body->setposition(position);
+	box->m_body->setorientation(orientation);
+	box->m_body->setawake();
+	box->m_body->calculatederiveddata();
+	box->calculateinternals();
+	world->addbox(box);
+}
+
+/** the deepest any vertex of the box goes under the floor, and how many do. */
+static float testdeepest(const collision_box &box, uint32_t *under) {
+	float deepest = 0.0f;
+	*under = 0;
+	for (uint32_t i = 0; i < 8; i++) {
+		_vec3 vertex( (i & 1) ? -1.0f : 1.0f, (i & 2) ? -1.0f : 1.0f, (i & 4) ? -1.0f : 1.0f );
+		float depth = -box.m_transform.transform(vertex).y;
+		if (depth < 0.0f) { continue; }
+		(*under)++;
+		if (depth > deepest) { deepest = depth; }
+	}
+	return deepest;
+}
+
+static void testcapacity() {
+	printf("contacts past the limit\n");
+
+	// boxes sunk flat a little way into the floor, far apart
+	physics_world world;
+	if (!world.create(test_capacity_boxes, test_capacity, test_limit, 1)) { testcheck(false, "world created"); return; }
+	for (uint32_t i = 0; i < test_capacity_boxes; i++) {
+		testsunkbox(&world, _vec3(float(i)*10.0f, 0.9f, 0.0f), _quaternion());
+	}
+	world.addplane( _vec3(0.0f, 1.0f, 0.0f), 0.0f );
+
+	collision_data &data = world.m_cdata;
+	world.generatecontacts();
+	printf("size %u contacts %u overflow %u high water %u grown %u\n", data.m_buffer.m_size,
+		data.m_contact_count, data.m_overflow_count, data.m_high_water, data.m_grow_count);
+	testcheck(data.m_buffer.m_size == test_limit, "the contacts grow to the limit");
+	testcheck(data.m_contact_count == test_limit, "the contacts fill it");
+	testcheck(data.m_grow_count == 3, "the contacts grow by half, or to fit");
+	testcheck(data.m_overflow_count == test_capacity_boxes*4 - test_limit, "every contact past the limit is overflow");
+	testcheck(data.m_high_water == test_capacity_boxes*4, "the high water counts every contact found");
+
+	// the first box's contacts were kept when the array moved
+	bool kept = true;
+	for (uint32_t i = 0; i < 4; i++) {
+		const contact &c = data.m_contact_array[i];
+		if (c.m_body[0] != world.m_boxes[0].m_body || abs(c.m_contact_point.x) != 1.0f || abs(c.m_penetration - 0.1f) > 1e-5f) { kept = false; }
+	}
+	testcheck(kept, "the contacts found survive the array growing");
+
+	// fewer found the next step, the high water stays
+	world.m_boxes[3].m_body->setawake(false);
+	world.m_boxes[2].m_body->setawake(false);
+	world.generatecontacts();
+	testcheck(data.m_contact_count == 8 && data.m_overflow_count == 0, "the overflow is counted afresh each step");
+	testcheck(data.m_high_water == test_capacity_boxes*4 && data.m_grow_count == 3, "the high water and size stay");
+
+	// a box with room left for one contact keeps its deepest, whether
+	// its manifold is reduced from eight or has only a few.
+	bool reduce = collision_detector::s_reduce;
+	for (uint32_t way = 0; way < 2; way++) {
+		collision_detector::s_reduce = (way == 0);
+
+		physics_world cut;
+		if (!cut.create(2, 5, 5, 1)) { testcheck(false, "world created"); break; }
+		testsunkbox(&cut, _vec3(0.0f, 0.9f, 0.0f), _quaternion());
+
+		_quaternion tilted(1.0f, 0.3f, 0.2f, 0.1f);
+		tilted.normalise();
+		testsunkbox(&cut, _vec3(10.0f, way ? 0.6f : -2.0f, 0.0f), tilted);
+		cut.addplane( _vec3(0.0f, 1.0f, 0.0f), 0.0f );
+		cut.generatecontacts();
+
+		const collision_box &box = cut.m_boxes[1];
+		const contact &last = cut.m_cdata.m_contact_array[4];
+		uint32_t under;
+		float deepest = testdeepest(box, &under);
+		printf("%u under: contacts %u reduced %u overflow %u kept depth %.3f deepest %.3f\n", under,
+			cut.m_cdata.m_contact_count, cut.m_cdata.m_reduced_count, cut.m_cdata.m_overflow_count, last.m_penetration, deepest);
+		testcheck(way ? (under > 1 && under <= manifold_max_contacts) : under == 8, "the box has the vertices under the floor meant");
+		testcheck(cut.m_cdata.m_contact_count == 5 && cut.m_cdata.m_overflow_count == (way ? under : manifold_max_contacts) - 1,
+			"the box is cut to one contact");
+		testcheck(last.m_body[0] == box.m_body && abs(last.m_penetration - deepest) < 1e-5f,
+			way ? "the deepest is kept, not reduced" : "the deepest of a reduced manifold is kept");
+	}
+	collision_detector::s_reduce = reduce;
+}
+
+/** puts box two of unit half size on box one, at the given place and turn about y. */
+static void teststacked(collision_box *one, collision_box *two, const _vec3 &position, float turn) {
+	one->m_half_size = _vec3(1.0f, 1.0f, 1.0f);
+	two->m_half_size = _vec3(1.0f, 1.0f, 1.0f);
+	one->m_body->setposition( _vec3(0.0f, 0.0f, 0.0f) );
+	one->m_body->setorientation(_quaternion());
+	two->m_body->setposition(position);
+	two->m_body->setorientation( cos(turn*0.5f), 0.0f, sin(turn*0.5f), 0.0f );
+	one->m_body->calculatederiveddata();
+	two->m_body->calculatederiveddata();
+	one->calculateinternals();
+	two->calculateinternals();
+}
+
+static void testboxmanifold() {
+	printf("box on box\n");
+
+	physics_world world;
+	collision_data data;
+	if (!world.create(2, 64, 4096, 1) || !data.create(8, 8)) { testcheck(false, "world created"); return; }
+	collision_box *one = world.createbox();
+	collision_box *two = world.createbox();
+	if (!one || !two) { testcheck(false, "boxes created"); return; }
+
+	// set off to one side, sunk a tenth into the box below
+	teststacked(one, two, _vec3(0.5f, 1.9f, 0.2f), 0.0f);
+	uint32_t found = collision_detector::boxandbox(*one, *two, &data);
+	bool corners = true;
+	float low[2] = { 1e9f, 1e9f }, high[2] = { -1e9f, -1e9f };
+	for (uint32_t i = 0; i < found; i++) {
+		const contact &c = data.m_contact_array[i];
+		if (abs(c.m_penetration - 0.1f) > 1e-4f || abs(c.m_contact_point.y - 0.9f) > 1e-4f) { corners = false; }
+		if (c.m_contact_normal.y * (c.m_body[0] == one->m_body ? -1.0f : 1.0f) < 0.999f) { corners = false; }
+		if (c.m_contact_point.x < low[0])  { low[0]  = c.m_contact_point.x; }
+		if (c.m_contact_point.x > high[0]) { high[0] = c.m_contact_point.x; }
+		if (c.m_contact_point.z < low[1])  { low[1]  = c.m_contact_point.z; }
+		if (c.m_contact_point.z > high[1]) { high[1] = c.m_contact_point.z; }
+	}
+	printf("resting: contacts %u x %.3f to %.3f z %.3f to %.3f\n", found, low[0], high[0], low[1], high[1]);
+	testcheck(found == 4 && corners, "a box resting on another has four contacts under its face");
+	testcheck(abs(low[0] + 0.5f) < 1e-4f && abs(high[0] - 1.0f) < 1e-4f && abs(low[1] + 0.8f) < 1e-4f && abs(high[1] - 1.0f) < 1e-4f,
+		"they are the corners where the faces meet");
+
+	// moved and turned a little, the contacts keep their features
+	uint32_t features[8];
+	for (uint32_t i = 0; i < found; i++) { features[i] = data.m_contact_array[i].m_feature; }
+	teststacked(one, two, _vec3(0.52f, 1.91f, 0.19f), 0.01f);
+	data.reset();
+	uint32_t moved = collision_detector::boxandbox(*one, *two, &data);
+	uint32_t same = 0;
+	for (uint32_t i = 0; i < moved; i++) {
+		for (uint32_t j = 0; j < found; j++) { if (data.m_contact_array[i].m_feature == features[j]) { same++; break; } }
+	}
+	testcheck(moved == found && same == found, "moved a little, the contacts keep their features");
+
+	// turned an eighth of a turn, the faces meet in an octagon
+	bool reduce = collision_detector::s_reduce;
+	for (uint32_t way = 0; way < 2; way++) {
+		collision_detector::s_reduce = (way == 1);
+		teststacked(one, two, _vec3(0.0f, 1.9f, 0.0f), 3.14159265f*0.25f);
+		data.reset();
+		found = collision_detector::boxandbox(*one, *two, &data);
+		printf("turned, %s: contacts %u reduced %u\n", way ? "reduced" : "all", found, data.m_reduced_count);
+		testcheck(found == (way ? manifold_max_contacts : 8u) && data.m_reduced_count == (way ? 4u : 0u),
+			way ? "the octagon is reduced to four" : "a box turned on another has eight contacts");
+	}
+	collision_detector::s_reduce = reduce;
+	data.destroy();
+}
+
+/** a stack of boxes a little apart, dropped a little above the floor. */
+static bool teststack(physics_world *world, uint32_t height) {
+	if (!world->create(height, 64, 4096, 1)) { return false; }
+
+	for (uint32_t i = 0; i < height; i++) {
+		collision_box *box = world->createbox();
+		if (!box) { return false; }
+		box->m_half_size = _vec3(1.0f, 1.0f, 1.0f);
+
+		rigid_body *body = box->m_body;
+		float offset = (i & 1) ? 0.01f : -0.01f;
+		body->setposition( _vec3(offset, 1.05f + float(i)*2.02f, offset*0.5f) );
+		body->setorientation(_quaternion());
+		body->setvelocity( _vec3(0.0f, 0.0f, 0.0f) );
+		body->setrotation( _vec3(0.0f, 0.0f, 0.0f) );
+		body->setmass(8.0f);
+
+		_mat3 tensor;
+		tensor.setblockinertiatensor(box->m_half_size, 8.0f);
+		body->setinertiatensor(tensor);
+
+		body->setlineardamping(0.95f);
+		body->setangulardamping(0.8f);
+		body->setacceleration(0.0f, -10.0f, 0.0f);
+		body->setawake();
+		body->calculatederiveddata();
+		body->storeprevious();
+
+		world->addbox(box);
+	}
+	world->addplane( _vec3(0.0f, 1.0f, 0.0f), 0.0f );
+	return true;
+}
+
+static void testimpulsestacks() {
+	static const uint32_t heights[] = { 4, 8, 12 };
+
+	for (uint32_t h = 0; h < sizeof(heights)/sizeof(heights[0]); h++) {
+		uint32_t height = heights[h];
+		printf("stack of %u, sequential impulse\n", height);
+
+		physics_world world;
+		if (!teststack(&world, height)) { testcheck(false, "world created"); return; }
+		world.m_resolver.m_mode = solver_sequential_impulse;
+
+		uint32_t awake = height;
+		uint32_t steps = 0;
+		while (awake && steps < test_stack_steps) {
+			world.step(test_step);
+			steps++;
+
+			awake = 0;
+			for (uint32_t i = 0; i < height; i++) {
+				if (world.m_boxes[i].m_body->getawake()) { awake++; }
+			}
+		}
+
+		uint32_t fallen = 0;
+		for (uint32_t i = 0; i < height; i++) {
+			if (world.m_boxes[i].m_body->getposition().y < float(i)*2.0f) { fallen++; }
+		}
+		_vec3 apart = world.m_boxes[height-1].m_body->getposition() - world.m_boxes[0].m_body->getposition();
+		float drift = sqrt(apart.x*apart.x + apart.z*apart.z);
+
+		printf("steps %u awake %u fallen %u drift %.3f\n", steps, awake, fallen, drift);
+		testcheck(fallen == 0, "the stack stands");
+		testcheck(drift < test_stack_drift, "the stack stays straight");
+		testcheck(awake == 0, "the stack goes to sleep");
+	}
+}
+
+int main() {
+	testsleeping();
+	testawake();
+	testhalfspace();
+	testcapacity();
+	testboxmanifold();
+	testimpulsestacks();
+
+	return testresult();
+}